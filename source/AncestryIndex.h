@@ -0,0 +1,96 @@
+#ifndef ANCESTRY_INDEX_H
+#define ANCESTRY_INDEX_H
+
+#include "emp/base/assert.hpp"
+#include "emp/base/Ptr.hpp"
+
+#include <cstddef>
+
+/**
+ * An index over a phylogeny answering "is taxon A an ancestor of taxon B" in
+ * O(log depth), instead of walking B's parents one at a time.
+ *
+ * Each taxon stores its depth and one jump pointer to an ancestor (skew-binary
+ * jump pointers, Myers 1983). Jumps are chosen so that any ancestor is
+ * reachable in O(log depth) steps, and a taxon's links are set once, from its
+ * parent's, when the taxon is created (Link, called from the systematics
+ * OnNew hook). Jump targets are ancestors, which the systematics keeps as
+ * long as they have living descendants, so links never dangle.
+ *
+ * A taxon type is indexed by giving its data an `ancestry` member of type
+ * ancestry::Links<taxon type>.
+ */
+namespace ancestry {
+
+template <typename TAXON_T>
+struct Links {
+  size_t depth = 0;
+  emp::Ptr<TAXON_T> jump = nullptr;
+};
+
+/**
+ * Input: A newly created taxon, whose parent (if any) is already linked.
+ *
+ * Output: None
+ *
+ * Purpose: To add a taxon to the index.
+ */
+template <typename TAXON_T>
+void Link(emp::Ptr<TAXON_T> taxon) {
+  Links<TAXON_T>& links = taxon->GetData().ancestry;
+  emp::Ptr<TAXON_T> parent = taxon->GetParent();
+  if (parent == nullptr) {
+    links.depth = 0;
+    links.jump = taxon;
+    return;
+  }
+  const Links<TAXON_T>& parent_links = parent->GetData().ancestry;
+  const Links<TAXON_T>& jump_links = parent_links.jump->GetData().ancestry;
+  links.depth = parent_links.depth + 1;
+  // Jump twice as far as the parent's jump when the parent's jump and its
+  // jump's jump cover equal distances; otherwise restart at the parent
+  if (parent_links.depth - jump_links.depth == jump_links.depth - jump_links.jump->GetData().ancestry.depth) {
+    links.jump = jump_links.jump;
+  } else {
+    links.jump = parent;
+  }
+}
+
+template <typename TAXON_T>
+size_t GetDepth(emp::Ptr<TAXON_T> taxon) { return taxon->GetData().ancestry.depth; }
+
+/**
+ * Input: (1) A taxon; (2) the depth of the ancestor to find (at most the
+ * taxon's own depth).
+ *
+ * Output: The taxon's ancestor at that depth (the taxon itself at its own
+ * depth).
+ *
+ * Purpose: To find an ancestor in O(log depth) steps.
+ */
+template <typename TAXON_T>
+emp::Ptr<TAXON_T> GetAncestorAtDepth(emp::Ptr<TAXON_T> taxon, size_t depth) {
+  emp_assert(depth <= GetDepth(taxon), depth, GetDepth(taxon));
+  while (GetDepth(taxon) > depth) {
+    emp::Ptr<TAXON_T> jump = taxon->GetData().ancestry.jump;
+    taxon = GetDepth(jump) >= depth ? jump : taxon->GetParent();
+  }
+  return taxon;
+}
+
+/**
+ * Input: (1) The possible ancestor; (2) the possible descendant.
+ *
+ * Output: Whether the first taxon is the second or one of its ancestors.
+ *
+ * Purpose: To check ancestry in O(log depth).
+ */
+template <typename TAXON_T>
+bool IsAncestor(emp::Ptr<TAXON_T> ancestor, emp::Ptr<TAXON_T> descendant) {
+  if (GetDepth(ancestor) > GetDepth(descendant)) return false;
+  return GetAncestorAtDepth(descendant, GetDepth(ancestor)) == ancestor;
+}
+
+}
+
+#endif
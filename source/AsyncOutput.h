@@ -0,0 +1,284 @@
+#ifndef ASYNC_OUTPUT_H
+#define ASYNC_OUTPUT_H
+
+#include "Checkpoint.h"
+
+#include "emp/data/DataFile.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Background writing of output files (ASYNC_OUTPUT).
+ *
+ * The simulation thread formats its output (data file rows, snapshots, dumps,
+ * checkpoints) into memory and hands the bytes to a WriteQueue, whose writer thread does
+ * the file I/O. Writes happen in the order they were queued, so files are
+ * identical to ones written synchronously. A queue holds at most
+ * max_queued_bytes of unwritten output; past that, queueing more waits for the
+ * writer to catch up, so a slow filesystem slows the simulation down rather
+ * than growing memory without bound. Everything queued is written before the
+ * queue is destroyed.
+ */
+namespace async_output {
+
+constexpr size_t DEFAULT_MAX_QUEUED_BYTES = size_t{64} << 20;
+
+class WriteQueue {
+protected:
+  enum class JOB_TYPE { OPEN, APPEND, CLOSE, WHOLE_FILE, ATOMIC_FILE, FLUSH };
+  struct Job {
+    JOB_TYPE type;
+    std::string filepath;
+    std::string bytes;
+  };
+
+  size_t max_queued_bytes;
+  std::deque<Job> jobs;
+  size_t queued_bytes = 0;
+  bool is_writing = false;
+  bool is_stopping = false;
+  bool all_writes_ok = true;
+
+  std::mutex mutex;
+  std::condition_variable job_added;
+  std::condition_variable job_done;
+  std::thread write_thread;
+
+  // Only used by the writer thread
+  std::unordered_map<std::string, std::ofstream> open_files;
+
+  void Push(JOB_TYPE type, const std::string& filepath, std::string bytes = "") {
+    std::unique_lock lock(mutex);
+    // An oversized write still goes through once everything before it is written
+    job_done.wait(lock, [&] {
+      return queued_bytes == 0 || queued_bytes + bytes.size() <= max_queued_bytes;
+    });
+    queued_bytes += bytes.size();
+    jobs.push_back({type, filepath, std::move(bytes)});
+    job_added.notify_one();
+  }
+
+  bool DoJob(Job& job) {
+    switch (job.type) {
+    case JOB_TYPE::OPEN: {
+      std::ofstream& out = open_files[job.filepath];
+      out.open(job.filepath, std::ios::binary | std::ios::trunc);
+      return bool(out);
+    }
+    case JOB_TYPE::APPEND: {
+      auto it = open_files.find(job.filepath);
+      if (it == open_files.end()) {
+        it = open_files.emplace(job.filepath, std::ofstream(job.filepath, std::ios::binary | std::ios::app)).first;
+      }
+      it->second.write(job.bytes.data(), job.bytes.size());
+      return bool(it->second);
+    }
+    case JOB_TYPE::CLOSE: {
+      auto it = open_files.find(job.filepath);
+      if (it == open_files.end()) return true;
+      it->second.close();
+      const bool is_ok = !it->second.fail();
+      open_files.erase(it);
+      return is_ok;
+    }
+    case JOB_TYPE::WHOLE_FILE: {
+      std::ofstream out(job.filepath, std::ios::binary | std::ios::trunc);
+      out.write(job.bytes.data(), job.bytes.size());
+      return bool(out);
+    }
+    case JOB_TYPE::ATOMIC_FILE:
+      return checkpoint::WriteFileAtomic(job.filepath, job.bytes);
+    case JOB_TYPE::FLUSH: {
+      bool is_ok = true;
+      for (auto& [filepath, out] : open_files) is_ok = bool(out.flush()) && is_ok;
+      return is_ok;
+    }
+    }
+    return false;
+  }
+
+  void WriteLoop() {
+    std::unique_lock lock(mutex);
+    while (true) {
+      job_added.wait(lock, [this] { return !jobs.empty() || is_stopping; });
+      if (jobs.empty()) return;
+      Job job = std::move(jobs.front());
+      jobs.pop_front();
+      is_writing = true;
+      lock.unlock();
+      const bool is_ok = DoJob(job);
+      lock.lock();
+      all_writes_ok = all_writes_ok && is_ok;
+      queued_bytes -= job.bytes.size();
+      is_writing = false;
+      job_done.notify_all();
+    }
+  }
+
+public:
+  WriteQueue(size_t _max_queued_bytes = DEFAULT_MAX_QUEUED_BYTES) :
+    max_queued_bytes(_max_queued_bytes), write_thread([this] { WriteLoop(); })
+  { }
+  WriteQueue(const WriteQueue&) = delete;
+  WriteQueue& operator=(const WriteQueue&) = delete;
+  ~WriteQueue() {
+    {
+      std::lock_guard lock(mutex);
+      is_stopping = true;
+    }
+    job_added.notify_one();
+    write_thread.join();
+  }
+
+  // Create (or truncate) a file that Append adds to until it is closed.
+  void Open(const std::string& filepath) { Push(JOB_TYPE::OPEN, filepath); }
+  void Append(const std::string& filepath, std::string bytes) { Push(JOB_TYPE::APPEND, filepath, std::move(bytes)); }
+  void Close(const std::string& filepath) { Push(JOB_TYPE::CLOSE, filepath); }
+
+  // Replace the contents of a file.
+  void WriteFile(const std::string& filepath, std::string bytes) {
+    Push(JOB_TYPE::WHOLE_FILE, filepath, std::move(bytes));
+  }
+
+  // Replace the contents of a file without ever leaving it partly written
+  // (see checkpoint::WriteFileAtomic).
+  void WriteFileAtomic(const std::string& filepath, std::string bytes) {
+    Push(JOB_TYPE::ATOMIC_FILE, filepath, std::move(bytes));
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: Whether every write so far succeeded.
+   *
+   * Purpose: To wait until everything queued so far (including appends to
+   * files that are still open) is written out to the filesystem.
+   */
+  bool Flush() {
+    Push(JOB_TYPE::FLUSH, "");
+    std::unique_lock lock(mutex);
+    job_done.wait(lock, [this] { return jobs.empty() && !is_writing; });
+    return all_writes_ok;
+  }
+};
+
+/**
+ * A stream buffer that collects output in memory and queues it to be
+ * appended to its file each time the stream is flushed (emp::DataFile
+ * flushes after every row). The file is replaced, unless append is set.
+ */
+class QueuedStreamBuf : public std::streambuf {
+protected:
+  std::shared_ptr<WriteQueue> queue;
+  std::string filepath;
+  std::string buffer;
+
+  int_type overflow(int_type c) override {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) buffer.push_back(traits_type::to_char_type(c));
+    return traits_type::not_eof(c);
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize n) override {
+    buffer.append(s, n);
+    return n;
+  }
+
+  int sync() override {
+    if (!buffer.empty()) {
+      queue->Append(filepath, std::move(buffer));
+      buffer.clear();
+    }
+    return 0;
+  }
+
+public:
+  QueuedStreamBuf(std::shared_ptr<WriteQueue> _queue, const std::string& _filepath, bool append = false) :
+    queue(std::move(_queue)), filepath(_filepath)
+  {
+    if (!append) queue->Open(filepath);
+  }
+  QueuedStreamBuf(const QueuedStreamBuf&) = delete;
+  QueuedStreamBuf& operator=(const QueuedStreamBuf&) = delete;
+  ~QueuedStreamBuf() {
+    sync();
+    queue->Close(filepath);
+  }
+};
+
+namespace internal {
+  // Owns a data file's stream; a base class so that it outlives the data file,
+  // which writes to the stream when it is destroyed.
+  struct QueuedOStream {
+    QueuedStreamBuf buffer;
+    std::ostream stream;
+
+    QueuedOStream(std::shared_ptr<WriteQueue> queue, const std::string& filepath) :
+      buffer(std::move(queue), filepath), stream(&buffer) { }
+  };
+}
+
+/**
+ * A data file (emp::DataFile, or a subclass that can be constructed from an
+ * output stream) whose rows are written by a WriteQueue.
+ */
+template <typename DATA_FILE_T = emp::DataFile>
+class QueuedDataFile : private internal::QueuedOStream, public DATA_FILE_T {
+public:
+  template <typename... ARG_Ts>
+  QueuedDataFile(std::shared_ptr<WriteQueue> queue, const std::string& filepath, ARG_Ts&&... args) :
+    internal::QueuedOStream(std::move(queue), filepath),
+    DATA_FILE_T(stream, std::forward<ARG_Ts>(args)...)
+  { }
+};
+
+namespace internal {
+  // Owns an appended data file's stream (see QueuedOStream).
+  struct AppendedOStream {
+    std::unique_ptr<std::streambuf> buffer;
+    std::ostream stream;
+
+    static std::unique_ptr<std::streambuf> OpenBuffer(std::shared_ptr<WriteQueue> queue, const std::string& filepath) {
+      if (queue) return std::make_unique<QueuedStreamBuf>(std::move(queue), filepath, true);
+      auto file_buffer = std::make_unique<std::filebuf>();
+      file_buffer->open(filepath, std::ios::out | std::ios::binary | std::ios::app);
+      return file_buffer;
+    }
+
+    AppendedOStream(std::shared_ptr<WriteQueue> queue, const std::string& filepath) :
+      buffer(OpenBuffer(std::move(queue), filepath)), stream(buffer.get()) { }
+  };
+}
+
+/**
+ * A data file that adds its rows to the end of an existing file without
+ * repeating the file's header, for runs resumed from a checkpoint. Rows are
+ * written by the WriteQueue if one is given, and directly otherwise.
+ */
+template <typename DATA_FILE_T = emp::DataFile>
+class AppendedDataFile : private internal::AppendedOStream, public DATA_FILE_T {
+public:
+  AppendedDataFile(std::shared_ptr<WriteQueue> queue, const std::string& filepath) :
+    internal::AppendedOStream(std::move(queue), filepath),
+    DATA_FILE_T(stream)
+  {
+    // Files that write a header of their own (columnar files) skip it too
+    if constexpr (requires (DATA_FILE_T& file) { file.SkipHeader(); }) DATA_FILE_T::SkipHeader();
+  }
+
+  void PrintHeaderKeys() override { }
+};
+
+}
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "emp/base/vector.hpp"
+#include "emp/bits/Bits.hpp"
+#include "emp/math/Random.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Binary checkpoint format helpers.
+ *
+ * A checkpoint is a flat byte buffer: a header (magic number, format version,
+ * world mode) followed by whatever the world and its organisms write, in the
+ * order they write it. Values are stored in native (little-endian on all
+ * supported platforms) byte order; strings and nested blobs are length
+ * prefixed. Bump FORMAT_VERSION whenever the layout written by any world or
+ * organism changes.
+ */
+namespace checkpoint {
+
+constexpr uint64_t MAGIC = 0x54504b434d5953; // "SYMCKPT"
+constexpr uint32_t FORMAT_VERSION = 3;
+
+class Writer {
+protected:
+  std::string buffer;
+
+public:
+  template<typename T>
+  void Write(const T& val) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be written directly");
+    buffer.append(reinterpret_cast<const char*>(&val), sizeof(T));
+  }
+
+  void WriteString(const std::string& str) {
+    Write<uint64_t>(str.size());
+    buffer.append(str);
+  }
+
+  // Vectors of plain values are length prefixed.
+  template<typename T>
+  void WriteVector(const emp::vector<T>& vec) {
+    Write<uint64_t>(vec.size());
+    for (const T& val : vec) Write(val);
+  }
+
+  // Bits are packed 8 per byte.
+  template<typename BITS_T>
+  void WriteBits(const BITS_T& bits) {
+    const size_t num_bits = bits.GetSize();
+    Write<uint64_t>(num_bits);
+    for (size_t byte_start = 0; byte_start < num_bits; byte_start += 8) {
+      uint8_t byte = 0;
+      for (size_t i = byte_start; i < num_bits && i < byte_start + 8; ++i) {
+        if (bits.Get(i)) byte |= (uint8_t)(1 << (i - byte_start));
+      }
+      Write(byte);
+    }
+  }
+
+  const std::string& GetBuffer() const { return buffer; }
+  std::string TakeBuffer() { return std::move(buffer); }
+  size_t GetSize() const { return buffer.size(); }
+};
+
+class Reader {
+protected:
+  std::string buffer;
+  size_t read_pos = 0;
+  bool ok = true; // False once any read has run past the end of the buffer
+
+  bool Take(void* dest, size_t num_bytes) {
+    if (!ok || num_bytes > buffer.size() - read_pos) {
+      ok = false;
+      return false;
+    }
+    std::memcpy(dest, buffer.data() + read_pos, num_bytes);
+    read_pos += num_bytes;
+    return true;
+  }
+
+public:
+  Reader() = default;
+  explicit Reader(std::string in_buffer) : buffer(std::move(in_buffer)) { }
+
+  bool LoadFile(const std::string& filepath) {
+    std::ifstream in(filepath, std::ios::binary);
+    if (!in) return false;
+    buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    read_pos = 0;
+    ok = true;
+    return true;
+  }
+
+  // Failed reads return a value-initialized T and mark the reader as not ok.
+  template<typename T>
+  T Read() {
+    static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be read directly");
+    T val{};
+    Take(&val, sizeof(T));
+    return val;
+  }
+
+  std::string ReadString() {
+    const uint64_t size = Read<uint64_t>();
+    if (!ok || size > buffer.size() - read_pos) {
+      ok = false;
+      return "";
+    }
+    std::string str = buffer.substr(read_pos, size);
+    read_pos += size;
+    return str;
+  }
+
+  template<typename T>
+  void ReadVector(emp::vector<T>& vec) {
+    const uint64_t size = Read<uint64_t>();
+    if (!ok || size > (buffer.size() - read_pos) / sizeof(T)) {
+      ok = false;
+      return;
+    }
+    vec.resize(size);
+    for (T& val : vec) val = Read<T>();
+  }
+
+  // Bit count must match the destination's size (i.e., same TAG_LENGTH).
+  template<size_t NUM_BITS>
+  void ReadBits(emp::BitSet<NUM_BITS>& bits) {
+    if (Read<uint64_t>() != NUM_BITS) {
+      ok = false;
+      return;
+    }
+    ReadBitValues(bits, NUM_BITS);
+  }
+
+  void ReadBits(emp::BitVector& bits) {
+    const uint64_t num_bits = Read<uint64_t>();
+    if (!ok || num_bits / 8 > buffer.size() - read_pos) {
+      ok = false;
+      return;
+    }
+    bits.Resize(num_bits);
+    ReadBitValues(bits, num_bits);
+  }
+
+  template<typename BITS_T>
+  void ReadBitValues(BITS_T& bits, size_t num_bits) {
+    for (size_t byte_start = 0; byte_start < num_bits; byte_start += 8) {
+      const uint8_t byte = Read<uint8_t>();
+      for (size_t i = byte_start; i < num_bits && i < byte_start + 8; ++i) {
+        bits.Set(i, (byte >> (i - byte_start)) & 1);
+      }
+    }
+  }
+
+  // Marks the reader as not ok, for values that were read but don't make sense.
+  void Fail() { ok = false; }
+
+  bool IsOK() const { return ok; }
+  bool AtEnd() const { return read_pos == buffer.size(); }
+};
+
+// Random number generators are stored as their internal state (the
+// middle-square Weyl sequence position, its seed, and the cached exponential
+// variate), so a restored generator continues the exact sequence the saved one
+// would have drawn (and saving one doesn't disturb it). emp::Random keeps that
+// state in protected members, which RandomStateAccess reaches from a derived
+// class; it is never instantiated.
+class RandomStateAccess : public emp::Random {
+public:
+  // RANDOM_T is emp::Random or const emp::Random.
+  template<typename RANDOM_T>
+  static auto Fields(RANDOM_T& random) {
+    return std::tie(
+      random.*(&RandomStateAccess::value),
+      random.*(&RandomStateAccess::weyl_state),
+      random.*(&RandomStateAccess::original_seed),
+      random.*(&RandomStateAccess::expRV)
+    );
+  }
+};
+
+// Fails to compile if emp::Random gains state that RandomStateAccess misses.
+static_assert(sizeof(emp::Random) == 3 * sizeof(uint64_t) + sizeof(double),
+              "emp::Random has state that checkpoints don't store");
+
+constexpr size_t RANDOM_STATE_SIZE = 3 * sizeof(uint64_t) + sizeof(double);
+
+inline std::string SaveRandomState(const emp::Random& random) {
+  const auto [value, weyl_state, original_seed, exp_rv] = RandomStateAccess::Fields(random);
+  Writer writer;
+  writer.Write<uint64_t>(value);
+  writer.Write<uint64_t>(weyl_state);
+  writer.Write<uint64_t>(original_seed);
+  writer.Write<double>(exp_rv);
+  return writer.TakeBuffer();
+}
+
+inline bool RestoreRandomState(emp::Random& random, const std::string& state) {
+  if (state.size() != RANDOM_STATE_SIZE) return false;
+  Reader reader(state);
+  const uint64_t value = reader.Read<uint64_t>();
+  const uint64_t weyl_state = reader.Read<uint64_t>();
+  const uint64_t original_seed = reader.Read<uint64_t>();
+  const double exp_rv = reader.Read<double>();
+  if (!reader.IsOK()) return false;
+  RandomStateAccess::Fields(random) = std::tie(value, weyl_state, original_seed, exp_rv);
+  return true;
+}
+
+/**
+ * Input: Path of the file to write and the bytes to write into it.
+ *
+ * Output: Boolean indicating whether the file was written.
+ *
+ * Purpose: Write the file next to its destination and then rename it into
+ * place, so a crash mid-write never leaves a truncated checkpoint behind.
+ */
+inline bool WriteFileAtomic(const std::string& filepath, const std::string& bytes) {
+  const std::string tmp_filepath = filepath + ".tmp";
+  {
+    std::ofstream out(tmp_filepath, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(bytes.data(), bytes.size());
+    if (!out) return false;
+  }
+  return std::rename(tmp_filepath.c_str(), filepath.c_str()) == 0;
+}
+
+}
+
+#endif
@@ -0,0 +1,488 @@
+#ifndef COLUMNAR_DATA_H
+#define COLUMNAR_DATA_H
+
+#include "Checkpoint.h"
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/data/DataFile.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#ifdef SYMBULATION_USE_ZLIB
+#include <zlib.h>
+#endif
+
+/**
+ * Columnar binary data files (DATA_FILE_FORMAT "columnar").
+ *
+ * A columnar data file holds the same columns, with the same values, as the
+ * CSV data file it replaces, but stored column by column in blocks of rows:
+ * - Header: MAGIC, FORMAT_VERSION, the CODEC column values are stored with,
+ *   whether the CSV file has a header row, and each column's key and
+ *   description
+ * - Blocks, until the end of the file: the number of rows, then for each
+ *   column its type and its encoded values (length prefixed, so readers can
+ *   skip columns they don't need)
+ *
+ * Each column's type is chosen per block: INT if every value is an integer,
+ * FLOAT if every value is a number, and STRING otherwise. INT values are
+ * stored as varints of the (zigzag encoded) difference from the previous
+ * value, and FLOAT values the same way as a decimal exponent and mantissa
+ * (0.00123 is -5 and 123), so slowly changing columns (counts, histogram
+ * bins, settings) take a byte or two per row and printed floats about four.
+ * Values are kept exactly as emp::DataFile prints them, so converting back
+ * to CSV (WriteCSV) reproduces the CSV file.
+ *
+ * With the DEFLATE codec (the default when built with SYMBULATION_USE_ZLIB,
+ * i.e., make ZLIB=1), each column's encoded values are zlib compressed and
+ * preceded by their uncompressed size. Version 1 files have no codec in the
+ * header and are never compressed; they can still be read.
+ *
+ * Numbers use native byte order (see checkpoint::Writer).
+ */
+namespace columnar {
+
+constexpr uint64_t MAGIC = 0x4c4f434d5953; // "SYMCOL"
+constexpr uint32_t FORMAT_VERSION = 2;
+constexpr size_t DEFAULT_BLOCK_ROWS = 64;
+inline const std::string FILE_EXTENSION = ".col";
+
+enum class COLUMN_TYPE : uint8_t { INT = 0, FLOAT = 1, STRING = 2 };
+enum class CODEC : uint8_t { NONE = 0, DEFLATE = 1 };
+
+#ifdef SYMBULATION_USE_ZLIB
+constexpr CODEC DEFAULT_CODEC = CODEC::DEFLATE;
+#else
+constexpr CODEC DEFAULT_CODEC = CODEC::NONE;
+#endif
+
+// Whether this build can write and read columns stored with the codec
+inline bool HasCodec(CODEC codec) {
+#ifdef SYMBULATION_USE_ZLIB
+  return codec == CODEC::NONE || codec == CODEC::DEFLATE;
+#else
+  return codec == CODEC::NONE;
+#endif
+}
+
+inline void WriteVarint(checkpoint::Writer& writer, uint64_t val) {
+  while (val >= 0x80) {
+    writer.Write<uint8_t>((val & 0x7f) | 0x80);
+    val >>= 7;
+  }
+  writer.Write<uint8_t>(val);
+}
+
+inline uint64_t ReadVarint(checkpoint::Reader& reader) {
+  uint64_t val = 0;
+  for (size_t shift = 0; shift < 64 && reader.IsOK(); shift += 7) {
+    const uint8_t byte = reader.Read<uint8_t>();
+    val |= uint64_t(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) break;
+  }
+  return val;
+}
+
+inline void WriteVarString(checkpoint::Writer& writer, const std::string& str) {
+  WriteVarint(writer, str.size());
+  for (char c : str) writer.Write(c);
+}
+
+inline std::string ReadVarString(checkpoint::Reader& reader) {
+  std::string str(ReadVarint(reader), '\0');
+  for (char& c : str) c = reader.Read<char>();
+  return str;
+}
+
+/**
+ * Input: (1) The writer to append to; (2) a column's encoded values; (3) the
+ * codec to store them with.
+ *
+ * Output: None
+ *
+ * Purpose: To write a column's encoded values, compressing them if the codec
+ * calls for it.
+ */
+inline void WritePayload(checkpoint::Writer& writer, const std::string& payload, CODEC codec) {
+  emp_assert(HasCodec(codec));
+#ifdef SYMBULATION_USE_ZLIB
+  if (codec == CODEC::DEFLATE) {
+    thread_local std::string compressed;
+    uLongf compressed_size = compressBound(payload.size());
+    compressed.resize(compressed_size);
+    const int result = compress2(reinterpret_cast<Bytef*>(compressed.data()), &compressed_size,
+                                 reinterpret_cast<const Bytef*>(payload.data()), payload.size(),
+                                 Z_DEFAULT_COMPRESSION);
+    emp_assert(result == Z_OK, result);
+    compressed.resize(compressed_size);
+    writer.Write<uint64_t>(payload.size());
+    writer.WriteString(compressed);
+    return;
+  }
+#endif
+  writer.WriteString(payload);
+}
+
+/**
+ * Input: (1) The reader positioned at a column's encoded values; (2) the codec
+ * they were stored with; (3) where to put the (uncompressed) encoded values.
+ *
+ * Output: Whether the values were read.
+ *
+ * Purpose: To read a column's encoded values written by WritePayload.
+ */
+inline bool ReadPayload(checkpoint::Reader& reader, CODEC codec, std::string& payload) {
+  if (codec == CODEC::NONE) {
+    payload = reader.ReadString();
+    return reader.IsOK();
+  }
+#ifdef SYMBULATION_USE_ZLIB
+  if (codec == CODEC::DEFLATE) {
+    const uint64_t size = reader.Read<uint64_t>();
+    const std::string compressed = reader.ReadString();
+    // zlib can't expand data more than about 1032 times, so larger sizes are corrupt
+    if (!reader.IsOK() || size > (compressed.size() + 1) * 1032) return false;
+    payload.resize(size);
+    uLongf payload_size = size;
+    const int result = uncompress(reinterpret_cast<Bytef*>(payload.data()), &payload_size,
+                                  reinterpret_cast<const Bytef*>(compressed.data()), compressed.size());
+    return result == Z_OK && payload_size == size;
+  }
+#endif
+  return false;
+}
+
+inline uint64_t ZigZag(int64_t val) { return (uint64_t(val) << 1) ^ uint64_t(val >> 63); }
+inline int64_t UnZigZag(uint64_t val) { return int64_t(val >> 1) ^ -int64_t(val & 1); }
+
+/**
+ * Input: A floating point value.
+ *
+ * Output: The value as emp::DataFile prints it (default stream formatting).
+ *
+ * Purpose: To turn FLOAT values back into text.
+ */
+inline std::string FormatFloat(double val) {
+  thread_local std::ostringstream stream;
+  stream.str("");
+  stream << val;
+  return stream.str();
+}
+
+// Only accepts values that print back to exactly the same text.
+inline bool ParseInt(std::string_view text, int64_t& val) {
+  const auto [end, err] = std::from_chars(text.data(), text.data() + text.size(), val);
+  return err == std::errc() && end == text.data() + text.size() && std::to_string(val) == text;
+}
+
+inline double DecimalToDouble(int64_t mantissa, int64_t exponent) {
+  const std::string text = std::to_string(mantissa) + "e" + std::to_string(exponent);
+  return std::strtod(text.c_str(), nullptr);
+}
+
+/**
+ * Input: (1) A value, as text; (2) output decimal mantissa; (3) output
+ * decimal exponent.
+ *
+ * Output: Whether the value is a number that prints back to exactly the same
+ * text from its mantissa and exponent.
+ *
+ * Purpose: To split a printed floating point value (e.g., 0.00123 or 1e+06)
+ * into its decimal digits (123) and exponent (-5). Values printed with the
+ * default 6 significant digits have mantissas of at most 3 varint bytes.
+ */
+inline bool ParseDecimal(std::string_view text, int64_t& mantissa, int64_t& exponent) {
+  size_t i = 0;
+  const bool is_negative = !text.empty() && text[0] == '-';
+  if (is_negative) ++i;
+  uint64_t digits = 0;
+  size_t num_digits = 0;
+  bool has_digits = false;
+  bool has_point = false;
+  exponent = 0;
+  for (; i < text.size(); ++i) {
+    const char c = text[i];
+    if (c == '.' && !has_point) {
+      has_point = true;
+      continue;
+    }
+    if (c < '0' || c > '9') break;
+    has_digits = true;
+    if (has_point) --exponent;
+    if (digits == 0 && c == '0') continue;
+    if (++num_digits > 18) return false;
+    digits = digits * 10 + (c - '0');
+  }
+  if (!has_digits) return false;
+  if (i < text.size() && text[i] == 'e') {
+    ++i;
+    if (i < text.size() && text[i] == '+') ++i;
+    int64_t printed_exponent = 0;
+    const auto [end, err] = std::from_chars(text.data() + i, text.data() + text.size(), printed_exponent);
+    if (err != std::errc()) return false;
+    exponent += printed_exponent;
+    i = end - text.data();
+  }
+  if (i != text.size()) return false;
+  mantissa = is_negative ? -int64_t(digits) : int64_t(digits);
+  return FormatFloat(DecimalToDouble(mantissa, exponent)) == text;
+}
+
+/**
+ * Input: (1) The writer to append to; (2) one block's values for a column, as
+ * text; (3) the codec to store them with.
+ *
+ * Output: None
+ *
+ * Purpose: To choose the column's type for this block and write its values.
+ */
+inline void WriteColumn(checkpoint::Writer& writer, const emp::vector<std::string>& values,
+                        CODEC codec = CODEC::NONE) {
+  thread_local emp::vector<int64_t> mantissas;
+  thread_local emp::vector<int64_t> exponents;
+  mantissas.resize(values.size());
+  exponents.resize(values.size());
+  COLUMN_TYPE type = COLUMN_TYPE::INT;
+  for (size_t i = 0; i < values.size() && type == COLUMN_TYPE::INT; ++i) {
+    if (!ParseInt(values[i], mantissas[i])) type = COLUMN_TYPE::FLOAT;
+  }
+  if (type == COLUMN_TYPE::FLOAT) {
+    for (size_t i = 0; i < values.size() && type == COLUMN_TYPE::FLOAT; ++i) {
+      if (!ParseDecimal(values[i], mantissas[i], exponents[i])) type = COLUMN_TYPE::STRING;
+    }
+  }
+
+  checkpoint::Writer payload;
+  if (type == COLUMN_TYPE::STRING) {
+    for (const std::string& value : values) WriteVarString(payload, value);
+  } else {
+    int64_t prev_mantissa = 0;
+    int64_t prev_exponent = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (type == COLUMN_TYPE::FLOAT) {
+        WriteVarint(payload, ZigZag(exponents[i] - prev_exponent));
+        prev_exponent = exponents[i];
+      }
+      WriteVarint(payload, ZigZag(int64_t(uint64_t(mantissas[i]) - uint64_t(prev_mantissa))));
+      prev_mantissa = mantissas[i];
+    }
+  }
+  writer.Write(type);
+  WritePayload(writer, payload.GetBuffer(), codec);
+}
+
+/**
+ * Input: (1) The reader positioned at a column's type; (2) the number of rows
+ * in the block; (3) where to append the column's values, as text; (4) the
+ * codec the file's columns are stored with.
+ *
+ * Output: Whether the column was read.
+ *
+ * Purpose: To read one block's values for a column.
+ */
+inline bool ReadColumn(checkpoint::Reader& reader, size_t num_rows, emp::vector<std::string>& values,
+                       CODEC codec = CODEC::NONE) {
+  const COLUMN_TYPE type = reader.Read<COLUMN_TYPE>();
+  std::string payload_bytes;
+  if (!ReadPayload(reader, codec, payload_bytes)) return false;
+  checkpoint::Reader payload(std::move(payload_bytes));
+  if (type == COLUMN_TYPE::STRING) {
+    for (size_t i = 0; i < num_rows; ++i) values.push_back(ReadVarString(payload));
+  } else if (type == COLUMN_TYPE::INT || type == COLUMN_TYPE::FLOAT) {
+    int64_t mantissa = 0;
+    int64_t exponent = 0;
+    for (size_t i = 0; i < num_rows; ++i) {
+      if (type == COLUMN_TYPE::FLOAT) exponent += UnZigZag(ReadVarint(payload));
+      mantissa = int64_t(uint64_t(mantissa) + uint64_t(UnZigZag(ReadVarint(payload))));
+      values.push_back(type == COLUMN_TYPE::INT ? std::to_string(mantissa) :
+                       FormatFloat(DecimalToDouble(mantissa, exponent)));
+    }
+  } else {
+    return false;
+  }
+  return payload.IsOK() && payload.AtEnd();
+}
+
+/**
+ * A whole columnar data file, with every value as text.
+ */
+struct Table {
+  CODEC codec = CODEC::NONE;
+  bool has_header_row = true;
+  emp::vector<std::string> keys;
+  emp::vector<std::string> descs;
+  emp::vector<emp::vector<std::string>> columns;
+
+  size_t GetNumRows() const { return columns.empty() ? 0 : columns[0].size(); }
+};
+
+/**
+ * Input: (1) The path of a columnar data file; (2) the table to read it into.
+ *
+ * Output: Whether the file was read. A file whose last block was cut short
+ * (e.g., by a crash) is read up to that block. Compressed files can only be
+ * read by builds with the same codec (see HasCodec).
+ *
+ * Purpose: To read a columnar data file.
+ */
+inline bool ReadTable(const std::string& filepath, Table& table) {
+  checkpoint::Reader reader;
+  if (!reader.LoadFile(filepath)) return false;
+  if (reader.Read<uint64_t>() != MAGIC) return false;
+  const uint32_t version = reader.Read<uint32_t>();
+  if (version != 1 && version != FORMAT_VERSION) return false;
+  table.codec = (version == 1) ? CODEC::NONE : reader.Read<CODEC>();
+  if (!HasCodec(table.codec)) return false;
+  table.has_header_row = reader.Read<uint8_t>();
+  const size_t num_columns = reader.Read<uint64_t>();
+  table.keys.clear();
+  table.descs.clear();
+  for (size_t col = 0; col < num_columns && reader.IsOK(); ++col) {
+    table.keys.push_back(reader.ReadString());
+    table.descs.push_back(reader.ReadString());
+  }
+  if (!reader.IsOK()) return false;
+
+  table.columns.assign(num_columns, {});
+  while (!reader.AtEnd()) {
+    const size_t num_rows = reader.Read<uint64_t>();
+    const size_t block_columns = reader.Read<uint64_t>();
+    if (!reader.IsOK() || block_columns != num_columns) break;
+    bool block_ok = true;
+    emp::vector<emp::vector<std::string>> block(num_columns);
+    for (size_t col = 0; col < num_columns && block_ok; ++col) {
+      block_ok = ReadColumn(reader, num_rows, block[col], table.codec);
+    }
+    if (!block_ok) break;
+    for (size_t col = 0; col < num_columns; ++col) {
+      table.columns[col].insert(table.columns[col].end(), block[col].begin(), block[col].end());
+    }
+  }
+  return true;
+}
+
+/**
+ * Input: (1) A table; (2) the stream to write to.
+ *
+ * Output: None
+ *
+ * Purpose: To write a table in the same CSV format emp::DataFile uses.
+ */
+inline void WriteCSV(const Table& table, std::ostream& out) {
+  if (table.has_header_row) {
+    for (size_t col = 0; col < table.keys.size(); ++col) {
+      if (col > 0) out << ',';
+      out << table.keys[col];
+    }
+    out << '\n';
+  }
+  for (size_t row = 0; row < table.GetNumRows(); ++row) {
+    for (size_t col = 0; col < table.columns.size(); ++col) {
+      if (col > 0) out << ',';
+      out << table.columns[col][row];
+    }
+    out << '\n';
+  }
+}
+
+/**
+ * An emp::DataFile that writes a columnar data file instead of CSV. Columns
+ * are added and timed exactly as for emp::DataFile.
+ */
+class DataFile : public emp::DataFile {
+protected:
+  size_t block_rows;
+  CODEC codec;
+  size_t num_rows = 0;            // Rows in the current block
+  bool has_header_row = false;    // Whether PrintHeaderKeys was called
+  bool header_written = false;
+  emp::vector<emp::vector<std::string>> block_values; // Current block, by column
+  std::ostringstream value_stream;
+  checkpoint::Writer writer;
+
+  void WriteHeader() {
+    writer.Write(MAGIC);
+    writer.Write(FORMAT_VERSION);
+    writer.Write(codec);
+    writer.Write<uint8_t>(has_header_row);
+    writer.Write<uint64_t>(keys.size());
+    for (size_t col = 0; col < keys.size(); ++col) {
+      writer.WriteString(keys[col]);
+      writer.WriteString(descs[col]);
+    }
+    header_written = true;
+  }
+
+  void WriteBlock() {
+    if (!header_written) WriteHeader();
+    if (num_rows > 0) {
+      writer.Write<uint64_t>(num_rows);
+      writer.Write<uint64_t>(block_values.size());
+      for (auto& values : block_values) {
+        WriteColumn(writer, values, codec);
+        values.clear();
+      }
+      num_rows = 0;
+    }
+    os->write(writer.GetBuffer().data(), writer.GetBuffer().size());
+    os->flush();
+    writer = checkpoint::Writer();
+  }
+
+public:
+  DataFile(const std::string& filename, size_t _block_rows = DEFAULT_BLOCK_ROWS, CODEC _codec = DEFAULT_CODEC) :
+    emp::DataFile(filename),
+    block_rows(std::max<size_t>(1, _block_rows)),
+    codec(_codec)
+  { emp_assert(HasCodec(codec)); }
+  DataFile(std::ostream& out, size_t _block_rows = DEFAULT_BLOCK_ROWS, CODEC _codec = DEFAULT_CODEC) :
+    emp::DataFile(out),
+    block_rows(std::max<size_t>(1, _block_rows)),
+    codec(_codec)
+  { emp_assert(HasCodec(codec)); }
+  DataFile(const DataFile&) = delete;
+  DataFile& operator=(const DataFile&) = delete;
+  ~DataFile() { WriteBlock(); }
+
+  // The header row is written (as the table's keys) when the file is converted to CSV.
+  void PrintHeaderKeys() override { has_header_row = true; }
+
+  // For adding blocks to the end of a file that already has its header (which
+  // must be for the same codec, i.e., written by a build with the same ZLIB setting).
+  void SkipHeader() { header_written = true; }
+
+  void Update() override {
+    for (auto& fun : pre_funs) fun();
+    block_values.resize(funs.size());
+    for (size_t col = 0; col < funs.size(); ++col) {
+      value_stream.str("");
+      funs[col](value_stream);
+      block_values[col].push_back(value_stream.str());
+    }
+    if (++num_rows >= block_rows) WriteBlock();
+  }
+
+  using emp::DataFile::Update;
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To write out the rows collected so far.
+   */
+  void Flush() { WriteBlock(); }
+};
+
+}
+
+#endif
@@ -43,21 +43,32 @@ EMP_BUILD_CONFIG(SymConfigBase,
     VALUE(DOMINANT_COUNT, size_t, 10, "Number of dominant hosts to select"),
     VALUE(FILE_PATH, std::string, "Data", "Output file path"),
     VALUE(FILE_NAME, std::string, "_data", "Root output file name"),
+    VALUE(DATA_FILE_FORMAT, std::string, "csv", "In what format should data files be written? csv [text] or columnar [compact binary, with a .col suffix, compressed when built with ZLIB=1; convert to csv with symbulation_columnar_to_csv, see ColumnarData.h]"),
+    VALUE(ASYNC_OUTPUT, bool, 0, "Should data files, snapshots, dumps and checkpoints be written on a background thread, so the simulation doesn't wait on the filesystem? (0 for no, 1 for yes)"),
+    VALUE(ASYNC_OUTPUT_QUEUE_MB, size_t, 64, "With ASYNC_OUTPUT, how many megabytes of output can wait to be written before the simulation waits for the writer?"),
     VALUE(CURE, bool, 0, "Should all symbionts die (0 for no, 1 for yes)"),
     VALUE(CURE_UPDATES, size_t, 0, "How many updates should run before all symbionts die, will take the next update for effect"),
+    VALUE(CHECKPOINT_INTERVAL, int, 0, "How frequently, in updates, should the full world state be saved to a checkpoint file? 0 for never"),
+    VALUE(CHECKPOINT_PATH, std::string, "", "Path of the checkpoint file (overwritten at each checkpoint). Leave blank to use FILE_PATH + Checkpoint + FILE_NAME + _SEED<seed>.ckpt"),
+    VALUE(LOAD_CHECKPOINT, std::string, "", "Path of a checkpoint file to resume the experiment from (written by a run with the same world mode and size); data files are appended to. Leave blank to start a new experiment"),
+    VALUE(POPULATION_STORE, std::string, "objects", "How should default mode hosts and symbionts be stored while the experiment runs? Options: objects [one object per organism], soa [structure-of-arrays, faster for large worlds; not supported with PHYLOGENY, TAG_MATCHING, FREE_LIVING_SYMS, ECTOSYMBIOSIS or OUSTING]"),
 
     GROUP(SPATIAL_STRUCTURE, "Spatial structure settings"),
     VALUE(SPATIAL_STRUCT_MODE, std::string, "well-mixed", "Options: well-mixed, grid, load (requires filepath in LoadFile param)"),
     VALUE(SPATIAL_STRUCT_CFG_PATH, std::string, "spatial-struct.mat", "Path to the file containing the spatial structure"),
-    VALUE(SPATIAL_STRUCT_LOAD_MODE, std::string, "matrix", "Expected file format for loaded spatial structure. Options: matrix, edges"),
+    VALUE(SPATIAL_STRUCT_LOAD_MODE, std::string, "matrix", "Expected file format for loaded spatial structure. Options: matrix, edges, binary"),
+    VALUE(SPATIAL_STRUCT_CACHE_PATH, std::string, "", "Used for the edges load mode. Path to a binary cache of the loaded spatial structure; read if it exists, otherwise written after loading the edges file. Leave blank for no cache"),
     VALUE(WORLD_WIDTH, size_t, 100, "Used for grid and well-mixed modes. Width of the world, just multiplied by the height to get total size"),
     VALUE(WORLD_HEIGHT, size_t, 100, "Used for grid and well-mixed modes. Height of world, just multiplied by width to get total size"),
+    VALUE(SCHEDULE_MODE, std::string, "random", "In what order should world positions be processed each update? Options: random [every position, in a new random order], occupied [only positions occupied at the start of the update, in random order; faster for sparse worlds], blocked-random [every position, in randomly ordered blocks of SCHEDULE_BLOCK_SIZE adjacent positions; better cache locality]"),
+    VALUE(SCHEDULE_BLOCK_SIZE, size_t, 64, "Used for the blocked-random schedule mode. Number of adjacent positions processed together"),
 
     GROUP(PHYLOGENY, "PHYLOGENY"),
     VALUE(PHYLOGENY, bool, 0, "Should the world keep track of host and symbiont phylogenies? (0 for no, 1 for yes)"),
     VALUE(TRACK_PHYLOGENY_INTERACTIONS, bool, 0, "Should the world keep track of interactions between hosts and symbionts, then write the count of all (including historical) interactions committed by tracked taxa? (0 for no, 1 for yes)?"),
     VALUE(WRITE_CURRENT_INTERACTION_COUNTS, bool, 0, "Should the world write the count of only-currently-present interactions? (0 for no, 1 for yes)"),
     VALUE(PHYLOGENY_SNAPSHOT_INTERVAL, int, 10001, "How often to output phylogeny snapshots"),
+    VALUE(SNAPSHOT_GZIP, bool, 0, "Should interaction snapshots be gzip compressed (written with a .gz suffix)? Requires building with ZLIB=1 (0 for no, 1 for yes)"),
     VALUE(NUM_PHYLO_BINS, size_t, 5, "How many bins should organisms be separated into if phylogeny is on?"),
     VALUE(PHYLOGENY_TAXON_TYPE, std::string, "interaction-value-binned", "What are phylogeny taxa based on? Options: interaction-value-binned, interaction-value-exact, tag, individual"),
     VALUE(STORE_EXTINCT, bool, 0, "Should extinct taxa be stored? (0 for no, 1 for yes)"),
@@ -95,7 +106,9 @@ EMP_BUILD_CONFIG(SymConfigBase,
     VALUE(TAG_MUTATION_SIZE, double, 0.01, "What is the probability that any given position in the bitstring tag flips during mutation?"),
     VALUE(VT_TAG_MATCH, bool, 1, "Should tag matching be required for vertical transmission (0 for no, 1 for yes)?"),
     VALUE(WRITE_TAG_MATRIX, bool, 0, "At the end of the experiment, should a similarity matrix of all persisting tags be generated?"),
-    VALUE(TAG_MATRIX_SAMPLE_PROPORTION, double, 0.1, "What proportion of positions in the world should be sampled to produce the tag matrix from?"),
+    VALUE(TAG_MATRIX_SAMPLE_PROPORTION, double, 0.1, "What proportion of positions in the world should be sampled to produce the tag matrix from? (1 for the whole population)"),
+    VALUE(TAG_MATRIX_FORMAT, std::string, "csv", "In what format should the tag matrix be written? csv [text] or binary [compact; float32 distances, see tag_utils.h]"),
+    VALUE(TAG_MATRIX_NUM_THREADS, size_t, 0, "How many threads should be used to compute the tag matrix? (0 for one per hardware thread)"),
     VALUE(HOST_STARTING_TAGS_ONE_PROB, double, 0, "What probability should initializing bits in tags have of being 1s? Hosted symbionts will be assigned their host's tag. (0 for basic, all-0 only tags)")
 )
 #endif
@@ -6,12 +6,24 @@
 #include "ConfigSetup.h"
 #include "emp/Evolve/Systematics.hpp"
 #include "TaxonData.h"
+#include "OrganismPool.h"
+#include "Checkpoint.h"
 
 class Organism {
 
   public:
   using taxon_info_t = double;
 
+#ifndef SYM_DISABLE_ORGANISM_POOL
+  // Organisms (including all derived types) are allocated from org_pool,
+  // which records each organism's size and owning pool with its memory.
+  static void* operator new(size_t size) { return org_pool::Allocate(size); }
+  static void operator delete(void* ptr) { org_pool::Free(ptr); }
+  // Over-aligned organism types bypass the pool.
+  static void* operator new(size_t size, std::align_val_t align) { return ::operator new(size, align); }
+  static void operator delete(void* ptr, size_t size, std::align_val_t align) { ::operator delete(ptr, size, align); }
+#endif
+
   Organism() = default;
   Organism(const Organism &) = default;
   Organism(Organism &&) = default;
@@ -296,6 +308,15 @@ class Organism {
     std::cout << "GetCyclesGiven called from Organism" << std::endl;
     throw "Organism method called!";
   }
+  //Checkpoint functions
+  virtual void SaveCheckpoint(checkpoint::Writer& writer) const {
+    std::cout << "SaveCheckpoint called from Organism" << std::endl;
+    throw "Organism method called!";
+  }
+  virtual void LoadCheckpoint(checkpoint::Reader& reader) {
+    std::cout << "LoadCheckpoint called from Organism" << std::endl;
+    throw "Organism method called!";
+  }
   //Bacterium functions
   virtual double ProcessLysogenResources(double phage_inc_val) {
     std::cout << "ProcessLysogenResources called from Organism" << std::endl;
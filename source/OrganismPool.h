@@ -0,0 +1,330 @@
+#ifndef ORGANISM_POOL_H
+#define ORGANISM_POOL_H
+
+#include "emp/base/assert.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * Slab/free-list allocator for organisms.
+ *
+ * Organism overrides its class-level operator new/delete to use this pool, so
+ * every organism type (Host, Symbiont, Phage, SGPHost, ...) created with
+ * emp::NewPtr and destroyed with Ptr::Delete (e.g., in CleanupGraveyard)
+ * recycles memory from earlier organisms of the same size instead of going
+ * through the global heap. Memory is carved out of slabs of SLAB_OBJECTS
+ * objects, and freed objects go onto a per-size free list.
+ *
+ * NOTE - Each thread allocates from its own pool, and every object records the
+ *        pool it came from, so it is always returned to that pool. Organisms
+ *        may be deleted on a different thread than they were created on (e.g.,
+ *        a world built on one thread and run on another): they wait on the
+ *        owning pool's remote free list until its thread allocates again. A
+ *        thread's pool is freed once the thread has exited and the last of its
+ *        organisms is deleted.
+ * NOTE - Compile with -DSYM_DISABLE_ORGANISM_POOL to use the global heap
+ *        instead (e.g., when debugging memory with sanitizers).
+ */
+namespace org_pool {
+
+/**
+ * Allocation counters, for benchmarking. Frees from other threads are counted
+ * when the pool takes the memory back.
+ */
+struct PoolStats {
+  size_t num_allocs = 0;      // Total organism allocations
+  size_t num_reused = 0;      // Allocations served from a free list
+  size_t num_frees = 0;       // Total organism deallocations
+  size_t num_live = 0;        // Organisms currently allocated
+  size_t num_slabs = 0;       // Slabs allocated from the global heap
+  size_t bytes_reserved = 0;  // Bytes held in slabs
+};
+
+class OrganismPool {
+public:
+  static constexpr size_t SLAB_OBJECTS = 256;
+
+protected:
+  struct FreeNode { FreeNode* next; };
+
+  // Precedes every object: the pool (and size class) it belongs to. Headers
+  // are written once, when their slab is allocated.
+  struct alignas(std::max_align_t) Header {
+    OrganismPool* owner;
+    size_t size_class;
+  };
+
+  // All objects of one (aligned) size share a free list.
+  struct SizeClass {
+    size_t obj_size = 0;
+    FreeNode* free_list = nullptr;
+  };
+
+  std::vector<SizeClass> size_classes;
+  std::vector<void*> slabs;
+  PoolStats stats;
+
+  // Objects freed by other threads, waiting for this pool's thread to take
+  // them back (see TakeRemoteFrees). Guarded by remote_mutex, as is
+  // is_retired.
+  std::mutex remote_mutex;
+  FreeNode* remote_frees = nullptr;
+  std::atomic<bool> has_remote_frees = false;
+  // Set when the pool's thread has exited (see Retire)
+  bool is_retired = false;
+
+  static size_t GetAlignedSize(size_t size) {
+    constexpr size_t align = alignof(std::max_align_t);
+    size = (size < sizeof(FreeNode)) ? sizeof(FreeNode) : size;
+    return ((size + align - 1) / align) * align;
+  }
+
+  static Header& GetHeader(void* ptr) {
+    return *(static_cast<Header*>(ptr) - 1);
+  }
+
+  // Organisms come in a handful of sizes, so a linear scan is fast.
+  size_t GetSizeClass(size_t obj_size) {
+    for (size_t i = 0; i < size_classes.size(); ++i) {
+      if (size_classes[i].obj_size == obj_size) return i;
+    }
+    size_classes.emplace_back();
+    size_classes.back().obj_size = obj_size;
+    return size_classes.size() - 1;
+  }
+
+  void AddSlab(size_t size_class_id) {
+    SizeClass& size_class = size_classes[size_class_id];
+    const size_t block_size = sizeof(Header) + size_class.obj_size;
+    const size_t slab_bytes = block_size * SLAB_OBJECTS;
+    char* slab = static_cast<char*>(::operator new(slab_bytes));
+    slabs.emplace_back(slab);
+    ++stats.num_slabs;
+    stats.bytes_reserved += slab_bytes;
+    // Thread slab's objects onto the free list (in address order)
+    for (size_t i = SLAB_OBJECTS; i > 0; --i) {
+      char* block = slab + ((i - 1) * block_size);
+      new (block) Header{this, size_class_id};
+      FreeNode* node = reinterpret_cast<FreeNode*>(block + sizeof(Header));
+      node->next = size_class.free_list;
+      size_class.free_list = node;
+    }
+  }
+
+  // Move objects freed by other threads onto this pool's free lists.
+  void TakeRemoteFrees() {
+    FreeNode* node = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(remote_mutex);
+      node = remote_frees;
+      remote_frees = nullptr;
+      has_remote_frees.store(false, std::memory_order_relaxed);
+    }
+    while (node != nullptr) {
+      FreeNode* next = node->next;
+      SizeClass& size_class = size_classes[GetHeader(node).size_class];
+      node->next = size_class.free_list;
+      size_class.free_list = node;
+      ++stats.num_frees;
+      --stats.num_live;
+      node = next;
+    }
+  }
+
+public:
+  OrganismPool() = default;
+  OrganismPool(const OrganismPool&) = delete;
+  OrganismPool& operator=(const OrganismPool&) = delete;
+
+  ~OrganismPool() {
+    for (void* slab : slabs) {
+      ::operator delete(slab);
+    }
+  }
+
+  /**
+   * Input: The object that was allocated.
+   *
+   * Output: The pool it was allocated from.
+   *
+   * Purpose: To find which pool an object must be returned to.
+   */
+  static OrganismPool* GetOwner(void* ptr) { return GetHeader(ptr).owner; }
+
+  void* Allocate(size_t size) {
+    SizeClass* size_class = &size_classes[GetSizeClass(GetAlignedSize(size))];
+    ++stats.num_allocs;
+    ++stats.num_live;
+    if (size_class->free_list == nullptr && has_remote_frees.load(std::memory_order_acquire)) {
+      TakeRemoteFrees();
+    }
+    if (size_class->free_list == nullptr) {
+      AddSlab(size_class - size_classes.data());
+    } else {
+      ++stats.num_reused;
+    }
+    FreeNode* node = size_class->free_list;
+    size_class->free_list = node->next;
+    return node;
+  }
+
+  /**
+   * Input: An object allocated from this pool.
+   *
+   * Output: None
+   *
+   * Purpose: To return an object to this pool, from the thread that uses the
+   * pool. Other threads must use FreeRemote (org_pool::Free picks the right
+   * one).
+   */
+  void Free(void* ptr) {
+    if (ptr == nullptr) return;
+    emp_assert(GetOwner(ptr) == this, "Objects must be freed into the pool they came from");
+    SizeClass& size_class = size_classes[GetHeader(ptr).size_class];
+    FreeNode* node = static_cast<FreeNode*>(ptr);
+    node->next = size_class.free_list;
+    size_class.free_list = node;
+    ++stats.num_frees;
+    --stats.num_live;
+  }
+
+  /**
+   * Input: An object allocated from this pool.
+   *
+   * Output: None
+   *
+   * Purpose: To return an object to this pool from any other thread. If the
+   * pool's thread has exited and this was its last object, the pool is
+   * deleted.
+   */
+  void FreeRemote(void* ptr) {
+    if (ptr == nullptr) return;
+    emp_assert(GetOwner(ptr) == this, "Objects must be freed into the pool they came from");
+    bool is_last = false;
+    {
+      std::lock_guard<std::mutex> lock(remote_mutex);
+      if (is_retired) {
+        // The pool's thread is gone, so nothing else touches stats
+        ++stats.num_frees;
+        is_last = --stats.num_live == 0;
+      } else {
+        FreeNode* node = static_cast<FreeNode*>(ptr);
+        node->next = remote_frees;
+        remote_frees = node;
+        has_remote_frees.store(true, std::memory_order_release);
+      }
+    }
+    if (is_last) delete this;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: Called (once) by the pool's thread when it exits, for pools
+   * allocated with new. Deletes the pool now if none of its objects are still
+   * live; otherwise the last FreeRemote does.
+   */
+  void Retire() {
+    bool is_empty = false;
+    {
+      std::lock_guard<std::mutex> lock(remote_mutex);
+      is_retired = true;
+      for (FreeNode* node = remote_frees; node != nullptr; node = node->next) {
+        ++stats.num_frees;
+        --stats.num_live;
+      }
+      remote_frees = nullptr;
+      is_empty = stats.num_live == 0;
+    }
+    if (is_empty) delete this;
+  }
+
+  const PoolStats& GetStats() const { return stats; }
+  // Zero event counters (allocs, reuses, frees); current state (live objects, slabs) is kept.
+  void ResetStats() {
+    stats.num_allocs = 0;
+    stats.num_reused = 0;
+    stats.num_frees = 0;
+  }
+};
+
+namespace internal {
+  // The calling thread's pool, until the thread exits
+  inline thread_local OrganismPool* thread_pool = nullptr;
+
+  struct ThreadPool {
+    OrganismPool* pool = new OrganismPool();
+    ThreadPool() { thread_pool = pool; }
+    ~ThreadPool() {
+      thread_pool = nullptr;
+      pool->Retire();
+    }
+  };
+}
+
+/**
+ * Input: None
+ *
+ * Output: The calling thread's organism pool.
+ *
+ * Purpose: To get the pool organisms are allocated from. It is retired when
+ * the thread exits.
+ */
+inline OrganismPool& GetPool() {
+  static thread_local internal::ThreadPool thread_pool;
+  return *thread_pool.pool;
+}
+
+/**
+ * Input: The size of the object to allocate.
+ *
+ * Output: Memory for the object, from the calling thread's pool.
+ *
+ * Purpose: To allocate an organism.
+ */
+inline void* Allocate(size_t size) { return GetPool().Allocate(size); }
+
+/**
+ * Input: The object to free.
+ *
+ * Output: None
+ *
+ * Purpose: To return an organism's memory to the pool it was allocated from:
+ * directly if that is the calling thread's pool, or else through the pool's
+ * remote free list (including after the calling thread's own pool is
+ * retired).
+ */
+inline void Free(void* ptr) {
+  if (ptr == nullptr) return;
+  OrganismPool* owner = OrganismPool::GetOwner(ptr);
+  if (owner == internal::thread_pool) owner->Free(ptr);
+  else owner->FreeRemote(ptr);
+}
+
+/**
+ * Input: None
+ *
+ * Output: Organism allocation counters (all zeros if the pool is disabled).
+ *
+ * Purpose: To report allocation churn, e.g., from benchmarks.
+ */
+inline const PoolStats& GetStats() { return GetPool().GetStats(); }
+
+/**
+ * Input: None
+ *
+ * Output: None
+ *
+ * Purpose: To zero allocation event counters (e.g., between benchmark runs).
+ */
+inline void ResetStats() { GetPool().ResetStats(); }
+
+}
+
+#endif
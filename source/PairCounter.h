@@ -0,0 +1,98 @@
+#ifndef PAIR_COUNTER_H
+#define PAIR_COUNTER_H
+
+#include "emp/base/vector.hpp"
+
+#include "utils.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Counts occurrences of (first, second) ID pairs, e.g., (host taxon,
+ * symbiont taxon) interactions.
+ *
+ * Counts are kept in one flat vector, in the order pairs were first added, and
+ * found through an open-addressing (linear probing) index into it, instead of
+ * a map of maps. Memory is proportional to the number of distinct pairs, and
+ * iteration order is deterministic. Clear keeps the allocated memory, so
+ * counting again (e.g., every snapshot) doesn't reallocate.
+ */
+class PairCounter {
+public:
+  struct Entry {
+    uint64_t first;
+    uint64_t second;
+    size_t count;
+  };
+
+protected:
+  static constexpr size_t EMPTY = 0; // slots store entry index + 1
+
+  emp::vector<Entry> entries;
+  emp::vector<size_t> slots;
+  size_t slot_mask = 0;
+
+  static uint64_t Hash(uint64_t first, uint64_t second) {
+    return utils::SplitMix64(first * 0x9e3779b97f4a7c15 ^ (second + 0x632be59bd9b4e019));
+  }
+
+  size_t FindSlot(uint64_t first, uint64_t second) const {
+    size_t slot = Hash(first, second) & slot_mask;
+    while (slots[slot] != EMPTY) {
+      const Entry& entry = entries[slots[slot] - 1];
+      if (entry.first == first && entry.second == second) break;
+      slot = (slot + 1) & slot_mask;
+    }
+    return slot;
+  }
+
+  void Rehash(size_t num_slots) {
+    slots.assign(num_slots, EMPTY);
+    slot_mask = num_slots - 1;
+    for (size_t i = 0; i < entries.size(); ++i) {
+      slots[FindSlot(entries[i].first, entries[i].second)] = i + 1;
+    }
+  }
+
+public:
+  PairCounter() = default;
+
+  /**
+   * Input: (1) The first ID; (2) the second ID; (3) how many to add.
+   *
+   * Output: None
+   *
+   * Purpose: To count a pair.
+   */
+  void Add(uint64_t first, uint64_t second, size_t count = 1) {
+    // Keep the index at most half full
+    if (2 * (entries.size() + 1) > slots.size()) Rehash(slots.empty() ? 64 : 2 * slots.size());
+    const size_t slot = FindSlot(first, second);
+    if (slots[slot] == EMPTY) {
+      entries.push_back({first, second, 0});
+      slots[slot] = entries.size();
+    }
+    entries[slots[slot] - 1].count += count;
+  }
+
+  size_t GetCount(uint64_t first, uint64_t second) const {
+    if (slots.empty()) return 0;
+    const size_t slot = FindSlot(first, second);
+    return slots[slot] == EMPTY ? 0 : entries[slots[slot] - 1].count;
+  }
+
+  size_t GetSize() const { return entries.size(); }
+
+  void Clear() {
+    entries.clear();
+    std::fill(slots.begin(), slots.end(), EMPTY);
+  }
+
+  // Pairs in the order they were first added
+  auto begin() const { return entries.begin(); }
+  auto end() const { return entries.end(); }
+};
+
+#endif
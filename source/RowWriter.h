@@ -0,0 +1,246 @@
+#ifndef ROW_WRITER_H
+#define ROW_WRITER_H
+
+#include "AsyncOutput.h"
+
+#include "emp/base/assert.hpp"
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef SYMBULATION_USE_ZLIB
+#include <zlib.h>
+#endif
+
+/**
+ * Streaming CSV output for large snapshot files.
+ *
+ * A RowWriter formats rows straight into a fixed-size buffer (integers with
+ * std::to_chars, no temporary strings) and hands the buffer to a ByteSink
+ * whenever it fills up, so writing a file of any length uses a bounded amount
+ * of memory. Sinks write to a file, to an async_output::WriteQueue
+ * (ASYNC_OUTPUT), or gzip compress into another sink (only when built with
+ * SYMBULATION_USE_ZLIB, i.e., make ZLIB=1).
+ */
+namespace output {
+
+constexpr size_t DEFAULT_BUFFER_BYTES = size_t{1} << 20;
+inline const std::string GZIP_EXTENSION = ".gz";
+
+#ifdef SYMBULATION_USE_ZLIB
+constexpr bool HAS_GZIP = true;
+#else
+constexpr bool HAS_GZIP = false;
+#endif
+
+class ByteSink {
+public:
+  virtual ~ByteSink() = default;
+  // Write (and possibly take) the bytes; the caller clears them afterwards.
+  virtual void Write(std::string& bytes) = 0;
+  // Finish the file; returns whether every write succeeded.
+  virtual bool Close() = 0;
+};
+
+class FileSink : public ByteSink {
+protected:
+  std::ofstream out;
+
+public:
+  FileSink(const std::string& filepath) : out(filepath, std::ios::binary | std::ios::trunc) { }
+  void Write(std::string& bytes) override { out.write(bytes.data(), bytes.size()); }
+  bool Close() override {
+    out.close();
+    return !out.fail();
+  }
+};
+
+class QueueSink : public ByteSink {
+protected:
+  std::shared_ptr<async_output::WriteQueue> queue;
+  std::string filepath;
+
+public:
+  QueueSink(std::shared_ptr<async_output::WriteQueue> _queue, const std::string& _filepath) :
+    queue(std::move(_queue)), filepath(_filepath)
+  {
+    queue->Open(filepath);
+  }
+  void Write(std::string& bytes) override { queue->Append(filepath, std::move(bytes)); }
+  bool Close() override {
+    queue->Close(filepath);
+    return true; // Failures are reported by the queue's Flush
+  }
+};
+
+#ifdef SYMBULATION_USE_ZLIB
+class GzipSink : public ByteSink {
+protected:
+  std::unique_ptr<ByteSink> sink;
+  z_stream stream{};
+  std::string compressed;
+  bool is_ok = true;
+
+  void Deflate(const std::string& bytes, int flush) {
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(bytes.data()));
+    stream.avail_in = bytes.size();
+    do {
+      const size_t old_size = compressed.size();
+      compressed.resize(old_size + DEFAULT_BUFFER_BYTES / 4);
+      stream.next_out = reinterpret_cast<Bytef*>(compressed.data() + old_size);
+      stream.avail_out = compressed.size() - old_size;
+      is_ok = deflate(&stream, flush) != Z_STREAM_ERROR && is_ok;
+      compressed.resize(compressed.size() - stream.avail_out);
+    } while (stream.avail_out == 0);
+    if (!compressed.empty()) {
+      sink->Write(compressed);
+      compressed.clear();
+    }
+  }
+
+public:
+  GzipSink(std::unique_ptr<ByteSink> _sink) : sink(std::move(_sink)) {
+    // 15 + 16: the largest window, with a gzip header
+    is_ok = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+  }
+  GzipSink(const GzipSink&) = delete;
+  GzipSink& operator=(const GzipSink&) = delete;
+  ~GzipSink() { deflateEnd(&stream); }
+
+  void Write(std::string& bytes) override { Deflate(bytes, Z_NO_FLUSH); }
+  bool Close() override {
+    Deflate("", Z_FINISH);
+    return sink->Close() && is_ok;
+  }
+};
+#endif
+
+/**
+ * Input: (1) The path of the file to write; (2) the queue to write it with
+ * (or nullptr to write it directly); (3) whether to gzip compress it.
+ *
+ * Output: The sink to write the file's bytes to.
+ *
+ * Purpose: To open a file for a RowWriter. Compressed files are written to
+ * filepath as given (callers add GZIP_EXTENSION); compression requires
+ * HAS_GZIP.
+ */
+inline std::unique_ptr<ByteSink> OpenSink(const std::string& filepath,
+                                          std::shared_ptr<async_output::WriteQueue> queue,
+                                          bool gzip = false) {
+  std::unique_ptr<ByteSink> sink;
+  if (queue) sink = std::make_unique<QueueSink>(std::move(queue), filepath);
+  else sink = std::make_unique<FileSink>(filepath);
+#ifdef SYMBULATION_USE_ZLIB
+  if (gzip) sink = std::make_unique<GzipSink>(std::move(sink));
+#else
+  emp_assert(!gzip, "gzip output requires building with SYMBULATION_USE_ZLIB");
+#endif
+  return sink;
+}
+
+class RowWriter {
+protected:
+  std::unique_ptr<ByteSink> sink;
+  std::string buffer;
+  size_t buffer_bytes;
+  bool is_row_start = true;
+
+  void Separate() {
+    if (!is_row_start) buffer.push_back(',');
+    is_row_start = false;
+  }
+
+  void Add(std::integral auto val) {
+    Separate();
+    const size_t old_size = buffer.size();
+    buffer.resize(old_size + 24);
+    const auto [end, err] = std::to_chars(buffer.data() + old_size, buffer.data() + buffer.size(), val);
+    buffer.resize(end - buffer.data());
+  }
+
+  // Formatted as std::ostream (and so emp::DataFile) formats doubles by default
+  void Add(std::floating_point auto val) {
+    Separate();
+    const size_t old_size = buffer.size();
+    buffer.resize(old_size + 32);
+    const auto [end, err] = std::to_chars(buffer.data() + old_size, buffer.data() + buffer.size(), val, std::chars_format::general, 6);
+    buffer.resize(end - buffer.data());
+  }
+
+  void Add(std::string_view val) {
+    Separate();
+    buffer.append(val);
+  }
+
+public:
+  RowWriter(std::unique_ptr<ByteSink> _sink, size_t _buffer_bytes = DEFAULT_BUFFER_BYTES) :
+    sink(std::move(_sink)), buffer_bytes(_buffer_bytes)
+  {
+    buffer.reserve(buffer_bytes + 256);
+  }
+  RowWriter(RowWriter&&) = default;
+  RowWriter& operator=(RowWriter&&) = delete;
+  ~RowWriter() { Close(); }
+
+  /**
+   * Input: The fields of a row (integers, doubles, or strings).
+   *
+   * Output: None
+   *
+   * Purpose: To write a comma separated row.
+   */
+  template <typename... FIELD_Ts>
+  void Row(const FIELD_Ts&... fields) {
+    (Add(fields), ...);
+    EndRow();
+  }
+
+  // Add one field to the current row, for rows whose length is only known at
+  // runtime; finish the row with EndRow.
+  template <typename FIELD_T>
+  void Field(const FIELD_T& field) { Add(field); }
+
+  void EndRow() {
+    buffer.push_back('\n');
+    is_row_start = true;
+    if (buffer.size() >= buffer_bytes) Flush();
+  }
+
+  // Write text (e.g., a header line) as is.
+  void Write(std::string_view text) {
+    buffer.append(text);
+    if (buffer.size() >= buffer_bytes) Flush();
+  }
+
+  void Flush() {
+    if (buffer.empty()) return;
+    sink->Write(buffer);
+    buffer.clear();
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: Whether the file was written.
+   *
+   * Purpose: To write out the rest of the file and close it.
+   */
+  bool Close() {
+    if (!sink) return true;
+    Flush();
+    const bool is_ok = sink->Close();
+    sink.reset();
+    return is_ok;
+  }
+};
+
+}
+
+#endif
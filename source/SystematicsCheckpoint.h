@@ -0,0 +1,322 @@
+#ifndef SYSTEMATICS_CHECKPOINT_H
+#define SYSTEMATICS_CHECKPOINT_H
+
+#include "Checkpoint.h"
+
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/Evolve/Systematics.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Checkpoint support for emp::Systematics.
+ *
+ * A systematics manager is stored as its counters followed by every taxon it
+ * keeps (active, ancestor and outside), in ID order so that parents come
+ * before their offspring. Each taxon's data struct writes its own fields
+ * (SaveCheckpoint/LoadCheckpoint, see TaxonData.h) into a length-prefixed
+ * blob. Loading replaces whatever taxa the manager held with the stored ones;
+ * the world then points its organisms (and, for managers that store
+ * positions, its positions) at the restored taxa by ID.
+ *
+ * emp::Taxon and emp::Systematics have no setters for most of this
+ * bookkeeping, so it is restored through the *Access classes below, which
+ * reach the protected members from derived classes (they are never
+ * instantiated).
+ */
+namespace checkpoint {
+
+template <typename TAXON_T>
+class TaxonAccess : public TAXON_T {
+public:
+  static void SetCounts(TAXON_T& taxon, size_t num_orgs, size_t tot_orgs,
+                        size_t num_offspring, size_t total_offspring) {
+    taxon.*(&TaxonAccess::num_orgs) = num_orgs;
+    taxon.*(&TaxonAccess::tot_orgs) = tot_orgs;
+    taxon.*(&TaxonAccess::num_offspring) = num_offspring;
+    taxon.*(&TaxonAccess::total_offspring) = total_offspring;
+  }
+
+  static void AddOffspringLink(TAXON_T& taxon, emp::Ptr<TAXON_T> offspring) {
+    (taxon.*(&TaxonAccess::offspring)).insert(offspring);
+  }
+};
+
+template <typename ORG>
+class SystematicsBaseAccess : public emp::SystematicsBase<ORG> {
+public:
+  // BASE_T is emp::SystematicsBase<ORG> or a const one.
+  template <typename BASE_T>
+  static auto Counters(BASE_T& sys) {
+    return std::tie(
+      sys.*(&SystematicsBaseAccess::next_id),
+      sys.*(&SystematicsBaseAccess::org_count),
+      sys.*(&SystematicsBaseAccess::total_depth),
+      sys.*(&SystematicsBaseAccess::num_roots),
+      sys.*(&SystematicsBaseAccess::curr_update)
+    );
+  }
+
+  // The deepest taxon is recomputed the next time it is asked for.
+  static void ForgetMaxDepth(emp::SystematicsBase<ORG>& sys) {
+    sys.*(&SystematicsBaseAccess::max_depth) = -1;
+  }
+};
+
+template <typename SYS_T>
+class SystematicsAccess : public SYS_T {
+  using taxon_ptr_t = emp::Ptr<typename SYS_T::taxon_t>;
+
+  // Depending on the Empirical version, positions are stored flat or per
+  // population ID
+  static auto& TaxonLocations(SYS_T& sys) {
+    return sys.*(&SystematicsAccess::taxon_locations);
+  }
+  static constexpr bool FlatLocations() {
+    return std::is_same_v<std::decay_t<decltype(TaxonLocations(std::declval<SYS_T&>())[0])>, taxon_ptr_t>;
+  }
+
+public:
+  // Positions with no organism in them
+  static void ClearTaxonLocations(SYS_T& sys) {
+    auto& locations = TaxonLocations(sys);
+    if constexpr (FlatLocations()) {
+      std::fill(locations.begin(), locations.end(), nullptr);
+    } else {
+      for (auto& pop_locations : locations) {
+        std::fill(pop_locations.begin(), pop_locations.end(), nullptr);
+      }
+    }
+  }
+
+  static void SetTaxonAt(SYS_T& sys, emp::WorldPosition pos, taxon_ptr_t taxon) {
+    auto& locations = TaxonLocations(sys);
+    if constexpr (FlatLocations()) {
+      if (locations.size() <= pos.GetIndex()) locations.resize(pos.GetIndex() + 1, nullptr);
+      locations[pos.GetIndex()] = taxon;
+    } else {
+      if (locations.size() <= pos.GetPopID()) locations.resize(pos.GetPopID() + 1);
+      auto& pop_locations = locations[pos.GetPopID()];
+      if (pop_locations.size() <= pos.GetIndex()) pop_locations.resize(pos.GetIndex() + 1, nullptr);
+      pop_locations[pos.GetIndex()] = taxon;
+    }
+  }
+
+  // Drop cached pointers to taxa that are about to be deleted.
+  static void ForgetTaxonPointers(SYS_T& sys) {
+    sys.*(&SystematicsAccess::mrca) = nullptr;
+    sys.*(&SystematicsAccess::most_recent) = nullptr;
+    sys.*(&SystematicsAccess::next_parent) = nullptr;
+  }
+};
+
+// Which of the manager's sets a stored taxon belongs to.
+enum class TaxonStatus : uint8_t { ACTIVE=0, ANCESTOR, OUTSIDE };
+
+// Stored in place of a missing parent (or an organism's missing taxon)
+constexpr uint64_t NO_TAXON = std::numeric_limits<uint64_t>::max();
+
+template <typename ORG_INFO>
+struct SavedTaxon {
+  size_t id = 0;
+  ORG_INFO info{};
+  TaxonStatus status = TaxonStatus::ACTIVE;
+  uint64_t parent_id = NO_TAXON;
+  size_t num_orgs = 0;
+  size_t tot_orgs = 0;
+  size_t num_offspring = 0;
+  size_t total_offspring = 0;
+  double origination_time = 0.0;
+  double destruction_time = 0.0;
+  std::string data;
+};
+
+// A systematics manager read from a checkpoint, not yet restored.
+template <typename ORG_INFO>
+struct SavedSystematics {
+  size_t next_id = 0;
+  size_t org_count = 0;
+  size_t total_depth = 0;
+  size_t num_roots = 0;
+  size_t curr_update = 0;
+  emp::vector<SavedTaxon<ORG_INFO>> taxa; // In ID order
+};
+
+/**
+ * Input: (1) The checkpoint writer to save into; (2) the systematics manager
+ * to save.
+ *
+ * Output: None
+ *
+ * Purpose: To save a systematics manager and every taxon it keeps.
+ */
+template <typename ORG, typename ORG_INFO, typename DATA_STRUCT>
+void SaveSystematics(Writer& writer, const emp::Systematics<ORG, ORG_INFO, DATA_STRUCT>& sys) {
+  using taxon_t = emp::Taxon<ORG_INFO, DATA_STRUCT>;
+  const auto [next_id, org_count, total_depth, num_roots, curr_update] =
+    SystematicsBaseAccess<ORG>::Counters(static_cast<const emp::SystematicsBase<ORG>&>(sys));
+  writer.Write<uint64_t>(next_id);
+  writer.Write<uint64_t>(org_count);
+  writer.Write<uint64_t>(total_depth);
+  writer.Write<uint64_t>(num_roots);
+  writer.Write<uint64_t>(curr_update);
+
+  emp::vector<std::pair<emp::Ptr<taxon_t>, TaxonStatus>> taxa;
+  for (emp::Ptr<taxon_t> taxon : sys.GetActive()) taxa.emplace_back(taxon, TaxonStatus::ACTIVE);
+  for (emp::Ptr<taxon_t> taxon : sys.GetAncestors()) taxa.emplace_back(taxon, TaxonStatus::ANCESTOR);
+  for (emp::Ptr<taxon_t> taxon : sys.GetOutside()) taxa.emplace_back(taxon, TaxonStatus::OUTSIDE);
+  std::sort(taxa.begin(), taxa.end(), [](const auto& a, const auto& b) {
+    return a.first->GetID() < b.first->GetID();
+  });
+
+  writer.Write<uint64_t>(taxa.size());
+  for (const auto& [taxon, status] : taxa) {
+    writer.Write<uint64_t>(taxon->GetID());
+    writer.Write<ORG_INFO>(taxon->GetInfo());
+    writer.Write(status);
+    writer.Write<uint64_t>(taxon->GetParent() ? taxon->GetParent()->GetID() : NO_TAXON);
+    writer.Write<uint64_t>(taxon->GetNumOrgs());
+    writer.Write<uint64_t>(taxon->GetTotOrgs());
+    writer.Write<uint64_t>(taxon->GetNumOff());
+    writer.Write<uint64_t>(taxon->GetTotalOffspring());
+    writer.Write<double>(taxon->GetOriginationTime());
+    writer.Write<double>(taxon->GetDestructionTime());
+    Writer data_writer;
+    taxon->GetData().SaveCheckpoint(data_writer);
+    writer.WriteString(data_writer.TakeBuffer());
+  }
+}
+
+/**
+ * Input: (1) The checkpoint reader to load from; (2) the saved systematics
+ * to fill in.
+ *
+ * Output: Boolean indicating whether a well-formed systematics manager was
+ * read (every taxon's parent stored before it, and its data readable).
+ *
+ * Purpose: To read a systematics manager without touching the world, so a
+ * bad checkpoint can be rejected before anything is replaced.
+ */
+template <typename DATA_STRUCT, typename ORG_INFO>
+bool ReadSystematics(Reader& reader, SavedSystematics<ORG_INFO>& saved) {
+  saved.next_id = reader.Read<uint64_t>();
+  saved.org_count = reader.Read<uint64_t>();
+  saved.total_depth = reader.Read<uint64_t>();
+  saved.num_roots = reader.Read<uint64_t>();
+  saved.curr_update = reader.Read<uint64_t>();
+  const size_t num_taxa = reader.Read<uint64_t>();
+  saved.taxa.clear();
+  for (size_t i = 0; i < num_taxa && reader.IsOK(); i++) {
+    SavedTaxon<ORG_INFO>& taxon = saved.taxa.emplace_back();
+    taxon.id = reader.Read<uint64_t>();
+    taxon.info = reader.Read<ORG_INFO>();
+    taxon.status = reader.Read<TaxonStatus>();
+    taxon.parent_id = reader.Read<uint64_t>();
+    taxon.num_orgs = reader.Read<uint64_t>();
+    taxon.tot_orgs = reader.Read<uint64_t>();
+    taxon.num_offspring = reader.Read<uint64_t>();
+    taxon.total_offspring = reader.Read<uint64_t>();
+    taxon.origination_time = reader.Read<double>();
+    taxon.destruction_time = reader.Read<double>();
+    taxon.data = reader.ReadString();
+    if (!reader.IsOK() || taxon.status > TaxonStatus::OUTSIDE) return false;
+    if (i > 0 && taxon.id <= saved.taxa[i - 1].id) return false;
+    if (taxon.parent_id != NO_TAXON) {
+      // Parents have smaller IDs, so they have already been read
+      const auto parent = std::lower_bound(
+        saved.taxa.begin(), saved.taxa.end() - 1, taxon.parent_id,
+        [](const SavedTaxon<ORG_INFO>& t, uint64_t target) { return t.id < target; }
+      );
+      if (parent == saved.taxa.end() - 1 || parent->id != taxon.parent_id) return false;
+    }
+    DATA_STRUCT data;
+    Reader data_reader(taxon.data);
+    data.LoadCheckpoint(data_reader);
+    if (!data_reader.IsOK() || !data_reader.AtEnd()) return false;
+  }
+  return reader.IsOK() && saved.taxa.size() == num_taxa;
+}
+
+/**
+ * Input: (1) The saved systematics (from ReadSystematics); (2) a taxon ID.
+ *
+ * Output: Whether the saved systematics has a taxon with that ID.
+ */
+template <typename ORG_INFO>
+bool HasTaxon(const SavedSystematics<ORG_INFO>& saved, uint64_t id) {
+  const auto taxon = std::lower_bound(
+    saved.taxa.begin(), saved.taxa.end(), id,
+    [](const SavedTaxon<ORG_INFO>& t, uint64_t target) { return t.id < target; }
+  );
+  return taxon != saved.taxa.end() && taxon->id == id;
+}
+
+/**
+ * Input: (1) The systematics manager to restore into; (2) the saved
+ * systematics (from ReadSystematics); (3) a function called on each restored
+ * taxon, after its parent (e.g., to index it).
+ *
+ * Output: The restored taxa, by ID.
+ *
+ * Purpose: To replace every taxon the manager holds with the saved ones. The
+ * caller must point its organisms at the restored taxa (and, if the manager
+ * stores positions, fill in TaxonLocations), since the organisms' old taxa
+ * are deleted.
+ */
+template <typename ORG, typename ORG_INFO, typename DATA_STRUCT, typename ON_RESTORE_T>
+std::unordered_map<size_t, emp::Ptr<emp::Taxon<ORG_INFO, DATA_STRUCT>>> RestoreSystematics(
+  emp::Systematics<ORG, ORG_INFO, DATA_STRUCT>& sys,
+  const SavedSystematics<ORG_INFO>& saved,
+  ON_RESTORE_T&& on_restore
+) {
+  using sys_t = emp::Systematics<ORG, ORG_INFO, DATA_STRUCT>;
+  using taxon_t = emp::Taxon<ORG_INFO, DATA_STRUCT>;
+
+  for (emp::Ptr<taxon_t> taxon : sys.active_taxa) taxon.Delete();
+  for (emp::Ptr<taxon_t> taxon : sys.ancestor_taxa) taxon.Delete();
+  for (emp::Ptr<taxon_t> taxon : sys.outside_taxa) taxon.Delete();
+  sys.active_taxa.clear();
+  sys.ancestor_taxa.clear();
+  sys.outside_taxa.clear();
+  SystematicsAccess<sys_t>::ForgetTaxonPointers(sys);
+  SystematicsAccess<sys_t>::ClearTaxonLocations(sys);
+
+  std::unordered_map<size_t, emp::Ptr<taxon_t>> taxa;
+  for (const SavedTaxon<ORG_INFO>& saved_taxon : saved.taxa) {
+    emp::Ptr<taxon_t> parent = nullptr;
+    if (saved_taxon.parent_id != NO_TAXON) parent = taxa.at(saved_taxon.parent_id);
+    emp::Ptr<taxon_t> taxon = emp::NewPtr<taxon_t>(saved_taxon.id, saved_taxon.info, parent);
+    taxon->SetOriginationTime(saved_taxon.origination_time);
+    taxon->SetDestructionTime(saved_taxon.destruction_time);
+    TaxonAccess<taxon_t>::SetCounts(*taxon, saved_taxon.num_orgs, saved_taxon.tot_orgs,
+                                    saved_taxon.num_offspring, saved_taxon.total_offspring);
+    if (parent) TaxonAccess<taxon_t>::AddOffspringLink(*parent, taxon);
+    Reader data_reader(saved_taxon.data);
+    taxon->GetData().LoadCheckpoint(data_reader);
+    switch (saved_taxon.status) {
+      case TaxonStatus::ACTIVE: sys.active_taxa.insert(taxon); break;
+      case TaxonStatus::ANCESTOR: sys.ancestor_taxa.insert(taxon); break;
+      case TaxonStatus::OUTSIDE: sys.outside_taxa.insert(taxon); break;
+    }
+    taxa.emplace(saved_taxon.id, taxon);
+    on_restore(taxon);
+  }
+
+  SystematicsBaseAccess<ORG>::Counters(static_cast<emp::SystematicsBase<ORG>&>(sys)) = std::tie(
+    saved.next_id, saved.org_count, saved.total_depth, saved.num_roots, saved.curr_update
+  );
+  SystematicsBaseAccess<ORG>::ForgetMaxDepth(sys);
+  return taxa;
+}
+
+}
+
+#endif
@@ -1,15 +1,35 @@
 #ifndef TAXONDATA_H
 #define TAXONDATA_H
 
+#include "AncestryIndex.h"
+#include "Checkpoint.h"
+
+#include <map>
+
 namespace datastruct {
 
+  // emp::DataNode has no setters for the statistics it has accumulated, so
+  // checkpoints restore them through this class, which reaches its protected
+  // members from a derived class (it is never instantiated).
+  using int_val_node_t = emp::DataNode<double, emp::data::Current, emp::data::Range>;
+  class IntValNodeAccess : public int_val_node_t {
+  public:
+    static void Restore(int_val_node_t& node, size_t count, double current, double total, double min, double max) {
+      node.*(&IntValNodeAccess::val_count) = count;
+      node.*(&IntValNodeAccess::cur_val) = current;
+      node.*(&IntValNodeAccess::total) = total;
+      node.*(&IntValNodeAccess::min) = min;
+      node.*(&IntValNodeAccess::max) = max;
+    }
+  };
+
   struct TaxonDataBase {
       using has_fitness_t = std::false_type;
       using has_mutations_t = std::false_type;
       using has_phen_t = std::false_type;
       using taxon_info_t = double;
 
-      emp::DataNode<double, emp::data::Current, emp::data::Range> int_val;
+      int_val_node_t int_val;
 
       void RecordIntVal(double _iv) {
         int_val.Add(_iv);
@@ -18,10 +38,29 @@ namespace datastruct {
       double GetIntVal() const {
         return int_val.GetMean();
       }
+
+      void SaveCheckpoint(checkpoint::Writer& writer) const {
+        writer.Write<uint64_t>(int_val.GetCount());
+        writer.Write<double>(int_val.GetCurrent());
+        writer.Write<double>(int_val.GetTotal());
+        writer.Write<double>(int_val.GetMin());
+        writer.Write<double>(int_val.GetMax());
+      }
+
+      void LoadCheckpoint(checkpoint::Reader& reader) {
+        const size_t count = reader.Read<uint64_t>();
+        const double current = reader.Read<double>();
+        const double total = reader.Read<double>();
+        const double min = reader.Read<double>();
+        const double max = reader.Read<double>();
+        IntValNodeAccess::Restore(int_val, count, current, total, min, max);
+      }
   };
 
   struct HostTaxonData : TaxonDataBase {
         std::unordered_map<unsigned long long int, int> associated_syms;
+        // Kept up to date by the host systematics' OnNew hook (see SetupPhylogenyTracking)
+        ancestry::Links<emp::Taxon<taxon_info_t, HostTaxonData>> ancestry;
         void ClearInteractions() {associated_syms.clear();}
         void AddInteraction(emp::Ptr<emp::Taxon<taxon_info_t, TaxonDataBase>> sym) {
           if (emp::Has(associated_syms, sym->GetID())){
@@ -30,10 +69,33 @@ namespace datastruct {
             associated_syms[sym->GetID()] = 1;
           }
         }
+
+        // The ancestry index isn't stored; it is rebuilt as taxa are restored.
+        // Interactions are stored in taxon ID order, so the same interactions
+        // always give the same checkpoint.
+        void SaveCheckpoint(checkpoint::Writer& writer) const {
+          TaxonDataBase::SaveCheckpoint(writer);
+          std::map<unsigned long long int, int> sorted_syms(associated_syms.begin(), associated_syms.end());
+          writer.Write<uint64_t>(sorted_syms.size());
+          for (const auto& [sym_taxon, count] : sorted_syms) {
+            writer.Write<uint64_t>(sym_taxon);
+            writer.Write<int>(count);
+          }
+        }
+
+        void LoadCheckpoint(checkpoint::Reader& reader) {
+          TaxonDataBase::LoadCheckpoint(reader);
+          associated_syms.clear();
+          const size_t num_associated_syms = reader.Read<uint64_t>();
+          for (size_t i = 0; i < num_associated_syms && reader.IsOK(); i++) {
+            const unsigned long long int sym_taxon = reader.Read<uint64_t>();
+            associated_syms[sym_taxon] = reader.Read<int>();
+          }
+        }
   };
 
   struct SymbiontTaxonData : TaxonDataBase {
-    size_t lineage_host_switch_count;
+    size_t lineage_host_switch_count = 0;
 
     void DetermineHostSwitch(emp::Ptr<emp::Taxon<taxon_info_t, datastruct::TaxonDataBase>> host, emp::Ptr<emp::Taxon<taxon_info_t, datastruct::TaxonDataBase>>  host_of_parent) {
       // check is one host is descended from the other
@@ -54,12 +116,11 @@ namespace datastruct {
     * Purpose: To determine whether a host switch occurred.
     */
     bool CheckIfInLineage(emp::Ptr<emp::Taxon<taxon_info_t, datastruct::TaxonDataBase>> host, emp::Ptr<emp::Taxon<taxon_info_t, datastruct::TaxonDataBase>> possible_ancestor) {
-      emp::Ptr<emp::Taxon<taxon_info_t, datastruct::TaxonDataBase>> cur = host;
-      while (cur != nullptr && cur->GetID() != possible_ancestor->GetID() && cur->GetOriginationTime() >= possible_ancestor->GetOriginationTime()) {
-        cur = cur->GetParent();
-      }
-      // true if no parent found or parent found is not the possible ancestor
-      return (cur == nullptr || !(cur->GetID() == possible_ancestor->GetID()));
+      // Host taxa are stored as base taxa on organisms; their ancestry index
+      // is in their host data
+      using host_taxon_t = emp::Taxon<taxon_info_t, HostTaxonData>;
+      // true if the possible ancestor is not the host or one of its ancestors
+      return !ancestry::IsAncestor(possible_ancestor.Cast<host_taxon_t>(), host.Cast<host_taxon_t>());
     }
 
     void SetHostSwitch(size_t _in) {
@@ -69,6 +130,16 @@ namespace datastruct {
     size_t GetHostSwitch() const {
       return lineage_host_switch_count;
     }
+
+    void SaveCheckpoint(checkpoint::Writer& writer) const {
+      TaxonDataBase::SaveCheckpoint(writer);
+      writer.Write<uint64_t>(lineage_host_switch_count);
+    }
+
+    void LoadCheckpoint(checkpoint::Reader& reader) {
+      TaxonDataBase::LoadCheckpoint(reader);
+      lineage_host_switch_count = reader.Read<uint64_t>();
+    }
   };
 
 }
@@ -0,0 +1,93 @@
+#ifndef SYM_BENCH_H
+#define SYM_BENCH_H
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+/**
+ * Small harness shared by the benchmarks in source/bench.
+ *
+ * Every benchmark reports one JSON object per line (JSON Lines), so runs can be
+ * appended to a results file and compared over time:
+ *   {"bench": "...", "params": "...", "seconds": ..., "updates_per_sec": ...,
+ *    "orgs_per_sec": ..., "peak_rss_kb": ...}
+ * updates_per_sec is 0 for benchmarks that don't run whole updates, and
+ * orgs_per_sec counts whatever unit of work the benchmark processes (organisms
+ * processed, births, CPU cycles, ...; see each benchmark).
+ */
+namespace bench {
+
+/**
+ * Accumulates time over several start/stop intervals, so setup and bookkeeping
+ * between timed sections are left out.
+ */
+class Stopwatch {
+protected:
+  using clock_t = std::chrono::steady_clock;
+  clock_t::time_point start_time;
+  double elapsed_seconds = 0;
+
+public:
+  void Start() { start_time = clock_t::now(); }
+  void Stop() {
+    const std::chrono::duration<double> elapsed = clock_t::now() - start_time;
+    elapsed_seconds += elapsed.count();
+  }
+  double GetSeconds() const { return elapsed_seconds; }
+};
+
+template<typename FUN_T>
+double TimeSeconds(FUN_T&& fun) {
+  Stopwatch stopwatch;
+  stopwatch.Start();
+  fun();
+  stopwatch.Stop();
+  return stopwatch.GetSeconds();
+}
+
+/**
+ * Input: None
+ *
+ * Output: Peak resident set size of this process so far, in kilobytes.
+ *
+ * Purpose: To report memory use alongside throughput. The peak only grows, so
+ * run memory-hungry benchmarks last (or on their own) to attribute it.
+ */
+inline long GetPeakRSSKB() {
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+  return usage.ru_maxrss; // Kilobytes on Linux
+}
+
+struct Result {
+  std::string bench;    // Benchmark name
+  std::string params;   // Benchmark parameters, e.g. "size=10000,moi=1"
+  double seconds = 0;   // Time spent in the timed section
+  size_t updates = 0;   // Whole world updates run in the timed section
+  size_t orgs = 0;      // Units of work processed in the timed section
+};
+
+/**
+ * Input: The stream to report to and the benchmark result.
+ *
+ * Output: None
+ *
+ * Purpose: To write one benchmark result as a line of JSON.
+ */
+inline void Report(std::ostream& out, const Result& result) {
+  const double seconds = (result.seconds > 0) ? result.seconds : 1e-9;
+  out << "{\"bench\": \"" << result.bench << "\""
+      << ", \"params\": \"" << result.params << "\""
+      << ", \"seconds\": " << result.seconds
+      << ", \"updates_per_sec\": " << (result.updates / seconds)
+      << ", \"orgs_per_sec\": " << (result.orgs / seconds)
+      << ", \"peak_rss_kb\": " << GetPeakRSSKB()
+      << "}" << std::endl;
+}
+
+}
+
+#endif
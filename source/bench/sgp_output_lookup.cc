@@ -0,0 +1,103 @@
+// Microbenchmark: SGP output-buffer credit checking.
+//
+// Times the per-output work done by SGPHost::ProcessOutputBuffer and
+// SGPWorld::ProcessSymOutputBuffer: finding which tasks (if any) an output is
+// correct for in the organism's task environment, and checking/crediting it.
+// The flat lookup in LogicTaskIOBank::TaskIO is compared against the hash-table
+// layout it replaced (rebuilt here from the same environments).
+//
+// Usage: sgp_output_lookup [bank size] [outputs]
+// Results are reported as JSON lines (see Bench.h); orgs_per_sec is outputs/s.
+
+#include "Bench.h"
+#include "../sgp_mode/tasks/LogicTaskIOBank.h"
+
+#include "emp/math/Random.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace sgpmode::tasks;
+
+struct HashedTaskIO {
+  std::unordered_set<uint32_t> valid_outputs;
+  std::unordered_map<uint32_t, emp::vector<size_t>> task_lookup;
+};
+
+using bench::TimeSeconds;
+
+int main(int argc, char* argv[]) {
+  const size_t bank_size = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  const size_t num_outputs = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 20000000;
+
+  emp::Random random(2);
+  LogicTaskSet task_set;
+  task_set.AddTasksByName({"NOT", "NAND", "AND", "OR_NOT", "OR", "AND_NOT", "NOR", "XOR", "EQU"});
+  LogicTaskIOBank io_bank(random, task_set);
+  const double build_secs = TimeSeconds([&]() { io_bank.GenerateBank(bank_size); });
+
+  emp::vector<HashedTaskIO> hashed_bank(bank_size);
+  for (size_t env_id = 0; env_id < bank_size; ++env_id) {
+    const auto& task_io = io_bank.GetIO(env_id);
+    for (size_t task_id = 0; task_id < task_io.correct_outputs.size(); ++task_id) {
+      for (const auto& io_set : task_io.correct_outputs[task_id]) {
+        hashed_bank[env_id].valid_outputs.emplace(io_set.output);
+        hashed_bank[env_id].task_lookup[io_set.output].emplace_back(task_id);
+      }
+    }
+  }
+
+  // Queries: (environment, output) pairs, about half of them correct outputs
+  emp::vector<std::pair<size_t, uint32_t>> queries(num_outputs);
+  for (auto& [env_id, output] : queries) {
+    env_id = random.GetUInt(bank_size);
+    const auto& task_io = io_bank.GetIO(env_id);
+    output = random.P(0.5)
+      ? task_io.valid_outputs[random.GetUInt(task_io.valid_outputs.size())]
+      : random.GetUInt();
+  }
+
+  // Credited outputs (as in CPUState), one organism per environment touched
+  const size_t num_tasks = task_set.GetSize();
+  const size_t credit_stride = 4;
+  emp::vector<uint32_t> flat_credited(num_tasks * credit_stride);
+  emp::vector<uint32_t> flat_num_credited(num_tasks, 0);
+  emp::vector<std::set<uint32_t>> set_credited(num_tasks);
+
+  size_t flat_credits = 0;
+  const double flat_secs = TimeSeconds([&]() {
+    for (const auto& [env_id, output] : queries) {
+      for (size_t task_id : io_bank.GetIO(env_id).FindTaskIDs(output)) {
+        const uint32_t* credited = flat_credited.data() + (task_id * credit_stride);
+        if (std::find(credited, credited + flat_num_credited[task_id], output) != credited + flat_num_credited[task_id]) continue;
+        flat_credited[(task_id * credit_stride) + flat_num_credited[task_id]] = output;
+        if (++flat_num_credited[task_id] == credit_stride) flat_num_credited[task_id] = 0;
+        ++flat_credits;
+      }
+    }
+  });
+
+  size_t hashed_credits = 0;
+  const double hashed_secs = TimeSeconds([&]() {
+    for (const auto& [env_id, output] : queries) {
+      const HashedTaskIO& task_io = hashed_bank[env_id];
+      if (!task_io.valid_outputs.count(output)) continue;
+      for (size_t task_id : task_io.task_lookup.at(output)) {
+        if (set_credited[task_id].count(output)) continue;
+        set_credited[task_id].emplace(output);
+        if (set_credited[task_id].size() == credit_stride) set_credited[task_id].clear();
+        ++hashed_credits;
+      }
+    }
+  });
+
+  const std::string params = "bank=" + std::to_string(bank_size) + ",tasks=" + std::to_string(num_tasks);
+  bench::Report(std::cout, {"sgp_io_bank_build", params, build_secs, 0, bank_size});
+  bench::Report(std::cout, {"sgp_output_lookup", params + ",layout=flat", flat_secs, 0, num_outputs});
+  bench::Report(std::cout, {"sgp_output_lookup", params + ",layout=hash", hashed_secs, 0, num_outputs});
+  return (flat_credits == hashed_credits) ? 0 : 1;
+}
@@ -0,0 +1,534 @@
+// Benchmark suite for the hot paths of each mode.
+//
+// Usage: symbulation_bench [benchmark name prefix ...]
+//   With no arguments, every benchmark runs. Results are reported as JSON lines
+//   (see Bench.h); `make bench` appends them to symbulation_bench_results.jsonl.
+//
+// Benchmarks and what orgs_per_sec counts:
+//   default_update          Hosts + symbionts processed by SymWorld::Update
+//   default_host_process    Hosts run through Host::Process (no reproduction)
+//   default_distrib_res     Hosts run through Host::DistribResources
+//   default_sym_birth_tags  Symbiont births through SymDoBirth with tag matching
+//   default_data_files      Hosts + symbionts per update while writing data every update
+//   default_interaction_snapshot  Host taxa written to an interaction snapshot (10^6 taxa,
+//                           two interactions each), through emp::File string
+//                           concatenation (as WritePhylogenyFile used to) vs. RowWriter
+//   default_host_ancestry   Host ancestry checks in a 10^5 generation lineage, walking
+//                           parents (as CheckIfInLineage used to) vs. the ancestry index
+//   lysis_update            Hosts + phage processed by LysisWorld::Update (lysis and bursts on)
+//   sgp_cpu_step            CPU cycles run by SGPHardware::RunCPUStep
+//   sgp_io_bank             Task IO environments generated for a 10^5 environment bank,
+//                           serially and seeded on all hardware threads
+//   sgp_process_outputs     Host output buffers processed by SGPHost::ProcessOutputBuffer
+//   sgp_interaction_compat  Host-endosymbiont compatibility checks, through a chain of
+//                           std::function hooks (as SGPWorld used to) vs. the
+//                           compile-time policies used by SGPWorld::CountCompatibleSymbionts
+
+#include "Bench.h"
+
+#include "../default_mode/SymWorld.h"
+#include "../default_mode/Host.h"
+#include "../default_mode/Symbiont.h"
+#include "../default_mode/DataNodes.h"
+#include "../lysis_mode/LysisWorld.h"
+#include "../sgp_mode/SGPWorld.h"
+
+#include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
+
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+
+// Empirical doesn't support more than one translation unit, so any CC files are
+// included last.
+#include "../default_mode/WorldSetup.cc"
+#include "../lysis_mode/LysisWorldSetup.cc"
+#include "../sgp_mode/SGPWorld.cc"
+#include "../sgp_mode/SGPWorldSetup.cc"
+#include "../sgp_mode/SGPWorldData.cc"
+#include "../sgp_mode/SGPW_InteractionMechanismSetup.cc"
+#include "../sgp_mode/SGPW_TaskProfileSetup.cc"
+
+using sgp_world_t = sgpmode::SGPWorld;
+using sgp_host_t = sgp_world_t::sgp_host_t;
+using sgp_sym_t = sgp_world_t::sgp_sym_t;
+
+// Data files written by benchmarks go here (removed at the end of the run).
+const std::filesystem::path bench_data_dir = std::filesystem::temp_directory_path() / "symbulation_bench";
+
+size_t CountOrgs(SymWorld& world) {
+  size_t count = 0;
+  for (size_t i = 0; i < world.GetSize(); ++i) {
+    if (world.IsOccupied(i)) count += 1 + world.GetOrg(i).GetSymbionts().size();
+    if (world.GetSymAt(i)) ++count;
+  }
+  return count;
+}
+
+void ConfigureGrid(SymConfigBase& config, size_t width, size_t height, double start_moi) {
+  config.SPATIAL_STRUCT_MODE("grid");
+  config.WORLD_WIDTH(width);
+  config.WORLD_HEIGHT(height);
+  config.START_MOI(start_moi);
+  config.FILE_PATH(bench_data_dir.string() + "/");
+}
+
+// Steady-state world: plenty of resources, but no one ever has enough to reproduce.
+void ConfigureNoReproduction(SymConfigBase& config) {
+  config.HOST_REPRO_RES(1e12);
+  config.SYM_HORIZ_TRANS_RES(1e12);
+  config.SYM_VERT_TRANS_RES(1e12);
+}
+
+// Time `num_updates` updates of a set-up world (after a short warm-up).
+bench::Result TimeUpdates(SymWorld& world, const std::string& name, const std::string& params, size_t num_updates) {
+  for (size_t i = 0; i < 10; ++i) world.Update();
+  bench::Result result{name, params};
+  bench::Stopwatch stopwatch;
+  for (size_t i = 0; i < num_updates; ++i) {
+    result.orgs += CountOrgs(world);
+    stopwatch.Start();
+    world.Update();
+    stopwatch.Stop();
+  }
+  result.seconds = stopwatch.GetSeconds();
+  result.updates = num_updates;
+  return result;
+}
+
+void BenchDefaultUpdate(std::ostream& out) {
+  for (size_t width : {30, 100}) {
+    for (double moi : {0.0, 1.0}) {
+      SymConfigBase config;
+      ConfigureGrid(config, width, width, moi);
+      emp::Random random(1);
+      SymWorld world(random, &config);
+      world.Setup();
+      const std::string params = "size=" + std::to_string(width * width) + ",moi=" + emp::to_string(moi);
+      bench::Report(out, TimeUpdates(world, "default_update", params, (width < 100) ? 500 : 100));
+    }
+  }
+}
+
+// Update throughput at low occupancy (5% of a 200x200 grid) for each schedule mode.
+void BenchDefaultSchedule(std::ostream& out) {
+  for (const std::string mode : {"random", "occupied", "blocked-random"}) {
+    SymConfigBase config;
+    ConfigureGrid(config, 200, 200, 1);
+    ConfigureNoReproduction(config);
+    config.INIT_POP_SIZE(2000);
+    config.SCHEDULE_MODE(mode);
+    emp::Random random(1);
+    SymWorld world(random, &config);
+    world.Setup();
+    bench::Report(out, TimeUpdates(world, "default_schedule", "size=40000,pop=2000,mode=" + mode, 500));
+  }
+}
+
+void BenchDefaultHostProcess(std::ostream& out) {
+  SymConfigBase config;
+  ConfigureGrid(config, 100, 100, 1);
+  ConfigureNoReproduction(config);
+  emp::Random random(1);
+  SymWorld world(random, &config);
+  world.Setup();
+
+  bench::Result result{"default_host_process", "size=10000,moi=1"};
+  result.seconds = bench::TimeSeconds([&]() {
+    for (size_t round = 0; round < 200; ++round) {
+      for (size_t i = 0; i < world.GetSize(); ++i) {
+        if (!world.IsOccupied(i)) continue;
+        world.GetOrg(i).Process(i);
+        ++result.orgs;
+      }
+    }
+  });
+  bench::Report(out, result);
+}
+
+void BenchDefaultDistribResources(std::ostream& out) {
+  for (double moi : {0.0, 1.0}) {
+    SymConfigBase config;
+    ConfigureGrid(config, 100, 100, moi);
+    config.SYM_LIMIT(3);
+    emp::Random random(1);
+    SymWorld world(random, &config);
+    world.Setup();
+
+    bench::Result result{"default_distrib_res", "size=10000,moi=" + emp::to_string(moi)};
+    result.seconds = bench::TimeSeconds([&]() {
+      for (size_t round = 0; round < 500; ++round) {
+        for (size_t i = 0; i < world.GetSize(); ++i) {
+          if (!world.IsOccupied(i)) continue;
+          static_cast<Host&>(world.GetOrg(i)).DistribResources(config.RES_DISTRIBUTE());
+          ++result.orgs;
+        }
+      }
+    });
+    bench::Report(out, result);
+  }
+}
+
+void BenchDefaultSymBirthTags(std::ostream& out) {
+  SymConfigBase config;
+  ConfigureGrid(config, 100, 100, 1);
+  config.TAG_MATCHING(1);
+  config.SYM_LIMIT(3);
+  emp::Random random(1);
+  SymWorld world(random, &config);
+  world.Setup();
+
+  // Parents: every hosted symbiont at the start (births only add symbionts).
+  emp::vector<emp::WorldPosition> parents;
+  for (size_t i = 0; i < world.GetSize(); ++i) {
+    if (!world.IsOccupied(i)) continue;
+    for (size_t sym_i = 0; sym_i < world.GetOrg(i).GetSymbionts().size(); ++sym_i) {
+      parents.emplace_back(sym_i + 1, i);
+    }
+  }
+  if (parents.empty()) return;
+
+  bench::Result result{"default_sym_birth_tags", "size=10000,sym_limit=3,metric=" + config.TAG_METRIC()};
+  bench::Stopwatch stopwatch;
+  for (size_t birth = 0; birth < 500000; ++birth) {
+    const emp::WorldPosition& parent_pos = parents[birth % parents.size()];
+    emp::Ptr<Organism> parent = world.GetOrg(parent_pos.GetPopID()).GetSymbionts()[parent_pos.GetIndex() - 1];
+    emp::Ptr<Organism> sym_baby = parent->Reproduce();
+    stopwatch.Start();
+    world.SymDoBirth(sym_baby, parent_pos);
+    stopwatch.Stop();
+    ++result.orgs;
+  }
+  result.seconds = stopwatch.GetSeconds();
+  bench::Report(out, result);
+}
+
+void BenchDefaultTagMatrix(std::ostream& out) {
+  for (const std::string format : {"csv", "binary"}) {
+    SymConfigBase config;
+    ConfigureGrid(config, 100, 100, 1);
+    config.TAG_MATCHING(1);
+    config.TAG_MATRIX_SAMPLE_PROPORTION(1);
+    config.TAG_MATRIX_FORMAT(format);
+    emp::Random random(1);
+    SymWorld world(random, &config);
+    world.Setup();
+
+    bench::Result result{"default_tag_matrix", "size=10000,sample=1,format=" + format + ",metric=" + config.TAG_METRIC()};
+    bench::Stopwatch stopwatch;
+    for (size_t round = 0; round < 3; ++round) {
+      stopwatch.Start();
+      world.WriteTagMatrixFile((bench_data_dir / "tag_matrix").string());
+      stopwatch.Stop();
+      result.orgs += CountOrgs(world);
+    }
+    result.seconds = stopwatch.GetSeconds();
+    bench::Report(out, result);
+  }
+}
+
+// Data collection on a full world and on a sparse (5% occupied) 200x200 world.
+void BenchDefaultDataFiles(std::ostream& out) {
+  for (const auto& [width, pop_size] : {std::pair<size_t, int>{100, -1}, {200, 2000}}) {
+    SymConfigBase config;
+    ConfigureGrid(config, width, width, 1);
+    // Keep the sparse world sparse
+    if (pop_size > 0) ConfigureNoReproduction(config);
+    config.INIT_POP_SIZE(pop_size);
+    config.DATA_INT(1);
+    config.FILE_NAME("_bench");
+    emp::Random random(1);
+    SymWorld world(random, &config);
+    world.Setup();
+    world.CreateDataFiles();
+    const std::string params = "size=" + std::to_string(width * width) + ",pop=" +
+      std::to_string(world.GetNumOrgs()) + ",moi=1,data_int=1";
+    bench::Report(out, TimeUpdates(world, "default_data_files", params, 100));
+  }
+}
+
+void BenchDefaultInteractionSnapshot(std::ostream& out) {
+  const size_t num_taxa = 1000000;
+  emp::vector<datastruct::HostTaxonData> taxa(num_taxa);
+  for (size_t id = 0; id < num_taxa; ++id) {
+    taxa[id].associated_syms[2 * id] = 1;
+    taxa[id].associated_syms[2 * id + 1] = 3;
+  }
+  const std::string params = "taxa=" + std::to_string(num_taxa) + ",interactions=2";
+
+  bench::Result concat_result{"default_interaction_snapshot", params + ",path=concat", 0, 0, num_taxa};
+  concat_result.seconds = bench::TimeSeconds([&]() {
+    emp::File interaction_file;
+    interaction_file << "host, symbiont, count";
+    for (size_t id = 0; id < num_taxa; ++id) {
+      for (auto interaction : taxa[id].associated_syms) {
+        interaction_file << emp::to_string(id) + "," + emp::to_string(interaction.first) + "," +
+          emp::to_string(interaction.second);
+      }
+    }
+    interaction_file.Write((bench_data_dir / "interaction_snapshot_concat").string());
+  });
+  bench::Report(out, concat_result);
+
+  bench::Result stream_result{"default_interaction_snapshot", params + ",path=stream", 0, 0, num_taxa};
+  stream_result.seconds = bench::TimeSeconds([&]() {
+    output::RowWriter interaction_file(output::OpenSink((bench_data_dir / "interaction_snapshot_stream").string(), nullptr));
+    interaction_file.Write("host, symbiont, count\n");
+    for (size_t id = 0; id < num_taxa; ++id) {
+      for (const auto& [sym_taxon, count] : taxa[id].associated_syms) interaction_file.Row(id, sym_taxon, count);
+    }
+  });
+  bench::Report(out, stream_result);
+}
+
+void BenchDefaultHostAncestry(std::ostream& out) {
+  const size_t num_taxa = 100000;
+  const size_t num_checks = 100000;
+  emp::vector<emp::Ptr<taxon_t::host_taxon_t>> taxa;
+  for (size_t id = 0; id < num_taxa; ++id) {
+    // One long lineage, with a side branch every 10 generations
+    emp::Ptr<taxon_t::host_taxon_t> parent = nullptr;
+    if (id > 0) parent = (id % 10 == 0 && id > 10) ? taxa[id - 11] : taxa[id - 1];
+    taxa.push_back(emp::NewPtr<taxon_t::host_taxon_t>(id, 0, parent));
+    ancestry::Link(taxa.back());
+  }
+  emp::Random random(9);
+  emp::vector<std::pair<size_t, size_t>> checks;
+  for (size_t i = 0; i < num_checks; ++i) checks.emplace_back(random.GetUInt(num_taxa), random.GetUInt(num_taxa));
+  const std::string params = "taxa=" + std::to_string(num_taxa);
+
+  size_t walk_found = 0;
+  bench::Result walk_result{"default_host_ancestry", params + ",path=walk", 0, 0, num_checks};
+  walk_result.seconds = bench::TimeSeconds([&]() {
+    for (const auto& [ancestor_id, descendant_id] : checks) {
+      emp::Ptr<taxon_t::host_taxon_t> cur = taxa[descendant_id];
+      while (cur != nullptr && cur->GetID() > ancestor_id) cur = cur->GetParent();
+      walk_found += (cur != nullptr && cur->GetID() == ancestor_id);
+    }
+  });
+  bench::Report(out, walk_result);
+
+  size_t index_found = 0;
+  bench::Result index_result{"default_host_ancestry", params + ",path=index", 0, 0, num_checks};
+  index_result.seconds = bench::TimeSeconds([&]() {
+    for (const auto& [ancestor_id, descendant_id] : checks) {
+      index_found += ancestry::IsAncestor(taxa[ancestor_id], taxa[descendant_id]);
+    }
+  });
+  bench::Report(out, index_result);
+  if (walk_found != index_found) {
+    std::cerr << "default_host_ancestry: paths disagree (" << walk_found << " vs " << index_found << ")" << std::endl;
+  }
+
+  for (emp::Ptr<taxon_t::host_taxon_t> taxon : taxa) taxon.Delete();
+}
+
+void BenchLysisUpdate(std::ostream& out) {
+  SymConfigLysis config;
+  ConfigureGrid(config, 100, 100, 1);
+  config.LYSIS(1);
+  config.LYSIS_CHANCE(1);
+  config.BURST_SIZE(10);
+  config.BURST_TIME(10);
+  config.SYM_LIMIT(10);
+  config.SYM_LYSIS_RES(10);
+  emp::Random random(1);
+  LysisWorld world(random, &config);
+  world.Setup();
+  bench::Report(out, TimeUpdates(world, "lysis_update", "size=10000,moi=1,burst_size=10", 100));
+}
+
+void ConfigureSGP(sgpmode::SymConfigSGP& config, size_t width, size_t height) {
+  ConfigureGrid(config, width, height, 0);
+  config.FILE_NAME("_bench");
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  config.TASK_IO_BANK_SIZE(10000);
+}
+
+void BenchSGPCPUStep(std::ostream& out) {
+  sgpmode::SymConfigSGP config;
+  ConfigureSGP(config, 50, 50);
+  emp::Random random(1);
+  sgp_world_t world(random, &config);
+  world.Setup();
+
+  bench::Result result{"sgp_cpu_step", "size=2500"};
+  result.seconds = bench::TimeSeconds([&]() {
+    for (size_t round = 0; round < 2000; ++round) {
+      for (size_t i = 0; i < world.GetSize(); ++i) {
+        if (!world.IsOccupied(i)) continue;
+        static_cast<sgp_host_t&>(world.GetOrg(i)).GetHardware().RunCPUStep(1);
+        ++result.orgs;
+      }
+    }
+  });
+  bench::Report(out, result);
+}
+
+void BenchSGPIOBank(std::ostream& out) {
+  const size_t bank_size = 100000;
+  emp::Random random(1);
+  sgpmode::tasks::LogicTaskSet task_set;
+  task_set.AddTasksByName({"NOT", "NAND", "AND", "OR_NOT", "OR", "AND_NOT", "NOR", "XOR", "EQU"});
+  const std::string params = "size=" + std::to_string(bank_size) + ",tasks=" + std::to_string(task_set.GetSize());
+
+  {
+    sgpmode::tasks::LogicTaskIOBank io_bank(random, task_set);
+    bench::Result result{"sgp_io_bank", params + ",path=serial", 0, 0, bank_size};
+    result.seconds = bench::TimeSeconds([&]() { io_bank.GenerateBank(bank_size); });
+    bench::Report(out, result);
+  }
+  {
+    sgpmode::tasks::LogicTaskIOBank io_bank(random, task_set);
+    bench::Result result{"sgp_io_bank", params + ",path=seeded", 0, 0, bank_size};
+    result.seconds = bench::TimeSeconds([&]() { io_bank.GenerateSeededBank(bank_size, 1, 0); });
+    bench::Report(out, result);
+  }
+}
+
+void BenchSGPProcessOutputs(std::ostream& out) {
+  sgpmode::SymConfigSGP config;
+  ConfigureSGP(config, 50, 50);
+  emp::Random random(1);
+  sgp_world_t world(random, &config);
+  world.Setup();
+
+  // Each host gets 8 outputs per round, about half of them correct for its environment.
+  bench::Result result{"sgp_process_outputs", "size=2500,outputs=8"};
+  bench::Stopwatch stopwatch;
+  emp::vector<uint32_t> outputs(8);
+  for (size_t round = 0; round < 200; ++round) {
+    for (size_t i = 0; i < world.GetSize(); ++i) {
+      if (!world.IsOccupied(i)) continue;
+      sgp_host_t& host = static_cast<sgp_host_t&>(world.GetOrg(i));
+      auto& cpu_state = host.GetHardware().GetCPUState();
+      const auto& valid_outputs = world.GetTaskEnv().GetIOBank().GetIO(cpu_state.GetTaskEnvID()).valid_outputs;
+      for (uint32_t& output : outputs) {
+        output = (random.P(0.5) && valid_outputs.size())
+          ? valid_outputs[random.GetUInt(valid_outputs.size())]
+          : random.GetUInt();
+      }
+      cpu_state.SetOutputs(outputs);
+      stopwatch.Start();
+      host.ProcessOutputBuffer();
+      stopwatch.Stop();
+      ++result.orgs;
+    }
+  }
+  result.seconds = stopwatch.GetSeconds();
+  bench::Report(out, result);
+}
+
+// Update throughput at low occupancy (5% of a 100x100 grid) for each schedule mode.
+void BenchSGPSchedule(std::ostream& out) {
+  for (const std::string mode : {"random", "occupied", "blocked-random"}) {
+    sgpmode::SymConfigSGP config;
+    ConfigureSGP(config, 100, 100);
+    config.INIT_POP_SIZE(500);
+    config.SCHEDULE_MODE(mode);
+    emp::Random random(1);
+    sgp_world_t world(random, &config);
+    world.Setup();
+    bench::Report(out, TimeUpdates(world, "sgp_schedule", "size=10000,pop=500,mode=" + mode, 200));
+  }
+}
+
+void BenchSGPInteractionCompat(std::ostream& out) {
+  sgpmode::SymConfigSGP config;
+  ConfigureSGP(config, 50, 50);
+  config.START_MOI(1);
+  config.SYM_LIMIT(4);
+  config.TASK_PROFILE_MODE("self-all");
+  config.INTERACTION_PROFILE_COMPATIBILITY_MODE("task-any-match");
+  emp::Random random(1);
+  sgp_world_t world(random, &config);
+  world.Setup();
+  for (size_t i = 0; i < 50; ++i) world.Update(); // Let organisms perform some tasks
+
+  // The hooks SGPWorld configured before compatibility checks were policies.
+  std::function<const emp::BitVector&(const sgp_host_t&)> fun_get_host_task_profile =
+    [](const sgp_host_t& host) -> const emp::BitVector& {
+      return host.GetHardware().GetCPUState().GetTasksPerformed();
+    };
+  std::function<const emp::BitVector&(const sgp_sym_t&)> fun_get_sym_task_profile =
+    [](const sgp_sym_t& sym) -> const emp::BitVector& {
+      return sym.GetHardware().GetCPUState().GetTasksPerformed();
+    };
+  std::function<bool(const emp::BitVector&, const emp::BitVector&)> fun_task_profile_compatibility_check =
+    [](const emp::BitVector& a, const emp::BitVector& b) { return utils::AnyMatchingOnes(a, b); };
+  std::function<bool(const sgp_host_t&, const sgp_sym_t&)> fun_interaction_compatibility_check =
+    [&](const sgp_host_t& host, const sgp_sym_t& sym) {
+      return fun_task_profile_compatibility_check(fun_get_host_task_profile(host), fun_get_sym_task_profile(sym));
+    };
+
+  emp::vector<emp::Ptr<sgp_host_t>> hosts;
+  size_t num_syms = 0;
+  for (size_t i = 0; i < world.GetSize(); ++i) {
+    if (!world.IsOccupied(i)) continue;
+    hosts.push_back(static_cast<sgp_host_t*>(world.GetOrgPtr(i).Raw()));
+    num_syms += hosts.back()->GetSymbionts().size();
+  }
+
+  const size_t rounds = 2000;
+  size_t hook_count = 0;
+  bench::Result hook_result{"sgp_interaction_compat", "size=2500,sym_limit=4,path=std_function", 0, 0, rounds * num_syms};
+  hook_result.seconds = bench::TimeSeconds([&]() {
+    for (size_t round = 0; round < rounds; ++round) {
+      for (emp::Ptr<sgp_host_t> host : hosts) {
+        for (emp::Ptr<Organism> sym : host->GetSymbionts()) {
+          hook_count += fun_interaction_compatibility_check(*host, static_cast<sgp_sym_t&>(*sym));
+        }
+      }
+    }
+  });
+
+  size_t policy_count = 0;
+  bench::Result policy_result{"sgp_interaction_compat", "size=2500,sym_limit=4,path=policy", 0, 0, rounds * num_syms};
+  policy_result.seconds = bench::TimeSeconds([&]() {
+    for (size_t round = 0; round < rounds; ++round) {
+      for (emp::Ptr<sgp_host_t> host : hosts) {
+        policy_count += world.CountCompatibleSymbionts(*host);
+      }
+    }
+  });
+
+  if (hook_count != policy_count) {
+    std::cerr << "sgp_interaction_compat: paths disagree (" << hook_count << " vs " << policy_count << ")" << std::endl;
+  }
+  bench::Report(out, hook_result);
+  bench::Report(out, policy_result);
+}
+
+int main(int argc, char* argv[]) {
+  const emp::vector<std::pair<std::string, std::function<void(std::ostream&)>>> benchmarks = {
+    {"default_update", BenchDefaultUpdate},
+    {"default_schedule", BenchDefaultSchedule},
+    {"default_host_process", BenchDefaultHostProcess},
+    {"default_distrib_res", BenchDefaultDistribResources},
+    {"default_sym_birth_tags", BenchDefaultSymBirthTags},
+    {"default_tag_matrix", BenchDefaultTagMatrix},
+    {"default_data_files", BenchDefaultDataFiles},
+    {"default_interaction_snapshot", BenchDefaultInteractionSnapshot},
+    {"default_host_ancestry", BenchDefaultHostAncestry},
+    {"lysis_update", BenchLysisUpdate},
+    {"sgp_cpu_step", BenchSGPCPUStep},
+    {"sgp_io_bank", BenchSGPIOBank},
+    {"sgp_process_outputs", BenchSGPProcessOutputs},
+    {"sgp_schedule", BenchSGPSchedule},
+    {"sgp_interaction_compat", BenchSGPInteractionCompat}
+  };
+
+  std::filesystem::create_directories(bench_data_dir);
+  for (const auto& [name, fun_bench] : benchmarks) {
+    bool selected = (argc < 2);
+    for (int i = 1; i < argc; ++i) {
+      if (name.rfind(argv[i], 0) == 0) selected = true;
+    }
+    if (selected) fun_bench(std::cout);
+  }
+  std::filesystem::remove_all(bench_data_dir);
+  return 0;
+}
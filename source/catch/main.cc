@@ -6,6 +6,12 @@
 #include "sanity_check.test.cc"
 
 #include "../test/utils.test.cc"
+#include "../test/OrganismPool.test.cc"
+#include "../test/Batch.test.cc"
+#include "../test/ColumnarData.test.cc"
+#include "../test/AsyncOutput.test.cc"
+#include "../test/RowWriter.test.cc"
+#include "../test/AncestryIndex.test.cc"
 #include "../test/default_mode_test/SymWorld.test.cc"
 #include "../test/default_mode_test/DataNodes.test.cc"
 #include "../test/default_mode_test/Host.test.cc"
@@ -16,7 +22,11 @@
 #include "../test/default_mode_test/Phylogenies.test.cc"
 #include "../test/default_mode_test/TagMatching.test.cc"
 #include "../test/default_mode_test/SpatialStructure.test.cc"
+#include "../test/default_mode_test/OccupancyIndex.test.cc"
+#include "../test/default_mode_test/UpdateSchedule.test.cc"
 #include "../test/default_mode_test/PopulationStructure.test.cc"
+#include "../test/default_mode_test/Checkpoint.test.cc"
+#include "../test/default_mode_test/SoAPopulation.test.cc"
 
 #include "../test/efficient_mode_test/EfficientSymbiont.test.cc"
 #include "../test/efficient_mode_test/EfficientHost.test.cc"
@@ -61,6 +71,10 @@
 
 #include "../test/sgp_mode_test/unit_tests/RingBuffer.test.cc"
 #include "../test/sgp_mode_test/unit_tests/Stacks.test.cc"
+#include "../test/sgp_mode_test/unit_tests/Scheduler.test.cc"
+#include "../test/sgp_mode_test/unit_tests/ReproductionQueue.test.cc"
+#include "../test/sgp_mode_test/unit_tests/JumpTableCache.test.cc"
+#include "../test/sgp_mode_test/unit_tests/LogicTaskIOBank.test.cc"
 #include "../test/sgp_mode_test/unit_tests/SGPCureHosts.test.cc"
 #include "../test/sgp_mode_test/unit_tests/SGPWorldData.test.cc"
 
@@ -72,6 +86,7 @@
 #include "../test/sgp_mode_test/functional_tests/TempChangingEnvironments.test.cc"
 #include "../test/sgp_mode_test/functional_tests/SGPWorld.test.cc"
 #include "../test/sgp_mode_test/functional_tests/PopulationStructure.test.cc"
+#include "../test/sgp_mode_test/functional_tests/SGPCheckpoint.test.cc"
 
 // Anya's tests
 #include "../test/sgp_mode_test/unit_tests/SGPWorld.test.cc"
@@ -5,6 +5,8 @@
 
 #include "SymWorld.h"
 
+#include <sstream>
+
 /**
 * Input: None.
 *
@@ -16,6 +18,9 @@ void SymWorld::CreateDataFiles() {
   int TIMING_REPEAT = my_config->DATA_INT();
   std::string file_ending = "_SEED" + std::to_string(my_config->SEED()) + ".data";
 
+  // Population data nodes only need to be collected on updates that are written
+  if (TIMING_REPEAT > 0) SetDataNodeInterval(TIMING_REPEAT);
+
   SetupHostIntValFile(my_config->FILE_PATH()+"HostVals"+my_config->FILE_NAME()+file_ending).SetTimingRepeat(TIMING_REPEAT);
   SetupSymIntValFile(my_config->FILE_PATH()+"SymVals"+my_config->FILE_NAME()+file_ending).SetTimingRepeat(TIMING_REPEAT);
   SetupTransmissionFile(my_config->FILE_PATH()+"TransmissionRates"+my_config->FILE_NAME()+file_ending).SetTimingRepeat(TIMING_REPEAT);
@@ -238,89 +243,38 @@ emp::DataFile& SymWorld::SetupReproHistFile(const std::string& filename) {
  * the host systematic information
  */
 void SymWorld::WritePhylogenyFile(const std::string & filename) {
-  sym_sys->Snapshot("SymSnapshot_"+filename);
-  host_sys->Snapshot("HostSnapshot_"+filename);
+  WriteSystematicsSnapshot(*sym_sys, sym_snapshot_columns, "SymSnapshot_"+filename);
+  WriteSystematicsSnapshot(*host_sys, host_snapshot_columns, "HostSnapshot_"+filename);
 
+  // Interaction snapshots can have millions of rows with STORE_EXTINCT, so
+  // rows are streamed out rather than built up in memory
   if (my_config->TRACK_PHYLOGENY_INTERACTIONS()) {
-    emp::File interaction_file;
-    // interaction_file << "host, symbiont, host_interaction, sym_interaction, count";
-    interaction_file << "host, symbiont, count";
-
-    for (emp::Ptr<taxon_t::host_taxon_t> t : host_sys->GetActive()) {
-      for (auto interaction : t->GetData().associated_syms) {
-        // It feels like there should be a better way to do this, but all the
-        // obvious solutions involved converting all these values to the same
-        // numerical type, which doesn't end well (since they're a mix of large
-        // integers and small floating points)
-        interaction_file << emp::to_string(t->GetID()) + "," +
-          emp::to_string(interaction.first) + "," +
-          // emp::to_string(t->GetInfo()) + "," +
-          // emp::to_string(interaction.first->GetInfo()) + "," +
-          emp::to_string(interaction.second);
-      }
-    }
-
-    for (emp::Ptr<taxon_t::host_taxon_t> t : host_sys->GetAncestors()) {
-      for (auto interaction : t->GetData().associated_syms) {
-        // It feels like there should be a better way to do this, but all the
-        // obvious solutions involved converting all these values to the same
-        // numerical type, which doesn't end well (since they're a mix of large
-        // integers and small floating points)
-        interaction_file << emp::to_string(t->GetID()) + "," +
-          emp::to_string(interaction.first) + "," +
-          // emp::to_string(t->GetInfo()) + "," +
-          // emp::to_string(interaction.first->GetInfo()) + "," +
-          emp::to_string(interaction.second);
-      }
-    }
-
-    for (emp::Ptr<taxon_t::host_taxon_t> t : host_sys->GetOutside()) {
-      for (auto interaction : t->GetData().associated_syms) {
-        // It feels like there should be a better way to do this, but all the
-        // obvious solutions involved converting all these values to the same
-        // numerical type, which doesn't end well (since they're a mix of large
-        // integers and small floating points)
-        interaction_file << emp::to_string(t->GetID()) + "," +
-          emp::to_string(interaction.first) + "," +
-          // emp::to_string(t->GetInfo()) + "," +
-          // emp::to_string(interaction.first->GetInfo()) + "," +
-          emp::to_string(interaction.second);
+    output::RowWriter interaction_file = OpenSnapshotWriter("InteractionSnapshot_" + filename);
+    // interaction_file.Write("host, symbiont, host_interaction, sym_interaction, count\n");
+    interaction_file.Write("host, symbiont, count\n");
+    auto write_interactions = [&interaction_file](emp::Ptr<taxon_t::host_taxon_t> t) {
+      for (const auto& [sym_taxon, count] : t->GetData().associated_syms) {
+        interaction_file.Row(t->GetID(), sym_taxon, count);
       }
-    }
-
-    interaction_file.Write("InteractionSnapshot_" + filename);
+    };
+    for (emp::Ptr<taxon_t::host_taxon_t> t : host_sys->GetActive()) write_interactions(t);
+    for (emp::Ptr<taxon_t::host_taxon_t> t : host_sys->GetAncestors()) write_interactions(t);
+    for (emp::Ptr<taxon_t::host_taxon_t> t : host_sys->GetOutside()) write_interactions(t);
   }
   if (my_config->WRITE_CURRENT_INTERACTION_COUNTS()) {
-    emp::File cur_interaction_file;
-    cur_interaction_file << "host,symbiont,count";
-    std::unordered_map<unsigned long long int, std::unordered_map<unsigned long long int, int>> current_interactions;
-
-    for (size_t i = 0; i < GetSize(); i++) {
-      if (IsOccupied(i)) {
-        unsigned long long int host_taxon = pop[i]->GetTaxon()->GetID();
-        for (auto sym : pop[i]->GetSymbionts()) {
-          unsigned long long int sym_taxon = sym->GetTaxon()->GetID();
-          if (!current_interactions.contains(host_taxon)) {
-            std::unordered_map<unsigned long long int, int> syms_map = { std::pair(sym_taxon, 1) };
-            current_interactions.emplace(host_taxon, syms_map);
-          }
-          else if (!current_interactions.at(host_taxon).contains(sym_taxon)) {
-            current_interactions.at(host_taxon).emplace(sym_taxon, 1);
-          }
-          else {
-            current_interactions.at(host_taxon).at(sym_taxon)++;
-          }
-        }
+    current_interactions.Clear();
+    host_positions.ForEach([&](size_t i) {
+      const size_t host_taxon = pop[i]->GetTaxon()->GetID();
+      for (auto sym : pop[i]->GetSymbionts()) {
+        current_interactions.Add(host_taxon, sym->GetTaxon()->GetID());
       }
-    }
+    });
 
-    for (auto host_pair : current_interactions) {
-      for (auto sym_pair : host_pair.second) {
-        cur_interaction_file << emp::to_string(host_pair.first) + "," + emp::to_string(sym_pair.first) + "," + emp::to_string(sym_pair.second);
-      }
+    output::RowWriter cur_interaction_file = OpenSnapshotWriter("CurrentInteractionsSnapshot_" + filename);
+    cur_interaction_file.Write("host,symbiont,count\n");
+    for (const PairCounter::Entry& interaction : current_interactions) {
+      cur_interaction_file.Row(interaction.first, interaction.second, interaction.count);
     }
-
-    cur_interaction_file.Write("CurrentInteractionsSnapshot_" + filename);
   }
 
 }
@@ -338,16 +292,13 @@ void SymWorld::MapPhylogenyInteractions() {
     t->GetData().ClearInteractions();
   }
 
-  for (size_t pos = 0; pos < pop.size(); pos++) {
-    if (!IsOccupied(pos)) {
-      continue;
-    }
+  host_positions.ForEach([&](size_t pos) {
     datastruct::HostTaxonData & host_data = host_sys->GetTaxonAt(pos)->GetData();
     for (emp::Ptr<Organism> sym : pop[pos]->GetSymbionts()) {
       host_data.AddInteraction(sym->GetTaxon());
     }
 
-  }
+  });
 
 }
 
@@ -507,7 +458,7 @@ emp::DataFile& SymWorld::SetupTagDistFile(const std::string& filename) {
  * concluded
  */
 void SymWorld::WriteOrgDumpFile(const std::string& filename) {
-  std::ofstream out_file(filename);
+  std::ostringstream out_file;
   out_file << "host_int,sym_int,host_repro_count,host_towards_partner_count,host_from_partner_count," <<
     "sym_repro_count,sym_towards_partner_count,sym_from_partner_count";
   if (my_config->TAG_MATCHING()) {
@@ -516,72 +467,62 @@ void SymWorld::WriteOrgDumpFile(const std::string& filename) {
   }
   out_file << "\n";
 
-  for (size_t i = 0; i < size(); i++) {
-    if (IsOccupied(i)) {
-      if (pop[i]->HasSym()) {
-        emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
-        for (size_t j = 0; j < symbionts.size(); j++) {
-          out_file << pop[i]->GetIntVal() << "," << symbionts[j]->GetIntVal() << "," << pop[i]->GetReproCount() <<
-            "," << pop[i]->GetTowardsPartnerCount() << "," << pop[i]->GetFromPartnerCount() <<
-            "," << symbionts[j]->GetReproCount() << "," << symbionts[j]->GetTowardsPartnerCount() <<
-            "," << symbionts[j]->GetFromPartnerCount();
-          if (my_config->TAG_MATCHING()) {
-            out_file << "," << pop[i]->GetTag().ToBinaryString() << "," << symbionts[j]->GetTag().ToBinaryString() <<
-              "," << (*tag_metric)(pop[i]->GetTag(), symbionts[j]->GetTag());
-            if (my_config->HOST_TAG_PERMISSIVENESS_EVOLVES()) out_file << "," << pop[i]->GetTagPermissiveness();
-          }
-        }
-      }
-      else {
-        out_file << pop[i]->GetIntVal() << ",," << pop[i]->GetReproCount() << "," <<
-          pop[i]->GetTowardsPartnerCount() << "," << pop[i]->GetFromPartnerCount() << ",,,";
+  host_positions.ForEach([&](size_t i) {
+    if (pop[i]->HasSym()) {
+      emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
+      for (size_t j = 0; j < symbionts.size(); j++) {
+        out_file << pop[i]->GetIntVal() << "," << symbionts[j]->GetIntVal() << "," << pop[i]->GetReproCount() <<
+          "," << pop[i]->GetTowardsPartnerCount() << "," << pop[i]->GetFromPartnerCount() <<
+          "," << symbionts[j]->GetReproCount() << "," << symbionts[j]->GetTowardsPartnerCount() <<
+          "," << symbionts[j]->GetFromPartnerCount();
         if (my_config->TAG_MATCHING()) {
-          out_file << "," << pop[i]->GetTag().ToBinaryString() << ",,";
+          out_file << "," << pop[i]->GetTag().ToBinaryString() << "," << symbionts[j]->GetTag().ToBinaryString() <<
+            "," << CalcTagMetric(pop[i]->GetTag(), symbionts[j]->GetTag());
           if (my_config->HOST_TAG_PERMISSIVENESS_EVOLVES()) out_file << "," << pop[i]->GetTagPermissiveness();
         }
       }
-      out_file << "\n";
     }
-  }
-  out_file.close();
+    else {
+      out_file << pop[i]->GetIntVal() << ",," << pop[i]->GetReproCount() << "," <<
+        pop[i]->GetTowardsPartnerCount() << "," << pop[i]->GetFromPartnerCount() << ",,,";
+      if (my_config->TAG_MATCHING()) {
+        out_file << "," << pop[i]->GetTag().ToBinaryString() << ",,";
+        if (my_config->HOST_TAG_PERMISSIVENESS_EVOLVES()) out_file << "," << pop[i]->GetTagPermissiveness();
+      }
+    }
+    out_file << "\n";
+  });
+  WriteOutputFile(filename, out_file.str());
 }
 
 void SymWorld::WriteTagMatrixFile(const std::string& filename) {
-  std::ofstream out_file(filename);
+  const std::string& cfg_format = my_config->TAG_MATRIX_FORMAT();
+  utils::ValidateConfigMode(tag_matrix_format_cfg_mapping, "TAG_MATRIX_FORMAT", cfg_format);
+  const tag_utils::TagMatrixFormat format = tag_matrix_format_cfg_mapping.at(cfg_format);
 
   emp::vector<size_t> sampled_positions = emp::Choose(GetRandom(), GetSize(), my_config->TAG_MATRIX_SAMPLE_PROPORTION() * GetSize());
 
-  // write the host position of every sym
-  out_file << ',';
+  // rows are sampled hosts; columns are the syms in sampled hosts, labeled by
+  // host position (for mulit-infection, have non-unique ids (or change this!))
+  tag_batch_t host_tags;
+  tag_batch_t sym_tags;
+  emp::vector<size_t> host_positions;
+  emp::vector<size_t> sym_host_positions;
   for (size_t i : sampled_positions) {
     if (IsOccupied(i)) {
-      if (pop[i]->HasSym()) {
-        emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
-        for (size_t j = 0; j < symbionts.size(); j++) {
-          out_file << i << ","; // for mulit-infection, have non-unique ids (or change this!)
-        }
+      host_tags.Add(pop[i]->GetTag());
+      host_positions.push_back(i);
+      for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) {
+        sym_tags.Add(sym->GetTag());
+        sym_host_positions.push_back(i);
       }
     }
   }
-  out_file << "\n";
 
-  // for every host, calculate the tag distance to every sym
-  for (size_t k : sampled_positions) {
-    if (IsOccupied(k)) {
-      out_file << k << ',';
-
-      // calculate tag distance to every sym
-      for (size_t i : sampled_positions) {
-        if (IsOccupied(i) && pop[i]->HasSym()) {
-          emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
-          for (size_t j = 0; j < symbionts.size(); j++) {
-            out_file << (*tag_metric)(pop[k]->GetTag(), symbionts[j]->GetTag()) << ",";
-          }
-        }
-      }
-      out_file << "\n";
-    }
-  }
+  // for every host, calculate the tag distance to every sym (streamed in blocks of hosts)
+  std::ofstream out_file(filename, std::ios::out | std::ios::binary);
+  tag_utils::WriteTagMatrix(out_file, tag_engine, host_tags, host_positions,
+    sym_tags, sym_host_positions, format, my_config->TAG_MATRIX_NUM_THREADS());
   out_file.close();
 }
 
@@ -641,6 +582,156 @@ void SymWorld::WriteTagMatrixFile(const std::string& filename) {
     return file;
   }
 
+/**
+ * Input: None
+ *
+ * Output: None
+ *
+ * Purpose: To register (once) the update callback that fills the population
+ * data nodes. Collection only happens on updates that are a multiple of the
+ * data node interval, so the population isn't rescanned on updates that are
+ * never written.
+ */
+void SymWorld::SetupDataNodeCollection() {
+  if (data_node_collection_registered) return;
+  data_node_collection_registered = true;
+  OnUpdate([this](size_t ud) {
+    if (CollectsDataNodesAt(ud)) CollectDataNodes();
+  });
+}
+
+/**
+ * Input: None
+ *
+ * Output: None
+ *
+ * Purpose: To reset and refill every population data node that has been
+ * created, in a single pass over the population. Each node receives its data
+ * in the same order as a separate scan would give it, so file output is
+ * unchanged.
+ */
+void SymWorld::CollectDataNodes() {
+  // Reset every node that is rebuilt from the population
+  if (data_node_hostcount) data_node_hostcount->Reset();
+  if (data_node_symcount) data_node_symcount->Reset();
+  if (data_node_hostedsymcount) data_node_hostedsymcount->Reset();
+  if (data_node_freesymcount) data_node_freesymcount->Reset();
+  if (data_node_uninf_hosts) data_node_uninf_hosts->Reset();
+  if (data_node_hostintval) data_node_hostintval->Reset();
+  if (data_node_symintval) data_node_symintval->Reset();
+  if (data_node_freesymintval) data_node_freesymintval->Reset();
+  if (data_node_hostedsymintval) data_node_hostedsymintval->Reset();
+  if (data_node_syminfectchance) data_node_syminfectchance->Reset();
+  if (data_node_freesyminfectchance) data_node_freesyminfectchance->Reset();
+  if (data_node_hostedsyminfectchance) data_node_hostedsyminfectchance->Reset();
+  if (data_node_tag_dist) data_node_tag_dist->Reset();
+  if (data_node_host_permissiveness) data_node_host_permissiveness->Reset();
+  if (data_node_within_host_variance) data_node_within_host_variance->Reset();
+  if (data_node_within_host_mean) data_node_within_host_mean->Reset();
+  if (data_node_host_repro_count) data_node_host_repro_count->Reset();
+  if (data_node_sym_repro_count) data_node_sym_repro_count->Reset();
+  if (data_node_host_towards_partner_rate) data_node_host_towards_partner_rate->Reset();
+  if (data_node_host_from_partner_rate) data_node_host_from_partner_rate->Reset();
+  if (data_node_sym_towards_partner_rate) data_node_sym_towards_partner_rate->Reset();
+  if (data_node_sym_from_partner_rate) data_node_sym_from_partner_rate->Reset();
+  if (data_node_host_tag_richness) data_node_host_tag_richness->Reset();
+  if (data_node_host_tag_shannon) data_node_host_tag_shannon->Reset();
+  if (data_node_symbiont_tag_richness) data_node_symbiont_tag_richness->Reset();
+  if (data_node_symbiont_tag_shannon) data_node_symbiont_tag_shannon->Reset();
+
+  // Only touch the parts of organisms that some node needs
+  const bool collect_tag_diversity = data_node_host_tag_richness || data_node_host_tag_shannon ||
+    data_node_symbiont_tag_richness || data_node_symbiont_tag_shannon;
+  const bool collect_within_host = data_node_within_host_variance || data_node_within_host_mean;
+  const bool collect_host_only = collect_tag_diversity || collect_within_host ||
+    data_node_host_repro_count || data_node_sym_repro_count ||
+    data_node_host_towards_partner_rate || data_node_host_from_partner_rate ||
+    data_node_sym_towards_partner_rate || data_node_sym_from_partner_rate;
+  const bool collect_hosted_syms = collect_host_only || data_node_symcount ||
+    data_node_hostedsymcount || data_node_uninf_hosts || data_node_symintval ||
+    data_node_hostedsymintval || data_node_syminfectchance ||
+    data_node_hostedsyminfectchance || data_node_tag_dist;
+
+  emp::vector<emp::BitSet<TAG_LENGTH>> host_tags;
+  emp::vector<emp::BitSet<TAG_LENGTH>> symbiont_tags;
+  emp::vector<double> int_vals;
+
+  occupied_positions.ForEach([&](size_t i) {
+    if (IsOccupied(i)) {
+      emp::Ptr<Organism> host = pop[i];
+      if (data_node_hostcount) data_node_hostcount->AddDatum(1);
+      if (data_node_hostintval) data_node_hostintval->AddDatum(host->GetIntVal());
+      if (data_node_host_permissiveness) data_node_host_permissiveness->AddDatum(host->GetTagPermissiveness());
+
+      if (collect_hosted_syms) {
+        emp::vector<emp::Ptr<Organism>>& syms = host->GetSymbionts();
+        const size_t sym_size = syms.size();
+        if (data_node_symcount) data_node_symcount->AddDatum(sym_size);
+        if (data_node_hostedsymcount) data_node_hostedsymcount->AddDatum(sym_size);
+        if (data_node_uninf_hosts && sym_size == 0) data_node_uninf_hosts->AddDatum(1);
+        for (size_t j = 0; j < sym_size; j++) {
+          emp::Ptr<Organism> sym = syms[j];
+          if (data_node_symintval) data_node_symintval->AddDatum(sym->GetIntVal());
+          if (data_node_hostedsymintval) data_node_hostedsymintval->AddDatum(sym->GetIntVal());
+          if (data_node_syminfectchance) data_node_syminfectchance->AddDatum(sym->GetInfectionChance());
+          if (data_node_hostedsyminfectchance) data_node_hostedsyminfectchance->AddDatum(sym->GetInfectionChance());
+          if (data_node_tag_dist) data_node_tag_dist->AddDatum(CalcTagMetric(host->GetTag(), sym->GetTag()));
+        }
+
+        if (collect_host_only && host->IsHost()) {
+          if (data_node_host_repro_count) data_node_host_repro_count->AddDatum(host->GetReproCount());
+          if (data_node_host_towards_partner_rate) {
+            data_node_host_towards_partner_rate->AddDatum((double)host->GetTowardsPartnerCount() / (double)host->GetReproCount());
+          }
+          if (data_node_host_from_partner_rate) {
+            data_node_host_from_partner_rate->AddDatum((double)host->GetFromPartnerCount() / (double)host->GetReproCount());
+          }
+          if (collect_tag_diversity) host_tags.push_back(host->GetTag());
+          for (emp::Ptr<Organism> sym : syms) {
+            if (data_node_sym_repro_count) data_node_sym_repro_count->AddDatum(sym->GetReproCount());
+            if (data_node_sym_towards_partner_rate) {
+              data_node_sym_towards_partner_rate->AddDatum((double)sym->GetTowardsPartnerCount() / (double)sym->GetReproCount());
+            }
+            if (data_node_sym_from_partner_rate) {
+              data_node_sym_from_partner_rate->AddDatum((double)sym->GetFromPartnerCount() / (double)sym->GetReproCount());
+            }
+            if (collect_tag_diversity) symbiont_tags.push_back(sym->GetTag());
+          }
+
+          if (collect_within_host && host->HasSym()) {
+            int_vals.resize(sym_size);
+            for (size_t j = 0; j < sym_size; j++) {
+              int_vals[j] = syms[j]->GetIntVal();
+            }
+            if (data_node_within_host_mean) data_node_within_host_mean->AddDatum(emp::Mean(int_vals));
+            if (data_node_within_host_variance) {
+              // Can't take the variance of 1 thing
+              data_node_within_host_variance->AddDatum(sym_size > 1 ? emp::Variance(int_vals) : 0);
+            }
+          }
+        }
+      }
+    }
+
+    if (sym_pop[i]) {
+      emp::Ptr<Organism> sym = sym_pop[i];
+      if (data_node_symcount) data_node_symcount->AddDatum(1);
+      if (data_node_freesymcount) data_node_freesymcount->AddDatum(1);
+      if (data_node_symintval) data_node_symintval->AddDatum(sym->GetIntVal());
+      if (data_node_freesymintval) data_node_freesymintval->AddDatum(sym->GetIntVal());
+      if (data_node_syminfectchance) data_node_syminfectchance->AddDatum(sym->GetInfectionChance());
+      if (data_node_freesyminfectchance) data_node_freesyminfectchance->AddDatum(sym->GetInfectionChance());
+    }
+  });
+
+  if (collect_tag_diversity) {
+    if (data_node_host_tag_richness) data_node_host_tag_richness->AddDatum(emp::UniqueCount(host_tags));
+    if (data_node_host_tag_shannon) data_node_host_tag_shannon->AddDatum(emp::ShannonEntropy(host_tags));
+    if (data_node_symbiont_tag_richness) data_node_symbiont_tag_richness->AddDatum(emp::UniqueCount(symbiont_tags));
+    if (data_node_symbiont_tag_shannon) data_node_symbiont_tag_shannon->AddDatum(emp::ShannonEntropy(symbiont_tags));
+  }
+}
+
 /**
  * Input: None
  *
@@ -653,14 +744,7 @@ void SymWorld::WriteTagMatrixFile(const std::string& filename) {
 emp::DataMonitor<int>& SymWorld::GetHostCountDataNode() {
   if (!data_node_hostcount) {
     data_node_hostcount.New();
-    OnUpdate([this](size_t) {
-      data_node_hostcount -> Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          data_node_hostcount->AddDatum(1);
-        }
-      }
-    });
+    SetupDataNodeCollection();
   }
   return *data_node_hostcount;
 }
@@ -678,17 +762,7 @@ emp::DataMonitor<int>& SymWorld::GetHostCountDataNode() {
 emp::DataMonitor<int>& SymWorld::GetSymCountDataNode() {
   if (!data_node_symcount) {
     data_node_symcount.New();
-    OnUpdate([this](size_t) {
-      data_node_symcount -> Reset();
-      for (size_t i = 0; i < pop.size(); i++) {
-        if (IsOccupied(i)) {
-          data_node_symcount->AddDatum((pop[i]->GetSymbionts()).size());
-        }
-        if (sym_pop[i]) {
-          data_node_symcount->AddDatum(1);
-        }
-      }
-    });
+    SetupDataNodeCollection();
   }
   return *data_node_symcount;
 }
@@ -706,16 +780,7 @@ emp::DataMonitor<int>& SymWorld::GetSymCountDataNode() {
 emp::DataMonitor<int>& SymWorld::GetCountHostedSymsDataNode() {
   if (!data_node_hostedsymcount) {
     data_node_hostedsymcount.New();
-    OnUpdate(
-      [this](size_t) {
-        data_node_hostedsymcount->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i)) {
-            data_node_hostedsymcount->AddDatum(pop[i]->GetSymbionts().size());
-          }
-        }
-      }
-    );
+    SetupDataNodeCollection();
   }
   return *data_node_hostedsymcount;
 }
@@ -733,16 +798,7 @@ emp::DataMonitor<int>& SymWorld::GetCountHostedSymsDataNode() {
 emp::DataMonitor<int>& SymWorld::GetCountFreeSymsDataNode() {
   if (!data_node_freesymcount) {
     data_node_freesymcount.New();
-    OnUpdate(
-      [this](size_t) {
-        data_node_freesymcount->Reset();
-        for (size_t i = 0; i < pop.size(); i++) {
-          if (sym_pop[i]) {
-            data_node_freesymcount->AddDatum(1);
-          }
-        }
-      }
-    );
+    SetupDataNodeCollection();
   }
   return *data_node_freesymcount;
 }
@@ -761,18 +817,7 @@ emp::DataMonitor<int>& SymWorld::GetUninfectedHostsDataNode() {
   //keep track of host organisms that are uninfected
   if (!data_node_uninf_hosts) {
     data_node_uninf_hosts.New();
-    OnUpdate(
-      [this](size_t) {
-        data_node_uninf_hosts -> Reset();
-        for (size_t i = 0; i < pop.size(); i++) {
-          if (IsOccupied(i)) {
-            if ((pop[i]->GetSymbionts()).empty()) {
-              data_node_uninf_hosts->AddDatum(1);
-            }
-          } //endif
-        } //end for
-      }
-    ); //end OnUpdate
+    SetupDataNodeCollection();
   } //end if
   return *data_node_uninf_hosts;
 }
@@ -792,14 +837,7 @@ emp::DataMonitor<int>& SymWorld::GetUninfectedHostsDataNode() {
 emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetHostIntValDataNode() {
   if (!data_node_hostintval) {
     data_node_hostintval.New();
-    OnUpdate([this](size_t) {
-      data_node_hostintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          data_node_hostintval->AddDatum(pop[i]->GetIntVal());
-        }
-      }
-    });
+    SetupDataNodeCollection();
   }
   data_node_hostintval->SetupBins(-1.0, 1.1, 21);
   return *data_node_hostintval;
@@ -818,21 +856,7 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetHostIntValDataNode(
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymIntValDataNode() {
   if (!data_node_symintval) {
     data_node_symintval.New();
-    OnUpdate([this](size_t) {
-      data_node_symintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for (size_t j=0; j< sym_size; j++) {
-            data_node_symintval->AddDatum(syms[j]->GetIntVal());
-          }//close for
-        }
-        if (sym_pop[i]) {
-          data_node_symintval->AddDatum(sym_pop[i]->GetIntVal());
-        } //close if
-      }//close for
-    });
+    SetupDataNodeCollection();
   }
   data_node_symintval->SetupBins(-1.0, 1.1, 21);
   return *data_node_symintval;
@@ -851,14 +875,7 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymIntValDataNode()
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymIntValDataNode() {
   if (!data_node_freesymintval) {
     data_node_freesymintval.New();
-    OnUpdate([this](size_t) {
-      data_node_freesymintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (sym_pop[i]) {
-          data_node_freesymintval->AddDatum(sym_pop[i]->GetIntVal());
-        } //close if
-      }//close for
-    });
+    SetupDataNodeCollection();
   }
   data_node_freesymintval->SetupBins(-1.0, 1.1, 21);
   return *data_node_freesymintval;
@@ -876,18 +893,7 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymIntValDataNod
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetHostedSymIntValDataNode() {
   if (!data_node_hostedsymintval) {
     data_node_hostedsymintval.New();
-    OnUpdate([this](size_t) {
-      data_node_hostedsymintval->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for (size_t j=0; j< sym_size; j++) {
-            data_node_hostedsymintval->AddDatum(syms[j]->GetIntVal());
-          }//close for
-        }//close if
-      }//close for
-    });
+    SetupDataNodeCollection();
   }
   data_node_hostedsymintval->SetupBins(-1.0, 1.1, 21);
   return *data_node_hostedsymintval;
@@ -906,21 +912,7 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetHostedSymIntValDataN
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymInfectChanceDataNode() {
   if (!data_node_syminfectchance) {
     data_node_syminfectchance.New();
-    OnUpdate([this](size_t) {
-      data_node_syminfectchance->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for (size_t j=0; j< sym_size; j++) {
-            data_node_syminfectchance->AddDatum(syms[j]->GetInfectionChance());
-          }//close for
-        }
-        if (sym_pop[i]) {
-          data_node_syminfectchance->AddDatum(sym_pop[i]->GetInfectionChance());
-        } //close if
-      }//close for
-    });
+    SetupDataNodeCollection();
   }
   data_node_syminfectchance->SetupBins(0, 1.1, 11);
   return *data_node_syminfectchance;
@@ -940,14 +932,7 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetSymInfectChanceDataN
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymInfectChanceDataNode() {
   if (!data_node_freesyminfectchance) {
     data_node_freesyminfectchance.New();
-    OnUpdate([this](size_t) {
-      data_node_freesyminfectchance->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (sym_pop[i]) {
-          data_node_freesyminfectchance->AddDatum(sym_pop[i]->GetInfectionChance());
-        } //close if
-      }//close for
-    });
+    SetupDataNodeCollection();
   }
   data_node_freesyminfectchance->SetupBins(0, 1.1, 11);
   return *data_node_freesyminfectchance;
@@ -966,18 +951,7 @@ emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetFreeSymInfectChanceD
 emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetHostedSymInfectChanceDataNode() {
   if (!data_node_hostedsyminfectchance) {
     data_node_hostedsyminfectchance.New();
-    OnUpdate([this](size_t) {
-      data_node_hostedsyminfectchance->Reset();
-      for (size_t i = 0; i< pop.size(); i++) {
-        if (IsOccupied(i)) {
-          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-          size_t sym_size = syms.size();
-          for (size_t j=0; j< sym_size; j++) {
-            data_node_hostedsyminfectchance->AddDatum(syms[j]->GetInfectionChance());
-          }//close for
-        }
-      }//close for
-    });
+    SetupDataNodeCollection();
   }
   data_node_hostedsyminfectchance->SetupBins(0, 1.1, 11);
   return *data_node_hostedsyminfectchance;
@@ -1107,20 +1081,7 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetVerticalTransmissio
 emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode() {
   if (!data_node_tag_dist) {
     data_node_tag_dist.New();
-    OnUpdate([this](size_t) {
-      data_node_tag_dist->Reset();
-      for (size_t i = 0; i < pop.size(); i++) {
-        if (IsOccupied(i)) {
-          if (pop[i]->HasSym()) {
-            emp::vector<emp::Ptr<Organism>> symbionts = pop[i]->GetSymbionts();
-            for (size_t j = 0; j < symbionts.size(); j++) {
-              double distance = (*tag_metric)(pop[i]->GetTag(), symbionts[j]->GetTag());
-              data_node_tag_dist->AddDatum(distance);
-            }
-          }
-        } //endif
-      } //end for
-    }); //end OnUpdate
+    SetupDataNodeCollection();
   } //end if
   data_node_tag_dist->SetupBins(0, 1.1, 11);
   return *data_node_tag_dist;
@@ -1138,14 +1099,7 @@ emp::DataMonitor<double, emp::data::Histogram>& SymWorld::GetTagDistanceDataNode
 emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   if (!data_node_host_permissiveness) {
     data_node_host_permissiveness.New();
-    OnUpdate([this](size_t) {
-      data_node_host_permissiveness->Reset();
-      for (size_t i = 0; i < pop.size(); i++) {
-        if (IsOccupied(i)) {
-          data_node_host_permissiveness->AddDatum(pop[i]->GetTagPermissiveness());
-        } //endif
-      } //end for
-    }); //end OnUpdate
+    SetupDataNodeCollection();
   } //end if
   return *data_node_host_permissiveness;
 }
@@ -1154,25 +1108,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetWithinHostVarianceDataNode() {
     if (!data_node_within_host_variance) {
       data_node_within_host_variance.New();
-      OnUpdate([this](size_t) {
-        data_node_within_host_variance->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost() && pop[i]->HasSym()) {
-	          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-	          size_t sym_size = syms.size();
-            if (sym_size > 1) { // Can't take the variance of 1 thing
-              emp::vector<double> int_vals(sym_size);
-              for (size_t j=0; j< sym_size; j++) {
-                int_vals[j] = syms[j]->GetIntVal();
-              }//close for
-              data_node_within_host_variance->AddDatum(emp::Variance(int_vals));
-            } else {
-              data_node_within_host_variance->AddDatum(0);
-            }
-
-          } //close if
-	      }//close for
-      });
+      SetupDataNodeCollection();
     }
     return *data_node_within_host_variance;
   }
@@ -1180,20 +1116,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<double,emp::data::Histogram>& SymWorld::GetWithinHostMeanDataNode() {
     if (!data_node_within_host_mean) {
       data_node_within_host_mean.New();
-      OnUpdate([this](size_t) {
-        data_node_within_host_mean->Reset();
-        for (size_t i = 0; i< pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost() && pop[i]->HasSym()) {
-	          emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-	          size_t sym_size = syms.size();
-	          emp::vector<double> int_vals(sym_size);
-            for (size_t j=0; j< sym_size; j++) {
-	            int_vals[j] = syms[j]->GetIntVal();
-	          }//close for
-            data_node_within_host_mean->AddDatum(emp::Mean(int_vals));
-	        }//close if
-	      }//close for
-      });
+      SetupDataNodeCollection();
     }
     return *data_node_within_host_mean;
   }
@@ -1211,18 +1134,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<size_t>& SymWorld::GetHostReproCountDataNode() {
     if (!data_node_host_repro_count) {
       data_node_host_repro_count.New();
-      OnUpdate([this](size_t) {
-        data_node_host_repro_count->Reset();
-        data_node_sym_repro_count->Reset();
-        for (size_t i = 0; i < pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost()) {
-            data_node_host_repro_count->AddDatum(pop[i]->GetReproCount());
-            for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) {
-              data_node_sym_repro_count->AddDatum(sym->GetReproCount());
-            }
-          }
-        }
-      });
+      SetupDataNodeCollection();
     }
     return *data_node_host_repro_count;
   }
@@ -1240,6 +1152,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<size_t>& SymWorld::GetSymReproCountDataNode() {
     if (!data_node_sym_repro_count) {
       data_node_sym_repro_count.New();
+      SetupDataNodeCollection();
     }
     return *data_node_sym_repro_count;
   }
@@ -1257,23 +1170,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<double>& SymWorld::GetHostTowardsPartnerRateDataNode() {
     if (!data_node_host_towards_partner_rate) {
       data_node_host_towards_partner_rate.New();
-      OnUpdate([this](size_t) {
-        data_node_host_towards_partner_rate->Reset();
-        data_node_host_from_partner_rate->Reset();
-        data_node_sym_towards_partner_rate->Reset();
-        data_node_sym_from_partner_rate->Reset();
-
-        for (size_t i = 0; i < pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost()) {
-            data_node_host_towards_partner_rate->AddDatum((double)pop[i]->GetTowardsPartnerCount() / (double)pop[i]->GetReproCount());
-            data_node_host_from_partner_rate->AddDatum((double)pop[i]->GetFromPartnerCount() / (double)pop[i]->GetReproCount());
-            for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) {
-              data_node_sym_towards_partner_rate->AddDatum((double)sym->GetTowardsPartnerCount() / (double)sym->GetReproCount());
-              data_node_sym_from_partner_rate->AddDatum((double)sym->GetFromPartnerCount() / (double)sym->GetReproCount());
-            }
-          }
-        }
-        });
+      SetupDataNodeCollection();
     }
     return *data_node_host_towards_partner_rate;
   }
@@ -1291,6 +1188,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<double>& SymWorld::GetHostFromPartnerRateDataNode() {
     if (!data_node_host_from_partner_rate) {
       data_node_host_from_partner_rate.New();
+      SetupDataNodeCollection();
     }
     return *data_node_host_from_partner_rate;
   }
@@ -1307,6 +1205,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<double>& SymWorld::GetSymTowardsPartnerRateDataNode() {
     if (!data_node_sym_towards_partner_rate) {
       data_node_sym_towards_partner_rate.New();
+      SetupDataNodeCollection();
     }
     return *data_node_sym_towards_partner_rate;
   }
@@ -1323,6 +1222,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<double>& SymWorld::GetSymFromPartnerRateDataNode() {
     if (!data_node_sym_from_partner_rate) {
       data_node_sym_from_partner_rate.New();
+      SetupDataNodeCollection();
     }
     return *data_node_sym_from_partner_rate;
   }
@@ -1339,28 +1239,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<int>& SymWorld::GetHostTagRichness() {
     if (!data_node_host_tag_richness) {
       data_node_host_tag_richness.New();
-      OnUpdate([this](size_t) {
-        emp::vector<emp::BitSet<TAG_LENGTH>> host_tags;
-        emp::vector<emp::BitSet<TAG_LENGTH>> symbiont_tags;
-        data_node_host_tag_richness->Reset();
-        data_node_host_tag_shannon->Reset();
-        data_node_symbiont_tag_richness->Reset();
-        data_node_symbiont_tag_shannon->Reset();
-
-        for (size_t i = 0; i < pop.size(); i++) {
-          if (IsOccupied(i) && pop[i]->IsHost()) {
-            host_tags.push_back(pop[i]->GetTag());
-            for (emp::Ptr<Organism> sym : pop[i]->GetSymbionts()) {
-              symbiont_tags.push_back(sym->GetTag());
-            }
-          }
-        }
-
-        data_node_host_tag_richness->AddDatum(emp::UniqueCount(host_tags));
-        data_node_host_tag_shannon->AddDatum(emp::ShannonEntropy(host_tags));
-        data_node_symbiont_tag_richness->AddDatum(emp::UniqueCount(symbiont_tags));
-        data_node_symbiont_tag_shannon->AddDatum(emp::ShannonEntropy(symbiont_tags));
-        });
+      SetupDataNodeCollection();
     }
     return *data_node_host_tag_richness;
   }
@@ -1377,6 +1256,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<double>& SymWorld::GetHostTagShannonDiversity() {
     if (!data_node_host_tag_shannon) {
       data_node_host_tag_shannon.New();
+      SetupDataNodeCollection();
     }
     return *data_node_host_tag_shannon;
   }
@@ -1393,6 +1273,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<int>& SymWorld::GetSymbiontTagRichness() {
     if (!data_node_symbiont_tag_richness) {
       data_node_symbiont_tag_richness.New();
+      SetupDataNodeCollection();
     }
     return *data_node_symbiont_tag_richness;
   }
@@ -1409,6 +1290,7 @@ emp::DataMonitor<double>& SymWorld::GetHostTagPermissiveness() {
   emp::DataMonitor<double>& SymWorld::GetSymbiontTagShannonDiversity() {
     if (!data_node_symbiont_tag_shannon) {
       data_node_symbiont_tag_shannon.New();
+      SetupDataNodeCollection();
     }
     return *data_node_symbiont_tag_shannon;
   }
@@ -5,9 +5,13 @@
 #include "../../Empirical/include/emp/tools/string_utils.hpp"
 #include <iomanip> // setprecision
 #include <sstream> // stringstream
+#include <span>
 #include <string>
+#include <typeinfo>
 #include "../Organism.h"
 #include "SymWorld.h"
+#include "Symbiont.h"
+#include "ResourceKernel.h"
 
 class Host: public Organism {
 
@@ -697,6 +701,21 @@ public:
   }
 
 
+  /**
+   * Input: The pointer to the organism that is to be added to the host's symbionts.
+   *
+   * Output: None
+   *
+   * Purpose: To place a symbiont into a host directly, without the checks and
+   * side effects of AddSymbiont (e.g., when restoring a saved population).
+   */
+  void PlaceSymbiont(emp::Ptr<Organism> _in) {
+    syms.push_back(_in);
+    _in->SetHost(this);
+    _in->SetLocation(emp::WorldPosition(syms.size(), location.GetIndex()));
+  }
+
+
   /**
    * Input: None
    *
@@ -834,31 +853,69 @@ public:
    * is split into equal chunks for each symbiont
    */
   void DistribResources(double resources) {
-    double hostIntVal = interaction_val; //using private variable because we can
-    //do ectosymbiosis if the config setting is on, there is a parallel sym
-
     //In the event that the host has no symbionts, the host gets all resources not allocated to defense or
     // given to absent partner.
     if (syms.empty()) {
-      if (hostIntVal >= 0) {
-        double spent = resources * hostIntVal;
-        this->AddPoints(resources - spent);
-      }
-      else {
-        double hostDefense = -1.0 * hostIntVal * resources;
-        this->AddPoints(resources - hostDefense);
-      }
+      this->AddPoints(resource_kernel::KeepResources(interaction_val, resources));
       return; //This concludes resource distribution for a host without symbionts
     }
 
     size_t num_sym = syms.size();
     double sym_piece = (double) resources / num_sym;
 
+    if (AreDefaultSymbionts(syms)) {
+      DistribResToDefaultSyms({syms.data(), syms.size()}, sym_piece);
+      return;
+    }
     for(size_t i=0; i < syms.size(); i++) {
       DistribResToSym(syms[i], sym_piece);
     }
   } //end DistribResources
 
+  /**
+   * Input: A list of symbionts.
+   *
+   * Output: Whether every symbiont is a plain (default mode) Symbiont.
+   *
+   * Purpose: To check whether the symbionts can take the batch resource
+   * distribution path. Subclasses may change how symbionts process resources
+   * or gain points (e.g., Phage or EfficientSymbiont), so they can't.
+   */
+  static bool AreDefaultSymbionts(const emp::vector<emp::Ptr<Organism>>& sym_list) {
+    for (emp::Ptr<Organism> sym : sym_list) {
+      if (typeid(*sym) != typeid(Symbiont)) return false;
+    }
+    return true;
+  }
+
+  /**
+   * Input: The plain Symbionts to whom resources are distributed and the resources each might recieve.
+   *
+   * Output: None
+   *
+   * Purpose: To distribute resources between the host and each symbiont, exactly as
+   * DistribResToSym does, but with the batch kernel (see ResourceKernel.h) and
+   * without virtual calls for each symbiont.
+   */
+  void DistribResToDefaultSyms(std::span<const emp::Ptr<Organism>> sym_list, double sym_piece) {
+    thread_local emp::vector<double> sym_int_vals;
+    thread_local emp::vector<double> sym_gains;
+    thread_local emp::vector<double> host_gains;
+    const size_t num_syms = sym_list.size();
+    sym_int_vals.resize(num_syms);
+    sym_gains.resize(num_syms);
+    host_gains.resize(num_syms);
+    for (size_t i = 0; i < num_syms; i++) {
+      sym_int_vals[i] = static_cast<Symbiont&>(*sym_list[i]).Symbiont::GetIntVal();
+    }
+    resource_kernel::DistribToSyms(interaction_val, sym_piece, my_config->SYNERGY(),
+      sym_int_vals.data(), num_syms, sym_gains.data(), host_gains.data());
+    for (size_t i = 0; i < num_syms; i++) {
+      static_cast<Symbiont&>(*sym_list[i]).Symbiont::AddPoints(sym_gains[i]);
+      this->AddPoints(host_gains[i]);
+    }
+  }
+
   /**
    * Input: The total resources received by the host and its location in the world.
    *
@@ -901,6 +958,10 @@ public:
    * Purpose: To distribute resources between sym and host depending on their interaction values.
    */
   void DistribResToSym(emp::Ptr<Organism> sym, double sym_piece) {
+    if (typeid(*sym) == typeid(Symbiont)) {
+      DistribResToDefaultSyms({&sym, 1}, sym_piece);
+      return;
+    }
     double host_int_val = interaction_val;
     double host_donation = 0;
     if (host_int_val < 0) {
@@ -978,6 +1039,71 @@ public:
     } //if org has syms
     GrowOlder();
   }
+
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the host's state, including its symbionts and in-progress
+   * reproductive symbionts, into a checkpoint.
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const override {
+    writer.Write(interaction_val);
+    writer.Write(age);
+    writer.Write<uint64_t>(reproductions);
+    writer.Write<uint64_t>(towards_partner_count);
+    writer.Write<uint64_t>(from_partner_count);
+    writer.Write(tag_permissiveness);
+    writer.Write(points);
+    writer.Write(res_in_process);
+    writer.Write(dead);
+    writer.WriteBits(tag);
+    writer.Write<uint64_t>(syms.size());
+    for (emp::Ptr<Organism> sym : syms) {
+      sym->SaveCheckpoint(writer);
+    }
+    writer.Write<uint64_t>(repro_syms.size());
+    for (emp::Ptr<Organism> repro_sym : repro_syms) {
+      repro_sym->SaveCheckpoint(writer);
+    }
+  }
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the host's state from a checkpoint. Symbionts are
+   * created by the world (so they have the right type for the world's mode)
+   * and placed directly, without the checks and side effects of AddSymbiont.
+   * With PHYLOGENY on, the world gives the host and its symbionts their
+   * taxa once the checkpoint's systematics are restored.
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) override {
+    interaction_val = reader.Read<double>();
+    age = reader.Read<int>();
+    reproductions = reader.Read<uint64_t>();
+    towards_partner_count = reader.Read<uint64_t>();
+    from_partner_count = reader.Read<uint64_t>();
+    tag_permissiveness = reader.Read<double>();
+    points = reader.Read<double>();
+    res_in_process = reader.Read<double>();
+    dead = reader.Read<bool>();
+    reader.ReadBits(tag);
+    const size_t num_syms = reader.Read<uint64_t>();
+    for (size_t i = 0; i < num_syms && reader.IsOK(); i++) {
+      emp::Ptr<Organism> sym = my_world->MakeCheckpointSymbiont();
+      sym->LoadCheckpoint(reader);
+      PlaceSymbiont(sym);
+    }
+    const size_t num_repro_syms = reader.Read<uint64_t>();
+    for (size_t i = 0; i < num_repro_syms && reader.IsOK(); i++) {
+      emp::Ptr<Organism> repro_sym = my_world->MakeCheckpointSymbiont();
+      repro_sym->LoadCheckpoint(reader);
+      repro_syms.push_back(repro_sym);
+    }
+  }
 }; //Host
 
 #endif
@@ -0,0 +1,116 @@
+#pragma once
+
+/*
+  This file contains the OccupancyIndex class, which tracks which positions of
+  a world are occupied so that sparse worlds can be scanned without visiting
+  every empty cell.
+
+  The class is designed with the following trade-offs:
+  - Positions are stored as one bit each, so marking a position occupied or
+    empty is O(1), and iterating costs one popcount-sized step per 64
+    positions plus one step per occupied position
+  - Iteration always visits positions in increasing order, so replacing a
+    full scan with ForEach visits organisms in the same order (and thus keeps
+    data files and random draws unchanged)
+*/
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+class OccupancyIndex {
+protected:
+  static constexpr size_t WORD_BITS = 64;
+
+  emp::vector<uint64_t> words;
+  size_t count = 0;
+
+  static size_t NumWords(size_t num_positions) {
+    return (num_positions + WORD_BITS - 1) / WORD_BITS;
+  }
+
+public:
+  OccupancyIndex() = default;
+
+  /**
+   * Input: The number of positions in the world.
+   *
+   * Output: None
+   *
+   * Purpose: To resize the index. Positions past the new size are no longer
+   * occupied.
+   */
+  void Resize(size_t num_positions) {
+    for (size_t pos = num_positions; pos < words.size() * WORD_BITS; ++pos) Set(pos, false);
+    words.resize(NumWords(num_positions), 0);
+  }
+
+  /**
+   * Input: A world position and whether it is occupied.
+   *
+   * Output: None
+   *
+   * Purpose: To mark a position occupied or empty. The index grows as needed.
+   */
+  void Set(size_t pos, bool is_occupied) {
+    const size_t word = pos / WORD_BITS;
+    if (word >= words.size()) {
+      if (!is_occupied) return;
+      words.resize(word + 1, 0);
+    }
+    const uint64_t mask = uint64_t{1} << (pos % WORD_BITS);
+    if (is_occupied == ((words[word] & mask) != 0)) return;
+    words[word] ^= mask;
+    if (is_occupied) ++count;
+    else --count;
+  }
+
+  bool Has(size_t pos) const {
+    const size_t word = pos / WORD_BITS;
+    return word < words.size() && (words[word] >> (pos % WORD_BITS)) & 1;
+  }
+  size_t GetCount() const { return count; }
+  bool IsEmpty() const { return count == 0; }
+
+  void Clear() {
+    std::fill(words.begin(), words.end(), 0);
+    count = 0;
+  }
+
+  /**
+   * Input: A function taking a position.
+   *
+   * Output: None
+   *
+   * Purpose: To call the function on every occupied position, in increasing
+   * order. The function may empty the position it is given, but must not mark
+   * other positions occupied.
+   */
+  template<typename FUN_T>
+  void ForEach(FUN_T&& fun) const {
+    for (size_t word = 0; word < words.size(); ++word) {
+      uint64_t bits = words[word];
+      while (bits) {
+        fun(word * WORD_BITS + std::countr_zero(bits));
+        bits &= bits - 1;
+      }
+    }
+  }
+
+  /**
+   * Input: The buffer to fill.
+   *
+   * Output: None
+   *
+   * Purpose: To list the occupied positions in increasing order.
+   */
+  void GetPositions(emp::vector<size_t>& out) const {
+    out.clear();
+    out.reserve(count);
+    ForEach([&out](size_t pos) { out.push_back(pos); });
+  }
+};
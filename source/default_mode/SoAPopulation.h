@@ -0,0 +1,513 @@
+#ifndef SOA_POPULATION_H
+#define SOA_POPULATION_H
+
+#include "SymWorld.h"
+#include "Host.h"
+#include "Symbiont.h"
+#include "OccupancyIndex.h"
+#include "ResourceKernel.h"
+#include "UpdateSchedule.h"
+#include "../Checkpoint.h"
+#include "../spatial_utils.h"
+
+#include "../../Empirical/include/emp/base/vector.hpp"
+#include "../../Empirical/include/emp/math/Random.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <typeinfo>
+
+/**
+ * Structure-of-arrays (SoA) population store for default-mode hosts and their
+ * endosymbionts (POPULATION_STORE soa).
+ *
+ * Instead of one heap-allocated Host/Symbiont object per organism, organism
+ * state is kept in contiguous arrays, indexed by world position for hosts and
+ * by symbiont slot for symbionts. Each host owns a fixed range of SYM_LIMIT
+ * symbiont slots: host i's symbionts are in slots
+ * [i * SYM_LIMIT, i * SYM_LIMIT + host_sym_count[i]), so a symbiont's host is
+ * slot / SYM_LIMIT.
+ *
+ * Update() mirrors SymWorld::Update(), Host::Process() and Symbiont::Process()
+ * step for step. It draws from the world's random number generator in the
+ * same order and records the world's transmission data nodes, so a
+ * population loaded from a world follows the same trajectory and writes the
+ * same data files as the world would (for configurations accepted by
+ * SupportsConfig). The world's organisms are rebuilt from the arrays
+ * (StoreToWorld) only on updates whose population data nodes are collected or
+ * that are checkpointed.
+ */
+class SoAPopulation {
+protected:
+  SymWorld& world;
+  SymConfigBase& config;
+  emp::Random& random;
+
+  size_t world_size = 0;
+  size_t sym_limit = 0; // Number of symbiont slots per host
+  UpdateSchedule schedule;
+
+  // --- Host arrays (indexed by world position) ---
+  OccupancyIndex hosts;
+  emp::vector<double> host_int_val;
+  emp::vector<double> host_points;
+  emp::vector<int> host_age;
+  emp::vector<size_t> host_repro_count;
+  emp::vector<size_t> host_sym_count;
+
+  // --- Symbiont arrays (indexed by symbiont slot) ---
+  emp::vector<double> sym_int_val;
+  emp::vector<double> sym_points;
+  emp::vector<int> sym_age;
+  emp::vector<double> sym_infection_chance;
+  emp::vector<size_t> sym_repro_count;
+
+  // Scratch space for resource distribution
+  emp::vector<double> sym_gains;
+  emp::vector<double> host_gains;
+
+  size_t GetSlotID(size_t host_id, size_t sym_i) const {
+    emp_assert(sym_i <= sym_limit); // sym_i == sym_limit is one past host's last slot
+    return (host_id * sym_limit) + sym_i;
+  }
+
+  // A newborn host's symbionts are gathered in an extra range of slots past
+  // the end of the world (the "nursery"), and moved once its position is known
+  size_t GetNurseryID() const { return world_size; }
+
+  void ResizeArrays() {
+    hosts.Clear();
+    hosts.Resize(world_size);
+    host_int_val.assign(world_size, 0.0);
+    host_points.assign(world_size, 0.0);
+    host_age.assign(world_size, 0);
+    host_repro_count.assign(world_size, 0);
+    host_sym_count.assign(world_size + 1, 0);
+    const size_t num_slots = (world_size + 1) * sym_limit;
+    sym_int_val.assign(num_slots, 0.0);
+    sym_points.assign(num_slots, 0.0);
+    sym_age.assign(num_slots, 0);
+    sym_infection_chance.assign(num_slots, 0.0);
+    sym_repro_count.assign(num_slots, 0);
+  }
+
+  void ClearHost(size_t host_id) {
+    hosts.Set(host_id, false);
+    host_sym_count[host_id] = 0;
+  }
+
+  void CopySym(size_t to_slot, size_t from_slot) {
+    sym_int_val[to_slot] = sym_int_val[from_slot];
+    sym_points[to_slot] = sym_points[from_slot];
+    sym_age[to_slot] = sym_age[from_slot];
+    sym_infection_chance[to_slot] = sym_infection_chance[from_slot];
+    sym_repro_count[to_slot] = sym_repro_count[from_slot];
+  }
+
+  // Mirrors Host::SymAllowedIn
+  bool SymAllowedIn(size_t num_syms) {
+    if (!config.PHAGE_EXCLUDE()) return true;
+    return random.GetUInt((int)pow(2.0, num_syms)) == 0;
+  }
+
+  // Mirrors Host::AddSymbiont (without ousting) for a newborn symbiont.
+  // Returns whether the symbiont was added.
+  bool AddSym(size_t host_id, double int_val, double infection_chance, size_t repro_count) {
+    const bool allowed_in = SymAllowedIn(host_sym_count[host_id]);
+    if (host_sym_count[host_id] >= sym_limit || !allowed_in) return false;
+    const size_t slot = GetSlotID(host_id, host_sym_count[host_id]);
+    sym_int_val[slot] = int_val;
+    sym_points[slot] = 0.0;
+    sym_age[slot] = 0;
+    sym_infection_chance[slot] = infection_chance;
+    sym_repro_count[slot] = repro_count;
+    ++host_sym_count[host_id];
+    return true;
+  }
+
+  // Remove symbiont from host's slots, keeping the remaining symbionts in order.
+  void RemoveSym(size_t host_id, size_t sym_i) {
+    emp_assert(sym_i < host_sym_count[host_id]);
+    const size_t end = GetSlotID(host_id, host_sym_count[host_id]);
+    for (size_t slot = GetSlotID(host_id, sym_i); slot + 1 < end; ++slot) {
+      CopySym(slot, slot + 1);
+    }
+    --host_sym_count[host_id];
+  }
+
+  // Mirrors Host::Mutate and Symbiont::Mutate for interaction values.
+  double MutateIntVal(double int_val, double mutation_rate, double mutation_size) {
+    if (random.GetDouble(0.0, 1.0) <= mutation_rate) {
+      int_val += random.GetNormal(0.0, mutation_size);
+      if (int_val < -1) int_val = -1;
+      else if (int_val > 1) int_val = 1;
+    }
+    return int_val;
+  }
+
+  // Mirrors Symbiont::Reproduce (MakeNew and Mutate); returns the offspring's interaction value.
+  double ReproduceSym(size_t slot) {
+    // The Symbiont constructor draws a random infection chance before it is
+    // overwritten with the parent's
+    if (config.SYM_INFECTION_CHANCE() == -2) random.GetDouble(0, 1);
+    return MutateIntVal(sym_int_val[slot], config.MUTATION_RATE(), config.MUTATION_SIZE());
+  }
+
+  // Mirrors SymWorld::GetNeighborHost
+  int FindNeighborHost(size_t host_id) {
+    for (size_t i = 0; i < 3; i++) {
+      emp::WorldPosition neighbor = world.GetRandomNeighborPos(emp::WorldPosition(host_id));
+      if (neighbor.IsValid() && hosts.Has(neighbor.GetIndex())) {
+        return neighbor.GetIndex();
+      }
+    }
+    // Mirrors SymWorld::GetValidNeighborOrgIDs
+    emp::vector<size_t> valid_neighbors;
+    switch (world.GetSpatialStructureMode()) {
+      case SymWorld::SPATIAL_STRUCT_MODE::WELL_MIXED:
+        hosts.ForEach([&](size_t neighbor_id) {
+          if (neighbor_id != host_id) valid_neighbors.emplace_back(neighbor_id);
+        });
+        break;
+      case SymWorld::SPATIAL_STRUCT_MODE::GRID:
+        for (spatial_utils::GRID_DIR dir : spatial_utils::grid_directions) {
+          const size_t neighbor_id = spatial_utils::GetGridNeighbor(
+            host_id,
+            dir,
+            config.WORLD_WIDTH(),
+            config.WORLD_HEIGHT()
+          );
+          if (hosts.Has(neighbor_id)) valid_neighbors.emplace_back(neighbor_id);
+        }
+        break;
+      case SymWorld::SPATIAL_STRUCT_MODE::LOAD:
+        for (size_t neighbor_id : world.GetSpatialStructure().GetNeighbors(host_id)) {
+          if (hosts.Has(neighbor_id)) valid_neighbors.emplace_back(neighbor_id);
+        }
+        break;
+    }
+    if (valid_neighbors.empty()) return -1;
+    return valid_neighbors[random.GetUInt(0, valid_neighbors.size())];
+  }
+
+  // Mirrors the world's (asynchronous) birth position function
+  emp::WorldPosition FindBirthPos(size_t parent_id) {
+    if (world.IsWellMixedPopStruct()) {
+      return emp::WorldPosition(world.GetRandomCellID());
+    }
+    return world.GetRandomNeighborPos(emp::WorldPosition(parent_id));
+  }
+
+  // Mirrors Host::DistribResources (a host's symbionts' slots are contiguous,
+  // so the batch kernel reads and writes them in place)
+  void DistribResources(size_t host_id, double resources) {
+    const size_t num_syms = host_sym_count[host_id];
+    if (num_syms == 0) {
+      host_points[host_id] += resource_kernel::KeepResources(host_int_val[host_id], resources);
+      return;
+    }
+    const double sym_piece = resources / num_syms;
+    const size_t begin = GetSlotID(host_id, 0);
+    sym_gains.resize(num_syms);
+    host_gains.resize(num_syms);
+    resource_kernel::DistribToSyms(host_int_val[host_id], sym_piece, config.SYNERGY(),
+      &sym_int_val[begin], num_syms, sym_gains.data(), host_gains.data());
+    for (size_t i = 0; i < num_syms; ++i) {
+      sym_points[begin + i] += sym_gains[i];
+      host_points[host_id] += host_gains[i];
+    }
+  }
+
+  // Mirrors Host::Reproduce, Symbiont::VerticalTransmission and SymWorld::DoBirth
+  void HostReproduce(size_t host_id) {
+    double host_mutation_size = config.HOST_MUTATION_SIZE();
+    if (host_mutation_size == -1) host_mutation_size = config.MUTATION_SIZE();
+    double host_mutation_rate = config.HOST_MUTATION_RATE();
+    if (host_mutation_rate == -1) host_mutation_rate = config.MUTATION_RATE();
+    const double baby_int_val = MutateIntVal(host_int_val[host_id], host_mutation_rate, host_mutation_size);
+    host_points[host_id] = 0;
+
+    const size_t baby_id = GetNurseryID();
+    host_sym_count[baby_id] = 0;
+    const size_t begin = GetSlotID(host_id, 0);
+    for (size_t slot = begin; slot < begin + host_sym_count[host_id]; ++slot) {
+      if (!world.WillTransmit()) continue;
+      world.GetVerticalTransmissionAttemptCount().AddDatum(sym_int_val[slot]);
+      if (sym_points[slot] >= config.SYM_VERT_TRANS_RES()) {
+        const double sym_baby_int_val = ReproduceSym(slot);
+        sym_points[slot] -= config.SYM_VERT_TRANS_RES();
+        AddSym(baby_id, sym_baby_int_val, sym_infection_chance[slot], sym_repro_count[slot] + 1);
+        world.GetVerticalTransmissionSuccessCount().AddDatum(sym_int_val[slot]);
+      }
+    }
+
+    const emp::WorldPosition birth_pos = FindBirthPos(host_id);
+    if (!birth_pos.IsValid() || birth_pos.GetIndex() == host_id) return;
+    const size_t birth_id = birth_pos.GetIndex();
+    // Offspring replaces anything already at its position
+    hosts.Set(birth_id, true);
+    host_int_val[birth_id] = baby_int_val;
+    host_points[birth_id] = 0;
+    host_age[birth_id] = 0;
+    host_repro_count[birth_id] = host_repro_count[host_id] + 1;
+    host_sym_count[birth_id] = host_sym_count[baby_id];
+    for (size_t sym_i = 0; sym_i < host_sym_count[baby_id]; ++sym_i) {
+      CopySym(GetSlotID(birth_id, sym_i), GetSlotID(baby_id, sym_i));
+    }
+  }
+
+  // Mirrors Symbiont::IndependentReproduction and SymWorld::SymDoBirth for a
+  // hosted symbiont
+  void HorizontalTransmission(size_t host_id, size_t slot) {
+    if (!config.HORIZ_TRANS() || sym_points[slot] < config.SYM_HORIZ_TRANS_RES()) return;
+    world.RecordHorizontalTransmissionAttempt(sym_int_val[slot]);
+    if (!config.FREE_HT_FAILURE()) sym_points[slot] = 0;
+
+    const double sym_baby_int_val = ReproduceSym(slot);
+    const int new_host_id = FindNeighborHost(host_id);
+    if (new_host_id < 0) return;
+    if (host_sym_count[new_host_id] >= sym_limit) {
+      world.GetHorizontalTransmissionSizeFailCount().AddDatum(sym_int_val[slot]);
+      return;
+    }
+    if (!AddSym(new_host_id, sym_baby_int_val, sym_infection_chance[slot], sym_repro_count[slot] + 1)) return;
+    if (config.FREE_HT_FAILURE()) sym_points[slot] = 0;
+    world.GetHorizontalTransmissionSuccessCount().AddDatum(sym_int_val[slot]);
+  }
+
+  // Mirrors Symbiont::Process for an endosymbiont. Returns whether the symbiont died.
+  bool ProcessSym(size_t host_id, size_t sym_i) {
+    const size_t slot = GetSlotID(host_id, sym_i);
+    HorizontalTransmission(host_id, slot);
+    // Symbiont::GrowOlder
+    sym_age[slot] += 1;
+    const bool is_dead = sym_age[slot] > config.SYM_AGE_MAX() && config.SYM_AGE_MAX() > 0;
+    if (config.SYM_WITHIN_LIFETIME_MUTATION_RATE()) {
+      if (random.P(config.SYM_WITHIN_LIFETIME_MUTATION_RATE())) {
+        sym_int_val[slot] = MutateIntVal(sym_int_val[slot], config.MUTATION_RATE(), config.MUTATION_SIZE());
+      }
+    }
+    return is_dead;
+  }
+
+  // Mirrors Host::Process. Returns whether the host died.
+  bool ProcessHost(size_t host_id) {
+    const double world_resources = world.PullResources(config.RES_DISTRIBUTE());
+    if (world_resources > 0) DistribResources(host_id, world_resources);
+
+    if (host_points[host_id] >= config.HOST_REPRO_RES()) {
+      HostReproduce(host_id);
+    }
+
+    // NOTE - Mirrors Host::Process, where the symbiont after a removed symbiont
+    //        is not processed this update.
+    for (size_t sym_i = 0; sym_i < host_sym_count[host_id]; ++sym_i) {
+      if (ProcessSym(host_id, sym_i)) {
+        RemoveSym(host_id, sym_i);
+      }
+    }
+
+    // Host::GrowOlder
+    host_age[host_id] += 1;
+    return host_age[host_id] > config.HOST_AGE_MAX() && config.HOST_AGE_MAX() > 0;
+  }
+
+public:
+  SoAPopulation(SymWorld& _world) :
+    world(_world),
+    config(*_world.GetConfig()),
+    random(_world.GetRandom())
+  { }
+
+  /**
+   * Input: The configuration to check.
+   *
+   * Output: Whether the SoA population can run worlds with this configuration.
+   *
+   * Purpose: The SoA population only models default-mode hosts with
+   * endosymbionts. Features that need per-organism objects (phylogenies, tags,
+   * free-living symbionts, ectosymbiosis and ousting) must use the world's
+   * own update.
+   */
+  static bool SupportsConfig(SymConfigBase& cfg) {
+    return !cfg.PHYLOGENY() &&
+      !cfg.TAG_MATCHING() &&
+      !cfg.FREE_LIVING_SYMS() &&
+      !cfg.ECTOSYMBIOSIS() &&
+      !cfg.OUSTING();
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To copy the world's current population into the SoA arrays.
+   */
+  void LoadFromWorld() {
+    emp_assert(SupportsConfig(config));
+    world_size = world.GetSize();
+    sym_limit = (config.SYM_LIMIT() > 0) ? (size_t)config.SYM_LIMIT() : 0;
+    schedule.SetMode(world.GetUpdateSchedule().GetMode());
+    schedule.SetBlockSize(world.GetUpdateSchedule().GetBlockSize());
+    ResizeArrays();
+    for (size_t host_id = 0; host_id < world_size; ++host_id) {
+      if (!world.IsOccupied(host_id)) continue;
+      Organism& host = world.GetOrg(host_id);
+      emp_assert(typeid(host) == typeid(Host) && host.GetReproSymbionts().empty());
+      hosts.Set(host_id, true);
+      host_int_val[host_id] = host.GetIntVal();
+      host_points[host_id] = host.GetPoints();
+      host_age[host_id] = host.GetAge();
+      host_repro_count[host_id] = host.GetReproCount();
+      emp::vector<emp::Ptr<Organism>>& syms = host.GetSymbionts();
+      emp_assert(syms.size() <= sym_limit);
+      for (size_t sym_i = 0; sym_i < syms.size() && sym_i < sym_limit; ++sym_i) {
+        emp_assert(typeid(*syms[sym_i]) == typeid(Symbiont));
+        const size_t slot = GetSlotID(host_id, sym_i);
+        sym_int_val[slot] = syms[sym_i]->GetIntVal();
+        sym_points[slot] = syms[sym_i]->GetPoints();
+        sym_age[slot] = syms[sym_i]->GetAge();
+        sym_infection_chance[slot] = syms[sym_i]->GetInfectionChance();
+        sym_repro_count[slot] = syms[sym_i]->GetReproCount();
+        ++host_sym_count[host_id];
+      }
+    }
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To replace the world's population with Host and Symbiont objects
+   * built from the SoA arrays (e.g., before the world's data nodes are
+   * collected). Doesn't change the state of the world's random number
+   * generator.
+   */
+  void StoreToWorld() {
+    emp_assert(world.GetSize() == world_size);
+    // NOTE - The Symbiont constructor draws from the rng if SYM_INFECTION_CHANCE is -2
+    const std::string random_state = checkpoint::SaveRandomState(random);
+    for (size_t host_id = 0; host_id < world_size; ++host_id) {
+      if (world.IsOccupied(host_id)) world.DoDeath(emp::WorldPosition(host_id));
+      if (!hosts.Has(host_id)) continue;
+      emp::Ptr<Host> host = emp::NewPtr<Host>(&random, &world, &config, host_int_val[host_id]);
+      host->SetPoints(host_points[host_id]);
+      host->SetAge(host_age[host_id]);
+      host->SetReproCount(host_repro_count[host_id]);
+      for (size_t sym_i = 0; sym_i < host_sym_count[host_id]; ++sym_i) {
+        const size_t slot = GetSlotID(host_id, sym_i);
+        emp::Ptr<Symbiont> sym = emp::NewPtr<Symbiont>(&random, &world, &config, sym_int_val[slot], sym_points[slot]);
+        sym->SetAge(sym_age[slot]);
+        sym->SetInfectionChance(sym_infection_chance[slot]);
+        sym->SetReproCount(sym_repro_count[slot]);
+        host->PlaceSymbiont(sym);
+      }
+      world.AddOrgAt(host, emp::WorldPosition(host_id));
+    }
+    checkpoint::RestoreRandomState(random, random_state);
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To process every host (and its symbionts) once, mirroring
+   * SymWorld::Update. The world's organisms are brought up to date first on
+   * updates whose data nodes are collected, and afterwards on updates that
+   * end with a periodic checkpoint.
+   */
+  void Update() {
+    if (world.CollectsDataNodesAt(world.GetUpdate())) StoreToWorld();
+    // Data files, data node collection and the update counter
+    world.emp::World<Organism>::Update();
+    world.DoResourceInflow();
+
+    for (size_t host_id : schedule.Build(random, world_size, &hosts)) {
+      if (!hosts.Has(host_id)) continue;
+      if (ProcessHost(host_id)) {
+        ClearHost(host_id);
+      }
+    }
+
+    if (world.IsPeriodicCheckpointUpdate()) {
+      StoreToWorld();
+      world.DoPeriodicCheckpoint();
+    }
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To remove every host's symbionts, mirroring SymWorld::CureHosts.
+   */
+  void CureHosts() {
+    hosts.ForEach([this](size_t host_id) { host_sym_count[host_id] = 0; });
+  }
+
+  size_t GetSize() const { return world_size; }
+  size_t GetSymLimit() const { return sym_limit; }
+
+  bool IsOccupied(size_t host_id) const { return hosts.Has(host_id); }
+  double GetHostIntVal(size_t host_id) const { return host_int_val[host_id]; }
+  double GetHostPoints(size_t host_id) const { return host_points[host_id]; }
+  int GetHostAge(size_t host_id) const { return host_age[host_id]; }
+  size_t GetHostReproCount(size_t host_id) const { return host_repro_count[host_id]; }
+  size_t GetSymCount(size_t host_id) const { return host_sym_count[host_id]; }
+  double GetSymIntVal(size_t host_id, size_t sym_i) const { return sym_int_val[GetSlotID(host_id, sym_i)]; }
+  double GetSymPoints(size_t host_id, size_t sym_i) const { return sym_points[GetSlotID(host_id, sym_i)]; }
+  int GetSymAge(size_t host_id, size_t sym_i) const { return sym_age[GetSlotID(host_id, sym_i)]; }
+  double GetSymInfectionChance(size_t host_id, size_t sym_i) const { return sym_infection_chance[GetSlotID(host_id, sym_i)]; }
+  size_t GetSymReproCount(size_t host_id, size_t sym_i) const { return sym_repro_count[GetSlotID(host_id, sym_i)]; }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of living hosts.
+   *
+   * Purpose: Same statistic as the world's host count data node.
+   */
+  size_t GetNumHosts() const { return hosts.GetCount(); }
+
+  /**
+   * Input: None
+   *
+   * Output: The number of endosymbionts.
+   *
+   * Purpose: Same statistic as the world's symbiont count data node (there are
+   * no free-living symbionts in the SoA population).
+   */
+  size_t GetNumSyms() const {
+    size_t num_syms = 0;
+    hosts.ForEach([&](size_t host_id) { num_syms += host_sym_count[host_id]; });
+    return num_syms;
+  }
+};
+
+/**
+ * Input: Whether to print the update numbers to standard output.
+ *
+ * Output: None
+ *
+ * Purpose: To run the experiment with the world's hosts and symbionts held in
+ * an SoAPopulation (POPULATION_STORE soa). Exits if the world isn't a
+ * default-mode world or its configuration isn't supported.
+ */
+void SymWorld::RunSoAExperiment(bool verbose) {
+  // Other modes' worlds have their own organisms and updates
+  if (typeid(*this) != typeid(SymWorld) || !SoAPopulation::SupportsConfig(*my_config)) {
+    std::cout << "POPULATION_STORE soa only supports default mode, without PHYLOGENY, TAG_MATCHING, FREE_LIVING_SYMS, ECTOSYMBIOSIS or OUSTING." << std::endl;
+    exit(-1);
+  }
+  SoAPopulation population(*this);
+  population.LoadFromWorld();
+  RunUpdates(population, verbose);
+  population.StoreToWorld();
+}
+
+#endif
@@ -8,8 +8,11 @@
   lab's chemical ecology model: https://github.com/emilydolson/chemical-ecology/blob/main/include/chemical-ecology/SpatialStructure.hpp
 
   The class is designed with the following trade-offs:
-  - Efficient random neighbor selection
-  - Efficient neighbor checking
+  - Efficient random neighbor selection (O(1))
+  - Efficient neighbor checking (O(log d) for a position with d neighbors)
+  - Memory proportional to the number of connections (compressed sparse row
+    storage, no dense matrix), so large custom topologies fit in memory
+  - Editing individual connections is O(number of connections)
 */
 
 #include "emp/base/vector.hpp"
@@ -21,60 +24,104 @@
 #include "emp/base/array.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
 #include <optional>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 class SpatialStructure {
+public:
+  using neighbors_t = std::span<const size_t>;
+
 protected:
 
   /**
-   * Purpose: Mapping of source positions ==> destination positions.
-   *          Destination IDs are kept in sorted order.
+   * Purpose: Connections stored in compressed sparse row (CSR) form. The
+   *          neighbors of position i are neighbor_ids[neighbor_offsets[i]]
+   *          through neighbor_ids[neighbor_offsets[i+1] - 1], in sorted order.
+   *          neighbor_offsets has one entry per position plus one.
    */
-  emp::vector< emp::vector<size_t> > ordered_connections;
+  emp::vector<size_t> neighbor_offsets = emp::vector<size_t>(1, 0);
+  emp::vector<size_t> neighbor_ids;
 
-  /**
-   * Purpose: Matrix specifying whether two positions are connected ([from][to]).
-   */
-  emp::vector< emp::vector<bool> > connection_matrix;
+  // Binary cache file header (see SaveStructureToBinary)
+  static constexpr uint64_t BINARY_MAGIC = 0x3153534d59535953; // "SYSYMSS1"
 
   /**
    * Input: None
    *
-   * Output: Boolean indicating whether ordered_connections and connection_matrix
-   *         are consistent with one another.
+   * Output: Boolean indicating whether the CSR arrays are well formed.
    *
-   * Purpose: Internal verification that ordered_connections and connection_matrix are
-   *          consistent. Used for internal asserts in debug mode.
+   * Purpose: Internal verification that offsets are non-decreasing, cover all
+   *          neighbor ids, and that each position's neighbors are sorted and
+   *          in range. Used for internal asserts in debug mode.
    */
   bool VerifyConnectionConsistency() const {
-    const size_t num_positions = connection_matrix.size();
-    // Check that ordered_connections has same number of positions as matrix
-    if (num_positions != ordered_connections.size()) {
+    if (neighbor_offsets.empty() || neighbor_offsets.front() != 0) {
+      return false;
+    }
+    if (neighbor_offsets.back() != neighbor_ids.size()) {
       return false;
     }
-    // Check consistency in connections across representations
+    const size_t num_positions = GetNumPositions();
+    // Offsets must be non-decreasing before rows can be viewed safely
     for (size_t from = 0; from < num_positions; ++from) {
-      emp_assert(connection_matrix[from].size() == num_positions);
-      for (size_t to = 0; to < num_positions; ++to) {
-        const bool connected = connection_matrix[from][to];
-        const auto& neighbors = ordered_connections[from];
-        emp_assert(std::is_sorted(neighbors.begin(), neighbors.end()));
-        const bool is_neighbor = std::binary_search(
-          neighbors.begin(),
-          neighbors.end(),
-          to
-        );
-        if (connected != is_neighbor) {
-          return false;
-        }
+      if (neighbor_offsets[from] > neighbor_offsets[from + 1]) {
+        return false;
+      }
+    }
+    for (size_t from = 0; from < num_positions; ++from) {
+      const neighbors_t neighbors = GetNeighbors(from);
+      if (!std::is_sorted(neighbors.begin(), neighbors.end())) {
+        return false;
+      }
+      if (!neighbors.empty() && neighbors.back() >= num_positions) {
+        return false;
       }
     }
     return true;
   }
 
+  /**
+   * Input: Number of positions and a list of (from, to) connections.
+   *
+   * Output: None
+   *
+   * Purpose: Build CSR arrays from an unordered edge list with a counting
+   *          pass, so no per-position vectors (or dense matrix) are needed.
+   */
+  void SetStructureFromEdges(
+    size_t num_positions,
+    const emp::vector<std::pair<size_t, size_t>>& edges
+  ) {
+    neighbor_offsets.assign(num_positions + 1, 0);
+    for (const auto& [from, to] : edges) {
+      emp_assert(from < num_positions);
+      emp_assert(to < num_positions);
+      ++neighbor_offsets[from + 1];
+    }
+    for (size_t pos = 0; pos < num_positions; ++pos) {
+      neighbor_offsets[pos + 1] += neighbor_offsets[pos];
+    }
+    neighbor_ids.resize(edges.size());
+    emp::vector<size_t> fill_pos(neighbor_offsets.begin(), neighbor_offsets.end() - 1);
+    for (const auto& [from, to] : edges) {
+      neighbor_ids[fill_pos[from]++] = to;
+    }
+    for (size_t pos = 0; pos < num_positions; ++pos) {
+      std::sort(
+        neighbor_ids.begin() + neighbor_offsets[pos],
+        neighbor_ids.begin() + neighbor_offsets[pos + 1]
+      );
+    }
+    emp_assert(VerifyConnectionConsistency());
+  }
+
 public:
 
   /**
@@ -87,26 +134,17 @@ public:
    *          "to" positions
    */
   void SetStructure(const emp::vector<emp::vector<size_t>>& in_struct) {
-    // Configure ordered connections (copy over and sort connections)
     const size_t num_positions = in_struct.size();
-    ordered_connections = in_struct;
-    for (emp::vector<size_t>& neighbors : ordered_connections) {
+    neighbor_offsets.assign(num_positions + 1, 0);
+    neighbor_ids.clear();
+    for (size_t from = 0; from < num_positions; ++from) {
+      const auto& neighbors = in_struct[from];
+      neighbor_ids.insert(neighbor_ids.end(), neighbors.begin(), neighbors.end());
       std::sort(
-        neighbors.begin(),
-        neighbors.end()
+        neighbor_ids.begin() + neighbor_offsets[from],
+        neighbor_ids.end()
       );
-    }
-    // Configure connection matrix
-    connection_matrix.clear();
-    connection_matrix.resize(
-      num_positions,
-      emp::vector<bool>(num_positions, false)
-    );
-    for (size_t from = 0; from < num_positions; ++from) {
-      const auto& neighbors = ordered_connections[from];
-      for (size_t to : neighbors) {
-        connection_matrix[from][to] = true;
-      }
+      neighbor_offsets[from + 1] = neighbor_ids.size();
     }
     emp_assert(VerifyConnectionConsistency());
   }
@@ -122,23 +160,17 @@ public:
    *          (maps [from][to])
    */
   void SetStructure(const emp::vector<emp::vector<bool>>& in_struct) {
-    // Configure connection matrix (copy from parameter)
     const size_t num_positions = in_struct.size();
-    connection_matrix = in_struct;
-    // Configure ordered connections
-    ordered_connections.clear();
-    ordered_connections.resize(
-      num_positions,
-      emp::vector<size_t>(0)
-    );
+    neighbor_offsets.assign(num_positions + 1, 0);
+    neighbor_ids.clear();
     for (size_t from = 0; from < num_positions; ++from) {
-      emp_assert(connection_matrix.size() == num_positions, "Connection matrix must be square");
+      emp_assert(in_struct[from].size() == num_positions, "Connection matrix must be square");
       for (size_t to = 0; to < num_positions; ++to) {
-        const bool connected = connection_matrix[from][to];
-        if (connected) {
-          ordered_connections[from].emplace_back(to);
+        if (in_struct[from][to]) {
+          neighbor_ids.emplace_back(to);
         }
       }
+      neighbor_offsets[from + 1] = neighbor_ids.size();
     }
     emp_assert(VerifyConnectionConsistency());
   }
@@ -150,6 +182,8 @@ public:
    *
    * Purpose: Create a connection between positions, from ==> to. Note that this
    *          forms a (one-way) directed connection.
+   *          NOTE - Editing a CSR structure is O(number of connections), so
+   *          prefer SetStructure for building large structures.
    */
   void Connect(size_t from, size_t to) {
     // Check position validity
@@ -160,12 +194,12 @@ public:
       return;
     }
     // Otherwise, connect from to to.
-    connection_matrix[from][to] = true;
-    auto& neighbors = ordered_connections[from];
-    neighbors.insert(
-      std::upper_bound(neighbors.begin(), neighbors.end(), to),
-      to
-    );
+    auto row_begin = neighbor_ids.begin() + neighbor_offsets[from];
+    auto row_end = neighbor_ids.begin() + neighbor_offsets[from + 1];
+    neighbor_ids.insert(std::upper_bound(row_begin, row_end, to), to);
+    for (size_t pos = from + 1; pos < neighbor_offsets.size(); ++pos) {
+      ++neighbor_offsets[pos];
+    }
     emp_assert(VerifyConnectionConsistency());
   }
 
@@ -202,14 +236,14 @@ public:
       return;
     }
     // Otherwise, remove connection from => to
-    connection_matrix[from][to] = false;
-    auto& neighbors = ordered_connections[from];
-    auto to_remove = std::equal_range(
-      neighbors.begin(),
-      neighbors.end(),
-      to
-    );
-    neighbors.erase(to_remove.first, to_remove.second);
+    auto row_begin = neighbor_ids.begin() + neighbor_offsets[from];
+    auto row_end = neighbor_ids.begin() + neighbor_offsets[from + 1];
+    auto to_remove = std::equal_range(row_begin, row_end, to);
+    const size_t num_removed = (size_t)(to_remove.second - to_remove.first);
+    neighbor_ids.erase(to_remove.first, to_remove.second);
+    for (size_t pos = from + 1; pos < neighbor_offsets.size(); ++pos) {
+      neighbor_offsets[pos] -= num_removed;
+    }
     emp_assert(VerifyConnectionConsistency());
   }
 
@@ -234,9 +268,12 @@ public:
    * Output: Boolean indicating whether "from" is connected to "to".
    *
    * Purpose: Check whether "from" is connected to "to". Note that this is directional.
+   *          O(log d) in the number of neighbors of "from".
    */
   bool IsConnected(size_t from, size_t to) const {
-    return connection_matrix[from][to];
+    emp_assert(from < GetNumPositions());
+    const neighbors_t neighbors = GetNeighbors(from);
+    return std::binary_search(neighbors.begin(), neighbors.end(), to);
   }
 
   /**
@@ -247,7 +284,18 @@ public:
    * Purpose: Get the total number of positions in the spatial structure
    */
   size_t GetNumPositions() const {
-    return connection_matrix.size();
+    return neighbor_offsets.size() - 1;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: Unsigned integer indicating the number of (directed) connections.
+   *
+   * Purpose: Get the total number of connections in the spatial structure
+   */
+  size_t GetNumConnections() const {
+    return neighbor_ids.size();
   }
 
   /**
@@ -255,22 +303,50 @@ public:
    *
    * Output: Connection matrix as a vector of vector of booleans.
    *
-   * Purpose: Get the spatial structure in adjacency matrix form.
+   * Purpose: Get the spatial structure in adjacency matrix form. The matrix is
+   *          built on request (O(positions^2) memory), so avoid calling this
+   *          on large structures.
    */
-  const emp::vector<emp::vector<bool>>& GetConnectionMatrix() const {
-    return connection_matrix;
+  emp::vector<emp::vector<bool>> GetConnectionMatrix() const {
+    const size_t num_positions = GetNumPositions();
+    emp::vector<emp::vector<bool>> matrix(
+      num_positions,
+      emp::vector<bool>(num_positions, false)
+    );
+    for (size_t from = 0; from < num_positions; ++from) {
+      for (size_t to : GetNeighbors(from)) {
+        matrix[from][to] = true;
+      }
+    }
+    return matrix;
   }
 
   /**
    * Input: Position to get the neighbors for
    *
-   * Output: const reference to list of neighbors of given position (pos)
+   * Output: View of the (ordered) neighbors of given position (pos). The view
+   *         is invalidated by any change to the structure.
    *
    * Purpose: Get an ordered list of neighbors for given position
    */
-  const emp::vector<size_t>& GetNeighbors(size_t pos) const {
-    emp_assert(pos < ordered_connections.size());
-    return ordered_connections[pos];
+  neighbors_t GetNeighbors(size_t pos) const {
+    emp_assert(pos < GetNumPositions());
+    return neighbors_t(
+      neighbor_ids.data() + neighbor_offsets[pos],
+      neighbor_offsets[pos + 1] - neighbor_offsets[pos]
+    );
+  }
+
+  /**
+   * Input: Position to get the neighbors for
+   *
+   * Output: Copy of the (ordered) neighbors of given position (pos).
+   *
+   * Purpose: Get an ordered list of neighbors for given position as a vector
+   */
+  emp::vector<size_t> GetNeighborList(size_t pos) const {
+    const neighbors_t neighbors = GetNeighbors(pos);
+    return emp::vector<size_t>(neighbors.begin(), neighbors.end());
   }
 
   /**
@@ -283,7 +359,7 @@ public:
    */
   std::optional<size_t> GetRandomNeighbor(emp::Random& rnd, size_t pos) const {
     emp_assert(pos < GetNumPositions()) ;
-    const auto& neighbors = ordered_connections[pos];
+    const neighbors_t neighbors = GetNeighbors(pos);
     if (neighbors.empty()) {
       return std::nullopt;
     }
@@ -345,20 +421,20 @@ public:
     std::sort(node_names.begin(), node_names.end());
     // Create mapping from names to position
     std::unordered_map<std::string, size_t> name_to_position;
+    name_to_position.reserve(num_positions);
     for (size_t pos = 0; pos < num_positions; ++pos) {
       name_to_position[node_names[pos]] = pos;
     }
-    // Begin reading edges
-    emp::vector< emp::vector<size_t> > connections(
-      num_positions,
-      emp::vector<size_t>(0)
-    );
+    // Translate edges into positions
+    emp::vector< std::pair<size_t, size_t> > connections;
+    connections.reserve(edges.size());
     for (const auto& pair : edges) {
-      const size_t from = name_to_position[pair.first];
-      const size_t to = name_to_position[pair.second];
-      connections[from].emplace_back(to);
+      connections.emplace_back(
+        name_to_position[pair.first],
+        name_to_position[pair.second]
+      );
     }
-    SetStructure(connections);
+    SetStructureFromEdges(num_positions, connections);
   }
 
   /**
@@ -400,6 +476,98 @@ public:
     SetStructure(matrix);
   }
 
+  /**
+   * Input: Path to write the binary structure file to.
+   *
+   * Output: Boolean indicating whether the file was written.
+   *
+   * Purpose: Save the CSR arrays in a compact binary format (magic number,
+   *          number of positions, number of connections, offsets, neighbor
+   *          ids; all as little-endian 64-bit integers) that can be loaded
+   *          much faster than re-parsing a large edge CSV.
+   */
+  bool SaveStructureToBinary(const std::string& filepath) const {
+    std::ofstream out(filepath, std::ios::binary);
+    if (!out) return false;
+    auto write_u64 = [&out](uint64_t val) {
+      out.write(reinterpret_cast<const char*>(&val), sizeof(val));
+    };
+    write_u64(BINARY_MAGIC);
+    write_u64(GetNumPositions());
+    write_u64(GetNumConnections());
+    for (size_t offset : neighbor_offsets) write_u64(offset);
+    for (size_t neighbor : neighbor_ids) write_u64(neighbor);
+    return (bool)out;
+  }
+
+  /**
+   * Input: Path to a binary structure file written by SaveStructureToBinary.
+   *
+   * Output: Boolean indicating whether the structure was loaded. On failure,
+   *         the current structure is left unchanged.
+   *
+   * Purpose: Load spatial structure from a binary structure file.
+   */
+  bool LoadStructureFromBinary(const std::string& filepath) {
+    std::ifstream in(filepath, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    const uint64_t file_size = (uint64_t)in.tellg();
+    in.seekg(0);
+    auto read_u64 = [&in]() {
+      uint64_t val = 0;
+      in.read(reinterpret_cast<char*>(&val), sizeof(val));
+      return val;
+    };
+    if (read_u64() != BINARY_MAGIC) return false;
+    const uint64_t num_positions = read_u64();
+    const uint64_t num_connections = read_u64();
+    // Check sizes against the file before allocating anything
+    if (!in || file_size / sizeof(uint64_t) < 4 ||
+        num_positions > file_size / sizeof(uint64_t) ||
+        num_connections > file_size / sizeof(uint64_t) ||
+        (4 + num_positions + num_connections) * sizeof(uint64_t) != file_size) {
+      return false;
+    }
+    emp::vector<uint64_t> in_offsets(num_positions + 1);
+    emp::vector<uint64_t> in_ids(num_connections);
+    in.read(reinterpret_cast<char*>(in_offsets.data()), in_offsets.size() * sizeof(uint64_t));
+    if (num_connections > 0) {
+      in.read(reinterpret_cast<char*>(in_ids.data()), in_ids.size() * sizeof(uint64_t));
+    }
+    if (!in) return false;
+    emp::vector<size_t> prev_offsets(in_offsets.begin(), in_offsets.end());
+    emp::vector<size_t> prev_ids(in_ids.begin(), in_ids.end());
+    std::swap(neighbor_offsets, prev_offsets);
+    std::swap(neighbor_ids, prev_ids);
+    if (!VerifyConnectionConsistency()) {
+      std::cout << "Malformed spatial structure file (" << filepath << ")" << std::endl;
+      std::swap(neighbor_offsets, prev_offsets);
+      std::swap(neighbor_ids, prev_ids);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Input: Path to edge csv file and path to its binary cache file.
+   *
+   * Output: None
+   *
+   * Purpose: Load spatial structure from the binary cache file if it exists.
+   *          Otherwise, load from the edge csv and write the cache for next
+   *          time. NOTE - the cache is not checked against the csv; delete it
+   *          if the csv changes.
+   */
+  void LoadStructureFromEdgeCSV(const std::string& filepath, const std::string& cache_filepath) {
+    if (cache_filepath != "" && LoadStructureFromBinary(cache_filepath)) {
+      return;
+    }
+    LoadStructureFromEdgeCSV(filepath);
+    if (cache_filepath != "" && !SaveStructureToBinary(cache_filepath)) {
+      std::cout << "Unable to write spatial structure cache (" << cache_filepath << ")" << std::endl;
+    }
+  }
+
   /**
    * Input: Stream to put output in, boolean indicating whether to print as mapping
    *        (from => to) or matrix format.
@@ -429,7 +597,7 @@ public:
     for (size_t from = 0; from < num_positions; ++from) {
       for (size_t to = 0; to < num_positions; ++to) {
         if (to) os << ",";
-        os << (size_t)connection_matrix[from][to];
+        os << (size_t)IsConnected(from, to);
       }
       os << std::endl;
     }
@@ -446,7 +614,7 @@ public:
     emp_assert(VerifyConnectionConsistency());
     const size_t num_positions = GetNumPositions();
     for (size_t from = 0; from < num_positions; ++from) {
-      const auto& neighbors = ordered_connections[from];
+      const neighbors_t neighbors = GetNeighbors(from);
       os << from << ":";
       for (size_t i = 0; i < neighbors.size(); ++i) {
         if (i) os << ",";
@@ -1,7 +1,9 @@
 #ifndef SYM_WORLD_H
 #define SYM_WORLD_H
 
+#include "OccupancyIndex.h"
 #include "SpatialStructure.h"
+#include "UpdateSchedule.h"
 
 #include "../../Empirical/include/emp/Evolve/World.hpp"
 #include "../../Empirical/include/emp/data/DataFile.hpp"
@@ -10,12 +12,23 @@
 #include "../../Empirical/include/emp/math/Random.hpp"
 #include "../../Empirical/include/emp/matching/MatchBin.hpp"
 
+#include "../AsyncOutput.h"
+#include "../ColumnarData.h"
+#include "../PairCounter.h"
+#include "../RowWriter.h"
 #include "../spatial_utils.h"
+#include "../tag_utils.h"
+#include "../utils.h"
 #include "../Organism.h"
+#include "../SystematicsCheckpoint.h"
 
 #include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory>
 #include <set>
 #include <math.h>
+#include <type_traits>
 #include <unordered_map>
 
 namespace taxon_t {
@@ -33,6 +46,8 @@ public:
   using fun_calc_info_t = std::function<taxon_t::info_t(Organism &)>;
   using tag_t = emp::BitSet<TAG_LENGTH>;
   using tag_metric_t = emp::BaseMetric<tag_t, tag_t>;
+  using tag_engine_t = tag_utils::TagDistanceEngine<TAG_LENGTH>;
+  using tag_batch_t = tag_utils::TagBatch<TAG_LENGTH>;
   using pop_t = typename emp::World<Organism>::pop_t;
   using host_systematics_t = emp::Systematics<Organism, taxon_t::info_t, datastruct::HostTaxonData>;
   using sym_systematics_t = emp::Systematics<Organism, taxon_t::info_t, datastruct::SymbiontTaxonData>;
@@ -46,6 +61,14 @@ public:
   enum class TAG_METRIC_TYPE { HAMMING, STREAK, HASH };
   static const std::unordered_map<std::string, TAG_METRIC_TYPE> tag_metric_type_cfg_mapping;
 
+  static const std::unordered_map<std::string, tag_utils::TagMatrixFormat> tag_matrix_format_cfg_mapping;
+
+  enum class DATA_FILE_FORMAT { CSV, COLUMNAR };
+  static const std::unordered_map<std::string, DATA_FILE_FORMAT> data_file_format_cfg_mapping;
+
+  enum class POPULATION_STORE { OBJECTS, SOA };
+  static const std::unordered_map<std::string, POPULATION_STORE> population_store_cfg_mapping;
+
 protected:
 
 
@@ -120,6 +143,26 @@ protected:
   */
   emp::Ptr<tag_metric_t> tag_metric;
 
+  /**
+   * Purpose: Decides the order positions are processed in each update (see
+   * SCHEDULE_MODE).
+   */
+  UpdateSchedule update_schedule;
+
+  /**
+   * Purpose: Track which positions hold a host, which hold a free-living
+   * symbiont, and which hold either, so that sparse worlds can be scanned
+   * without visiting empty cells.
+   */
+  OccupancyIndex host_positions;
+  OccupancyIndex free_sym_positions;
+  OccupancyIndex occupied_positions;
+
+  /**
+   * Purpose: Computes tag distances with tag_metric (see tag_utils.h).
+   */
+  tag_engine_t tag_engine;
+
   /**
    * Purpose: Tracks world configuration for tag metric type.
    */
@@ -133,6 +176,14 @@ protected:
    */
   SpatialStructure spatial_structure;
 
+  /**
+   *
+   * Purpose: Already-loaded spatial structure to copy in on setup instead of
+   *          reading the configured structure file (unowned; e.g., shared by
+   *          batch replicates). Only used in "load" spatial structure mode.
+   */
+  emp::Ptr<const SpatialStructure> shared_spatial_structure = nullptr;
+
   /**
    *
    * Purpose: Tracks whether spatial structure has been configured
@@ -178,6 +229,33 @@ protected:
   emp::Ptr<emp::DataMonitor<double, emp::data::Histogram>> data_node_attempts_verttrans;
   emp::Ptr<emp::DataMonitor<double, emp::data::Histogram>> data_node_successes_verttrans;
 
+  // Population data nodes (counts, histograms, etc.) are filled by a single
+  // pass over the population (see CollectDataNodes) on updates that are a
+  // multiple of data_node_interval.
+  size_t data_node_interval = 1;
+  bool data_node_collection_registered = false;
+
+  // The update a checkpoint was loaded at is where RunExperiment resumes.
+  size_t resume_update = 0;
+
+  // With ASYNC_OUTPUT, output files and periodic checkpoints are written by
+  // this queue's thread (see GetOutputQueue). Queued data files share
+  // ownership, so the queue outlives the world's data files and writes out
+  // everything before it is destroyed.
+  std::shared_ptr<async_output::WriteQueue> output_queue;
+
+  // Reused by WritePhylogenyFile to count current (host, symbiont) interactions
+  PairCounter current_interactions;
+
+  // An extra column (after the standard ones) in phylogeny snapshots
+  template <typename TAXON_T>
+  struct SnapshotColumn {
+    std::string key;
+    std::function<std::string(const TAXON_T&)> fun;
+  };
+  emp::vector<SnapshotColumn<taxon_t::host_taxon_t>> host_snapshot_columns;
+  emp::vector<SnapshotColumn<taxon_t::sym_taxon_t>> sym_snapshot_columns;
+
   // the taxon IDs of the first mutualistic pair (where BOTH sym and host are mutualistic)
   uint64_t first_mut_sym = 0;
   uint64_t first_mut_host = 0;
@@ -217,6 +295,24 @@ protected:
     // TODO: Update to include organism removal?
     pop.resize(new_size);
     sym_pop.resize(new_size);
+    host_positions.Resize(new_size);
+    free_sym_positions.Resize(new_size);
+    occupied_positions.Resize(new_size);
+  }
+
+  /**
+   * Input: (1) A position; (2) whether it holds a host; (3) whether it holds a
+   *        free-living symbiont.
+   *
+   * Output: None
+   *
+   * Purpose: To keep the occupancy indices up to date. Called whenever a
+   *          host or free-living symbiont is placed or removed.
+   */
+  void SetOccupancy(size_t pos, bool has_host, bool has_free_sym) {
+    host_positions.Set(pos, has_host);
+    free_sym_positions.Set(pos, has_free_sym);
+    occupied_positions.Set(pos, has_host || has_free_sym);
   }
 
   /**
@@ -225,6 +321,12 @@ protected:
    */
   void SetupSpatialStructure();
 
+  /**
+   * Purpose: Internal setup helper function used by SetupSpatialStructure() to
+   *          configure the update schedule (SCHEDULE_MODE).
+   */
+  void SetupSchedule();
+
   /**
    * Purpose: Internal setup helper function used by SetupSpatialStructure().
    */
@@ -269,6 +371,11 @@ public:
     if (my_config->TAG_MATCHING()) {
       SetupTagMatching();
     }
+
+    // Keep track of which positions are occupied as hosts come and go
+    // (free-living symbionts are tracked in AddOrgAt, ExtractSym, and DoSymDeath)
+    OnPlacement([this](size_t pos) { SetOccupancy(pos, true, IsSymPopOccupied(pos)); });
+    OnOrgDeath([this](size_t pos) { SetOccupancy(pos, false, IsSymPopOccupied(pos)); });
   }
 
 
@@ -498,6 +605,54 @@ public:
    */
   SPATIAL_STRUCT_MODE GetSpatialStructureMode() const { return spatial_struct_mode; }
 
+  /**
+   * Input: None
+   *
+   * Output: const reference to the world's spatial structure.
+   *
+   * Purpose: To get the spatial structure used to define neighbors in "load"
+   *          spatial structure mode.
+   */
+  const SpatialStructure& GetSpatialStructure() const { return spatial_structure; }
+
+  /**
+   * Input: None
+   *
+   * Output: const reference to the world's update schedule.
+   *
+   * Purpose: To get the order positions were last processed in, and which
+   *          positions are occupied.
+   */
+  const UpdateSchedule& GetUpdateSchedule() const { return update_schedule; }
+
+  /**
+   * Input: None
+   *
+   * Output: const reference to the index of positions holding a host, a
+   *         free-living symbiont, or either.
+   *
+   * Purpose: To visit occupied positions without scanning the whole world.
+   */
+  const OccupancyIndex& GetHostPositions() const { return host_positions; }
+  const OccupancyIndex& GetFreeSymPositions() const { return free_sym_positions; }
+  const OccupancyIndex& GetOccupiedPositions() const { return occupied_positions; }
+
+  /**
+   * Input: A spatial structure that has already been loaded for this world's
+   * configuration. It must outlive this world's setup.
+   *
+   * Output: None
+   *
+   * Purpose: To skip re-reading the spatial structure file in "load" spatial
+   *          structure mode (e.g., when many replicates share one structure).
+   *          Must be called before Setup().
+   */
+  void SetSharedSpatialStructure(const SpatialStructure& structure) {
+    shared_spatial_structure = &structure;
+  }
+
+  static void LoadSpatialStructure(SpatialStructure& structure, SymConfigBase& config);
+
   /**
    * Input: None
    *
@@ -558,6 +713,7 @@ public:
    */
   void SetTagMetric(emp::Ptr<tag_metric_t> _in) {
     tag_metric = _in;
+    tag_engine.SetMetric(_in);
   }
 
   /**
@@ -571,8 +727,19 @@ public:
     return tag_metric;
   }
 
+  /**
+   * Input: None
+   *
+   * Output: The engine computing distances with the world's tag metric
+   *
+   * Purpose: To compute many tag distances at once (see tag_utils.h)
+   */
+  const tag_engine_t& GetTagEngine() const {
+    return tag_engine;
+  }
+
   double CalcTagMetric(const tag_t& tag_a, const tag_t& tag_b) const {
-    return (*tag_metric)(tag_a, tag_b);
+    return tag_engine.Distance(tag_a, tag_b);
   }
 
   /**
@@ -621,6 +788,21 @@ public:
   }
 
 
+  /**
+   * Input: (1) The possible ancestor host taxon; (2) the possible descendant
+   * host taxon.
+   *
+   * Output: Whether the first taxon is the second or one of its ancestors
+   *
+   * Purpose: To check host ancestry in O(log depth) with the host systematic's
+   * ancestry index.
+   */
+  bool IsHostAncestor(emp::Ptr<taxon_t::host_taxon_t> ancestor, emp::Ptr<taxon_t::host_taxon_t> descendant) const {
+    emp_assert(host_sys, "Host ancestry requires PHYLOGENY");
+    return ancestry::IsAncestor(ancestor, descendant);
+  }
+
+
   /**
    * Input: None
    *
@@ -716,6 +898,20 @@ public:
     }
   }
 
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To add the per-update resource inflow to the world's resources
+   * (only if resources are limited).
+   */
+  void DoResourceInflow() {
+    if (total_res != -1) {
+      total_res += my_config->LIMITED_RES_INFLOW();
+    }
+  }
+
   /**
    * Input: An organism pointer to add to the graveyard
    *
@@ -732,6 +928,18 @@ public:
     graveyard.push_back(org);
   }
 
+  /**
+   * Input: The interaction value of the symbiont attempting horizontal transmission
+   *
+   * Output: None
+   *
+   * Purpose: To record a horizontal transmission attempt. Virtual so that worlds
+   * that process organisms on multiple threads can buffer the datum instead.
+   */
+  virtual void RecordHorizontalTransmissionAttempt(double int_val) {
+    GetHorizontalTransmissionAttemptCount().AddDatum(int_val);
+  }
+
 
   /**
    * Input: The pointer to the new organism;
@@ -778,6 +986,7 @@ public:
       }
       //set the cell to point to the new sym
       sym_pop[pos_id] = new_org;
+      SetOccupancy(pos_id, IsOccupied(pos_id), true);
     }
   }
 
@@ -975,6 +1184,472 @@ public:
   }
 
 
+  /**
+   * Input: The number of updates between population data node collections.
+   *
+   * Output: None
+   *
+   * Purpose: To only rescan the population for data nodes on updates that
+   * will be written (CreateDataFiles sets this to DATA_INT). Node values on
+   * other updates are left over from the last collection.
+   */
+  void SetDataNodeInterval(size_t interval) {
+    emp_assert(interval > 0);
+    data_node_interval = interval;
+  }
+  size_t GetDataNodeInterval() const { return data_node_interval; }
+
+  /**
+   * Input: An update.
+   *
+   * Output: Whether the population data nodes are collected (from the
+   * world's organisms) at the start of that update.
+   */
+  bool CollectsDataNodesAt(size_t ud) const {
+    return data_node_collection_registered && ud % data_node_interval == 0;
+  }
+
+  /**
+   * Input: The path of the data file to create.
+   *
+   * Output: The new data file, which the world updates every update.
+   *
+   * Purpose: To create a data file in the configured DATA_FILE_FORMAT. Hides
+   * emp::World::SetupFile, so every data file set up by a world (in any mode)
+   * can be written as a columnar file; columnar files get a .col suffix. Runs
+   * resumed from a checkpoint (LOAD_CHECKPOINT) add rows to the end of the
+   * data files the original run wrote.
+   */
+  emp::DataFile& SetupFile(const std::string& filename) {
+    const std::string& cfg_format = my_config->DATA_FILE_FORMAT();
+    utils::ValidateConfigMode(data_file_format_cfg_mapping, "DATA_FILE_FORMAT", cfg_format);
+    const bool is_columnar = data_file_format_cfg_mapping.at(cfg_format) == DATA_FILE_FORMAT::COLUMNAR;
+    const std::string filepath = is_columnar ? filename + columnar::FILE_EXTENSION : filename;
+
+    emp::Ptr<emp::DataFile> file;
+    if (my_config->LOAD_CHECKPOINT() != "") {
+      if (is_columnar) file = emp::NewPtr<async_output::AppendedDataFile<columnar::DataFile>>(GetOutputQueue(), filepath);
+      else file = emp::NewPtr<async_output::AppendedDataFile<>>(GetOutputQueue(), filepath);
+    } else if (GetOutputQueue()) {
+      if (is_columnar) file = emp::NewPtr<async_output::QueuedDataFile<columnar::DataFile>>(output_queue, filepath);
+      else file = emp::NewPtr<async_output::QueuedDataFile<>>(output_queue, filepath);
+    } else if (is_columnar) {
+      file = emp::NewPtr<columnar::DataFile>(filepath);
+    } else {
+      return base_world_t::SetupFile(filepath);
+    }
+    AddDataFile(file);
+    return *file;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The queue that writes this world's output files, or nullptr if
+   * ASYNC_OUTPUT is off.
+   *
+   * Purpose: To create the output queue the first time it is needed.
+   */
+  std::shared_ptr<async_output::WriteQueue> GetOutputQueue() {
+    if (!output_queue && my_config->ASYNC_OUTPUT()) {
+      output_queue = std::make_shared<async_output::WriteQueue>(my_config->ASYNC_OUTPUT_QUEUE_MB() << 20);
+    }
+    return output_queue;
+  }
+
+  /**
+   * Input: (1) The path of the file to write; (2) the file's contents.
+   *
+   * Output: None
+   *
+   * Purpose: To write a whole output file (a snapshot or dump) that has been
+   * formatted in memory, on the output queue's thread with ASYNC_OUTPUT.
+   */
+  void WriteOutputFile(const std::string& filepath, std::string contents) {
+    if (GetOutputQueue()) {
+      output_queue->WriteFile(filepath, std::move(contents));
+    } else {
+      std::ofstream out_file(filepath, std::ios::binary);
+      out_file << contents;
+    }
+  }
+
+  /**
+   * Input: (1) The systematics to snapshot; (2) the extra columns to write;
+   * (3) the path of the snapshot file.
+   *
+   * Output: None
+   *
+   * Purpose: To write a systematics snapshot, in emp::Systematics::Snapshot's
+   * format: every active, ancestor, and outside taxon, with its standard
+   * columns followed by the extra ones. Rows are formatted in memory and
+   * handed to the output queue with ASYNC_OUTPUT (emp's Snapshot can only
+   * write to a file itself).
+   */
+  template <typename SYSTEMATICS_T, typename TAXON_T>
+  void WriteSystematicsSnapshot(SYSTEMATICS_T& sys, const emp::vector<SnapshotColumn<TAXON_T>>& columns,
+                                const std::string& filepath) {
+    output::RowWriter file(output::OpenSink(filepath, GetOutputQueue()));
+    file.Write("id,ancestor_list,origin_time,destruction_time,num_orgs,tot_orgs,num_offspring,total_offspring,depth");
+    for (const SnapshotColumn<TAXON_T>& column : columns) {
+      file.Write(",");
+      file.Write(column.key);
+    }
+    file.Write("\n");
+
+    std::string ancestor_list;
+    auto write_taxon = [&](emp::Ptr<TAXON_T> t) {
+      if (t->GetParent()) ancestor_list = "[" + std::to_string(t->GetParent()->GetID()) + "]";
+      else ancestor_list = "[NONE]";
+      file.Field(t->GetID());
+      file.Field(ancestor_list);
+      file.Field(t->GetOriginationTime());
+      file.Field(t->GetDestructionTime());
+      file.Field(t->GetNumOrgs());
+      file.Field(t->GetTotOrgs());
+      file.Field(t->GetNumOff());
+      file.Field(t->GetTotalOffspring());
+      file.Field(t->GetDepth());
+      for (const SnapshotColumn<TAXON_T>& column : columns) file.Field(column.fun(*t));
+      file.EndRow();
+    };
+    for (emp::Ptr<TAXON_T> t : sys.GetActive()) write_taxon(t);
+    for (emp::Ptr<TAXON_T> t : sys.GetAncestors()) write_taxon(t);
+    for (emp::Ptr<TAXON_T> t : sys.GetOutside()) write_taxon(t);
+  }
+
+  /**
+   * Input: The path of the snapshot file to write.
+   *
+   * Output: A writer for the snapshot's rows.
+   *
+   * Purpose: To open a large CSV snapshot for streaming, gzip compressed
+   * (with a .gz suffix) with SNAPSHOT_GZIP, and written by the output queue
+   * with ASYNC_OUTPUT.
+   */
+  output::RowWriter OpenSnapshotWriter(const std::string& filepath) {
+    const bool gzip = my_config->SNAPSHOT_GZIP();
+    if (gzip && !output::HAS_GZIP) {
+      std::cout << "SNAPSHOT_GZIP requires building with ZLIB=1." << std::endl;
+      exit(-1);
+    }
+    return output::RowWriter(output::OpenSink(gzip ? filepath + output::GZIP_EXTENSION : filepath, GetOutputQueue(), gzip));
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: Whether every queued write so far succeeded (always true
+   * without ASYNC_OUTPUT).
+   *
+   * Purpose: To wait until all output so far has been written to the
+   * filesystem.
+   */
+  bool FlushOutput() {
+    return output_queue ? output_queue->Flush() : true;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The name of this world's mode, stored in checkpoints so that
+   * they are only loaded into the same kind of world.
+   */
+  virtual std::string GetCheckpointMode() const { return "default"; }
+
+  // Definitions of checkpoint organism factories, expanded in WorldSetup.cc
+  // (and overridden in each mode's world setup)
+  virtual emp::Ptr<Organism> MakeCheckpointHost();
+  virtual emp::Ptr<Organism> MakeCheckpointSymbiont();
+
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save world state that only a mode's world has (called at the
+   * end of CaptureCheckpoint).
+   */
+  virtual void SaveWorldCheckpoint(checkpoint::Writer& writer) const {}
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: A function that applies the loaded state to the world.
+   *
+   * Purpose: To read what SaveWorldCheckpoint saved. The returned function is
+   * only called once the whole checkpoint has been read and the population
+   * restored, so a bad checkpoint leaves the world unchanged.
+   */
+  virtual std::function<void()> LoadWorldCheckpoint(checkpoint::Reader& reader) {
+    return [](){};
+  }
+
+  /**
+   * Input: (1) A host; (2) the function to call on it and each of its
+   * symbionts and reproducing symbionts, in that order.
+   *
+   * Output: None
+   *
+   * Purpose: To visit a host's organisms in the order checkpoints store their
+   * taxa.
+   */
+  template <typename FUN_T>
+  static void ForEachCheckpointOrg(emp::Ptr<Organism> host, FUN_T&& fun) {
+    fun(host);
+    for (emp::Ptr<Organism> sym : host->GetSymbionts()) fun(sym);
+    for (emp::Ptr<Organism> repro_sym : host->GetReproSymbionts()) fun(repro_sym);
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The checkpoint file path set by CHECKPOINT_PATH, or a default
+   * path next to the run's data files.
+   */
+  std::string GetCheckpointPath() const {
+    if (my_config->CHECKPOINT_PATH() != "") return my_config->CHECKPOINT_PATH();
+    return my_config->FILE_PATH() + "Checkpoint" + my_config->FILE_NAME() + "_SEED" + std::to_string(my_config->SEED()) + ".ckpt";
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: The full world state (update, random number generator state,
+   * resources, every host, hosted symbiont and free-living symbiont, the
+   * phylogeny if one is tracked, and any mode-specific state) as a
+   * checkpoint buffer.
+   *
+   * Purpose: To capture a checkpoint without changing the world, so runs
+   * that checkpoint draw the same random numbers as runs that don't.
+   */
+  std::string CaptureCheckpoint() {
+    checkpoint::Writer writer;
+    writer.Write(checkpoint::MAGIC);
+    writer.Write(checkpoint::FORMAT_VERSION);
+    writer.WriteString(GetCheckpointMode());
+    writer.Write<uint64_t>(GetUpdate());
+    writer.WriteString(checkpoint::SaveRandomState(GetRandom()));
+    writer.Write(total_res);
+    writer.Write<uint64_t>(GetSize());
+
+    writer.Write<uint64_t>(host_positions.GetCount());
+    host_positions.ForEach([&](size_t i) {
+      writer.Write<uint64_t>(i);
+      pop[i]->SaveCheckpoint(writer);
+    });
+    writer.Write<uint64_t>(free_sym_positions.GetCount());
+    free_sym_positions.ForEach([&](size_t i) {
+      writer.Write<uint64_t>(i);
+      sym_pop[i]->SaveCheckpoint(writer);
+    });
+
+    // The phylogeny, then each organism's taxon, in the order organisms were
+    // written above
+    writer.Write<bool>(my_config->PHYLOGENY());
+    if (my_config->PHYLOGENY()) {
+      writer.Write(first_mut_host);
+      writer.Write(first_mut_sym);
+      checkpoint::SaveSystematics(writer, *host_sys);
+      checkpoint::SaveSystematics(writer, *sym_sys);
+      emp::vector<uint64_t> taxon_ids;
+      auto add_taxon_id = [&taxon_ids](emp::Ptr<Organism> org) {
+        emp::Ptr<taxon_t::base_taxon_t> taxon = org->GetTaxon();
+        taxon_ids.push_back(taxon ? taxon->GetID() : checkpoint::NO_TAXON);
+      };
+      host_positions.ForEach([&](size_t i) { ForEachCheckpointOrg(pop[i], add_taxon_id); });
+      free_sym_positions.ForEach([&](size_t i) { add_taxon_id(sym_pop[i]); });
+      writer.Write<uint64_t>(taxon_ids.size());
+      for (uint64_t id : taxon_ids) writer.Write(id);
+    }
+
+    SaveWorldCheckpoint(writer);
+    return writer.TakeBuffer();
+  }
+
+  /**
+   * Input: The path of the checkpoint file to write.
+   *
+   * Output: Boolean indicating whether the checkpoint was written.
+   *
+   * Purpose: To save a checkpoint, waiting for the file to be written.
+   */
+  bool SaveCheckpoint(const std::string& filepath) {
+    FlushOutput(); // Don't race a queued periodic checkpoint to the same file
+    return checkpoint::WriteFileAtomic(filepath, CaptureCheckpoint());
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: Whether the current update ends with a periodic checkpoint.
+   */
+  bool IsPeriodicCheckpointUpdate() const {
+    const int interval = my_config->CHECKPOINT_INTERVAL();
+    return interval > 0 && GetUpdate() % interval == 0;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To save a checkpoint every CHECKPOINT_INTERVAL updates (called
+   * at the end of each update). With ASYNC_OUTPUT, the world state is
+   * captured here and written to disk by the output queue.
+   */
+  void DoPeriodicCheckpoint() {
+    if (!IsPeriodicCheckpointUpdate()) return;
+    if (GetOutputQueue()) {
+      output_queue->WriteFileAtomic(GetCheckpointPath(), CaptureCheckpoint());
+    } else if (!SaveCheckpoint(GetCheckpointPath())) {
+      std::cout << "Unable to write checkpoint (" << GetCheckpointPath() << ")" << std::endl;
+    }
+  }
+
+  /**
+   * Input: The path of a checkpoint file.
+   *
+   * Output: Boolean indicating whether the checkpoint was loaded. If not, the
+   * world is left unchanged.
+   *
+   * Purpose: To replace the world's population and state (including its
+   * random number generator) with a checkpoint written by a world of the same
+   * mode and size (i.e., set up from the same configuration, including
+   * PHYLOGENY). Tracked phylogenies are restored with the same taxa and IDs.
+   */
+  bool LoadCheckpoint(const std::string& filepath) {
+    checkpoint::Reader reader;
+    if (!reader.LoadFile(filepath)) return false;
+    if (reader.Read<uint64_t>() != checkpoint::MAGIC) return false;
+    if (reader.Read<uint32_t>() != checkpoint::FORMAT_VERSION) return false;
+    if (reader.ReadString() != GetCheckpointMode()) return false;
+    const size_t saved_update = reader.Read<uint64_t>();
+    const std::string random_state = reader.ReadString();
+    const int saved_total_res = reader.Read<int>();
+    if (!reader.IsOK() || reader.Read<uint64_t>() != GetSize()) return false;
+    if (random_state.size() != checkpoint::RANDOM_STATE_SIZE) return false;
+
+    // Read every organism before touching the population
+    emp::vector<std::pair<size_t, emp::Ptr<Organism>>> hosts;
+    emp::vector<std::pair<size_t, emp::Ptr<Organism>>> free_syms;
+    const size_t num_hosts = reader.Read<uint64_t>();
+    for (size_t i = 0; i < num_hosts && reader.IsOK(); i++) {
+      const size_t pos = reader.Read<uint64_t>();
+      if (pos >= GetSize()) break;
+      emp::Ptr<Organism> host = MakeCheckpointHost();
+      host->SetLocation(emp::WorldPosition(pos));
+      host->LoadCheckpoint(reader);
+      hosts.emplace_back(pos, host);
+    }
+    const size_t num_free_syms = reader.Read<uint64_t>();
+    for (size_t i = 0; i < num_free_syms && reader.IsOK(); i++) {
+      const size_t pos = reader.Read<uint64_t>();
+      if (pos >= GetSize()) break;
+      emp::Ptr<Organism> sym = MakeCheckpointSymbiont();
+      sym->LoadCheckpoint(reader);
+      free_syms.emplace_back(pos, sym);
+    }
+
+    bool phylogeny_ok = reader.Read<bool>() == bool(my_config->PHYLOGENY());
+    uint64_t saved_first_mut_host = 0;
+    uint64_t saved_first_mut_sym = 0;
+    checkpoint::SavedSystematics<taxon_t::info_t> saved_host_sys;
+    checkpoint::SavedSystematics<taxon_t::info_t> saved_sym_sys;
+    emp::vector<uint64_t> taxon_ids;
+    if (phylogeny_ok && my_config->PHYLOGENY()) {
+      saved_first_mut_host = reader.Read<uint64_t>();
+      saved_first_mut_sym = reader.Read<uint64_t>();
+      phylogeny_ok = checkpoint::ReadSystematics<datastruct::HostTaxonData>(reader, saved_host_sys) &&
+                     checkpoint::ReadSystematics<datastruct::SymbiontTaxonData>(reader, saved_sym_sys);
+      const size_t num_taxon_ids = reader.Read<uint64_t>();
+      for (size_t i = 0; i < num_taxon_ids && reader.IsOK(); i++) {
+        taxon_ids.push_back(reader.Read<uint64_t>());
+      }
+      // Every organism's taxon must be in the right systematics
+      size_t id_i = 0;
+      auto check_taxon_id = [&](emp::Ptr<Organism> org) {
+        if (id_i >= taxon_ids.size()) phylogeny_ok = false;
+        else if (taxon_ids[id_i] != checkpoint::NO_TAXON) {
+          phylogeny_ok = phylogeny_ok && checkpoint::HasTaxon(org->IsHost() ? saved_host_sys : saved_sym_sys, taxon_ids[id_i]);
+        }
+        id_i++;
+      };
+      for (auto& [pos, host] : hosts) ForEachCheckpointOrg(host, check_taxon_id);
+      for (auto& [pos, sym] : free_syms) check_taxon_id(sym);
+      phylogeny_ok = phylogeny_ok && id_i == taxon_ids.size();
+    }
+    std::function<void()> apply_world_state = LoadWorldCheckpoint(reader);
+
+    if (!reader.IsOK() || !reader.AtEnd() || !phylogeny_ok ||
+        hosts.size() != num_hosts || free_syms.size() != num_free_syms) {
+      for (auto& [pos, org] : hosts) org.Delete();
+      for (auto& [pos, org] : free_syms) org.Delete();
+      return false;
+    }
+
+    occupied_positions.ForEach([this](size_t i) {
+      if (IsOccupied(i)) DoDeath(i);
+      DoSymDeath(i);
+    });
+    CleanupGraveyard();
+    for (auto& [pos, host] : hosts) {
+      AddOrgAt(host, emp::WorldPosition(pos));
+    }
+    for (auto& [pos, sym] : free_syms) {
+      AddOrgAt(sym, emp::WorldPosition(0, pos));
+    }
+    if (my_config->PHYLOGENY()) {
+      // Replaces the taxa the loaded hosts were just given
+      const auto host_taxa = checkpoint::RestoreSystematics(*host_sys, saved_host_sys,
+        [](emp::Ptr<taxon_t::host_taxon_t> taxon) { ancestry::Link(taxon); });
+      const auto sym_taxa = checkpoint::RestoreSystematics(*sym_sys, saved_sym_sys,
+        [](emp::Ptr<taxon_t::sym_taxon_t>) {});
+      size_t id_i = 0;
+      auto set_taxon = [&](emp::Ptr<Organism> org) {
+        const uint64_t id = taxon_ids[id_i++];
+        if (id == checkpoint::NO_TAXON) {
+          org->SetTaxon(nullptr);
+        } else if (org->IsHost()) {
+          org->SetTaxon(host_taxa.at(id).Cast<taxon_t::base_taxon_t>());
+        } else {
+          org->SetTaxon(sym_taxa.at(id).Cast<taxon_t::base_taxon_t>());
+        }
+      };
+      for (auto& [pos, host] : hosts) {
+        ForEachCheckpointOrg(host, set_taxon);
+        checkpoint::SystematicsAccess<host_systematics_t>::SetTaxonAt(
+          *host_sys, emp::WorldPosition(pos), host->GetTaxon().Cast<taxon_t::host_taxon_t>());
+      }
+      for (auto& [pos, sym] : free_syms) set_taxon(sym);
+      first_mut_host = saved_first_mut_host;
+      first_mut_sym = saved_first_mut_sym;
+    }
+    apply_world_state();
+    update = saved_update;
+    resume_update = saved_update;
+    total_res = saved_total_res;
+    checkpoint::RestoreRandomState(GetRandom(), random_state);
+    return true;
+  }
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To resume from the LOAD_CHECKPOINT checkpoint, if one is set
+   * (called at the end of Setup).
+   */
+  void SetupCheckpointResume() {
+    const std::string& filepath = my_config->LOAD_CHECKPOINT();
+    if (filepath == "") return;
+    if (!LoadCheckpoint(filepath)) {
+      std::cout << "Could not load checkpoint from LOAD_CHECKPOINT (" << filepath << ")." << std::endl;
+      exit(-1);
+    }
+  }
+
   //Definitions of data node functions, expanded in DataNodes.h
   virtual void CreateDataFiles();
   void MapPhylogenyInteractions();
@@ -994,6 +1669,8 @@ public:
   emp::DataFile& SetupSymDiversityFile(const std::string& filename);
   virtual void SetupTransmissionFileColumns(emp::DataFile& file);
   virtual void SetupHostFileColumns(emp::DataFile& file);
+  void SetupDataNodeCollection();
+  void CollectDataNodes();
   emp::DataMonitor<int>& GetHostCountDataNode();
   emp::DataMonitor<int>& GetSymCountDataNode();
   emp::DataMonitor<int>& GetCountHostedSymsDataNode();
@@ -1106,7 +1783,7 @@ public:
         const bool size_failed = pop[new_host_pos]->GetSymbionts().size() >= (long unsigned)my_config->SYM_LIMIT();
         bool tag_failed = false;
         if (my_config->TAG_MATCHING()) {
-          const double tag_distance = (*tag_metric)(pop[new_host_pos]->GetTag(), sym_baby->GetTag()) * TAG_LENGTH;
+          const double tag_distance = CalcTagMetric(pop[new_host_pos]->GetTag(), sym_baby->GetTag()) * TAG_LENGTH;
           const double permissiveness_mean = (my_config->HOST_TAG_PERMISSIVENESS_EVOLVES()) ? pop[new_host_pos]->GetTagPermissiveness() : my_config->TAG_PERMISSIVENESS();
           const double cutoff = GetRandom().GetPoisson(permissiveness_mean * TAG_LENGTH);
           tag_failed = tag_distance > cutoff;
@@ -1202,6 +1879,7 @@ public:
       sym = sym_pop[i];
       num_orgs--;
       sym_pop[i] = nullptr;
+      SetOccupancy(i, IsOccupied(i), false);
     }
     return sym;
   }
@@ -1219,6 +1897,7 @@ public:
       sym_pop[i].Delete();
       sym_pop[i] = nullptr;
       num_orgs--;
+      SetOccupancy(i, IsOccupied(i), false);
     }
   }
 
@@ -1275,16 +1954,14 @@ public:
    */
   void CureHosts() {
     //loop through hosts and clear all symbionts
-    for (size_t i = 0; i < pop.size(); i++) {
-      // see if position in world is occupied
-      if (!IsOccupied(i)) continue;
+    host_positions.ForEach([this](size_t i) {
       auto& host_syms = pop[i]->GetSymbionts();
       for (size_t j = 0; j < host_syms.size(); j++) {
         host_syms[j]->SetDead();
         SendToGraveyard(host_syms[j]);
       }
       pop[i]->ClearSyms(); //TODO: should clear syms just handle setting dead and to graveyard?
-    }
+    });
   }
 
   /**
@@ -1293,21 +1970,53 @@ public:
    * Output: None
    *
    * Purpose: Run the number of updates and non-mutation updates specified in the configuration settings.
+   * With POPULATION_STORE soa, hosts and symbionts are updated in a structure-of-arrays store
+   * (see SoAPopulation.h) instead of as objects.
    */
   void RunExperiment(bool verbose=true) {
     emp_assert(setup_spatial_structure);
+    const std::string& cfg_population_store = my_config->POPULATION_STORE();
+    utils::ValidateConfigMode(population_store_cfg_mapping, "POPULATION_STORE", cfg_population_store);
+    if (population_store_cfg_mapping.at(cfg_population_store) == POPULATION_STORE::SOA) {
+      RunSoAExperiment(verbose);
+    } else {
+      RunUpdates(*this, verbose);
+    }
+  }
+
+  // Definition of the structure-of-arrays experiment, expanded in SoAPopulation.h
+  void RunSoAExperiment(bool verbose);
+
+  /**
+   * Input: (1) The population to update: this world, or a store that updates the world's
+   * organisms in its place (see SoAPopulation.h); (2) whether to print the update numbers
+   * to standard output.
+   *
+   * Output: None
+   *
+   * Purpose: To run the updates and non-mutation updates of an experiment.
+   */
+  template <typename POPULATION_T>
+  void RunUpdates(POPULATION_T& population, bool verbose) {
+    // Experiments resumed from a checkpoint pick up at the checkpoint's update
+    const int start_update = resume_update;
+    resume_update = 0;
     //Loop through updates
     const int num_updates = my_config->UPDATES();
-    for (int i = 0; i < num_updates; i++) {
+    for (int i = std::min(start_update, num_updates); i < num_updates; i++) {
       if (verbose && (i % my_config->DATA_INT()) == 0) {
         std::cout << "Update: "<< i << std::endl;
         std::cout.flush();
       }
       // Check CURE config
       if (my_config->CURE() && (size_t)i == my_config->CURE_UPDATES()) {
-        CureHosts();
+        population.CureHosts();
       }
-      Update();
+      population.Update();
+    }
+    if constexpr (!std::is_same_v<POPULATION_T, SymWorld>) {
+      // The analysis reads the world's organisms
+      population.StoreToWorld();
     }
     on_analyze_population_sig.Trigger();
 
@@ -1319,16 +2028,16 @@ public:
       my_config->SYM_VERT_TRANS_RES(0);
     }
 
-    for (int i = 0; i < num_no_mut_updates; i++) {
+    for (int i = std::max(start_update - num_updates, 0); i < num_no_mut_updates; i++) {
       if (verbose && (i % my_config->DATA_INT()) == 0) {
         std::cout << "No mutation update: "<< i << std::endl;
         std::cout.flush();
       }
       // Check CURE config
       if (my_config->CURE() && (size_t)i == my_config->CURE_UPDATES()) {
-        CureHosts();
+        population.CureHosts();
       }
-      Update();
+      population.Update();
     }
   }
 
@@ -1395,9 +2104,7 @@ public:
     emp::World<Organism>::Update();
 
     // Handle resource inflow
-    if (total_res != -1) {
-      total_res += my_config->LIMITED_RES_INFLOW();
-    }
+    DoResourceInflow();
 
     if (my_config->PHYLOGENY()) {
       sym_sys->Update(); //sym_sys is not part of the systematics vector, handle it independently
@@ -1410,7 +2117,7 @@ public:
         );
       }
     }
-    emp::vector<size_t> schedule = emp::GetPermutation(GetRandom(), GetSize());
+    const emp::vector<size_t>& schedule = update_schedule.Build(GetRandom(), GetSize(), &occupied_positions);
     // divvy up and distribute resources to host and symbiont in each cell
     for (size_t i : schedule) {
       if (IsOccupied(i) == false && !sym_pop[i]) { continue; } // no organism at that cell
@@ -1435,6 +2142,8 @@ public:
       host_sys->ClearRemoveAfterReproQueue();
       sym_sys->ClearRemoveAfterReproQueue();
     }
+
+    DoPeriodicCheckpoint();
   } // Update()
 
 }; // SymWorld class
@@ -1467,4 +2176,28 @@ const std::unordered_map<
   {"hash", TAG_METRIC_TYPE::HASH}
 };
 
+const std::unordered_map<
+  std::string,
+  tag_utils::TagMatrixFormat
+> SymWorld::tag_matrix_format_cfg_mapping = {
+  {"csv", tag_utils::TagMatrixFormat::CSV},
+  {"binary", tag_utils::TagMatrixFormat::BINARY}
+};
+
+const std::unordered_map<
+  std::string,
+  SymWorld::DATA_FILE_FORMAT
+> SymWorld::data_file_format_cfg_mapping = {
+  {"csv", DATA_FILE_FORMAT::CSV},
+  {"columnar", DATA_FILE_FORMAT::COLUMNAR}
+};
+
+const std::unordered_map<
+  std::string,
+  SymWorld::POPULATION_STORE
+> SymWorld::population_store_cfg_mapping = {
+  {"objects", POPULATION_STORE::OBJECTS},
+  {"soa", POPULATION_STORE::SOA}
+};
+
 #endif
@@ -4,6 +4,7 @@
 #include "../../Empirical/include/emp/math/Random.hpp"
 #include "../../Empirical/include/emp/tools/string_utils.hpp"
 #include "SymWorld.h"
+#include "ResourceKernel.h"
 #include <set>
 #include <iomanip> // setprecision
 #include <sstream> // stringstream
@@ -197,7 +198,8 @@ public:
    * Purpose: To destruct the symbiont and remove the symbiont from the systematic.
    */
   ~Symbiont() {
-    if(my_config->PHYLOGENY() == 1) {
+    // Symbionts read from a rejected checkpoint were never given a taxon
+    if(my_config->PHYLOGENY() == 1 && my_taxon) {
       my_world->GetSymSys()->RemoveOrg(my_taxon.Cast<taxon_t::sym_taxon_t>());
       if (my_config->STORE_EXTINCT() && my_taxon->GetOriginationTime() == my_taxon->GetDestructionTime() && my_taxon->GetTotalOffspring() == 0) {
         my_world->GetSymSys()->outside_taxa.erase(my_taxon.Cast<taxon_t::sym_taxon_t>());
@@ -620,17 +622,8 @@ public:
    * (extreme interaction value in either direction) lose some of the resources that they get from the world.
    */
   void LoseResources(double resources) {
-    double int_val = interaction_val;
     if(my_host.IsNull()) { // this method should only be called on free-living syms, but double check!
-
-      if(int_val >= 0) {
-	      double spent = resources * int_val;
-        this->AddPoints(resources - spent);
-      }
-      else {
-        double attack = -1.0 * int_val * resources;
-        this->AddPoints(resources - attack);
-      }
+      this->AddPoints(resource_kernel::KeepResources(interaction_val, resources));
     }
   }
 
@@ -743,7 +736,7 @@ public:
   * */
   virtual bool SuccessfulVT(emp::Ptr<Organism> host_baby, emp::Ptr<Organism> sym_baby) {
     if (my_config->TAG_MATCHING()) {
-      const double tag_distance = (*my_world->GetTagMetric())(host_baby->GetTag(), sym_baby->GetTag())* TAG_LENGTH;
+      const double tag_distance = my_world->CalcTagMetric(host_baby->GetTag(), sym_baby->GetTag()) * TAG_LENGTH;
       const double permissiveness_mean = (my_config->HOST_TAG_PERMISSIVENESS_EVOLVES()) ? host_baby->GetTagPermissiveness() : my_config->TAG_PERMISSIVENESS();
       const double cutoff = random->GetPoisson(permissiveness_mean * TAG_LENGTH);
       if (tag_distance > cutoff) {
@@ -812,8 +805,7 @@ public:
   bool AttemptIndependentReproduction(emp::WorldPosition sym_pos) {
     if (my_config->HORIZ_TRANS()) { //non-lytic horizontal transmission enabled
       if (MeetsIndependentReproRequirements()) {
-        emp::DataMonitor<double, emp::data::Histogram>& data_node_attempts_horiztrans = my_world->GetHorizontalTransmissionAttemptCount();
-        data_node_attempts_horiztrans.AddDatum(GetIntVal());
+        my_world->RecordHorizontalTransmissionAttempt(GetIntVal());
 
         // symbiont reproduces independently (horizontal transmission) if it has enough resources
         //TODO: try just subtracting points to be consistent with vertical transmission
@@ -855,5 +847,44 @@ public:
 
     }
   }
+
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the symbiont's state into a checkpoint.
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const override {
+    writer.Write(interaction_val);
+    writer.Write(points);
+    writer.Write(dead);
+    writer.Write(infection_chance);
+    writer.Write(age);
+    writer.Write<uint64_t>(reproductions);
+    writer.Write<uint64_t>(towards_partner_count);
+    writer.Write<uint64_t>(from_partner_count);
+    writer.WriteBits(tag);
+  }
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the symbiont's state from a checkpoint. Its host and
+   * location are set by whoever places it.
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) override {
+    interaction_val = reader.Read<double>();
+    points = reader.Read<double>();
+    dead = reader.Read<bool>();
+    infection_chance = reader.Read<double>();
+    age = reader.Read<int>();
+    reproductions = reader.Read<uint64_t>();
+    towards_partner_count = reader.Read<uint64_t>();
+    from_partner_count = reader.Read<uint64_t>();
+    reader.ReadBits(tag);
+  }
 };
 #endif
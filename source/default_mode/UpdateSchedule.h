@@ -0,0 +1,140 @@
+#pragma once
+
+/*
+  This file contains the UpdateSchedule class, which decides the order that
+  world positions are processed in each update (see SCHEDULE_MODE).
+
+  The class is designed with the following trade-offs:
+  - The schedule buffer is reused every update, so building a schedule doesn't
+    allocate once the world has been processed once
+  - Which positions are occupied is tracked by the world (see OccupancyIndex),
+    so an occupied-only schedule costs time proportional to the number of
+    occupied positions (plus one step per 64 positions) rather than the world
+    size
+*/
+
+#include "OccupancyIndex.h"
+
+#include "emp/base/assert.hpp"
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/math/random_utils.hpp"
+#include "emp/math/Random.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+class UpdateSchedule {
+public:
+  /**
+   * Purpose: Scheduling strategies.
+   * - RANDOM: every position, in a new uniformly random order
+   * - OCCUPIED: only positions that are occupied when the schedule is built,
+   *   in random order. Organisms placed into empty positions during an update
+   *   are first processed the next update.
+   * - BLOCKED_RANDOM: every position, visiting blocks of adjacent positions
+   *   in random order (and the positions within each block in random order),
+   *   so neighboring positions are processed close together in time
+   */
+  enum class MODE { RANDOM, OCCUPIED, BLOCKED_RANDOM };
+  static const std::unordered_map<std::string, MODE> mode_cfg_mapping;
+
+protected:
+  MODE mode = MODE::RANDOM;
+  size_t block_size = 64;
+
+  emp::vector<size_t> order;       // Most recently built schedule (reused every update)
+  emp::vector<size_t> block_order; // Scratch space for BLOCKED_RANDOM
+
+  /**
+   * Input: The random number generator and the number of positions.
+   *
+   * Output: None
+   *
+   * Purpose: To fill order with a random permutation of [0, num_positions).
+   * Makes the same random draws as emp::GetPermutation so that schedules
+   * (and thus runs) are unchanged by reusing the buffer.
+   */
+  void FillPermutation(emp::Random& random, size_t num_positions) {
+    order.resize(num_positions);
+    if (num_positions == 0) return;
+    order[0] = 0;
+    for (size_t i = 1; i < num_positions; ++i) {
+      const size_t val_pos = random.GetUInt(i + 1);
+      order[i] = order[val_pos];
+      order[val_pos] = i;
+    }
+  }
+
+  void FillBlockedPermutation(emp::Random& random, size_t num_positions) {
+    emp_assert(block_size > 0);
+    const size_t num_blocks = (num_positions + block_size - 1) / block_size;
+    block_order.resize(num_blocks);
+    for (size_t block = 0; block < num_blocks; ++block) block_order[block] = block;
+    emp::Shuffle(random, block_order);
+
+    order.resize(num_positions);
+    auto order_it = order.begin();
+    for (size_t block : block_order) {
+      const auto block_begin = order_it;
+      const size_t block_end = std::min(num_positions, (block + 1) * block_size);
+      for (size_t pos = block * block_size; pos < block_end; ++pos) *(order_it++) = pos;
+      // Shuffle within the block
+      for (auto it = block_begin; it != order_it; ++it) {
+        std::iter_swap(it, it + random.GetUInt(order_it - it));
+      }
+    }
+  }
+
+public:
+  UpdateSchedule() = default;
+
+  void SetMode(MODE new_mode) { mode = new_mode; }
+  MODE GetMode() const { return mode; }
+
+  void SetBlockSize(size_t new_block_size) {
+    emp_assert(new_block_size > 0, "Schedule block size must be > 0");
+    block_size = new_block_size;
+  }
+  size_t GetBlockSize() const { return block_size; }
+
+  /**
+   * Input: (1) The random number generator; (2) the number of positions in
+   * the world; (3) the world's occupied positions (only needed for OCCUPIED).
+   *
+   * Output: The positions to process this update, in order.
+   *
+   * Purpose: To build the next update's schedule with the configured mode.
+   * The returned reference stays valid (and unchanged) until the next Build.
+   */
+  const emp::vector<size_t>& Build(emp::Random& random, size_t num_positions,
+                                   emp::Ptr<const OccupancyIndex> occupied = nullptr) {
+    switch (mode) {
+      case MODE::OCCUPIED:
+        emp_assert(occupied, "OCCUPIED schedules need the occupied positions");
+        occupied->GetPositions(order);
+        emp::Shuffle(random, order);
+        break;
+      case MODE::BLOCKED_RANDOM:
+        FillBlockedPermutation(random, num_positions);
+        break;
+      default:
+        FillPermutation(random, num_positions);
+        break;
+    }
+    return order;
+  }
+
+  const emp::vector<size_t>& GetOrder() const { return order; }
+};
+
+const std::unordered_map<
+  std::string,
+  UpdateSchedule::MODE
+> UpdateSchedule::mode_cfg_mapping = {
+  {"random", MODE::RANDOM},
+  {"occupied", MODE::OCCUPIED},
+  {"blocked-random", MODE::BLOCKED_RANDOM}
+};
@@ -5,6 +5,7 @@
 #include "Host.h"
 #include "Symbiont.h"
 #include "SpatialStructure.h"
+#include "SoAPopulation.h"
 #include "../utils.h"
 
 #include "../../Empirical/include/emp/datastructs/map_utils.hpp"
@@ -83,6 +84,29 @@ void SymWorld::Setup() {
   SetupHosts(&POP_SIZE);
   long unsigned int total_syms = POP_SIZE * start_moi;
   SetupSymbionts(&total_syms);
+  SetupCheckpointResume();
+}
+
+/**
+ * Input: None.
+ *
+ * Output: A new host to be filled in from a checkpoint.
+ *
+ * Purpose: To create hosts of the right type when loading a checkpoint.
+ */
+emp::Ptr<Organism> SymWorld::MakeCheckpointHost() {
+  return emp::NewPtr<Host>(&GetRandom(), this, my_config, 0);
+}
+
+/**
+ * Input: None.
+ *
+ * Output: A new symbiont to be filled in from a checkpoint.
+ *
+ * Purpose: To create symbionts of the right type when loading a checkpoint.
+ */
+emp::Ptr<Organism> SymWorld::MakeCheckpointSymbiont() {
+  return emp::NewPtr<Symbiont>(&GetRandom(), this, my_config, 0);
 }
 
 void SymWorld::SetupSpatialStructure() {
@@ -114,9 +138,21 @@ void SymWorld::SetupSpatialStructure() {
       emp_error("Given spatial structure mode undefined.");
       break;
   }
+  SetupSchedule();
   setup_spatial_structure = true;
 }
 
+void SymWorld::SetupSchedule() {
+  const std::string& cfg_schedule_mode = my_config->SCHEDULE_MODE();
+  utils::ValidateConfigMode(
+    UpdateSchedule::mode_cfg_mapping,
+    "SCHEDULE_MODE",
+    cfg_schedule_mode
+  );
+  update_schedule.SetMode(UpdateSchedule::mode_cfg_mapping.at(cfg_schedule_mode));
+  update_schedule.SetBlockSize(std::max<size_t>(1, my_config->SCHEDULE_BLOCK_SIZE()));
+}
+
 
 void SymWorld::SetupSpatialStructure_WellMixed() {
   // Resize world to maximum population size
@@ -138,16 +174,41 @@ void SymWorld::SetupSpatialStructure_Grid() {
 }
 
 
-void SymWorld::SetupSpatialStructure_Load() {
-  const std::string& load_mode = my_config->SPATIAL_STRUCT_LOAD_MODE();
+/**
+ * Input: The spatial structure to fill in and the config naming the structure
+ * file and its load mode.
+ *
+ * Output: None
+ *
+ * Purpose: To read a spatial structure from disk. Exits if the structure can't
+ * be loaded.
+ */
+void SymWorld::LoadSpatialStructure(SpatialStructure& structure, SymConfigBase& config) {
+  const std::string& load_mode = config.SPATIAL_STRUCT_LOAD_MODE();
   if (load_mode == "matrix") {
-    spatial_structure.LoadStructureFromMatrix(my_config->SPATIAL_STRUCT_CFG_PATH());
+    structure.LoadStructureFromMatrix(config.SPATIAL_STRUCT_CFG_PATH());
   } else if (load_mode == "edges") {
-    spatial_structure.LoadStructureFromEdgeCSV(my_config->SPATIAL_STRUCT_CFG_PATH());
+    structure.LoadStructureFromEdgeCSV(
+      config.SPATIAL_STRUCT_CFG_PATH(),
+      config.SPATIAL_STRUCT_CACHE_PATH()
+    );
+  } else if (load_mode == "binary") {
+    if (!structure.LoadStructureFromBinary(config.SPATIAL_STRUCT_CFG_PATH())) {
+      std::cout << "Unable to load spatial structure (" << config.SPATIAL_STRUCT_CFG_PATH() << ")" << std::endl;
+      exit(-1);
+    }
   } else {
     std::cout << "Unknown spatial structure load mode (" << load_mode << ")" << std::endl;
     exit(-1);
   }
+}
+
+void SymWorld::SetupSpatialStructure_Load() {
+  if (shared_spatial_structure == nullptr) {
+    LoadSpatialStructure(spatial_structure, *my_config);
+  } else {
+    spatial_structure = *shared_spatial_structure;
+  }
   // Initial population size should not exceed world size
   emp_assert(
     my_config->INIT_POP_SIZE() == -1 ||
@@ -225,25 +286,36 @@ void SymWorld::SetupPhylogenyTracking() {
   AddSystematics(host_sys);
   sym_sys->SetStorePosition(false);
 
-  sym_sys->AddSnapshotFun([](const taxon_t::sym_taxon_t& t) { return std::to_string(t.GetInfo()); }, "info");
-  host_sys->AddSnapshotFun([](const taxon_t::host_taxon_t& t) { return std::to_string(t.GetInfo()); }, "info");
+  // Index host ancestry as taxa are created, so host switches (and any other
+  // ancestry queries, see IsHostAncestor) don't walk host lineages
+  std::function<void(emp::Ptr<taxon_t::host_taxon_t>, Organism&)> index_host_ancestry =
+    [](emp::Ptr<taxon_t::host_taxon_t> taxon, Organism& org) {
+      ancestry::Link(taxon);
+    };
+  host_sys->OnNew(index_host_ancestry);
+
+  // Extra snapshot columns, written by WriteSystematicsSnapshot
+  sym_snapshot_columns.clear();
+  host_snapshot_columns.clear();
+  sym_snapshot_columns.push_back({"info", [](const taxon_t::sym_taxon_t& t) { return std::to_string(t.GetInfo()); }});
+  host_snapshot_columns.push_back({"info", [](const taxon_t::host_taxon_t& t) { return std::to_string(t.GetInfo()); }});
 
   // NOTE: Why not output this for all modes? Would make analysis scripts easier to port from one exp to another.
   if (phylo_taxon_type == PHYLO_TAXON_TYPE::TAG || phylo_taxon_type == PHYLO_TAXON_TYPE::INDIVIDUAL) {
-    sym_sys->AddSnapshotFun(
-      [](const taxon_t::sym_taxon_t& t) { return std::to_string((t.GetData()).GetIntVal()); },
-      "mean_int_val"
-    );
-    host_sys->AddSnapshotFun(
-      [](const taxon_t::host_taxon_t& t) { return std::to_string(t.GetData().GetIntVal()); },
-      "mean_int_val"
-    );
+    sym_snapshot_columns.push_back({
+      "mean_int_val",
+      [](const taxon_t::sym_taxon_t& t) { return std::to_string((t.GetData()).GetIntVal()); }
+    });
+    host_snapshot_columns.push_back({
+      "mean_int_val",
+      [](const taxon_t::host_taxon_t& t) { return std::to_string(t.GetData().GetIntVal()); }
+    });
   }
   if (phylo_taxon_type == PHYLO_TAXON_TYPE::INDIVIDUAL) {
-    sym_sys->AddSnapshotFun(
-      [](const taxon_t::sym_taxon_t& t) { return std::to_string(t.GetData().GetHostSwitch()); },
-      "lineage_host_switch_count"
-    );
+    sym_snapshot_columns.push_back({
+      "lineage_host_switch_count",
+      [](const taxon_t::sym_taxon_t& t) { return std::to_string(t.GetData().GetHostSwitch()); }
+    });
   }
 
   // NOTE: Could move the if statement out of experiment runtime by adjusting the functor based on config
@@ -335,6 +407,7 @@ void SymWorld::SetupTagMatching() {
         break;
     }
   }
+  tag_engine.SetMetric(tag_metric);
 }
 
 
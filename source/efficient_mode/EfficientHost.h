@@ -116,5 +116,29 @@ public:
     host_baby->SetEfficiency(GetEfficiency());
     return host_baby;
   }
+
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the efficient host's state, including its efficiency values, into a checkpoint.
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const override {
+    Host::SaveCheckpoint(writer);
+    writer.Write(efficiency);
+  }
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the efficient host's state from a checkpoint.
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) override {
+    Host::LoadCheckpoint(reader);
+    efficiency = reader.Read<double>();
+  }
 };
 #endif
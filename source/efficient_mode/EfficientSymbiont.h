@@ -291,5 +291,35 @@ public:
       }
     }
   }
+
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the efficient symbiont's state, including its efficiency and mutation values, into a checkpoint.
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const override {
+    Symbiont::SaveCheckpoint(writer);
+    writer.Write(efficiency);
+    writer.Write(ht_mut_size);
+    writer.Write(ht_mut_rate);
+    writer.Write(eff_mut_rate);
+  }
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the efficient symbiont's state from a checkpoint.
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) override {
+    Symbiont::LoadCheckpoint(reader);
+    efficiency = reader.Read<double>();
+    ht_mut_size = reader.Read<double>();
+    ht_mut_rate = reader.Read<double>();
+    eff_mut_rate = reader.Read<double>();
+  }
 };
 #endif
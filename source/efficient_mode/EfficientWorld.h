@@ -26,6 +26,11 @@ protected:
   void SetupSymbionts(long unsigned int* total_syms);
 
 public:
+  std::string GetCheckpointMode() const override { return "efficient"; }
+  // Definitions of checkpoint organism factories, expanded in EfficientWorldSetup.cc
+  emp::Ptr<Organism> MakeCheckpointHost() override;
+  emp::Ptr<Organism> MakeCheckpointSymbiont() override;
+
   /**
    * Input: a reference to a random number generator and a pointer to the configuration object for this experiment.
    *
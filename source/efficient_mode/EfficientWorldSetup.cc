@@ -52,4 +52,27 @@ void EfficientWorld::Setup() {
   if (efficient_config->EFFICIENCY_MUT_RATE() == -1) efficient_config->EFFICIENCY_MUT_RATE(efficient_config->HORIZ_MUTATION_RATE());
   SymWorld::Setup();
 }
+
+/**
+ * Input: None.
+ *
+ * Output: A new host to be filled in from a checkpoint.
+ *
+ * Purpose: To create efficient hosts when loading a checkpoint.
+ */
+emp::Ptr<Organism> EfficientWorld::MakeCheckpointHost() {
+  return emp::NewPtr<EfficientHost>(&GetRandom(), this, efficient_config, 0);
+}
+
+/**
+ * Input: None.
+ *
+ * Output: A new symbiont to be filled in from a checkpoint.
+ *
+ * Purpose: To create efficient symbionts when loading a checkpoint.
+ */
+emp::Ptr<Organism> EfficientWorld::MakeCheckpointSymbiont() {
+  return emp::NewPtr<EfficientSymbiont>(&GetRandom(), this, efficient_config, 0);
+}
+
 #endif
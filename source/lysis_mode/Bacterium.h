@@ -155,5 +155,29 @@ public:
     return processed_resources;
   }
 
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the bacterium's state, including its incorporation values, into a checkpoint.
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const override {
+    Host::SaveCheckpoint(writer);
+    writer.Write(host_incorporation_val);
+  }
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the bacterium's state from a checkpoint.
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) override {
+    Host::LoadCheckpoint(reader);
+    host_incorporation_val = reader.Read<double>();
+  }
+
 };//Bacterium
 #endif
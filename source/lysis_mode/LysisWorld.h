@@ -35,6 +35,11 @@ protected:
   void SetupSymbionts(long unsigned int* total_syms);
 
 public:
+  std::string GetCheckpointMode() const override { return "lysis"; }
+  // Definitions of checkpoint organism factories, expanded in LysisWorldSetup.cc
+  emp::Ptr<Organism> MakeCheckpointHost() override;
+  emp::Ptr<Organism> MakeCheckpointSymbiont() override;
+
   /**
    * Input: a reference to a random number generator and a pointer to the configuration object for this experiment.
    *
@@ -338,28 +343,26 @@ public:
       OnUpdate([this](size_t) {
         data_node_cfu -> Reset();
 
-        for (size_t i = 0; i < pop.size(); i++) {
-          if (IsOccupied(i)) {
-            //uninfected hosts
-            if ((pop[i]->GetSymbionts()).empty()) {
-              data_node_cfu->AddDatum(1);
-            }
+        host_positions.ForEach([this](size_t i) {
+          //uninfected hosts
+          if ((pop[i]->GetSymbionts()).empty()) {
+            data_node_cfu->AddDatum(1);
+          }
 
-            //infected hosts, check if all symbionts are lysogenic
-            if (pop[i]->HasSym()) {
-              emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
-              bool all_lysogenic = true;
-              for (long unsigned int j = 0; j < syms.size(); j++) {
-                if (syms[j]->IsPhage() && syms[j]->GetLysogeny() == false) {
-                  all_lysogenic = false;
-                }
-              }
-              if (all_lysogenic) {
-                data_node_cfu->AddDatum(1);
+          //infected hosts, check if all symbionts are lysogenic
+          if (pop[i]->HasSym()) {
+            emp::vector<emp::Ptr<Organism>>& syms = pop[i]->GetSymbionts();
+            bool all_lysogenic = true;
+            for (long unsigned int j = 0; j < syms.size(); j++) {
+              if (syms[j]->IsPhage() && syms[j]->GetLysogeny() == false) {
+                all_lysogenic = false;
               }
             }
-          } //endif
-        } //end for
+            if (all_lysogenic) {
+              data_node_cfu->AddDatum(1);
+            }
+          }
+        }); //end for each host
       }); //end OnUpdate
     } //end if
     return *data_node_cfu;
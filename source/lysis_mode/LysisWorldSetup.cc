@@ -45,4 +45,26 @@ void LysisWorld::SetupSymbionts(long unsigned int* total_syms) {
   }
 }
 
+/**
+ * Input: None.
+ *
+ * Output: A new host to be filled in from a checkpoint.
+ *
+ * Purpose: To create bacteria when loading a checkpoint.
+ */
+emp::Ptr<Organism> LysisWorld::MakeCheckpointHost() {
+  return emp::NewPtr<Bacterium>(&GetRandom(), this, lysis_config, 0);
+}
+
+/**
+ * Input: None.
+ *
+ * Output: A new symbiont to be filled in from a checkpoint.
+ *
+ * Purpose: To create phage when loading a checkpoint.
+ */
+emp::Ptr<Organism> LysisWorld::MakeCheckpointSymbiont() {
+  return emp::NewPtr<Phage>(&GetRandom(), this, lysis_config, 0);
+}
+
 #endif
@@ -431,5 +431,37 @@ public:
       my_world->MoveFreeSym(location);
     }
   }
+
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the phage's state, including its lysis values, into a checkpoint.
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const override {
+    Symbiont::SaveCheckpoint(writer);
+    writer.Write(burst_timer);
+    writer.Write(lysogeny);
+    writer.Write(incorporation_val);
+    writer.Write(chance_of_lysis);
+    writer.Write(induction_chance);
+  }
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the phage's state from a checkpoint.
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) override {
+    Symbiont::LoadCheckpoint(reader);
+    burst_timer = reader.Read<double>();
+    lysogeny = reader.Read<bool>();
+    incorporation_val = reader.Read<double>();
+    chance_of_lysis = reader.Read<double>();
+    induction_chance = reader.Read<double>();
+  }
 };
 #endif
@@ -0,0 +1,311 @@
+#ifndef SYMBULATION_BATCH_H
+#define SYMBULATION_BATCH_H
+
+#include "symbulation.h"
+
+#include "../../Empirical/include/emp/base/vector.hpp"
+#include "../../Empirical/include/emp/tools/string_utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+
+/**
+ * Batch mode: runs many replicates (a range of seeds, crossed with a sweep
+ * over config values) as independent worlds on a pool of worker threads in a
+ * single process, in place of launching the executable once per replicate
+ * (e.g., from stats_scripts/simple_repeat.py).
+ *
+ * Batch options are given alongside the usual config overrides:
+ *   --seeds START:END       Seeds START up to (not including) END
+ *   --sweep NAME=V1,V2,...  Run every replicate with each value of NAME (repeatable)
+ *   --threads N             Worker threads (defaults to the number of cores)
+ *   --no-shared-setup       Build setup (IO bank, spatial structure) per replicate
+ *
+ * Each replicate's FILE_NAME gets the swept values appended, so every
+ * replicate's data files are written under their own prefix. Lines a replicate
+ * prints to std::cout are prefixed with its seed and label.
+ */
+namespace batch {
+
+struct SweepParam {
+  std::string name;
+  emp::vector<std::string> values;
+};
+
+struct BatchSpec {
+  bool has_seeds = false;
+  int seed_start = 0;
+  int seed_end = 0;
+  emp::vector<SweepParam> sweep;
+  size_t num_threads = 0;   // 0 means use every core
+  bool share_setup = true;  // Build immutable setup once and share it across replicates
+};
+
+struct Replicate {
+  int seed = 0;
+  emp::vector<std::pair<std::string, std::string>> settings; // Swept config values
+  std::string label; // Appended to FILE_NAME
+};
+
+/**
+ * Input: The command line arguments and the batch spec to fill in.
+ *
+ * Output: Boolean indicating whether the batch options were valid.
+ *
+ * Purpose: To pull the batch options out of the command line. Batch options
+ * are removed from argv (and argc updated), leaving only the config options
+ * for CheckConfigFile.
+ */
+bool ParseBatchArgs(int& argc, char* argv[], BatchSpec& spec) {
+  int kept = 1;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = (i + 1 < argc);
+    if (arg == "--seeds" && has_value) {
+      const std::string range = argv[++i];
+      const size_t colon = range.find(':');
+      if (colon == std::string::npos) {
+        std::cerr << "Batch seeds must be given as START:END (got " << range << ")" << std::endl;
+        return false;
+      }
+      spec.seed_start = std::atoi(range.substr(0, colon).c_str());
+      spec.seed_end = std::atoi(range.substr(colon + 1).c_str());
+      spec.has_seeds = true;
+      if (spec.seed_end <= spec.seed_start) {
+        std::cerr << "Batch seed range is empty (" << range << ")" << std::endl;
+        return false;
+      }
+    } else if (arg == "--sweep" && has_value) {
+      const std::string param = argv[++i];
+      const size_t equals = param.find('=');
+      if (equals == std::string::npos || equals == 0 || equals + 1 == param.size()) {
+        std::cerr << "Batch sweeps must be given as NAME=V1,V2,... (got " << param << ")" << std::endl;
+        return false;
+      }
+      spec.sweep.push_back({param.substr(0, equals), emp::slice(param.substr(equals + 1), ',')});
+    } else if (arg == "--threads" && has_value) {
+      spec.num_threads = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--no-shared-setup") {
+      spec.share_setup = false;
+    } else if (arg == "--seeds" || arg == "--sweep" || arg == "--threads") {
+      std::cerr << "Missing value for batch option " << arg << std::endl;
+      return false;
+    } else {
+      argv[kept++] = argv[i];
+    }
+  }
+  argc = kept;
+  return true;
+}
+
+/**
+ * Input: The batch spec and the seed to use if the spec has no seed range.
+ *
+ * Output: Every replicate in the batch (each sweep combination for each seed).
+ *
+ * Purpose: To lay out the batch. Replicates are ordered by sweep combination,
+ * then seed.
+ */
+emp::vector<Replicate> BuildReplicates(const BatchSpec& spec, int default_seed) {
+  emp::vector<Replicate> combos(1);
+  for (const SweepParam& param : spec.sweep) {
+    emp::vector<Replicate> next_combos;
+    for (const Replicate& combo : combos) {
+      for (const std::string& value : param.values) {
+        Replicate next = combo;
+        next.settings.emplace_back(param.name, value);
+        next.label += "_" + param.name + value;
+        next_combos.push_back(next);
+      }
+    }
+    combos = std::move(next_combos);
+  }
+
+  const int seed_start = spec.has_seeds ? spec.seed_start : default_seed;
+  const int seed_end = spec.has_seeds ? spec.seed_end : default_seed + 1;
+  emp::vector<Replicate> replicates;
+  for (const Replicate& combo : combos) {
+    for (int seed = seed_start; seed < seed_end; ++seed) {
+      replicates.push_back(combo);
+      replicates.back().seed = seed;
+    }
+  }
+  return replicates;
+}
+
+/**
+ * Input: The batch spec and the base config.
+ *
+ * Output: Boolean indicating whether every swept setting exists in the config.
+ *
+ * Purpose: To catch misspelled sweep settings before any replicate runs.
+ */
+template<typename CONFIG_T>
+bool CheckSweepSettings(const BatchSpec& spec, CONFIG_T& config) {
+  for (const SweepParam& param : spec.sweep) {
+    if (!config.Has(param.name)) {
+      std::cerr << "Unknown config setting in batch sweep: " << param.name << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Input: The base settings (as written by Config::Write), a replicate, and the
+ * (freshly constructed) config to fill in for it.
+ *
+ * Output: None
+ *
+ * Purpose: To give each replicate its own copy of the config, with its seed,
+ * swept values, and FILE_NAME prefix applied.
+ */
+template<typename CONFIG_T>
+void SetupReplicateConfig(const std::string& base_settings, const Replicate& replicate, CONFIG_T& config) {
+  std::istringstream settings_stream(base_settings);
+  config.Read(settings_stream);
+  for (const auto& [name, value] : replicate.settings) {
+    config.Set(name, value);
+  }
+  config.SEED(replicate.seed);
+  config.FILE_NAME(config.FILE_NAME() + replicate.label);
+}
+
+/**
+ * Stream buffer that std::cout writes to while replicates run. Each thread's
+ * output is gathered into whole lines, which are written to the real stdout
+ * one at a time (so lines from different replicates never interleave),
+ * prefixed with the thread's current replicate.
+ */
+class ReplicateOutputBuf : public std::streambuf {
+protected:
+  struct ThreadOutput {
+    std::string prefix; // Empty outside of a replicate (e.g., on the main thread)
+    std::string line;   // Output since the last newline
+  };
+
+  std::streambuf* out;
+  std::mutex out_lock;
+
+  static ThreadOutput& GetThreadOutput() {
+    static thread_local ThreadOutput thread_output;
+    return thread_output;
+  }
+
+  void WriteLine(ThreadOutput& output) {
+    std::lock_guard<std::mutex> lock(out_lock);
+    out->sputn(output.prefix.data(), output.prefix.size());
+    out->sputn(output.line.data(), output.line.size());
+    out->pubsync();
+    output.line.clear();
+  }
+
+  int_type overflow(int_type ch) override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+    const char c = traits_type::to_char_type(ch);
+    xsputn(&c, 1);
+    return ch;
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize count) override {
+    ThreadOutput& output = GetThreadOutput();
+    for (std::streamsize begin = 0; begin < count; ) {
+      const char* newline = std::find(s + begin, s + count, '\n');
+      const std::streamsize end = (newline == s + count) ? count : (newline - s) + 1;
+      output.line.append(s + begin, end - begin);
+      if (newline != s + count) WriteLine(output);
+      begin = end;
+    }
+    return count;
+  }
+
+public:
+  ReplicateOutputBuf(std::streambuf* out) : out(out) { }
+
+  // Prefix for lines the calling thread prints from now on
+  static void SetPrefix(const std::string& prefix) { GetThreadOutput().prefix = prefix; }
+
+  // Write out (and end) the calling thread's unfinished line, if any
+  void FlushThread() {
+    ThreadOutput& output = GetThreadOutput();
+    if (output.line.empty()) return;
+    output.line += '\n';
+    WriteLine(output);
+  }
+};
+
+/**
+ * Input: The replicates to run, the number of worker threads, and the function
+ * that runs one replicate (given the replicate and its index).
+ *
+ * Output: None
+ *
+ * Purpose: To run replicates on a pool of worker threads. Workers take the next
+ * unstarted replicate until none are left, so long and short replicates
+ * balance out. Each replicate's world must live entirely on its worker thread.
+ * While replicates run, std::cout goes through a ReplicateOutputBuf.
+ */
+void RunReplicates(
+  const emp::vector<Replicate>& replicates,
+  size_t num_threads,
+  const std::function<void(const Replicate&, size_t)>& fun_run_replicate
+) {
+  if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+  num_threads = std::min(num_threads, replicates.size());
+
+  ReplicateOutputBuf replicate_output(std::cout.rdbuf());
+  std::streambuf* const cout_buf = std::cout.rdbuf(&replicate_output);
+
+  std::atomic<size_t> next_replicate = 0;
+  std::atomic<size_t> num_done = 0;
+  auto worker = [&]() {
+    for (size_t rep_id = next_replicate++; rep_id < replicates.size(); rep_id = next_replicate++) {
+      const Replicate& replicate = replicates[rep_id];
+      ReplicateOutputBuf::SetPrefix("[SEED " + std::to_string(replicate.seed) + replicate.label + "] ");
+      fun_run_replicate(replicate, rep_id);
+      replicate_output.FlushThread();
+      ReplicateOutputBuf::SetPrefix("");
+      std::cout << "Finished replicate " << ++num_done << "/" << replicates.size()
+                << " (SEED " << replicate.seed << replicate.label << ")" << std::endl;
+    }
+  };
+
+  emp::vector<std::thread> workers;
+  for (size_t i = 0; i < num_threads; ++i) workers.emplace_back(worker);
+  for (std::thread& t : workers) t.join();
+
+  replicate_output.FlushThread();
+  std::cout.rdbuf(cout_buf);
+}
+
+/**
+ * Input: The batch spec and the config settings the shared setup is built from.
+ *
+ * Output: Boolean indicating whether setup can be shared across replicates.
+ *
+ * Purpose: To check that nothing the shared setup is built from is swept.
+ * Sweeping one of these settings turns off setup sharing instead.
+ */
+bool CanShareSetup(const BatchSpec& spec, const emp::vector<std::string>& setup_settings) {
+  if (!spec.share_setup) return false;
+  for (const SweepParam& param : spec.sweep) {
+    if (std::find(setup_settings.begin(), setup_settings.end(), param.name) != setup_settings.end()) {
+      std::cout << "Not sharing setup across replicates because " << param.name << " is swept" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "../default_mode/SymWorld.h"
+#include "../default_mode/WorldSetup.cc"
+#include "../default_mode/DataNodes.h"
+#include "symbulation_batch.h"
+
+#include <sstream>
+
+// This is the main function for the NATIVE batch version of default mode: it
+// runs every replicate of a seed range/config sweep in one process (see
+// symbulation_batch.h for the batch options).
+int symbulation_main(int argc, char * argv[])
+{
+  batch::BatchSpec spec;
+  if (!batch::ParseBatchArgs(argc, argv, spec)) return 1;
+
+  SymConfigBase config;
+  CheckConfigFile(config, argc, argv);
+  if (!batch::CheckSweepSettings(spec, config)) return 1;
+
+  config.Write(std::cout);
+  std::stringstream base_settings;
+  config.Write(base_settings);
+
+  // Read a loaded spatial structure once, rather than once per replicate.
+  SpatialStructure shared_spatial_structure;
+  const bool share_spatial_structure = config.SPATIAL_STRUCT_MODE() == "load" &&
+    batch::CanShareSetup(spec, {"SPATIAL_STRUCT_MODE", "SPATIAL_STRUCT_LOAD_MODE", "SPATIAL_STRUCT_CFG_PATH", "SPATIAL_STRUCT_CACHE_PATH"});
+  if (share_spatial_structure) {
+    SymWorld::LoadSpatialStructure(shared_spatial_structure, config);
+  }
+
+  const emp::vector<batch::Replicate> replicates = batch::BuildReplicates(spec, config.SEED());
+  batch::RunReplicates(replicates, spec.num_threads,
+    [&](const batch::Replicate& replicate, size_t) {
+      SymConfigBase rep_config;
+      batch::SetupReplicateConfig(base_settings.str(), replicate, rep_config);
+      emp::Random random(rep_config.SEED());
+
+      SymWorld world(random, &rep_config);
+      if (share_spatial_structure) world.SetSharedSpatialStructure(shared_spatial_structure);
+
+      world.Setup();
+      world.CreateDataFiles();
+
+      world.RunExperiment(false);
+
+      //retrieve the dominant taxons for each organism and write them to a file
+      std::string file_ending = "_SEED" + std::to_string(rep_config.SEED()) + ".data";
+      if(rep_config.PHYLOGENY() == 1){
+        world.WritePhylogenyFile(rep_config.FILE_PATH()+"Phylogeny_"+rep_config.FILE_NAME()+file_ending);
+      }
+      if (rep_config.TAG_MATCHING() == 1 && rep_config.WRITE_TAG_MATRIX() == 1) {
+        world.WriteTagMatrixFile(rep_config.FILE_PATH() + "TagMatrix" + rep_config.FILE_NAME() + file_ending);
+      }
+      if (rep_config.WRITE_ORG_DUMP_FILE() == 1) {
+        world.WriteOrgDumpFile(rep_config.FILE_PATH() + "OrgDump" + rep_config.FILE_NAME() + file_ending);
+      }
+    }
+  );
+  return 0;
+}
+
+/*
+This definition guard prevents main from being defined twice during testing.
+In testing, Catch will define a main function which will initiate tests
+(including testing the symbulation_main function above).
+*/
+#ifndef CATCH_CONFIG_MAIN
+int main(int argc, char * argv[]) {
+  return symbulation_main(argc, argv);
+}
+#endif
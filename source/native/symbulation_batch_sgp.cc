@@ -0,0 +1,93 @@
+#include "../ConfigSetup.h"
+#include "../default_mode/DataNodes.h"
+#include "../default_mode/Host.h"
+#include "../default_mode/Symbiont.h"
+
+#include "../sgp_mode/hardware/SGPHardwareSpec.h"
+#include "../sgp_mode/SGPConfigSetup.h"
+#include "../sgp_mode/SGPWorld.h"
+
+#include "symbulation_batch.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Empirical doesn't support more than one translation unit, so any CC files are
+// included last.
+#include "../default_mode/WorldSetup.cc"
+#include "../sgp_mode/SGPWorld.cc"
+#include "../sgp_mode/SGPWorldSetup.cc"
+#include "../sgp_mode/SGPWorldData.cc"
+#include "../sgp_mode/SGPW_InteractionMechanismSetup.cc"
+#include "../sgp_mode/SGPW_TaskProfileSetup.cc"
+
+// This is the main function for the NATIVE batch version of SGP mode: it runs
+// every replicate of a seed range/config sweep in one process (see
+// symbulation_batch.h for the batch options).
+// NOTE - Replicates already run in parallel, so THREAD_COUNT should usually be 1.
+int symbulation_main(int argc, char *argv[]) {
+  batch::BatchSpec spec;
+  if (!batch::ParseBatchArgs(argc, argv, spec)) return 1;
+
+  sgpmode::SymConfigSGP config;
+  CheckConfigFile(config, argc, argv);
+  if (!batch::CheckSweepSettings(spec, config)) return 1;
+
+  std::stringstream base_settings;
+  config.Write(base_settings);
+
+  // Generate the task IO bank once and share it across replicates. The bank is
+  // drawn from the base SEED, so every replicate sees the same environments
+  // (use --no-shared-setup to reproduce single runs exactly).
+  emp::Random bank_random(config.SEED());
+  sgpmode::tasks::LogicTaskEnvironment shared_task_env(bank_random);
+  const bool share_io_bank =
+    batch::CanShareSetup(spec, {"TASK_ENV_CFG_PATH", "TASK_IO_BANK_SIZE", "TASK_IO_UNIQUE_OUTPUT", "TASK_IO_BANK_SEEDED"});
+  if (share_io_bank) {
+    shared_task_env.Setup(
+      config.TASK_ENV_CFG_PATH(),
+      config.TASK_IO_BANK_SIZE(),
+      config.TASK_IO_UNIQUE_OUTPUT(),
+      config.TASK_IO_BANK_SEEDED(),
+      config.TASK_IO_BANK_THREADS()
+    );
+  }
+
+  // Read a loaded spatial structure once, rather than once per replicate.
+  SpatialStructure shared_spatial_structure;
+  const bool share_spatial_structure = config.SPATIAL_STRUCT_MODE() == "load" &&
+    batch::CanShareSetup(spec, {"SPATIAL_STRUCT_MODE", "SPATIAL_STRUCT_LOAD_MODE", "SPATIAL_STRUCT_CFG_PATH", "SPATIAL_STRUCT_CACHE_PATH"});
+  if (share_spatial_structure) {
+    SymWorld::LoadSpatialStructure(shared_spatial_structure, config);
+  }
+
+  const emp::vector<batch::Replicate> replicates = batch::BuildReplicates(spec, config.SEED());
+  batch::RunReplicates(replicates, spec.num_threads,
+    [&](const batch::Replicate& replicate, size_t) {
+      sgpmode::SymConfigSGP rep_config;
+      batch::SetupReplicateConfig(base_settings.str(), replicate, rep_config);
+      // SGP data file names don't include the seed, so add it to the prefix.
+      rep_config.FILE_NAME(rep_config.FILE_NAME() + "_SEED" + std::to_string(rep_config.SEED()));
+      emp::Random random(rep_config.SEED());
+
+      sgpmode::SGPWorld world(random, &rep_config);
+      if (share_io_bank) world.SetSharedIOBank(shared_task_env.GetIOBank());
+      if (share_spatial_structure) world.SetSharedSpatialStructure(shared_spatial_structure);
+      world.Setup();
+      world.Run(false);
+
+      world.OutputDominantDataFile();
+    }
+  );
+  return 0;
+}
+
+/*
+This definition guard prevents main from being defined twice during testing.
+In testing, Catch will define a main function which will initiate tests
+(including testing the symbulation_main function above).
+*/
+#ifndef CATCH_CONFIG_MAIN
+int main(int argc, char *argv[]) { return symbulation_main(argc, argv); }
+#endif
@@ -0,0 +1,55 @@
+#include "../ColumnarData.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// Converts columnar data files (written with DATA_FILE_FORMAT columnar) back
+// into the CSV files the same run would have written with DATA_FILE_FORMAT csv.
+//
+// Usage: symbulation_columnar_to_csv FILE.col [OUTPUT]
+//   OUTPUT defaults to FILE (the input path without .col); use - for stdout.
+// Compressed files (written by builds with ZLIB=1) need a converter built with
+// ZLIB=1 too, e.g., make columnar-to-csv ZLIB=1.
+int columnar_to_csv_main(int argc, char * argv[])
+{
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " FILE" << columnar::FILE_EXTENSION << " [OUTPUT]" << std::endl;
+    return 1;
+  }
+  const std::string in_path = argv[1];
+  std::string out_path = (argc == 3) ? argv[2] : in_path;
+  if (argc == 2) {
+    const std::string& ext = columnar::FILE_EXTENSION;
+    if (out_path.size() > ext.size() && out_path.compare(out_path.size() - ext.size(), ext.size(), ext) == 0) {
+      out_path.resize(out_path.size() - ext.size());
+    } else {
+      out_path += ".csv";
+    }
+  }
+
+  columnar::Table table;
+  if (!columnar::ReadTable(in_path, table)) {
+    std::cerr << "Could not read columnar data file " << in_path;
+    if (!columnar::HasCodec(columnar::CODEC::DEFLATE)) std::cerr << " (if it is compressed, rebuild with ZLIB=1)";
+    std::cerr << std::endl;
+    return 1;
+  }
+  if (out_path == "-") {
+    columnar::WriteCSV(table, std::cout);
+    return 0;
+  }
+  std::ofstream out(out_path);
+  if (!out) {
+    std::cerr << "Could not open " << out_path << " for writing" << std::endl;
+    return 1;
+  }
+  columnar::WriteCSV(table, out);
+  return out ? 0 : 1;
+}
+
+#ifndef CATCH_CONFIG_MAIN
+int main(int argc, char * argv[]) {
+  return columnar_to_csv_main(argc, argv);
+}
+#endif
@@ -160,6 +160,30 @@ public:
     return host_baby;
   }
 
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the PGG host's state, including its public goods values, into a checkpoint.
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const override {
+    Host::SaveCheckpoint(writer);
+    writer.Write(sourcepool);
+  }
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the PGG host's state from a checkpoint.
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) override {
+    Host::LoadCheckpoint(reader);
+    sourcepool = reader.Read<double>();
+  }
+
 };//PGGHost
 
 #endif
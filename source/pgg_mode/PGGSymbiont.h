@@ -184,5 +184,29 @@ public:
     std::string formattedstring = temp.str();
     return formattedstring;
   }
+
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the PGG symbiont's state, including its public goods values, into a checkpoint.
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const override {
+    Symbiont::SaveCheckpoint(writer);
+    writer.Write(PGG_donate);
+  }
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the PGG symbiont's state from a checkpoint.
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) override {
+    Symbiont::LoadCheckpoint(reader);
+    PGG_donate = reader.Read<double>();
+  }
 };//PGGSymbiont
 #endif
@@ -69,4 +69,26 @@ void PGGWorld::SetupSymbionts(long unsigned int* total_syms) {
   }
 }
 
+/**
+ * Input: None.
+ *
+ * Output: A new host to be filled in from a checkpoint.
+ *
+ * Purpose: To create PGG hosts when loading a checkpoint.
+ */
+emp::Ptr<Organism> PGGWorld::MakeCheckpointHost() {
+  return emp::NewPtr<PGGHost>(&GetRandom(), this, pgg_config, 0);
+}
+
+/**
+ * Input: None.
+ *
+ * Output: A new symbiont to be filled in from a checkpoint.
+ *
+ * Purpose: To create PGG symbionts when loading a checkpoint.
+ */
+emp::Ptr<Organism> PGGWorld::MakeCheckpointSymbiont() {
+  return emp::NewPtr<PGGSymbiont>(&GetRandom(), this, pgg_config, 0);
+}
+
 #endif
@@ -0,0 +1,139 @@
+#ifndef SGPMODE_COMPATIBILITY_POLICY_H
+#define SGPMODE_COMPATIBILITY_POLICY_H
+
+#include "org_type_info.h"
+#include "../utils.h"
+
+#include "emp/base/assert.hpp"
+#include "emp/bits/Bits.hpp"
+
+#include <type_traits>
+
+/**
+ * Compile-time versions of the host-symbiont task profile and compatibility
+ * modes (TASK_PROFILE_MODE and INTERACTION_PROFILE_COMPATIBILITY_MODE).
+ *
+ * The world stores which modes are configured and dispatches on them once per
+ * call (or once per loop over a host's symbionts, see
+ * SGPWorld::CountCompatibleSymbionts), so the checks themselves are inlined
+ * instead of going through a chain of std::function calls.
+ */
+namespace sgpmode::policy {
+
+using task_profile_mode_t = org_info::TaskProfileMode;
+using interaction_compat_mode_t = org_info::InteractionCompatibilityMode;
+
+template<task_profile_mode_t MODE>
+using task_profile_mode_c = std::integral_constant<task_profile_mode_t, MODE>;
+
+template<interaction_compat_mode_t MODE>
+using interaction_compat_mode_c = std::integral_constant<interaction_compat_mode_t, MODE>;
+
+/**
+ * Input: An organism's CPU state.
+ *
+ * Output: The organism's task profile under the given task profile mode.
+ *
+ * Purpose: To select which tasks count toward an organism's task profile.
+ */
+template<task_profile_mode_t MODE, typename CPU_STATE_T>
+inline const emp::BitVector& SelectTaskProfile(const CPU_STATE_T& state) {
+  if constexpr (MODE == task_profile_mode_t::PARENT_ALL) {
+    return state.GetParentTasksPerformed();
+  } else if constexpr (MODE == task_profile_mode_t::PARENT_FIRST) {
+    return state.GetParentFirstTaskPerformed();
+  } else if constexpr (MODE == task_profile_mode_t::SELF_ALL) {
+    return state.GetTasksPerformed();
+  } else {
+    return state.GetFirstTaskPerformed();
+  }
+}
+
+/**
+ * Input: Two task profiles.
+ *
+ * Output: Boolean indicating whether the task profiles are compatible under the
+ * given compatibility mode.
+ *
+ * Purpose: To check task profile compatibility. Profiles are always compatible
+ * unless compatibility is task-based.
+ */
+template<interaction_compat_mode_t MODE>
+inline bool TaskProfilesCompatible(const emp::BitVector& a, const emp::BitVector& b) {
+  if constexpr (MODE == interaction_compat_mode_t::TASK_ANY_MATCH) {
+    return utils::AnyMatchingOnes(a, b);
+  } else if constexpr (MODE == interaction_compat_mode_t::TASK_PERFECT_MATCH) {
+    return a == b;
+  } else {
+    return true;
+  }
+}
+
+/**
+ * A comparison between a host's task profile and one of its symbionts' task
+ * profiles, tagged with the task profile versions it was computed from (see
+ * CPUState::GetTaskProfileVersion). Versions are never 0, so a default
+ * TaskProfileMatch is never current.
+ */
+struct TaskProfileMatch {
+  size_t host_version = 0;
+  size_t sym_version = 0;
+  bool compatible = false;    // Task profiles compatible under the configured mode
+  size_t match_strength = 0;  // Number of tasks in both task profiles
+
+  bool IsCurrent(size_t cur_host_version, size_t cur_sym_version) const {
+    return host_version == cur_host_version && sym_version == cur_sym_version;
+  }
+};
+
+/**
+ * Input: A task profile mode and a function taking the mode as a
+ * task_profile_mode_c.
+ *
+ * Output: The function's result.
+ *
+ * Purpose: To turn a (runtime) task profile mode into a compile-time constant.
+ */
+template<typename FUN_T>
+inline decltype(auto) WithTaskProfileMode(task_profile_mode_t mode, FUN_T&& fun) {
+  switch (mode) {
+    case task_profile_mode_t::PARENT_ALL:
+      return fun(task_profile_mode_c<task_profile_mode_t::PARENT_ALL>{});
+    case task_profile_mode_t::PARENT_FIRST:
+      return fun(task_profile_mode_c<task_profile_mode_t::PARENT_FIRST>{});
+    case task_profile_mode_t::SELF_ALL:
+      return fun(task_profile_mode_c<task_profile_mode_t::SELF_ALL>{});
+    case task_profile_mode_t::SELF_FIRST:
+      break;
+  }
+  emp_assert(mode == task_profile_mode_t::SELF_FIRST);
+  return fun(task_profile_mode_c<task_profile_mode_t::SELF_FIRST>{});
+}
+
+/**
+ * Input: An interaction compatibility mode and a function taking the mode as an
+ * interaction_compat_mode_c.
+ *
+ * Output: The function's result.
+ *
+ * Purpose: To turn a (runtime) compatibility mode into a compile-time constant.
+ */
+template<typename FUN_T>
+inline decltype(auto) WithInteractionCompatMode(interaction_compat_mode_t mode, FUN_T&& fun) {
+  switch (mode) {
+    case interaction_compat_mode_t::ALWAYS:
+      return fun(interaction_compat_mode_c<interaction_compat_mode_t::ALWAYS>{});
+    case interaction_compat_mode_t::TASK_ANY_MATCH:
+      return fun(interaction_compat_mode_c<interaction_compat_mode_t::TASK_ANY_MATCH>{});
+    case interaction_compat_mode_t::TASK_PERFECT_MATCH:
+      return fun(interaction_compat_mode_c<interaction_compat_mode_t::TASK_PERFECT_MATCH>{});
+    case interaction_compat_mode_t::TAG_PROBABILISTIC_MATCH:
+      break;
+  }
+  emp_assert(mode == interaction_compat_mode_t::TAG_PROBABILISTIC_MATCH);
+  return fun(interaction_compat_mode_c<interaction_compat_mode_t::TAG_PROBABILISTIC_MATCH>{});
+}
+
+}
+
+#endif
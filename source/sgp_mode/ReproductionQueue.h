@@ -2,99 +2,168 @@
 
 #include "../Organism.h"
 
-#include <deque>
-#include <functional>
+#include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
+#include "emp/math/random_utils.hpp"
 
-namespace sgpmode {
+#include <cstdint>
 
-// TODO - tests!
+namespace sgpmode {
 
 // Encapsulates information about a reproduction request
 struct ReproEvent {
   emp::Ptr<Organism> org; // Organism to reproduce
   emp::WorldPosition pos; // Location of reproduction event in world
-  bool valid = true;
-  // size_t event_id = 0;
   ReproEvent() = default;
   ReproEvent(
     emp::Ptr<Organism> in_org,
-    const emp::WorldPosition& in_pos,
-    bool in_valid=true
-  ) : org(in_org), pos(in_pos), valid(in_valid) { }
+    const emp::WorldPosition& in_pos
+  ) : org(in_org), pos(in_pos) { }
 };
 
 /*
   Tracks organisms queued for reproduction.
+  - The queue is split into one append-only segment per scheduler worker so
+    that threads can enqueue without locking.
+  - Each event gets a stable 64-bit id (segment in the high bits, position in
+    segment in the low bits). Ids remain valid until the queue is processed.
+  - Invalidated events are marked in a per-segment tombstone bitmap.
+  - Before processing, segments are merged into a single processing order.
+    With one segment, events are processed in the order they were queued.
+    With several segments, the merged order is shuffled with the given rng
+    (so no worker's events are favored), which is deterministic for a given
+    seed and segment count.
 */
 class ReproductionQueue {
 public:
-  using fun_repro_org_t = std::function<void(ReproEvent&)>;
+  using event_id_t = uint64_t;
+  static constexpr size_t SEGMENT_ID_SHIFT = 48;
+  static constexpr event_id_t SEGMENT_POS_MASK = (event_id_t(1) << SEGMENT_ID_SHIFT) - 1;
+
 protected:
-  // TODO - queue vector
-  emp::vector<ReproEvent> queue;
-  fun_repro_org_t fun_reproduce_org;
-  // TODO - set tracking what is in the queue
-  // std::unordered_set in
-  // TODO - next_id
-  // size_t next_id = 0; // id to assign to next reproduction event (will be unique with respect to all other currently queued events)
+  struct Segment {
+    emp::vector<ReproEvent> events;
+    emp::vector<uint64_t> tombstones; // One bit per event; set if event has been invalidated
+
+    void Clear() {
+      events.clear();
+      tombstones.clear();
+    }
+  };
+
+  emp::vector<Segment> segments = emp::vector<Segment>(1);
+  emp::vector<event_id_t> merged_ids; // Processing order (reused across updates)
+
+  static size_t GetSegmentID(event_id_t event_id) {
+    return static_cast<size_t>(event_id >> SEGMENT_ID_SHIFT);
+  }
+  static size_t GetSegmentPos(event_id_t event_id) {
+    return static_cast<size_t>(event_id & SEGMENT_POS_MASK);
+  }
+  static event_id_t MakeEventID(size_t segment_id, size_t segment_pos) {
+    emp_assert(segment_pos <= SEGMENT_POS_MASK);
+    return (static_cast<event_id_t>(segment_id) << SEGMENT_ID_SHIFT) | segment_pos;
+  }
+
+  // Merge segments into processing order (see class comment).
+  void MergeSegments(emp::Random& random) {
+    merged_ids.clear();
+    for (size_t segment_id = 0; segment_id < segments.size(); ++segment_id) {
+      const size_t num_events = segments[segment_id].events.size();
+      for (size_t segment_pos = 0; segment_pos < num_events; ++segment_pos) {
+        merged_ids.emplace_back(MakeEventID(segment_id, segment_pos));
+      }
+    }
+    if (segments.size() > 1) {
+      emp::Shuffle(random, merged_ids);
+    }
+  }
 
 public:
 
   void Clear() {
-    queue.clear();
+    for (Segment& segment : segments) {
+      segment.Clear();
+    }
+    merged_ids.clear();
+  }
+
+  // Set the number of segments (one per worker). Queue must be empty.
+  void SetNumSegments(size_t num_segments) {
+    emp_assert(num_segments > 0);
+    emp_assert(GetSize() == 0);
+    segments.resize(num_segments);
   }
 
+  size_t GetNumSegments() const { return segments.size(); }
+
   size_t GetSize() const {
-    return queue.size();
+    size_t size = 0;
+    for (const Segment& segment : segments) {
+      size += segment.events.size();
+    }
+    return size;
   }
 
-  const emp::vector<ReproEvent>& GetQueue() const {
-    return queue;
+  const emp::vector<ReproEvent>& GetSegment(size_t segment_id) const {
+    emp_assert(segment_id < segments.size());
+    return segments[segment_id].events;
   }
 
-  void SetReproduceOrgFun(fun_repro_org_t fun) {
-    fun_reproduce_org = fun;
+  const ReproEvent& GetEvent(event_id_t event_id) const {
+    emp_assert(GetSegmentID(event_id) < segments.size());
+    emp_assert(GetSegmentPos(event_id) < segments[GetSegmentID(event_id)].events.size());
+    return segments[GetSegmentID(event_id)].events[GetSegmentPos(event_id)];
   }
 
-  void Invalidate(size_t queue_pos) {
-    emp_assert(queue_pos < queue.size());
-    queue[queue_pos].valid = false;
+  // Has event not been invalidated?
+  bool IsValid(event_id_t event_id) const {
+    emp_assert(GetSegmentID(event_id) < segments.size());
+    const Segment& segment = segments[GetSegmentID(event_id)];
+    const size_t segment_pos = GetSegmentPos(event_id);
+    emp_assert(segment_pos < segment.events.size());
+    return !((segment.tombstones[segment_pos / 64] >> (segment_pos % 64)) & 1);
   }
 
-  // Add organism to queue, return organism's queue id (valid until queue is processed)
-  size_t Enqueue(
+  void Invalidate(event_id_t event_id) {
+    emp_assert(GetSegmentID(event_id) < segments.size());
+    Segment& segment = segments[GetSegmentID(event_id)];
+    const size_t segment_pos = GetSegmentPos(event_id);
+    emp_assert(segment_pos < segment.events.size());
+    segment.tombstones[segment_pos / 64] |= (uint64_t(1) << (segment_pos % 64));
+  }
+
+  // Add organism to given segment of the queue, return the event's id (valid until queue is processed).
+  // Only one thread may enqueue into a given segment.
+  event_id_t Enqueue(
     emp::Ptr<Organism> org_ptr,
-    const emp::WorldPosition& org_pos
+    const emp::WorldPosition& org_pos,
+    size_t segment_id=0
   ) {
-    const size_t queue_id = queue.size();
-    queue.emplace_back(org_ptr, org_pos, true);
-    return queue_id;
+    emp_assert(segment_id < segments.size());
+    Segment& segment = segments[segment_id];
+    const size_t segment_pos = segment.events.size();
+    if (segment_pos % 64 == 0) segment.tombstones.emplace_back(0);
+    segment.events.emplace_back(org_ptr, org_pos);
+    return MakeEventID(segment_id, segment_pos);
   }
 
-  // Queue must be processed all at once to avoid
-  // invalidating queue_ids.
-  // NOTE - could have world template and instead of a configurable functor.
-  //        Why functor? Currently resetting repro
-  // template<typename WORLD_T>
-  // void Process(WORLD_T& world) {
-
-  void Process() {
-    for (ReproEvent& repro_info : queue) {
-      emp::Ptr<Organism> org_ptr = repro_info.org;
-      // If queued organism is dead or repro event has been invalidated,
-      // don't reproduce.
-      if (!repro_info.valid || org_ptr->GetDead()) {
-        continue;
-      }
-      fun_reproduce_org(repro_info);
-      // emp::Ptr<Organism> child = org->Reproduce();
-      // (child->IsHost()) ?
-      //   world.HostDoBirth(child, org_ptr, repro_info.pos) :
-      //   world.SymDoBirth(child, repro_info.pos);
+  // Queue must be processed all at once to avoid invalidating event ids.
+  // Handler is called (in merged order) for each event that is still valid and
+  // whose organism is not dead at the time it comes up.
+  template<typename HANDLER_T>
+  void Process(emp::Random& random, HANDLER_T&& handler) {
+    MergeSegments(random);
+    for (event_id_t event_id : merged_ids) {
+      // Check at processing time: earlier reproductions can invalidate later events.
+      if (!IsValid(event_id)) continue;
+      const ReproEvent& repro_info = GetEvent(event_id);
+      if (repro_info.org->GetDead()) continue;
+      handler(repro_info);
     }
     Clear();
   }
 
 };
 
-}
\ No newline at end of file
+}
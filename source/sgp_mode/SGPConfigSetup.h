@@ -21,6 +21,8 @@ EMP_EXTEND_CONFIG(SymConfigSGP, SymConfigBase,
   VALUE(SYM_STEAL_PROP, double, 0.2, "Proportion of points for sym to steal from host on steal"),
   VALUE(HOST_MIN_CYCLES_BEFORE_REPRO, size_t, 0, "Number of CPU cycles organisms must wait between reproductions"),
   VALUE(SYM_MIN_CYCLES_BEFORE_REPRO, size_t, 0, "Number of CPU cycles organisms must wait between reproductions"),
+  VALUE(NUM_THREADS, size_t, 1, "Number of threads used to process organisms each update. Runs are reproducible for a given SEED and thread count."),
+  VALUE(JUMP_TABLE_CACHE_SIZE, size_t, 1000, "How many distinct programs' jump tables to cache, so unmutated or recurring genomes skip tag matching when their CPU is reset (0 disables the cache)"),
 
   // NOTE - Might be able to eliminate ORGANISM_TYPE if interaction modes are allowed to be "layered on"
   VALUE(INTERACTION_MECHANISM, std::string, "default", "What sgp organisms should population the world? (Options: 'default')"),
@@ -65,6 +67,8 @@ EMP_EXTEND_CONFIG(SymConfigSGP, SymConfigBase,
   VALUE(TASK_ENV_CFG_PATH, std::string, "environment.json", "Json file that provides environment configuration"),
   VALUE(TASK_IO_BANK_SIZE, size_t, 100000, "How many possible task input/output combinations to pre-generate?"),
   VALUE(TASK_IO_UNIQUE_OUTPUT, bool, true, "Should each output in the pregenerated io combinations be unique?"),
+  VALUE(TASK_IO_BANK_SEEDED, bool, false, "Generate the task io bank in chunks, each from its own random number stream seeded by one draw from the world's random number generator? (Needed for TASK_IO_BANK_THREADS. Gives a different bank than serial generation.)"),
+  VALUE(TASK_IO_BANK_THREADS, size_t, 0, "How many threads generate a seeded task io bank? (0: all hardware threads; the bank is the same for any number)"),
   VALUE(HOST_ONLY_FIRST_TASK_CREDIT, bool, false, "Only give host credit for one task (whatever they do first)?"),
   VALUE(SYM_ONLY_FIRST_TASK_CREDIT, bool, false, "Only give sym credit for one task (whatever they do first)?"),
 
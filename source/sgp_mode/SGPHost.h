@@ -4,6 +4,7 @@
 #include "../default_mode/Host.h"
 #include "hardware/SGPHardware.h"
 #include "SGPConfigSetup.h"
+#include "ReproductionQueue.h"
 
 #include "emp/base/Ptr.hpp"
 #include "emp/bits/Bits.hpp"
@@ -24,6 +25,7 @@ public:
   using hw_spec_t = HW_SPEC_T;
   using hw_t = SGPHardware<hw_spec_t>;
   using program_t = typename hw_t::program_t;
+  using shared_program_t = typename hw_t::shared_program_t;
 
   size_t matching_syms_to_interact_with = 0;
 protected:
@@ -86,13 +88,14 @@ public:
   { }
 
   /**
-   * Constructs an SGPHost with a copy of the provided genome.
+   * Constructs an SGPHost with the provided genome, which is shared with the
+   * organism it came from (copy-on-write) if given as a shared_program_t.
    */
   SGPHost(
     emp::Ptr<emp::Random> _random,
     emp::Ptr<world_t> _world,
     emp::Ptr<SymConfigSGP> _config,
-    const program_t& genome,
+    const shared_program_t& genome,
     double _intval = 0.0,                         /* Interaction value */
     const emp::vector<emp::Ptr<Organism>>& _syms = {},
     const emp::vector<emp::Ptr<Organism>>& _repro_syms = {},
@@ -106,7 +109,7 @@ public:
 
   SGPHost(const SGPHost& host) :
     Host(host),
-    hardware(host.my_world, this, host.hardware.GetProgram()),
+    hardware(host.my_world, this, host.hardware.GetSharedProgram()),
     my_world(host.my_world)
   { }
 
@@ -139,27 +142,30 @@ public:
 
   bool operator<(const Organism& other) const {
     if (const SGPHost* sgp = dynamic_cast<const SGPHost*>(&other)) {
-      return GetProgram() < sgp->GetProgram();
+      return *this < *sgp;
     } else {
       return false;
     }
   }
 
   bool operator<(const SGPHost& other) const {
+    // Organisms sharing a stored program have identical genomes.
+    if (hardware.SharesProgram(other.hardware)) return false;
     return GetProgram() < other.GetProgram();
   }
 
   // NOTE / TODO - What about host interaction values?
   bool operator==(const Organism& other) const {
     if (const SGPHost* sgp = dynamic_cast<const SGPHost*>(&other)) {
-      return GetProgram() == sgp->GetProgram();
+      return *this == *sgp;
     } else {
       return false;
     }
   }
 
   bool operator==(const SGPHost& other) const {
-    return hardware.GetProgram() == other.hardware.GetProgram();
+    return hardware.SharesProgram(other.hardware) ||
+      hardware.GetProgram() == other.hardware.GetProgram();
   }
 
   /**
@@ -223,7 +229,6 @@ public:
   const hw_t& GetHardware() const { return hardware; }
 
   const program_t& GetProgram() const { return hardware.GetProgram(); }
-  program_t& GetProgram() { return hardware.GetProgram(); }
 
   /**
    * Input: None
@@ -311,23 +316,37 @@ public:
     // Execute organism hardware according to cycles_to_exec
     // NOTE - Discuss possibility of host dying because of instruction executions.
     //        As-is, still run hardware forward full amount regardless
-    for (size_t i = 0; i < cycles_to_exec; ++i) {
-      if (GetDead()) {
-        return;
-      }
-      // TODO - do we need to update org location every update? (this was being done in RunCPUStep every cpu step)
-      // Execute 1 CPU cycle
-      GetHardware().RunCPUStep(1);
-      // Did host attempt to reproduce?
-      // NOTE - could move into a signal response
-      // NOTE - want to handle this after every clock cycle?
-      if (GetHardware().GetCPUState().ReproAttempt()) {
-        // upside to handling this here: we have direct access to organism
-        AttemptReproduction(pos);
+    if (my_world->after_host_cpu_step_sig.GetNumActions() == 0) {
+      // Nothing needs to run between cycles, so run cycles in batches that
+      // only stop to handle reproduction attempts.
+      for (size_t cycles_left = cycles_to_exec; cycles_left > 0; ) {
+        if (GetDead()) {
+          return;
+        }
+        cycles_left -= GetHardware().RunCPUStepsUntilReproAttempt(cycles_left);
+        if (GetHardware().GetCPUState().ReproAttempt()) {
+          AttemptReproduction(pos);
+        }
       }
+    } else {
+      for (size_t i = 0; i < cycles_to_exec; ++i) {
+        if (GetDead()) {
+          return;
+        }
+        // TODO - do we need to update org location every update? (this was being done in RunCPUStep every cpu step)
+        // Execute 1 CPU cycle
+        GetHardware().RunCPUStep(1);
+        // Did host attempt to reproduce?
+        // NOTE - could move into a signal response
+        // NOTE - want to handle this after every clock cycle?
+        if (GetHardware().GetCPUState().ReproAttempt()) {
+          // upside to handling this here: we have direct access to organism
+          AttemptReproduction(pos);
+        }
 
-      my_world->after_host_cpu_step_sig.Trigger(*this);
-      // NOTE - Check death here?
+        my_world->after_host_cpu_step_sig.Trigger(*this);
+        // NOTE - Check death here?
+      }
     }
     my_world->after_host_cpu_exec_sig.Trigger(*this);
     // Handle any endosymbionts (configurable at setup-time)
@@ -366,7 +385,7 @@ public:
       emp_assert(sym_count > 0);
       // TODO - Check that it is okay to re-order symbionts to avoid erase calls
       // Symbiont is dead, need to delete it.
-      cur_symbiont.Delete();
+      my_world->DeleteEndosymbiont(cur_symbiont);
       // Swap this symbiont with last in list, decrementing sym_count
       std::swap(syms[sym_i], syms[--sym_count]);
       // We will need to process what we just swapped into place, so
@@ -393,10 +412,11 @@ public:
       // Host pays cost
       DecPoints(repro_cost);
       // Add host to repro queue
-      // TODO - protect with mutex?
-      const size_t queue_id = my_world->GetReproQueue().Enqueue(
+      // (each scheduler thread enqueues into its own queue segment)
+      const ReproductionQueue::event_id_t queue_id = my_world->GetReproQueue().Enqueue(
         GetHardware().GetCPUState().GetOrgPtr(),
-        pos
+        pos,
+        my_world->GetWorkerID()
       );
       // Mark host hardware as repro in progress, no longer in repro "attempt" state.
       GetHardware().GetCPUState().MarkReproInProgress(queue_id);
@@ -424,10 +444,10 @@ public:
     auto& output_buffer = cpu_state.GetOutputBuffer();
     for (uint32_t val : output_buffer) {
       // Is this the correct output for any tasks?
-      if (task_io.IsValidOutput(val)) {
+      // Get all task ids associated with this output value (none if it's not correct)
+      const auto task_ids = task_io.FindTaskIDs(val);
+      if (!task_ids.empty()) {
         // Yes, this output is correct.
-        // Get all task ids associated with this output value
-        const emp::vector<size_t>& task_ids = task_io.GetTaskIDs(val);
 
         // Give credit for completed tasks
         for (size_t task_id : task_ids) {
@@ -574,7 +594,7 @@ public:
       random,
       my_world,
       my_world->GetConfigPtr(),
-      GetProgram(),
+      hardware.GetSharedProgram(),
       GetIntVal()
     );
   }
@@ -609,16 +629,37 @@ public:
    *Purpose: To update the host's counter for the number of their symbionts that they task match with
    */
   void UpdateSymMatchCount(){
-    matching_syms_to_interact_with = 0;
-    emp::vector<emp::Ptr<Organism>>& syms = GetSymbionts();
-    for (size_t endosym_i = 0; endosym_i < syms.size(); ++endosym_i) {
-
-      emp::Ptr<sgp_sym_t> cur_symbiont = static_cast<sgp_sym_t*>(syms[endosym_i].Raw());
+    matching_syms_to_interact_with = my_world->CountCompatibleSymbionts(*this);
+  }
 
-      bool is_matching = my_world->GetInteractionCompatibility(*this,*cur_symbiont);
-      matching_syms_to_interact_with += is_matching;
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the host's state, program and CPU state into a
+   * checkpoint.
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const override {
+    Host::SaveCheckpoint(writer);
+    writer.Write<uint64_t>(reproductions);
+    writer.Write<uint64_t>(matching_syms_to_interact_with);
+    hardware.SaveCheckpoint(writer);
+  }
 
-      }
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the host's state, program and CPU state from a
+   * checkpoint, so it carries on running where it left off.
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) override {
+    Host::LoadCheckpoint(reader);
+    reproductions = reader.Read<uint64_t>();
+    matching_syms_to_interact_with = reader.Read<uint64_t>();
+    hardware.LoadCheckpoint(reader);
   }
 
 };
@@ -3,6 +3,8 @@
 #include "sgpl/program/Program.hpp"
 #include "sgpl/library/OpLibrary.hpp"
 
+#include "hardware/SharedProgram.h"
+
 namespace sgpmode {
 
 // NOTE - We can set this up to be configurable (e.g., support different modes,
@@ -40,6 +42,29 @@ public:
     );
   }
 
+  /**
+   * Input: An organism's copy-on-write program.
+   *
+   * Output: None
+   *
+   * Purpose: Mutates a program that may be shared with relatives. sgplite's
+   * ApplyPointMutations runs on a reused scratch copy, so random draws are
+   * exactly those of MutateProgram(program_t&); the organism only gets its own
+   * stored program if the mutations changed something.
+   */
+  void MutateProgram(SharedProgram<program_t>& program) {
+    if (program.GetShareCount() == 1) {
+      MutateProgram(program.GetMutable());
+      return;
+    }
+    // Scratch keeps its capacity between births, so unchanged offspring cost a
+    // copy and a compare, but no allocation.
+    static thread_local program_t scratch;
+    scratch.assign(program.Get().begin(), program.Get().end());
+    MutateProgram(scratch);
+    if (scratch != program.Get()) program.Set(std::move(scratch));
+  }
+
 
 };
 
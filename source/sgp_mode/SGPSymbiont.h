@@ -3,7 +3,9 @@
 
 #include "../default_mode/Symbiont.h"
 #include "hardware/SGPHardware.h"
+#include "ReproductionQueue.h"
 #include "SGPHost.h"
+#include "CompatibilityPolicy.h"
 
 #include "emp/base/Ptr.hpp"
 #include "emp/Evolve/World_structure.hpp"
@@ -18,6 +20,7 @@ public:
   using hw_spec_t = HW_SPEC_T;
   using hw_t = SGPHardware<hw_spec_t>;
   using program_t = typename hw_t::program_t;
+  using shared_program_t = typename hw_t::shared_program_t;
   using host_t = SGPHost<HW_SPEC_T>;
 
 protected:
@@ -38,6 +41,15 @@ protected:
    */
   size_t reproductions = 0;
 
+  /**
+   *
+   * Purpose: Caches the comparison between this symbiont's task profile and its
+   * host's (see SGPWorld::GetTaskProfileMatch). Only touched by whichever
+   * thread is processing the host.
+   *
+   */
+  mutable policy::TaskProfileMatch host_profile_match;
+
   /**
    *
    * Purpose: Holds all configuration settings and points to same configuration
@@ -66,13 +78,14 @@ public:
   }
 
   /**
-   * Constructs an SGPSymbiont with a copy of the provided genome.
+   * Constructs an SGPSymbiont with the provided genome, which is shared with the
+   * organism it came from (copy-on-write) if given as a shared_program_t.
    */
   SGPSymbiont(
     emp::Ptr<emp::Random> _random,
     emp::Ptr<world_t> _world,
     emp::Ptr<SymConfigSGP> _config,
-    const program_t& genome,
+    const shared_program_t& genome,
     double _intval = 0.0, /* Interaction value */
     double _points = 0.0
   ) :
@@ -85,7 +98,7 @@ public:
 
   SGPSymbiont(const SGPSymbiont& symbiont) :
     Symbiont(symbiont),
-    hardware(symbiont.my_world, this, symbiont.hardware.GetProgram()),
+    hardware(symbiont.my_world, this, symbiont.hardware.GetSharedProgram()),
     my_world(symbiont.my_world)
   { }
 
@@ -121,27 +134,30 @@ public:
 
   bool operator<(const Organism& other) const {
     if (const SGPSymbiont* sgp = dynamic_cast<const SGPSymbiont*>(&other)) {
-      return GetProgram() < sgp->GetProgram();
+      return *this < *sgp;
     } else {
       return false;
     }
   }
 
   bool operator<(const SGPSymbiont& other) const {
+    // Organisms sharing a stored program have identical genomes.
+    if (hardware.SharesProgram(other.hardware)) return false;
     return GetProgram() < other.GetProgram();
   }
 
   // NOTE / TODO - What about host interaction values?
   bool operator==(const Organism& other) const {
     if (const SGPSymbiont* sgp = dynamic_cast<const SGPSymbiont*>(&other)) {
-      return GetProgram() == sgp->GetProgram();
+      return *this == *sgp;
     } else {
       return false;
     }
   }
 
   bool operator==(const SGPSymbiont& other) const {
-    return hardware.GetProgram() == other.hardware.GetProgram();
+    return hardware.SharesProgram(other.hardware) ||
+      hardware.GetProgram() == other.hardware.GetProgram();
   }
 
   /**
@@ -172,8 +188,9 @@ public:
   hw_t& GetHardware() { return hardware; }
   const hw_t& GetHardware() const { return hardware; }
 
+  policy::TaskProfileMatch& GetHostProfileMatch() const { return host_profile_match; }
+
   const program_t& GetProgram() const { return hardware.GetProgram(); }
-  program_t& GetProgram() { return hardware.GetProgram(); }
 
 
   /**
@@ -226,16 +243,27 @@ public:
     // Cash in cycles for this update
     // NOTE - Do we want to drain cpu cycles here (i.e., get cashed in for execution?)
     const size_t cycles_to_exec = GetHardware().GetCPUState().ExtractCPUCycles();
-    for (size_t i = 0; i < cycles_to_exec; ++i) {
-      GetHardware().RunCPUStep(1);
-      if(my_host) my_world->TriggerAfterEndosymCPUStepSig(pos, *this, my_host);
-
-      // Did endosymbiont attempt to reproduce?
-      // NOTE - want to handle this after every clock cycle?
-      if (GetHardware().GetCPUState().ReproAttempt()) {
-        AttemptIndependentReproduction(pos);
+    if (!my_host || my_world->after_endosym_cpu_step_sig.GetNumActions() == 0) {
+      // Nothing needs to run between cycles, so run cycles in batches that
+      // only stop to handle reproduction attempts.
+      for (size_t cycles_left = cycles_to_exec; cycles_left > 0; ) {
+        cycles_left -= GetHardware().RunCPUStepsUntilReproAttempt(cycles_left);
+        if (GetHardware().GetCPUState().ReproAttempt()) {
+          AttemptIndependentReproduction(pos);
+        }
       }
+    } else {
+      for (size_t i = 0; i < cycles_to_exec; ++i) {
+        GetHardware().RunCPUStep(1);
+        my_world->TriggerAfterEndosymCPUStepSig(pos, *this, my_host);
+
+        // Did endosymbiont attempt to reproduce?
+        // NOTE - want to handle this after every clock cycle?
+        if (GetHardware().GetCPUState().ReproAttempt()) {
+          AttemptIndependentReproduction(pos);
+        }
 
+      }
     }
 
     if(my_host) my_world->TriggerAfterEndosymCPUExecSig(pos, *this, my_host);
@@ -321,10 +349,11 @@ public:
       // Sym pays cost
       //DecPoints(repro_cost); //Need to check if changing this in default breaks everything, currently set to 0 in super class method
       // Add sym to repro queue
-      // TODO - protect with mutex for threading
-        const size_t queue_id = my_world->GetReproQueue().Enqueue(
+      // (each scheduler thread enqueues into its own queue segment)
+        const ReproductionQueue::event_id_t queue_id = my_world->GetReproQueue().Enqueue(
           GetHardware().GetCPUState().GetOrgPtr(),
-          sym_pos
+          sym_pos,
+          my_world->GetWorkerID()
         );
       // Mark symbiont's hardware as repro in progress, no longer in "attempt" state
       GetHardware().GetCPUState().MarkReproInProgress(queue_id);
@@ -421,7 +450,7 @@ public:
       random,
       my_world,
       my_world->GetConfigPtr(),
-      GetProgram(),
+      hardware.GetSharedProgram(),
       GetIntVal()
     );
   }
@@ -446,6 +475,36 @@ public:
                       // which didn't reset the cpu. I think we want to reset the CPU here also?
   }
 
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the symbiont's state, program and CPU state into a
+   * checkpoint.
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const override {
+    Symbiont::SaveCheckpoint(writer);
+    writer.Write<uint64_t>(reproductions);
+    hardware.SaveCheckpoint(writer);
+  }
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the symbiont's state, program and CPU state from a
+   * checkpoint, so it carries on running where it left off. (Its cached task
+   * profile match is recomputed, since the restored profiles have new
+   * versions.)
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) override {
+    Symbiont::LoadCheckpoint(reader);
+    reproductions = reader.Read<uint64_t>();
+    hardware.LoadCheckpoint(reader);
+  }
+
 };
 
 }
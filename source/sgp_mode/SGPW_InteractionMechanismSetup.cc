@@ -79,8 +79,8 @@ namespace sgpmode {
           // If symbiont is dead or doesn't have a host, skip.
           if (sym.GetDead()) { return; }
           // Will sym donate?
-          bool interact = random_ptr->P(sgp_config.HEALTH_INTERACTION_CHANCE());
-          interact = interact && fun_interaction_compatibility_check(host, sym);
+          bool interact = GetWorkerRandom().P(sgp_config.HEALTH_INTERACTION_CHANCE());
+          interact = interact && GetInteractionCompatibility(host, sym);
 
           const double donate_prop = sgp_config.MUTUALIST_CYCLE_GAIN_PROP();
           emp_assert(donate_prop <= 1.0 && donate_prop >= 0.0);
@@ -119,8 +119,8 @@ namespace sgpmode {
           if (sym.GetDead()) { return; }
           auto& host_state = host.GetHardware().GetCPUState();
           // Will sym steal?
-          bool interact = random_ptr->P(sgp_config.HEALTH_INTERACTION_CHANCE());
-          interact = interact && fun_interaction_compatibility_check(host, sym);
+          bool interact = GetWorkerRandom().P(sgp_config.HEALTH_INTERACTION_CHANCE());
+          interact = interact && GetInteractionCompatibility(host, sym);
 
           const double steal_prop = sgp_config.PARASITE_CYCLE_LOSS_PROP();
           emp_assert(steal_prop <= 1.0 && steal_prop >= 0.0);
@@ -157,8 +157,8 @@ namespace sgpmode {
           if (sym.GetDead()) { return; }
           auto& host_state = host.GetHardware().GetCPUState();
           // Will host and symbiont interact?
-          bool interact = random_ptr->P(sgp_config.HEALTH_INTERACTION_CHANCE());
-          interact = interact && fun_interaction_compatibility_check(host, sym);
+          bool interact = GetWorkerRandom().P(sgp_config.HEALTH_INTERACTION_CHANCE());
+          interact = interact && GetInteractionCompatibility(host, sym);
           const double sym_interaction_value = sym.GetIntVal();
           emp_assert(sym_interaction_value >= -1.0);
           emp_assert(sym_interaction_value <= 1.0 );
@@ -241,9 +241,9 @@ namespace sgpmode {
             emp::Ptr<sgp_sym_t> endosym_ptr = static_cast<sgp_sym_t*>(endosymbionts[sym_i].Raw());
             // interact = utils::AnyMatchingOnes(
             //   host_task_profile,
-            //   fun_get_sym_task_profile(*endosym_ptr)
+            //   GetSymbiontTaskProfile(*endosym_ptr)
             // );
-            interact = fun_interaction_compatibility_check(host, *endosym_ptr);
+            interact = GetInteractionCompatibility(host, *endosym_ptr);
             if (interact) {
               break;
             }
@@ -252,7 +252,7 @@ namespace sgpmode {
           sgp_config.MUTUALIST_DEATH_CHANCE() :
           sgp_config.BASE_DEATH_CHANCE();
           // Kill host with chosen probability
-          if (random_ptr->P(death_chance)) {
+          if (GetWorkerRandom().P(death_chance)) {
             host.SetDead();
           }
         }
@@ -271,28 +271,21 @@ namespace sgpmode {
             for (size_t sym_i = 0; sym_i < endosymbionts.size(); ++sym_i) {
               // Check if symbiont matches task profile
               emp::Ptr<sgp_sym_t> endosym_ptr = static_cast<sgp_sym_t*>(endosymbionts[sym_i].Raw());
-              const emp::BitVector& endosym_task_profile = fun_get_sym_task_profile(*endosym_ptr);
-              const bool can_escape = fun_interaction_compatibility_check(host, *endosym_ptr);
+              const emp::BitVector& endosym_task_profile = GetSymbiontTaskProfile(*endosym_ptr);
+              const bool can_escape = GetInteractionCompatibility(host, *endosym_ptr);
               if (can_escape) {
                 death_chance = sgp_config.PARASITE_DEATH_CHANCE();
                 // Endosymbiont gets opportunity to horizontally transmit
                 // By using this queue, offspring of parasites avoid getting into hosts that will die to the
                 // current stress event.
-                for (size_t i = 0; i < sgp_config.PARASITE_NUM_OFFSPRING_ON_STRESS_INTERACTION(); ++i) {
-                  emp::Ptr<Organism> sym_offspring = endosym_ptr->Reproduce();
-                  symbiont_stress_escapees.emplace_back(
-                    static_cast<sgp_sym_t*>(sym_offspring.Raw()),
-                    endosym_task_profile,
-                    endosym_ptr->GetHardware().GetCPUState().GetLocation().GetPopID()
-                  );
-                }
+                AddStressEscapees(endosym_ptr, endosym_task_profile);
                 // Once we leave this signal, the host (and this symbiont) will
                 // potentially be deleted.
                 // So, we need to handle the reproduction here (versus putting it into the queue).
               }
             }
             // Kill host with chosen probability
-            if (random_ptr->P(death_chance)) {
+            if (GetWorkerRandom().P(death_chance)) {
               host.SetDead();
             }
           }
@@ -307,19 +300,19 @@ namespace sgpmode {
             // Otherwise, base death chance.
             double death_chance = sgp_config.BASE_DEATH_CHANCE();
             auto& endosymbionts = host.GetSymbionts();
-            const emp::BitVector& host_task_profile = fun_get_host_task_profile(host);
+            const emp::BitVector& host_task_profile = GetHostTaskProfile(host);
             emp::vector<size_t> escapee_ids;
             for (size_t sym_i = 0; sym_i < endosymbionts.size(); ++sym_i) {
               // Check if symbiont matches task profile
               emp::Ptr<sgp_sym_t> endosym_ptr = static_cast<sgp_sym_t*>(endosymbionts[sym_i].Raw());
-              const bool can_escape = fun_interaction_compatibility_check(host, *endosym_ptr);
+              const bool can_escape = GetInteractionCompatibility(host, *endosym_ptr);
               if (can_escape) {
                 death_chance = sgp_config.PARASITE_DEATH_CHANCE();
                 escapee_ids.emplace_back(sym_i);
               }
             }
             // Kill host with chosen probability + allow escapees.
-            if (random_ptr->P(death_chance)) {
+            if (GetWorkerRandom().P(death_chance)) {
               // ------
               // Give any escapees a chance to escape!
               // Once we leave this signal, the host (and this symbiont) will
@@ -327,15 +320,8 @@ namespace sgpmode {
               // So, we need to handle the reproduction here (versus putting it into the queue) .
               for (size_t escapee_id : escapee_ids) {
                 emp::Ptr<sgp_sym_t> endosym_ptr = static_cast<sgp_sym_t*>(endosymbionts[escapee_id].Raw());
-                const emp::BitVector& endosym_task_profile = fun_get_sym_task_profile(*endosym_ptr);
-                for (size_t i = 0; i < sgp_config.PARASITE_NUM_OFFSPRING_ON_STRESS_INTERACTION(); ++i) {
-                  emp::Ptr<Organism> sym_offspring = endosym_ptr->Reproduce();
-                  symbiont_stress_escapees.emplace_back(
-                    static_cast<sgp_sym_t*>(sym_offspring.Raw()),
-                    endosym_task_profile,
-                    endosym_ptr->GetHardware().GetCPUState().GetLocation().GetPopID()
-                  );
-                }
+                const emp::BitVector& endosym_task_profile = GetSymbiontTaskProfile(*endosym_ptr);
+                AddStressEscapees(endosym_ptr, endosym_task_profile);
               }
               // ------
               // Mark host as dead
@@ -363,7 +349,7 @@ namespace sgpmode {
           for (size_t sym_i = 0; sym_i < endosymbionts.size(); ++sym_i) {
             // Check if symbiont matches task profile
             emp::Ptr<sgp_sym_t> endosym_ptr = static_cast<sgp_sym_t*>(endosymbionts[sym_i].Raw());
-            interact = fun_interaction_compatibility_check(
+            interact = GetInteractionCompatibility(
               host,
               *endosym_ptr
             );
@@ -402,7 +388,7 @@ namespace sgpmode {
           } // Otherwise, interaction value == 0.0, no interaction (neutral).
 
           // Kill host with chosen probability + allow any parasite escapees out
-          if (random_ptr->P(death_chance)) {
+          if (GetWorkerRandom().P(death_chance)) {
             // ------
             // Give any escapees a chance to escape!
             // Once we leave this signal, the host (and this symbiont) will
@@ -410,15 +396,8 @@ namespace sgpmode {
             // So, we need to handle the reproduction here (versus putting it into the queue) .
             for (size_t escapee_id : escapee_ids) {
               emp::Ptr<sgp_sym_t> endosym_ptr = static_cast<sgp_sym_t*>(endosymbionts[escapee_id].Raw());
-              const emp::BitVector& endosym_task_profile = fun_get_sym_task_profile(*endosym_ptr);
-              for (size_t i = 0; i < sgp_config.PARASITE_NUM_OFFSPRING_ON_STRESS_INTERACTION(); ++i) {
-                emp::Ptr<Organism> sym_offspring = endosym_ptr->Reproduce();
-                symbiont_stress_escapees.emplace_back(
-                  static_cast<sgp_sym_t*>(sym_offspring.Raw()),
-                  endosym_task_profile,
-                  endosym_ptr->GetHardware().GetCPUState().GetLocation().GetPopID()
-                );
-              }
+              const emp::BitVector& endosym_task_profile = GetSymbiontTaskProfile(*endosym_ptr);
+              AddStressEscapees(endosym_ptr, endosym_task_profile);
             }
             host.SetDead();
           }
@@ -433,7 +412,7 @@ namespace sgpmode {
           // Otherwise, base death chance.
           const double death_chance = sgp_config.BASE_DEATH_CHANCE();
           // Kill host with chosen probability
-          if (random_ptr->P(death_chance)) {
+          if (GetWorkerRandom().P(death_chance)) {
             host.SetDead();
           }
         }
@@ -702,7 +681,7 @@ namespace sgpmode {
             continue;
           }
 
-          const emp::BitVector& endosym_task_profile = fun_get_sym_task_profile(*cur_symbiont);
+          const emp::BitVector& endosym_task_profile = GetSymbiontTaskProfile(*cur_symbiont);
           bool sym_performed = endosym_task_profile.Get(task_id);
           task_matching_sym_count += sym_performed;
         }
@@ -718,7 +697,7 @@ namespace sgpmode {
               continue;
             }
 
-            const emp::BitVector& endosym_task_profile = fun_get_sym_task_profile(*cur_symbiont);
+            const emp::BitVector& endosym_task_profile = GetSymbiontTaskProfile(*cur_symbiont);
             bool sym_performed = endosym_task_profile.Get(task_id);
             if (sym_performed) {
               double sym_task_point = CalcSymNutrientInteraction(host,*cur_symbiont, task_value_before, task_id,task_matching_sym_count);
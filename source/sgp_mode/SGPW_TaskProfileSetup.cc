@@ -12,121 +12,39 @@ void SGPWorld::SetupTaskProfileMode() {
   // PARENT-FIRST
   // SELF-ALL
   // SELF-FIRST
-  // TODO - Create an enum!
-  if (sgp_config.TASK_PROFILE_MODE() == "parent-all") {
-    fun_get_host_task_profile = [](const sgp_host_t& host) -> const emp::BitVector& {
-      return host.GetHardware().GetCPUState().GetParentTasksPerformed();
-    };
-    fun_get_sym_task_profile = [](const sgp_sym_t& sym) -> const emp::BitVector& {
-      return sym.GetHardware().GetCPUState().GetParentTasksPerformed();
-    };
-  } else if (sgp_config.TASK_PROFILE_MODE() == "parent-first") {
-    fun_get_host_task_profile = [](const sgp_host_t& host) -> const emp::BitVector& {
-      return host.GetHardware().GetCPUState().GetParentFirstTaskPerformed();
-    };
-    fun_get_sym_task_profile = [](const sgp_sym_t& sym) -> const emp::BitVector& {
-      return sym.GetHardware().GetCPUState().GetParentFirstTaskPerformed();
-    };
-  } else if (sgp_config.TASK_PROFILE_MODE() == "self-all") {
-    fun_get_host_task_profile = [](const sgp_host_t& host) -> const emp::BitVector& {
-      return host.GetHardware().GetCPUState().GetTasksPerformed();
-    };
-    fun_get_sym_task_profile = [](const sgp_sym_t& sym) -> const emp::BitVector& {
-      return sym.GetHardware().GetCPUState().GetTasksPerformed();
-    };
-  } else if (sgp_config.TASK_PROFILE_MODE() == "self-first") {
-    fun_get_host_task_profile = [](const sgp_host_t& host) -> const emp::BitVector& {
-      return host.GetHardware().GetCPUState().GetFirstTaskPerformed();
-    };
-    fun_get_sym_task_profile = [](const sgp_sym_t& sym) -> const emp::BitVector& {
-      return sym.GetHardware().GetCPUState().GetFirstTaskPerformed();
-    };
-  } else {
+  if (!org_info::IsValidTaskProfileMode(sgp_config.TASK_PROFILE_MODE())) {
     std::cout << "Unrecognized TASK_PROFILE_MODE: " << sgp_config.TASK_PROFILE_MODE() << std::endl;
     std::cout << "Exiting." << std::endl;
     exit(-1);
   }
+  task_profile_mode = org_info::GetTaskProfileMode(sgp_config.TASK_PROFILE_MODE());
 }
 
 void SGPWorld::SetupInteractionCompatibilityMode() {
-  // Setup function that determines interaction compatibility
-  // Task compatibility is set up by SetupTaskProfileCompatibilityMode
-
-  if (sgp_config.INTERACTION_PROFILE_COMPATIBILITY_MODE() == "always"){
-    fun_interaction_compatibility_check = [this](
-      const sgp_host_t& host,
-      const sgp_sym_t& sym
-    ) -> bool {
-      return true;
-    };
-  } else if(sgp_config.INTERACTION_PROFILE_COMPATIBILITY_MODE() == "task-any-match" ||
-            sgp_config.INTERACTION_PROFILE_COMPATIBILITY_MODE() == "task-perfect-match") {
-    fun_interaction_compatibility_check = [this](
-      const sgp_host_t& host,
-      const sgp_sym_t& sym
-    ) -> bool {
-      return fun_task_profile_compatibility_check(
-        fun_get_host_task_profile(host),
-        fun_get_sym_task_profile(sym)
-      );
-    };
-  } else if(sgp_config.INTERACTION_PROFILE_COMPATIBILITY_MODE() == "tag-probabilistic-match"){
+  // Interaction compatibility is determined by interaction_compat_mode (set up
+  // by SetupTaskProfileCompatibilityMode); see GetInteractionCompatibility.
+  if (interaction_compat_mode == interaction_compat_mode_t::TAG_PROBABILISTIC_MATCH) {
     if(sgp_config.TAG_MATCHING() == false){
       std::cout << "ERROR: TAG_MATCHING must be on in order to use tag-probabilistic-match for INTERACTION_PROFILE_COMPATIBILITY_MODE" << std::endl;
       std::cout << "Exiting." << std::endl;
       exit(-1);
     }
-    fun_interaction_compatibility_check = [this](
-      const sgp_host_t& host,
-      const sgp_sym_t& sym
-    ) -> bool {
-      double tag_distance = (*tag_metric)(host.GetTag(), sym.GetTag()) * TAG_LENGTH;
-      double permissiveness_mean = (sgp_config.HOST_TAG_PERMISSIVENESS_EVOLVES()) ? host.GetTagPermissiveness() : sgp_config.TAG_PERMISSIVENESS();
-      double cutoff = GetRandom().GetPoisson(permissiveness_mean * TAG_LENGTH);
-      return(tag_distance <= cutoff);
-    };
   }
 }
 
 void SGPWorld::SetupTaskProfileCompatibilityMode() {
-  // Setup function that determines task profile compatibility
+  // Setup how task profile compatibility is determined
   // Task profile is determined by TASK_PROFILE_MODE
-  if (sgp_config.INTERACTION_PROFILE_COMPATIBILITY_MODE() == "always") {
-    // Task profiles are always compatible no matter their makeup.
-    fun_task_profile_compatibility_check = [this](
-      const emp::BitVector& a,
-      const emp::BitVector& b
-    ) -> bool {
-      return true;
-    };
-  } else if (sgp_config.INTERACTION_PROFILE_COMPATIBILITY_MODE() == "task-any-match") {
-    // Task profiles are compatible if they have at least one shared task between them.
-    fun_task_profile_compatibility_check = [this](
-      const emp::BitVector& a,
-      const emp::BitVector& b
-    ) -> bool {
-      return utils::AnyMatchingOnes(a, b);
-    };
-  } else if (sgp_config.INTERACTION_PROFILE_COMPATIBILITY_MODE() == "task-perfect-match") {
-    fun_task_profile_compatibility_check = [this](
-      const emp::BitVector& a,
-      const emp::BitVector& b
-    ) -> bool {
-      return a == b;
-    };
-  } else if(sgp_config.INTERACTION_PROFILE_COMPATIBILITY_MODE() == "tag-probabilistic-match"){
-    fun_task_profile_compatibility_check = [this](
-      const emp::BitVector& a,
-      const emp::BitVector& b
-    ) -> bool {
-      return true;
-    };
-  } else {
+  // - always: Task profiles are always compatible no matter their makeup.
+  // - task-any-match: Task profiles are compatible if they have at least one shared task between them.
+  // - task-perfect-match: Task profiles are compatible if they're identical.
+  // - tag-probabilistic-match: Task profiles are always compatible (interaction compatibility uses tags).
+  if (!org_info::IsValidInteractionCompatibilityMode(sgp_config.INTERACTION_PROFILE_COMPATIBILITY_MODE())) {
     std::cout << "Unrecognized INTERACTION_PROFILE_COMPATIBILITY_MODE: " << sgp_config.INTERACTION_PROFILE_COMPATIBILITY_MODE() << std::endl;
     std::cout << "Exiting." << std::endl;
     exit(-1);
   }
-
+  interaction_compat_mode = org_info::GetInteractionCompatibilityMode(sgp_config.INTERACTION_PROFILE_COMPATIBILITY_MODE());
 }
 
 void SGPWorld::SetupHorizontalTransmissionCompatibilityMode() {
@@ -145,23 +63,23 @@ void SGPWorld::SetupHorizontalTransmissionCompatibilityMode() {
       sgp_host_t& host,
       sgp_sym_t& sym
     ) -> bool {
-      const auto& host_profile = fun_get_host_task_profile(host);
-      const auto& sym_profile = fun_get_sym_task_profile(sym);
-      return fun_task_profile_compatibility_check(host_profile, sym_profile);
+      const auto& host_profile = GetHostTaskProfile(host);
+      const auto& sym_profile = GetSymbiontTaskProfile(sym);
+      return TaskProfileCompatibilityCheck(host_profile, sym_profile);
     };
     fun_host_sym_stress_trans_compatibility_check = [this](
       sgp_host_t& host,
       const emp::BitVector& profile
     ) -> bool {
-      const auto& host_profile = fun_get_host_task_profile(host);
-      return fun_task_profile_compatibility_check(host_profile, profile);
+      const auto& host_profile = GetHostTaskProfile(host);
+      return TaskProfileCompatibilityCheck(host_profile, profile);
     };
   } else if (sgp_config.HORIZONTAL_TRANSMISSION_COMPATIBILITY_MODE() == "task-profile-strictly-stronger-match") {
     fun_host_sym_horizontal_trans_compatibility_check = [this](
       sgp_host_t& host,
       sgp_sym_t& sym
     ) -> bool {
-      const emp::BitVector& incoming_sym_task_profile = fun_get_sym_task_profile(sym);
+      const emp::BitVector& incoming_sym_task_profile = GetSymbiontTaskProfile(sym);
       return NoBetterOrEquallyMatchingSymbionts(host, incoming_sym_task_profile);
     };
     fun_host_sym_stress_trans_compatibility_check = [this](
@@ -175,7 +93,7 @@ void SGPWorld::SetupHorizontalTransmissionCompatibilityMode() {
       sgp_host_t& host,
       sgp_sym_t& sym
     ) -> bool {
-      const emp::BitVector& incoming_sym_task_profile = fun_get_sym_task_profile(sym);
+      const emp::BitVector& incoming_sym_task_profile = GetSymbiontTaskProfile(sym);
       return NoBetterMatchingSymbionts(host, incoming_sym_task_profile);
     };
     fun_host_sym_stress_trans_compatibility_check = [this](
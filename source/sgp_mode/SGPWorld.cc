@@ -51,9 +51,25 @@ void SGPWorld::ProcessHostAt(const emp::WorldPosition& pos, sgp_host_t& host) {
 
   //check if host is dead at return
   if (host.GetDead()){
+    KillHostAt(pos);
+  }
+
+}
+
+void SGPWorld::KillHostAt(const emp::WorldPosition& pos) {
+  if (deferring_updates) {
+    worker_updates[GetWorkerID()].host_deaths.emplace_back(pos.GetIndex());
+  } else {
     DoDeath(pos);
   }
+}
 
+void SGPWorld::KillFreeLivingSymAt(size_t pop_id) {
+  if (deferring_updates) {
+    worker_updates[GetWorkerID()].free_sym_deaths.emplace_back(pop_id);
+  } else {
+    DoSymDeath(pop_id);
+  }
 }
 
 
@@ -67,7 +83,8 @@ void SGPWorld::ProcessFreeLivingSymAt(const emp::WorldPosition& pos, sgp_sym_t&
   emp_assert(!sym.IsHost()); // NOTE - IsSym function?
   // have to check for death first, because it might have moved
   if (sym.GetDead()) {
-    DoSymDeath(pos.GetPopID());
+    KillFreeLivingSymAt(pos.GetPopID());
+    return;
   } else {
     // Sym gains cpu cycles
     sym.GetHardware().GetCPUState().GainCPUCycles(sgp_config.CYCLES_PER_UPDATE());
@@ -75,15 +92,26 @@ void SGPWorld::ProcessFreeLivingSymAt(const emp::WorldPosition& pos, sgp_sym_t&
     before_freeliving_sym_process_sig.Trigger(sym);
     // NOTE - Do we want to drain cpu cycles here (i.e., get cashed in for execution?)
     const size_t cycles_to_exec = sym.GetHardware().GetCPUState().ExtractCPUCycles();
-    for (size_t i = 0; i < cycles_to_exec; ++i) {
-      sym.GetHardware().RunCPUStep(1);
-
-      // Did this sym attempt to reproduce?
-      if (sym.GetHardware().GetCPUState().ReproAttempt()) {
-        FreeLivingSymAttemptRepro(pos, sym);
+    if (after_freeliving_sym_cpu_step_sig.GetNumActions() == 0) {
+      // Nothing needs to run between cycles, so run cycles in batches that
+      // only stop to handle reproduction attempts.
+      for (size_t cycles_left = cycles_to_exec; cycles_left > 0; ) {
+        cycles_left -= sym.GetHardware().RunCPUStepsUntilReproAttempt(cycles_left);
+        if (sym.GetHardware().GetCPUState().ReproAttempt()) {
+          FreeLivingSymAttemptRepro(pos, sym);
+        }
       }
+    } else {
+      for (size_t i = 0; i < cycles_to_exec; ++i) {
+        sym.GetHardware().RunCPUStep(1);
 
-      after_freeliving_sym_cpu_step_sig.Trigger(sym);
+        // Did this sym attempt to reproduce?
+        if (sym.GetHardware().GetCPUState().ReproAttempt()) {
+          FreeLivingSymAttemptRepro(pos, sym);
+        }
+
+        after_freeliving_sym_cpu_step_sig.Trigger(sym);
+      }
     }
     after_freeliving_sym_cpu_exec_sig.Trigger(sym);
     // Call symbiont's process function
@@ -92,7 +120,7 @@ void SGPWorld::ProcessFreeLivingSymAt(const emp::WorldPosition& pos, sgp_sym_t&
   }
   // TODO - double check that this belongs just here and not also in endosymbiont code
   if (IsSymPopOccupied(pos.GetPopID()) && sym.GetDead()) {
-    DoSymDeath(pos.GetPopID());
+    KillFreeLivingSymAt(pos.GetPopID());
   }
 }
 
@@ -109,11 +137,11 @@ void SGPWorld::FreeLivingSymAttemptRepro(
   if (sym.GetPoints() >= repro_cost) {
     // Sym pays cost
     sym.DecPoints(repro_cost);
-    // Add sym to repro queue
-    // TODO - protect with mutex for threading
-    const size_t queue_id = repro_queue.Enqueue(
+    // Add sym to repro queue (each thread enqueues into its own queue segment)
+    const ReproductionQueue::event_id_t queue_id = repro_queue.Enqueue(
       sym.GetHardware().GetCPUState().GetOrgPtr(),
-      pos
+      pos,
+      GetWorkerID()
     );
     // Mark symbiont's hardware as repro in progress, no longer in "attempt" state
     sym.GetHardware().GetCPUState().MarkReproInProgress(queue_id);
@@ -131,10 +159,30 @@ void SGPWorld::SetMutationZero() {
 }
 
 void SGPWorld::DoReproduction() {
-  // Process reproduction queue
-  // NOTE - If do repro remains simplified to just calling the repro_queue's
-  //        process function, can get rid of this function.
-  repro_queue.Process();
+  // Process reproduction queue (merge order draws from the world's rng when
+  // there are multiple queue segments).
+  repro_queue.Process(
+    *random_ptr,
+    [this](const ReproEvent& repro_info) { ReproduceQueuedOrg(repro_info); }
+  );
+}
+
+void SGPWorld::ReproduceQueuedOrg(const ReproEvent& repro_info) {
+  emp::Ptr<Organism> org = repro_info.org;
+  emp::Ptr<Organism> child = org->Reproduce();
+  if (child->IsHost()) {
+    HostDoBirth(child, org, repro_info.pos);
+    // Mark parent as no longer reproducing (world handles setting state, so should handle resetting)
+    // NOTE - could move reset repro state in Reproduce functions
+    // static_cast<sgp_host_t*>(org.Raw())->GetHardware().GetCPUState().ResetReproState();
+  } else {
+    const emp::WorldPosition sym_baby_pos = SymDoBirth(child, repro_info.pos);
+    emp::Ptr<sgp_sym_t> sym_parent = static_cast<sgp_sym_t*>(org.Raw());
+    // Trigger any post-birth actions
+    after_sym_do_birth_sig.Trigger(sym_baby_pos, sym_parent);
+    // Mark parent as no longer reproducing
+    // static_cast<sgp_sym_t*>(org.Raw())->GetHardware().GetCPUState().ResetReproState();
+  }
 }
 
 // Called for symbionts in the reproduction queue
@@ -278,6 +326,92 @@ void SGPWorld::ProcessStressEscapees() {
   // TODO - add data collection for successful escapes
 }
 
+void SGPWorld::AddStressEscapees(
+  emp::Ptr<sgp_sym_t> sym_parent_ptr,
+  const emp::BitVector& parent_task_profile
+) {
+  const size_t escape_location = sym_parent_ptr->GetHardware().GetCPUState().GetLocation().GetPopID();
+  // Reproducing touches the world's rng and systematics, so wait until threads finish.
+  if (deferring_updates) {
+    worker_updates[GetWorkerID()].stress_escapee_parents.emplace_back(
+      sym_parent_ptr,
+      parent_task_profile,
+      escape_location
+    );
+    return;
+  }
+  ProduceStressEscapees(sym_parent_ptr, parent_task_profile, escape_location);
+}
+
+void SGPWorld::ProduceStressEscapees(
+  emp::Ptr<sgp_sym_t> sym_parent_ptr,
+  const emp::BitVector& parent_task_profile,
+  size_t escape_location
+) {
+  for (size_t i = 0; i < sgp_config.PARASITE_NUM_OFFSPRING_ON_STRESS_INTERACTION(); ++i) {
+    emp::Ptr<Organism> sym_offspring = sym_parent_ptr->Reproduce();
+    symbiont_stress_escapees.emplace_back(
+      static_cast<sgp_sym_t*>(sym_offspring.Raw()),
+      parent_task_profile,
+      escape_location
+    );
+  }
+}
+
+void SGPWorld::BeginDeferredUpdates() {
+  emp_assert(worker_updates.size() == scheduler.GetThreadCount());
+  // Reseed thread rngs from the world's rng (in thread order) so threaded runs
+  // are reproducible for a given seed and thread count.
+  for (DeferredUpdates& updates : worker_updates) {
+    updates.random.ResetSeed(random_ptr->GetInt(1, std::numeric_limits<int>::max()));
+    updates.Reset(host_task_successes.size(), sym_task_successes.size());
+  }
+  deferring_updates = true;
+}
+
+void SGPWorld::ApplyDeferredUpdates() {
+  deferring_updates = false;
+  // Apply each thread's updates in thread order. Within a thread, stress
+  // escapees are produced before any deaths so that escapee parents still exist.
+  for (DeferredUpdates& updates : worker_updates) {
+    for (size_t task_id = 0; task_id < updates.host_task_successes.size(); ++task_id) {
+      host_task_successes[task_id] += updates.host_task_successes[task_id];
+    }
+    for (size_t task_id = 0; task_id < updates.sym_task_successes.size(); ++task_id) {
+      sym_task_successes[task_id] += updates.sym_task_successes[task_id];
+    }
+    for (double int_val : updates.horiz_trans_attempts) {
+      RecordHorizontalTransmissionAttempt(int_val);
+    }
+    for (StressEscapeeParent& parent_info : updates.stress_escapee_parents) {
+      ProduceStressEscapees(
+        parent_info.sym_parent,
+        parent_info.parent_task_profile,
+        parent_info.escape_location
+      );
+    }
+    for (emp::Ptr<sgp_sym_t> sym_ptr : updates.infections) {
+      // Symbiont may have died or already infected (if it executed infect more than once).
+      const size_t pop_id = sym_ptr->GetHardware().GetCPUState().GetLocation().GetPopID();
+      const bool still_free_living = IsSymPopOccupied(pop_id) &&
+        sym_pop[pop_id].Raw() == static_cast<Organism*>(sym_ptr.Raw());
+      if (sym_ptr->GetDead() || !still_free_living) continue;
+      FreeLivingSymDoInfect(*sym_ptr);
+    }
+    for (emp::Ptr<Organism> sym_ptr : updates.graveyard) {
+      SendToGraveyard(sym_ptr);
+    }
+    for (size_t pop_id : updates.free_sym_deaths) {
+      DoSymDeath(pop_id);
+    }
+    for (size_t pop_id : updates.host_deaths) {
+      if (IsOccupied(pop_id)) {
+        DoDeath(emp::WorldPosition(pop_id));
+      }
+    }
+  }
+}
+
 void SGPWorld::ProcessGraveyard() {
   // clean up the graveyard
   for (size_t i = 0; i < graveyard.size(); ++i) {
@@ -320,10 +454,10 @@ void SGPWorld::ProcessSymOutputBuffer(sgp_sym_t& sym) {
   auto& output_buffer = cpu_state.GetOutputBuffer();
   for (uint32_t val : output_buffer) {
     // Is this the correct output for any tasks?
-    if (task_io.IsValidOutput(val)) {
+    // Get all task ids associated with this output value (none if it's not correct)
+    const auto task_ids = task_io.FindTaskIDs(val);
+    if (!task_ids.empty()) {
       // Yes, this output is correct.
-      // Get all task ids associated with this output value
-      const emp::vector<size_t>& task_ids = task_io.GetTaskIDs(val);
       // Give credit for completed tasks
       for (size_t task_id : task_ids) {
         // Is this a valid sym task?
@@ -349,7 +483,7 @@ void SGPWorld::ProcessSymOutputBuffer(sgp_sym_t& sym) {
           cpu_state.ResetCreditedOutputs(task_id);
         }
         // Track success
-        ++sym_task_successes[task_id];
+        ++GetSymTaskSuccesses()[task_id];
 
         // Calc base task value based on task environment, task requirements, and
         // symbiont's current point value.
@@ -383,11 +517,14 @@ void SGPWorld::ProcessSymOutputBuffer(sgp_sym_t& sym) {
 }
 
 void SGPWorld::HostDoMutation(sgp_host_t& host) {
-  mutator.MutateProgram(host.GetProgram());
+  // Programs are shared between relatives (copy-on-write); the mutator only
+  // unshares the program if a mutation actually lands.
+  mutator.MutateProgram(host.GetHardware().GetSharedProgram());
 }
 
 void SGPWorld::SymDoMutation(sgp_sym_t& sym) {
-  mutator.MutateProgram(sym.GetProgram());
+  // See HostDoMutation.
+  mutator.MutateProgram(sym.GetHardware().GetSharedProgram());
 }
 
 void SGPWorld::SymDonateToHost(Organism& from_sym, Organism& to_host) {
@@ -443,6 +580,11 @@ void SGPWorld::FreeLivingSymDoInfect(Organism& sym) {
   emp_assert(sgp_config.SYM_LIMIT() >= 0);
   // NOTE - Could add some runtime customizability here if we want. E.g., functors, etc.
   sgp_sym_t& sgp_sym = static_cast<sgp_sym_t&>(sym);
+  // Infection moves symbiont into a host, so wait until threads finish.
+  if (deferring_updates) {
+    worker_updates[GetWorkerID()].infections.emplace_back(&sgp_sym);
+    return;
+  }
   // Get sym's location in emp::World pop
   const size_t pop_index = sgp_sym.GetHardware().GetCPUState().GetLocation().GetPopID();
   // Check that there's an available host
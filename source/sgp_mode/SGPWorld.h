@@ -7,6 +7,7 @@
 #include "SGPHost.h"
 #include "SGPSymbiont.h"
 #include "org_type_info.h"
+#include "CompatibilityPolicy.h"
 #include "ReproductionQueue.h"
 #include "ProgramBuilder.h"
 #include "SGPMutator.h"
@@ -14,6 +15,7 @@
 #include "hardware/SGPHardwareSpec.h"
 #include "hardware/GenomeLibrary.h"
 #include "hardware/SGPHardware.h"
+#include "hardware/JumpTableCache.h"
 
 #include "emp/Evolve/World_structure.hpp"
 #include "emp/data/DataNode.hpp"
@@ -48,6 +50,7 @@ public:
   using task_io_bank_t = typename task_env_t::io_bank_t;
   using task_io_t = typename task_io_bank_t::TaskIO;
   using mutator_t = SGPMutator<sgp_prog_t, Library>;
+  using jump_table_cache_t = JumpTableCache<sgp_prog_t>;
   using sgp_prog_rectifier_t = sgpl::OpCodeRectifier<Library>;
 
   using fun_sym_do_birth_t = std::function<emp::WorldPosition(
@@ -69,21 +72,6 @@ public:
     sgp_sym_t&
   )>;
 
-  // Determines whether two task profiles are "compatible" with one another.
-  using fun_task_profile_compatibility_t = std::function<bool(
-    const emp::BitVector&,
-    const emp::BitVector&
-  )>;
-
-  // Determines whether a host and symbiont are "compatible" with one another.
-  using fun_interaction_compatibility_t = std::function<bool(
-    const sgp_host_t&,
-    const sgp_sym_t&
-  )>;
-
-  using fun_get_host_task_profile_t = std::function<const emp::BitVector&(const sgp_host_t&)>;
-  using fun_get_sym_task_profile_t = std::function<const emp::BitVector&(const sgp_sym_t&)>;
-
   using fun_do_resource_inflow_t = std::function<void(void)>;
 
   using fun_calc_host_nutrient_interaction_t = std::function<double(
@@ -118,6 +106,8 @@ public:
   using stress_sym_mode_t = typename org_info::StressSymbiontType;
   using health_sym_mode_t = typename org_info::HealthSymbiontType;
   using nutrient_sym_mode_t = typename org_info::NutrientSymbiontType;
+  using task_profile_mode_t = typename org_info::TaskProfileMode;
+  using interaction_compat_mode_t = typename org_info::InteractionCompatibilityMode;
 
   // Used for any snapshot info that should be added to the config snapshot file
   // in addition to values in sgp_config object.
@@ -211,6 +201,51 @@ public:
     { }
   };
 
+  // Endosymbiont that gets to produce stress escapees once the current
+  // (threaded) parallel phase of an update is over.
+  struct StressEscapeeParent {
+    emp::Ptr<sgp_sym_t> sym_parent;
+    emp::BitVector parent_task_profile;
+    size_t escape_location;
+
+    StressEscapeeParent() = default;
+    StressEscapeeParent(
+      emp::Ptr<sgp_sym_t> sym,
+      const emp::BitVector& tasks,
+      size_t loc
+    ) :
+      sym_parent(sym),
+      parent_task_profile(tasks),
+      escape_location(loc)
+    { }
+  };
+
+  // Changes that reach outside of an organism's world location, made while
+  // organisms are processed on scheduler threads. Each thread buffers its own
+  // changes, which are applied in thread order after all threads finish.
+  struct DeferredUpdates {
+    emp::Random random = emp::Random(1);    // Thread's rng for world-level draws (e.g., interaction chances)
+    emp::vector<size_t> host_deaths;        // Pop ids of hosts that died
+    emp::vector<size_t> free_sym_deaths;    // Pop ids of free-living symbionts that died
+    emp::vector<emp::Ptr<Organism>> graveyard; // Dead endosymbionts removed from their hosts
+    emp::vector<emp::Ptr<sgp_sym_t>> infections; // Free-living symbionts that executed an infect instruction
+    emp::vector<StressEscapeeParent> stress_escapee_parents;
+    emp::vector<double> horiz_trans_attempts; // Interaction values of symbionts that attempted horizontal transmission
+    emp::vector<size_t> host_task_successes;
+    emp::vector<size_t> sym_task_successes;
+
+    void Reset(size_t num_host_tasks, size_t num_sym_tasks) {
+      host_deaths.clear();
+      free_sym_deaths.clear();
+      graveyard.clear();
+      infections.clear();
+      stress_escapee_parents.clear();
+      horiz_trans_attempts.clear();
+      utils::ResizeFill(host_task_successes, num_host_tasks, 0);
+      utils::ResizeFill(sym_task_successes, num_sym_tasks, 0);
+    }
+  };
+
   // Tag used to trigger start module in signalgp programs during run
   tag_t START_TAG;
 
@@ -387,15 +422,22 @@ protected:
   size_t max_world_size; // Maximum number of locations in the world
   ReproductionQueue repro_queue; // Stores which organisms are queued for reproduction
   tasks::LogicTaskEnvironment task_env;   // Manages task set, task requirements, and task rewards
+  emp::Ptr<const task_io_bank_t> shared_io_bank = nullptr; // If set, task_env uses this IO bank instead of generating one (unowned)
   // TODO - Consider having symbiont rectifier and host rectifier
   //        -> Symbiont-specific instructions wouldn't be in host's instruction set
   sgp_prog_rectifier_t opcode_rectifier; // Used to "disable" instructions at runtime based on run configuration
   ProgramBuilder<hw_spec_t> prog_builder = ProgramBuilder<hw_spec_t>(opcode_rectifier); // Utility for building signalgp programs
   mutator_t mutator = mutator_t(opcode_rectifier);  // Handles mutating sgp programs
+  jump_table_cache_t jump_table_cache; // Jump tables of recently initialized programs (see SGPHardware)
 
   emp::vector<StressEscapee> symbiont_stress_escapees;
   emp::vector<size_t> escapee_ids; // Used to randomize order of processing escapees (to avoid biasing)
 
+  // One set of deferred updates per scheduler thread (only used when NUM_THREADS > 1).
+  emp::vector<DeferredUpdates> worker_updates;
+  // True while organisms are being processed on scheduler threads.
+  bool deferring_updates = false;
+
   // Flag for whether setup has been run.
   bool setup = false;
 
@@ -461,22 +503,59 @@ protected:
   //   we no longer have access to the symbiont parent for a stress transmission event.
   std::function<bool(sgp_host_t&, const emp::BitVector&)> fun_host_sym_stress_trans_compatibility_check;
 
-  // Configurable function that accesses what matching format should be 
-  // used to determing host-symbiont interaction compatibility.
-  fun_interaction_compatibility_t fun_interaction_compatibility_check;
+  // Which tasks make up host and symbiont task profiles (TASK_PROFILE_MODE).
+  // - E.g., do we want to use parent tasks, current tasks, etc.
+  // Resolved to a compile-time policy on use (see CompatibilityPolicy.h).
+  task_profile_mode_t task_profile_mode = task_profile_mode_t::SELF_ALL;
+
+  // What matching format is used to determine host-symbiont interaction and
+  // task compatibility (INTERACTION_PROFILE_COMPATIBILITY_MODE).
+  interaction_compat_mode_t interaction_compat_mode = interaction_compat_mode_t::ALWAYS;
 
-  // Configurable function that accesses what matching format should be 
-  // used to determing host-symbiont task compatibility.
-  fun_task_profile_compatibility_t fun_task_profile_compatibility_check;
+  // Internal helper for tag-probabilistic-match interaction compatibility.
+  bool TagProbabilisticMatch(const sgp_host_t& host, const sgp_sym_t& sym) {
+    return TagDistanceWithinCutoff(host, CalcTagMetric(host.GetTag(), sym.GetTag()));
+  }
 
-  // Configurable function that accesses task profile to be used for hosts.
-  // - E.g., do we want to use parent tasks, current tasks, etc.
-  fun_get_host_task_profile_t fun_get_host_task_profile;
+  // Internal helper: draws the host's (Poisson) tag permissiveness cutoff and
+  // checks a host-symbiont tag distance against it.
+  bool TagDistanceWithinCutoff(const sgp_host_t& host, double normalized_tag_distance) {
+    double tag_distance = normalized_tag_distance * TAG_LENGTH;
+    double permissiveness_mean = (sgp_config.HOST_TAG_PERMISSIVENESS_EVOLVES()) ? host.GetTagPermissiveness() : sgp_config.TAG_PERMISSIVENESS();
+    double cutoff = GetWorkerRandom().GetPoisson(permissiveness_mean * TAG_LENGTH);
+    return(tag_distance <= cutoff);
+  }
 
-  // Configurable function that accesses task profile to be used for symbionts.
-  // By keeping host/sym functions separately, we could configure them independently.
-  //    E.g., if we want hosts to use their full profile vs syms using first task only
-  fun_get_sym_task_profile_t fun_get_sym_task_profile;
+  // Internal helper: task profile comparison between a host and symbiont with
+  // both modes known at compile time. Cached on the symbiont, and only
+  // recomputed when either organism's task profiles change.
+  template<task_profile_mode_t PROFILE_MODE, interaction_compat_mode_t COMPAT_MODE>
+  const policy::TaskProfileMatch& CachedTaskProfileMatch(const sgp_host_t& host, const sgp_sym_t& sym) const {
+    const auto& host_state = host.GetHardware().GetCPUState();
+    const auto& sym_state = sym.GetHardware().GetCPUState();
+    policy::TaskProfileMatch& match = sym.GetHostProfileMatch();
+    if (!match.IsCurrent(host_state.GetTaskProfileVersion(), sym_state.GetTaskProfileVersion())) {
+      const emp::BitVector& host_profile = policy::SelectTaskProfile<PROFILE_MODE>(host_state);
+      const emp::BitVector& sym_profile = policy::SelectTaskProfile<PROFILE_MODE>(sym_state);
+      match.host_version = host_state.GetTaskProfileVersion();
+      match.sym_version = sym_state.GetTaskProfileVersion();
+      match.compatible = policy::TaskProfilesCompatible<COMPAT_MODE>(host_profile, sym_profile);
+      match.match_strength = utils::MatchingOnesCount(sym_profile, host_profile);
+    }
+    return match;
+  }
+
+  // Internal helper: interaction compatibility with both modes known at compile time.
+  template<task_profile_mode_t PROFILE_MODE, interaction_compat_mode_t COMPAT_MODE>
+  bool InteractionCompatible(const sgp_host_t& host, const sgp_sym_t& sym) {
+    if constexpr (COMPAT_MODE == interaction_compat_mode_t::ALWAYS) {
+      return true;
+    } else if constexpr (COMPAT_MODE == interaction_compat_mode_t::TAG_PROBABILISTIC_MATCH) {
+      return TagProbabilisticMatch(host, sym); // Random draw every check, so never cached
+    } else {
+      return CachedTaskProfileMatch<PROFILE_MODE, COMPAT_MODE>(host, sym).compatible;
+    }
+  }
 
     // ---- Symbiont vertical transmission signals / functors ----
   // before_sym_vert_transmission_sig - Triggers in SGPSymbiont::Vertical Transmission function.
@@ -510,6 +589,8 @@ protected:
   // ----- Internal helper functions -----
   // Called by Update()
   void DoReproduction();
+  // Called by DoReproduction() for each valid event in the reproduction queue.
+  void ReproduceQueuedOrg(const ReproEvent& repro_info);
 
 
   // Internal helper function to handle host births.
@@ -542,6 +623,18 @@ protected:
 
   void ProcessStressEscapees();
 
+  // Reproduce symbiont parent into stress escapees (added to symbiont_stress_escapees).
+  void ProduceStressEscapees(
+    emp::Ptr<sgp_sym_t> sym_parent_ptr,
+    const emp::BitVector& parent_task_profile,
+    size_t escape_location
+  );
+
+  // Internal helper functions for threaded updates.
+  // Called by Update() around a threaded scheduler run.
+  void BeginDeferredUpdates();
+  void ApplyDeferredUpdates();
+
   // --- Internal setup helper functions ---.
   // Called internally on world setup.
   // NOTE - Can we get rid of passing these values in as pointers?
@@ -605,6 +698,7 @@ public:
     SymWorld(rnd, _config),
     scheduler(rnd),
     task_env(rnd),
+    jump_table_cache(_config->JUMP_TABLE_CACHE_SIZE()),
     sgp_config(*_config)
   {
       // Configure default (no) nutrient interaction (IMPORTANT!)
@@ -661,25 +755,126 @@ public:
     return cpu_state.GetTaskPerformanceCount(task_id) < max_repeats;
   }
 
-  /* Accessor for host_task_successes */
-  emp::vector<size_t>& GetHostTaskSuccesses() { return host_task_successes; }
+  /* Accessor for host_task_successes (calling thread's counts during a threaded update) */
+  emp::vector<size_t>& GetHostTaskSuccesses() {
+    return (deferring_updates) ? worker_updates[GetWorkerID()].host_task_successes : host_task_successes;
+  }
 
-  /* Accessor for sym_task_successes */
-  emp::vector<size_t>& GetSymTaskSuccesses() { return sym_task_successes; }
+  /* Accessor for sym_task_successes (calling thread's counts during a threaded update) */
+  emp::vector<size_t>& GetSymTaskSuccesses() {
+    return (deferring_updates) ? worker_updates[GetWorkerID()].sym_task_successes : sym_task_successes;
+  }
+
+  /* Which scheduler thread is running on the calling thread? (0 if not threaded) */
+  size_t GetWorkerID() const { return Scheduler::GetWorkerID(); }
+
+  /* Is the world currently processing organisms on scheduler threads? */
+  bool IsDeferringUpdates() const { return deferring_updates; }
+
+  /**
+   * Input: None
+   *
+   * Output: Random number generator to use for world-level draws made while
+   * processing an organism.
+   *
+   * Purpose: During a threaded update, each thread draws from its own generator
+   * (reseeded from the world's generator every update). Otherwise, this is the
+   * world's generator.
+   */
+  emp::Random& GetWorkerRandom() {
+    return (deferring_updates) ? worker_updates[GetWorkerID()].random : *random_ptr;
+  }
 
   task_env_t& GetTaskEnv() { return task_env; }
   const task_env_t& GetTaskEnv() const { return task_env; }
 
+  /**
+   * Input: An IO bank generated for this world's task environment file. It
+   * must outlive this world.
+   *
+   * Output: None
+   *
+   * Purpose: To skip generating the task IO bank on setup (e.g., when many
+   * replicates share one bank). Must be called before Setup().
+   */
+  void SetSharedIOBank(const task_io_bank_t& io_bank) { shared_io_bank = &io_bank; }
+
   size_t GetTaskCount() const { return task_env.GetTaskCount(); }
 
   /* Accessor for host task profiles */
-  const emp::BitVector& GetHostTaskProfile(const sgp_host_t& host){return fun_get_host_task_profile(host);}
+  const emp::BitVector& GetHostTaskProfile(const sgp_host_t& host) const {
+    return policy::WithTaskProfileMode(task_profile_mode, [&host](auto profile_mode) -> const emp::BitVector& {
+      return policy::SelectTaskProfile<decltype(profile_mode)::value>(host.GetHardware().GetCPUState());
+    });
+  }
 
   /* Accessor for symbiont task profiles */
-  const emp::BitVector& GetSymbiontTaskProfile(const sgp_sym_t& symbiont){return fun_get_sym_task_profile(symbiont);}
+  const emp::BitVector& GetSymbiontTaskProfile(const sgp_sym_t& symbiont) const {
+    return policy::WithTaskProfileMode(task_profile_mode, [&symbiont](auto profile_mode) -> const emp::BitVector& {
+      return policy::SelectTaskProfile<decltype(profile_mode)::value>(symbiont.GetHardware().GetCPUState());
+    });
+  }
 
   /* Accessor for organism interaction compatibility */
-  const bool GetInteractionCompatibility(const sgp_host_t& host, const sgp_sym_t& symbiont){return fun_interaction_compatibility_check(host, symbiont);}
+  bool GetInteractionCompatibility(const sgp_host_t& host, const sgp_sym_t& symbiont) {
+    return policy::WithTaskProfileMode(task_profile_mode, [&](auto profile_mode) {
+      return policy::WithInteractionCompatMode(interaction_compat_mode, [&](auto compat_mode) {
+        return InteractionCompatible<decltype(profile_mode)::value, decltype(compat_mode)::value>(host, symbiont);
+      });
+    });
+  }
+
+  /**
+   * Input: A host and a symbiont.
+   *
+   * Output: The comparison between their task profiles (compatibility under the
+   * configured modes and the number of tasks in both profiles).
+   *
+   * Purpose: To compare a host with one of its endosymbionts. The comparison
+   * is cached on the symbiont until either task profile changes, so repeated
+   * checks every update are lookups.
+   */
+  const policy::TaskProfileMatch& GetTaskProfileMatch(const sgp_host_t& host, const sgp_sym_t& symbiont) const {
+    return policy::WithTaskProfileMode(task_profile_mode, [&](auto profile_mode) -> const policy::TaskProfileMatch& {
+      return policy::WithInteractionCompatMode(interaction_compat_mode, [&](auto compat_mode) -> const policy::TaskProfileMatch& {
+        return CachedTaskProfileMatch<decltype(profile_mode)::value, decltype(compat_mode)::value>(host, symbiont);
+      });
+    });
+  }
+
+  /**
+   * Input: A host.
+   *
+   * Output: The number of the host's symbionts that are compatible with it
+   * (see GetInteractionCompatibility).
+   *
+   * Purpose: To count compatible symbionts with the configured modes resolved
+   * once for the whole loop, so each check is inlined.
+   */
+  size_t CountCompatibleSymbionts(sgp_host_t& host) {
+    return policy::WithTaskProfileMode(task_profile_mode, [&](auto profile_mode) {
+      return policy::WithInteractionCompatMode(interaction_compat_mode, [&](auto compat_mode) {
+        size_t count = 0;
+        if constexpr (decltype(compat_mode)::value == interaction_compat_mode_t::TAG_PROBABILISTIC_MATCH) {
+          // Score the host's tag against all of its symbionts' tags at once
+          thread_local tag_batch_t sym_tags;
+          thread_local emp::vector<double> tag_distances;
+          sym_tags.Clear();
+          for (emp::Ptr<Organism> sym_ptr : host.GetSymbionts()) sym_tags.Add(sym_ptr->GetTag());
+          GetTagEngine().DistancesFrom(host.GetTag(), sym_tags, tag_distances);
+          for (double tag_distance : tag_distances) {
+            count += TagDistanceWithinCutoff(host, tag_distance);
+          }
+          return count;
+        }
+        for (emp::Ptr<Organism> sym_ptr : host.GetSymbionts()) {
+          const sgp_sym_t& sym = static_cast<const sgp_sym_t&>(*sym_ptr);
+          count += InteractionCompatible<decltype(profile_mode)::value, decltype(compat_mode)::value>(host, sym);
+        }
+        return count;
+      });
+    });
+  }
 
  /**
    * Input: A host, a symbiont, the value of a task before applying nutrient interaction, and the task id.
@@ -725,22 +920,18 @@ public:
   }
 
   const emp::BitVector& GetSymTaskProfile(
-    sgp_sym_t& sym
-  ) {
-    return fun_get_sym_task_profile(sym);
-  }
-
-  const emp::BitVector& GetHostTaskProfile(
-    sgp_host_t& host
-  ) {
-    return fun_get_host_task_profile(host);
+    const sgp_sym_t& sym
+  ) const {
+    return GetSymbiontTaskProfile(sym);
   }
 
   bool TaskProfileCompatibilityCheck(
     const emp::BitVector& host_task_profile,
     const emp::BitVector& sym_task_profile
-  ) {
-    return fun_task_profile_compatibility_check(host_task_profile, sym_task_profile);
+  ) const {
+    return policy::WithInteractionCompatMode(interaction_compat_mode, [&](auto compat_mode) {
+      return policy::TaskProfilesCompatible<decltype(compat_mode)::value>(host_task_profile, sym_task_profile);
+    });
   }
 
 
@@ -830,6 +1021,12 @@ public:
 
   const std::unordered_set<uint8_t>& GetJumpInstOpcodes() const { return sgp_jump_opcodes; }
 
+  jump_table_cache_t& GetJumpTableCache() {
+    emp_assert(!deferring_updates, "Jump table cache is not thread-safe");
+    return jump_table_cache;
+  }
+  const jump_table_cache_t& GetJumpTableCache() const { return jump_table_cache; }
+
   /**
    * Input: None
    *
@@ -845,11 +1042,23 @@ public:
     // TODO - implement inflow configuration
     // fun_do_resource_inflow();
     // Update scheduler's evaluation order
-    scheduler.UpdateSchedule();
+    if (update_schedule.GetMode() == UpdateSchedule::MODE::RANDOM) {
+      scheduler.UpdateSchedule();
+    } else {
+      scheduler.SetSchedule(update_schedule.Build(GetRandom(), GetSize(), &occupied_positions));
+    }
     // Run scheduler to process organisms
-    scheduler.Run(*this);
+    if (scheduler.IsThreaded()) {
+      // Changes that reach across world locations are buffered by each thread
+      // and applied (in a fixed order) after all threads finish.
+      BeginDeferredUpdates();
+      scheduler.Run(*this);
+      ApplyDeferredUpdates();
+    } else {
+      scheduler.Run(*this);
+    }
     // Process reproduction queue
-    repro_queue.Process();
+    DoReproduction();
     ProcessStressEscapees();
     // Process graveyard, deletes all dead organisms.
     ProcessGraveyard();
@@ -864,6 +1073,7 @@ public:
     if (sgp_config.PHYLOGENY()) {
       sym_sys->Update();
     }
+    DoPeriodicCheckpoint();
   }
 
   // TODO: AEV: Why is this separate from RunExperiment in SymWorld? Needs to be combined to support all the other functionality from RunExperiment
@@ -872,7 +1082,10 @@ public:
     emp_assert(sgp_config.UPDATES() >= 0);
     emp_assert(setup_spatial_structure);
     const size_t updates = sgp_config.UPDATES();
-    for (size_t u = 0; u <= updates; ++u) {
+    // Experiments resumed from a checkpoint pick up at the checkpoint's update
+    const size_t start_update = resume_update;
+    resume_update = 0;
+    for (size_t u = start_update; u <= updates; ++u) {
       Update();
       if (verbose && (u % sgp_config.PRINT_INTERVAL()) == 0) {
         std::cout << "Update: " << u << std::endl;
@@ -890,6 +1103,26 @@ public:
   // Process symbiont at given position in the world
   void ProcessFreeLivingSymAt(const emp::WorldPosition& pos, sgp_sym_t& sym);
 
+  // Remove dead host / free-living symbiont at given position (deferred during threaded updates)
+  void KillHostAt(const emp::WorldPosition& pos);
+  void KillFreeLivingSymAt(size_t pop_id);
+
+  // Delete an endosymbiont that has already been removed from its host
+  // (sent to the graveyard at the end of the parallel phase during threaded updates).
+  void DeleteEndosymbiont(emp::Ptr<Organism> sym_ptr) {
+    if (deferring_updates) {
+      worker_updates[GetWorkerID()].graveyard.emplace_back(sym_ptr);
+    } else {
+      sym_ptr.Delete();
+    }
+  }
+
+  // Endosymbiont gets to produce stress escapees (deferred during threaded updates).
+  void AddStressEscapees(
+    emp::Ptr<sgp_sym_t> sym_parent_ptr,
+    const emp::BitVector& parent_task_profile
+  );
+
   //void ProcessHostOutputBuffer(sgp_host_t& host);
   void ProcessSymOutputBuffer(sgp_sym_t& sym);
 
@@ -915,6 +1148,15 @@ public:
    */
   void Setup() override;
 
+  // Checkpoint support, expanded in SGPWorldSetup.cc
+  // NOTE - organisms store their programs and CPU state; the world adds the
+  //        sgp random number generators and the current task values.
+  std::string GetCheckpointMode() const override { return "sgp"; }
+  emp::Ptr<Organism> MakeCheckpointHost() override;
+  emp::Ptr<Organism> MakeCheckpointSymbiont() override;
+  void SaveWorldCheckpoint(checkpoint::Writer& writer) const override;
+  std::function<void()> LoadWorldCheckpoint(checkpoint::Reader& reader) override;
+
   void SetMutationZero();
 
   // Prototypes for reproduction handling methods
@@ -947,10 +1189,28 @@ public:
    */
   void SendToGraveyard(emp::Ptr<Organism> org) override;
 
+  /**
+   * Input: The interaction value of the symbiont attempting horizontal transmission
+   *
+   * Output: None
+   *
+   * Purpose: To record a horizontal transmission attempt (buffered by the
+   * calling thread during threaded updates).
+   */
+  void RecordHorizontalTransmissionAttempt(double int_val) override {
+    if (deferring_updates) {
+      worker_updates[GetWorkerID()].horiz_trans_attempts.emplace_back(int_val);
+    } else {
+      SymWorld::RecordHorizontalTransmissionAttempt(int_val);
+    }
+  }
+
   org_mode_t GetOrgType() const { return sgp_org_type; }
   stress_sym_mode_t GetStressSymType() const { return stress_sym_type; }
   health_sym_mode_t GetHealthSymType() const { return health_sym_type; }
   nutrient_sym_mode_t GetNutrientSymType() const { return nutrient_sym_type; }
+  task_profile_mode_t GetTaskProfileMode() const { return task_profile_mode; }
+  interaction_compat_mode_t GetInteractionCompatMode() const { return interaction_compat_mode; }
 
   ReproductionQueue& GetReproQueue() { return repro_queue; }
 
@@ -988,7 +1248,7 @@ public:
 
   bool NoBetterMatchingSymbionts(sgp_host_t& host, const emp::BitVector& profile) {
     if (host.HasSym()) {
-      const emp::BitVector& host_task_profile = fun_get_host_task_profile(host);
+      const emp::BitVector& host_task_profile = GetHostTaskProfile(host);
       const size_t match_strength = utils::MatchingOnesCount(
         profile,
         host_task_profile
@@ -998,11 +1258,7 @@ public:
       bool strongest_match = true;
       for (emp::Ptr<Organism> org_ptr : host.GetSymbionts()) {
         emp::Ptr<sgp_sym_t> endosym_ptr = static_cast<sgp_sym_t*>(org_ptr.Raw());
-        const emp::BitVector& endosym_profile = fun_get_sym_task_profile(*endosym_ptr);
-        const size_t endosym_match_strength = utils::MatchingOnesCount(
-          endosym_profile,
-          host_task_profile
-        );
+        const size_t endosym_match_strength = GetTaskProfileMatch(host, *endosym_ptr).match_strength;
         // NOTE: >= vs >
         if (endosym_match_strength > match_strength) {
           strongest_match = false;
@@ -1017,7 +1273,7 @@ public:
 
   bool NoBetterOrEquallyMatchingSymbionts(sgp_host_t& host, const emp::BitVector& profile) {
     if (host.HasSym()) {
-      const emp::BitVector& host_task_profile = fun_get_host_task_profile(host);
+      const emp::BitVector& host_task_profile = GetHostTaskProfile(host);
       const size_t match_strength = utils::MatchingOnesCount(
         profile,
         host_task_profile
@@ -1027,11 +1283,7 @@ public:
       bool strongest_match = true;
       for (emp::Ptr<Organism> org_ptr : host.GetSymbionts()) {
         emp::Ptr<sgp_sym_t> endosym_ptr = static_cast<sgp_sym_t*>(org_ptr.Raw());
-        const emp::BitVector& endosym_profile = fun_get_sym_task_profile(*endosym_ptr);
-        const size_t endosym_match_strength = utils::MatchingOnesCount(
-          endosym_profile,
-          host_task_profile
-        );
+        const size_t endosym_match_strength = GetTaskProfileMatch(host, *endosym_ptr).match_strength;
         // NOTE: >= vs >
         if (endosym_match_strength >= match_strength) {
           strongest_match = false;
@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <limits>
 #include <filesystem>
+#include <sstream>
 
 namespace sgpmode {
 
@@ -85,7 +86,7 @@ emp::DataFile& SGPWorld::SetupOrgCountFile(const std::string& filepath) {
       data_node_hostcount->Reset();
       data_node_hostedsymcount->Reset();
       data_node_freesymcount->Reset();
-      for (size_t pop_i = 0; pop_i < pop.size(); ++pop_i) {
+      occupied_positions.ForEach([this](size_t pop_i) {
         if (IsOccupied(pop_i)) {
           data_node_hostcount->AddDatum(1);
           data_node_hostedsymcount->AddDatum(pop[pop_i]->GetSymbionts().size());
@@ -93,7 +94,7 @@ emp::DataFile& SGPWorld::SetupOrgCountFile(const std::string& filepath) {
         if (sym_pop[pop_i]) {
           data_node_freesymcount->AddDatum(1);
         }
-      }
+      });
     }
   );
 
@@ -273,7 +274,7 @@ emp::DataFile& SGPWorld::SetupSymbiontInteractionValuesFile(const std::string& f
       // Should happen for OrgCounts data file
       data_node_symintval->Reset();
       data_node_symcount->Reset();
-      for (size_t pop_i = 0; pop_i < pop.size(); ++pop_i) {
+      occupied_positions.ForEach([this](size_t pop_i) {
         if (IsOccupied(pop_i)) {
           emp::vector<emp::Ptr<Organism>>& syms = pop[pop_i]->GetSymbionts();
           data_node_symcount->AddDatum(syms.size());
@@ -285,7 +286,7 @@ emp::DataFile& SGPWorld::SetupSymbiontInteractionValuesFile(const std::string& f
           data_node_symintval->AddDatum(sym_pop[pop_i]->GetIntVal());
           data_node_symcount->AddDatum(1);
         }
-      }
+      });
     }
   );
 
@@ -540,7 +541,7 @@ void SGPWorld::CollectCurrentUpdateData() {
       emp_assert(org.IsHost());
       sgp_host_t& host = static_cast<sgp_host_t&>(org);
       // (1) Update host task counts
-      const auto& host_task_profile = fun_get_host_task_profile(host);
+      const auto& host_task_profile = GetHostTaskProfile(host);
       auto& host_cpu_state = host.GetHardware().GetCPUState();
       // (1.5) Update host generations
       current_update_data.host_generations.emplace_back(
@@ -568,7 +569,7 @@ void SGPWorld::CollectCurrentUpdateData() {
         current_update_data.sym_generations.emplace_back(
           endosym_ptr->GetReproCount()
         );
-        const auto& endosym_task_profile = fun_get_sym_task_profile(*endosym_ptr);
+        const auto& endosym_task_profile = GetSymbiontTaskProfile(*endosym_ptr);
         auto& endosym_cpu_state = endosym_ptr->GetHardware().GetCPUState();
         bool any_match = false;
         bool all_match = true;
@@ -711,21 +712,21 @@ void SGPWorld::OutputDominantDataFile() {
     for (auto pair : dominant_organisms) {
       auto sample = pair.first.DynamicCast<sgp_host_t>();
 
-      std::ofstream genome_file;
+      std::ostringstream genome_file;
       std::filesystem::path genome_path = output_dir / dominant_dir / ("Genome_Host"+
         std::to_string(idx) + sgp_config.FILE_NAME()+".data"); // Any ending that actually does make sense for these files?
 
-      genome_file.open(genome_path);
       sample->GetHardware().PrintCode(genome_file);
+      WriteOutputFile(genome_path.string(), genome_file.str());
 
       size_t sym_idx = 0;
       for (auto &sym : sample->GetSymbionts()) {
-        std::ofstream genome_file;
+        std::ostringstream genome_file;
         std::filesystem::path genome_path = output_dir / dominant_dir / ("Genome_Sym"+
           std::to_string(sym_idx) + "_From_Host"+
           std::to_string(idx) + sgp_config.FILE_NAME()+".data");
-        genome_file.open(genome_path);
         sym.DynamicCast<sgp_sym_t>()->GetHardware().PrintCode(genome_file);
+        WriteOutputFile(genome_path.string(), genome_file.str());
         sym_idx++;
       }
 
@@ -95,12 +95,68 @@ void SGPWorld::Setup() {
   // NOTE - any way to clean this up a little? Or, add some explanatory comments.
   long unsigned int total_syms = POP_SIZE * start_moi;
   SetupSymbionts(&total_syms);
+  SetupCheckpointResume();
 
   CreateDataFiles();
   SnapshotConfig();
   setup = true;
 }
 
+emp::Ptr<Organism> SGPWorld::MakeCheckpointHost() {
+  return emp::NewPtr<sgp_host_t>(random_ptr, this, &sgp_config);
+}
+
+emp::Ptr<Organism> SGPWorld::MakeCheckpointSymbiont() {
+  return emp::NewPtr<sgp_sym_t>(random_ptr, this, &sgp_config);
+}
+
+// Saves the main sgp thread's random number generator, each scheduler
+// thread's world-level generator, and the current task values (which change
+// over the run with CHANGING_ENVIRONMENT). Scheduler threads' sgpl generators
+// aren't saved: they are reseeded from the world's generator every update.
+void SGPWorld::SaveWorldCheckpoint(checkpoint::Writer& writer) const {
+  writer.WriteString(checkpoint::SaveRandomState(sgpl::tlrand.Get()));
+  writer.Write<uint64_t>(worker_updates.size());
+  for (const DeferredUpdates& updates : worker_updates) {
+    writer.WriteString(checkpoint::SaveRandomState(updates.random));
+  }
+  writer.Write<uint64_t>(task_env.GetTaskCount());
+  for (size_t task_id = 0; task_id < task_env.GetTaskCount(); ++task_id) {
+    if (task_env.IsHostTask(task_id)) writer.Write(task_env.GetHostTaskReq(task_id).task_value);
+    if (task_env.IsSymTask(task_id)) writer.Write(task_env.GetSymTaskReq(task_id).task_value);
+  }
+}
+
+std::function<void()> SGPWorld::LoadWorldCheckpoint(checkpoint::Reader& reader) {
+  const std::string main_random_state = reader.ReadString();
+  // Only loads into a world with the same number of threads
+  if (reader.Read<uint64_t>() != worker_updates.size()) reader.Fail();
+  emp::vector<std::string> worker_random_states;
+  for (size_t i = 0; i < worker_updates.size() && reader.IsOK(); ++i) {
+    worker_random_states.push_back(reader.ReadString());
+  }
+  if (reader.Read<uint64_t>() != task_env.GetTaskCount()) reader.Fail();
+  emp::vector<std::pair<size_t, double>> host_task_values;
+  emp::vector<std::pair<size_t, double>> sym_task_values;
+  for (size_t task_id = 0; task_id < task_env.GetTaskCount() && reader.IsOK(); ++task_id) {
+    if (task_env.IsHostTask(task_id)) host_task_values.emplace_back(task_id, reader.Read<double>());
+    if (task_env.IsSymTask(task_id)) sym_task_values.emplace_back(task_id, reader.Read<double>());
+  }
+  if (main_random_state.size() != checkpoint::RANDOM_STATE_SIZE) reader.Fail();
+  for (const std::string& random_state : worker_random_states) {
+    if (random_state.size() != checkpoint::RANDOM_STATE_SIZE) reader.Fail();
+  }
+
+  return [this, main_random_state, worker_random_states, host_task_values, sym_task_values]() {
+    checkpoint::RestoreRandomState(sgpl::tlrand.Get(), main_random_state);
+    for (size_t i = 0; i < worker_updates.size(); ++i) {
+      checkpoint::RestoreRandomState(worker_updates[i].random, worker_random_states[i]);
+    }
+    for (const auto& [task_id, value] : host_task_values) task_env.GetHostTaskReq(task_id).task_value = value;
+    for (const auto& [task_id, value] : sym_task_values) task_env.GetSymTaskReq(task_id).task_value = value;
+  };
+}
+
 void SGPWorld::SetupChangingEnvironment() {
   // on setup, set NAND, AND-NOT, OR-NOT to be negative (at update zero)
   // then during each interval apply *-1 to the changing tasks
@@ -235,34 +291,20 @@ void SGPWorld::DisableConfigurableInstructions() {
 
 void SGPWorld::SetupScheduler() {
   // Configure scheduler w/max world size (updated in SGPWorld::Setup, and cfg thread count)
-  scheduler.SetupScheduler(max_world_size);
+  scheduler.SetupScheduler(max_world_size, sgp_config.NUM_THREADS());
+  // Each thread gets its own reproduction queue segment and deferred update buffer
+  repro_queue.Clear();
+  repro_queue.SetNumSegments(scheduler.GetThreadCount());
+  worker_updates.clear();
+  worker_updates.resize(scheduler.GetThreadCount());
   // Scheduler calls world's ProcessOrgAt function
 }
 
 void SGPWorld::SetupReproduction() {
   // Setup reproduction queue
+  // Queued reproduction events are handled by ReproduceQueuedOrg (see DoReproduction)
   repro_queue.Clear();
 
-  // NOTE - could configure reproduce function in repro queue for maximum
-  //        runtime configurability
-  repro_queue.SetReproduceOrgFun([this](ReproEvent& repro_info) {
-    emp::Ptr<Organism> org = repro_info.org;
-    emp::Ptr<Organism> child = org->Reproduce();
-    if (child->IsHost()) {
-      HostDoBirth(child, org, repro_info.pos);
-      // Mark parent as no longer reproducing (world handles setting state, so should handle resetting)
-      // NOTE - could move reset repro state in Reproduce functions
-      // static_cast<sgp_host_t*>(org.Raw())->GetHardware().GetCPUState().ResetReproState();
-    } else {
-      const emp::WorldPosition sym_baby_pos = SymDoBirth(child, repro_info.pos);
-      emp::Ptr<sgp_sym_t> sym_parent = static_cast<sgp_sym_t*>(org.Raw());
-      // Trigger any post-birth actions
-      after_sym_do_birth_sig.Trigger(sym_baby_pos, sym_parent);
-      // Mark parent as no longer reproducing
-      // static_cast<sgp_sym_t*>(org.Raw())->GetHardware().GetCPUState().ResetReproState();
-    }
-  });
-
   // OnBeforePlacement happens during emp::World's AddOrgAt
   // Set CPUState's location when organism is added to the world.
   OnBeforePlacement(
@@ -338,8 +380,8 @@ void SGPWorld::SetupSymReproduction() {
       sgp_host_t& host_parent
     ) -> bool {
       // Check if host profile and sym profile have any overlap?
-      auto& host_profile = fun_get_host_task_profile(host_parent);
-      auto& sym_profile = fun_get_sym_task_profile(sym);
+      auto& host_profile = GetHostTaskProfile(host_parent);
+      auto& sym_profile = GetSymbiontTaskProfile(sym);
       return utils::AnyMatchingOnes(host_profile, sym_profile);
     };
   } else {
@@ -472,11 +514,17 @@ void SGPWorld::SetupSymbionts(long unsigned int* total_syms) {
 void SGPWorld::SetupTaskEnvironment() {
   // TODO - configure any world <--> environment interactions that need to be
   //        setup prior to run
-  task_env.Setup(
-    sgp_config.TASK_ENV_CFG_PATH(),
-    sgp_config.TASK_IO_BANK_SIZE(),
-    sgp_config.TASK_IO_UNIQUE_OUTPUT()
-  );
+  if (shared_io_bank == nullptr) {
+    task_env.Setup(
+      sgp_config.TASK_ENV_CFG_PATH(),
+      sgp_config.TASK_IO_BANK_SIZE(),
+      sgp_config.TASK_IO_UNIQUE_OUTPUT(),
+      sgp_config.TASK_IO_BANK_SEEDED(),
+      sgp_config.TASK_IO_BANK_THREADS()
+    );
+  } else {
+    task_env.Setup(sgp_config.TASK_ENV_CFG_PATH(), *shared_io_bank);
+  }
 
   // Configure organism input buffers / environment id
   // NOTE - now that assigning new env io is in a function, could
@@ -12,99 +12,151 @@
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <thread>
 #include <algorithm>
 #include <limits>
 
 namespace sgpmode {
 
-// TODO - tests!
+// NOTE - Threaded mode is only safe when everything an organism touches while
+//        being processed lives in its own world location. Anything that
+//        reaches across locations (births, deaths, infections, etc.) must be
+//        deferred by the world until after Run returns (see SGPWorld::Update).
+// NOTE - emp::Ptr memory tracking (EMP_TRACK_MEM) is not thread safe, so debug
+//        builds should run with a single thread.
 class Scheduler {
 public:
   using fun_process_org_t = std::function<void(emp::WorldPosition, Organism&)>;
+  using fun_process_id_t = std::function<void(size_t)>;
 
 protected:
   emp::Random& random;
   emp::vector<size_t> schedule_order; // Order of pop ids to evaluate.
 
-  // // Threading-related member variables
-  // emp::vector<emp::vector<size_t>> thread_batches; // Contains schedule indexes handled for each thread.
-  // size_t thread_count; // How many threads?
-  // bool threaded_mode = false;
-  // emp::vector<std::thread> running_threads;
-  // bool thread_pool_started = false;
-  // emp::vector<size_t> thread_seeds; // To ensure replicates are independent, need to generate seeds using root rng
-
-  // std::mutex ready_lock;
-  // std::condition_variable ready_cv;
-  // std::atomic<size_t> cur_update = 0;
-
-  // std::mutex threads_done_lock;
-  // std::condition_variable threads_done_cv;
-  // size_t num_threads_done = 0;
-  // std::atomic_bool finished = false;
-
-  // // Helper function to get id to schedule w/thread batch info
-  // size_t GetID(size_t batch_id, size_t idx) {
-  //   emp_assert(batch_id < thread_batches.size());
-  //   emp_assert(idx < thread_batches[batch_id].size());
-  //   return schedule_order[thread_batches[batch_id][idx]];
-  // }
-
-  // TODO - re-evaluate use of threads; so much possibility for hard-to-detect bad behavior
-  // Can't pass in world as a temporary reference
-  // // TODO - benchmark this approach to scheduling on threads vs. dynamic batching
-  // template<typename WORLD_T>
-  // void RunThread(emp::Ptr<WORLD_T> world_ptr, size_t thread_id) {
-  //   // Make sure each thread gets a different, deterministic, seed
-  //   const size_t thread_seed = thread_seeds[thread_id];
-  //   const auto& schedule_ids = thread_batches[thread_id];
-  //   sgpl::tlrand.Get().ResetSeed(thread_seed);
-  //   size_t last_update = std::numeric_limits<size_t>::max();
-  //   while (true) {
-  //     if (!finished && last_update == cur_update) {
-  //       std::unique_lock<std::mutex> lock(ready_lock);
-  //       ready_cv.wait(
-  //         lock,
-  //         [&]() { return finished || last_update != cur_update; }
-  //       );
-  //     }
-  //     if (finished) return;
-  //     last_update = cur_update;
-  //     // Process assigned organisms
-  //     for (size_t schedule_i : schedule_ids) {
-  //       const size_t pop_id = GetID(thread_id, schedule_i);
-  //       world_ptr->ProcessOrgsAt(pop_id);
-  //     }
-
-  //     {
-  //       std::unique_lock<std::mutex> lock(threads_done_lock);
-  //       num_threads_done++;
-  //     }
-  //     threads_done_cv.notify_all();
-  //   }
-
-  // }
+  // Threading-related member variables
+  emp::vector<emp::vector<size_t>> thread_batches; // Contains schedule indexes handled for each thread.
+  size_t thread_count = 1; // How many threads?
+  bool threaded_mode = false;
+  emp::vector<std::thread> running_threads;
+  bool thread_pool_started = false;
+  emp::vector<int> thread_seeds; // To ensure replicates are independent, need to generate seeds using root rng
+  fun_process_id_t fun_process_id; // Called by threads on each pop id in their batch
+
+  std::mutex ready_lock;
+  std::condition_variable ready_cv;
+  size_t cur_update = 0; // Incremented (under ready_lock) to release threads for an update
+
+  std::mutex threads_done_lock;
+  std::condition_variable threads_done_cv;
+  size_t num_threads_done = 0;
+  bool finished = false;
+
+  // Id of the thread-pool worker running on the calling thread (0 for the main thread).
+  static size_t& WorkerID() {
+    static thread_local size_t worker_id = 0;
+    return worker_id;
+  }
+
+  // Helper function to get id to schedule w/thread batch info
+  size_t GetID(size_t batch_id, size_t idx) const {
+    emp_assert(batch_id < thread_batches.size());
+    emp_assert(idx < thread_batches[batch_id].size());
+    return schedule_order[thread_batches[batch_id][idx]];
+  }
+
+  // Split schedule indexes into one contiguous batch per thread. Batches are
+  // fixed for a given schedule size and thread count, which (along with
+  // per-thread seeds) keeps threaded runs reproducible. Batch storage is reused
+  // when the schedule size changes (see SetSchedule).
+  void SetupThreadBatches() {
+    thread_batches.resize(thread_count);
+    const size_t schedule_size = schedule_order.size();
+    for (size_t thread_id = 0; thread_id < thread_count; ++thread_id) {
+      const size_t batch_begin = (thread_id * schedule_size) / thread_count;
+      const size_t batch_end = ((thread_id + 1) * schedule_size) / thread_count;
+      thread_batches[thread_id].clear();
+      for (size_t schedule_i = batch_begin; schedule_i < batch_end; ++schedule_i) {
+        thread_batches[thread_id].emplace_back(schedule_i);
+      }
+    }
+    thread_seeds.resize(thread_count, 1);
+  }
+
+  void StartThreadPool() {
+    emp_assert(!thread_pool_started);
+    finished = false;
+    cur_update = 0;
+    for (size_t thread_id = 0; thread_id < thread_count; ++thread_id) {
+      running_threads.emplace_back(
+        [this, thread_id]() { RunThread(thread_id); }
+      );
+    }
+    thread_pool_started = true;
+  }
+
+  void StopThreadPool() {
+    if (!thread_pool_started) return;
+    {
+      std::unique_lock<std::mutex> lock(ready_lock);
+      finished = true;
+    }
+    ready_cv.notify_all();
+    for (std::thread& thread : running_threads) {
+      thread.join();
+    }
+    running_threads.clear();
+    thread_pool_started = false;
+  }
+
+  // Thread pool loop: wait for an update to be released, process this thread's
+  // batch, report back, repeat until finished.
+  void RunThread(size_t thread_id) {
+    WorkerID() = thread_id;
+    size_t last_update = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(ready_lock);
+        ready_cv.wait(
+          lock,
+          [&]() { return finished || last_update != cur_update; }
+        );
+        if (finished) return;
+        last_update = cur_update;
+      }
+      // Make sure each thread gets a different, deterministic, seed
+      sgpl::tlrand.Get().ResetSeed(thread_seeds[thread_id]);
+      // Process assigned organisms
+      const size_t batch_size = thread_batches[thread_id].size();
+      for (size_t i = 0; i < batch_size; ++i) {
+        fun_process_id(GetID(thread_id, i));
+      }
+      {
+        std::unique_lock<std::mutex> lock(threads_done_lock);
+        num_threads_done++;
+      }
+      threads_done_cv.notify_all();
+    }
+  }
 
 public:
   Scheduler(
     emp::Random& rand,
-    size_t world_size=1
-    // size_t num_threads=1
+    size_t world_size=1,
+    size_t num_threads=1
   ) :
     random(rand)
-    // thread_count(num_threads),
-    // threaded_mode(num_threads > 1)
   {
-    // SetupScheduler(world_size, num_threads);
-    SetupScheduler(world_size);
+    SetupScheduler(world_size, num_threads);
   }
 
-  ~Scheduler() { }
+  ~Scheduler() { StopThreadPool(); }
 
   // Allow re-configuration of scheduler post-construction.
-  void SetupScheduler(size_t world_size) {
+  void SetupScheduler(size_t world_size, size_t num_threads=1) {
     emp_assert(world_size > 0, "World size must be > 0");
+    emp_assert(num_threads > 0, "Thread count must be > 0");
+    StopThreadPool();
 
     // Resize schedule order to world size
     schedule_order.resize(world_size, 0);
@@ -115,22 +167,72 @@ public:
       0
     );
 
+    thread_count = num_threads;
+    threaded_mode = num_threads > 1;
+    SetupThreadBatches();
+    // Threads are started lazily on first threaded Run.
   }
 
   size_t GetScheduleSize() const { return schedule_order.size(); }
   const emp::vector<size_t>& GetCurSchedule() const { return schedule_order; }
+  size_t GetThreadCount() const { return thread_count; }
+  bool IsThreaded() const { return threaded_mode; }
+  const emp::vector<emp::vector<size_t>>& GetThreadBatches() const { return thread_batches; }
+
+  // Which worker is running on the calling thread? Always 0 outside of a threaded Run.
+  static size_t GetWorkerID() { return WorkerID(); }
 
   // Update schedule order (uniform random)
   void UpdateSchedule() {
     emp::Shuffle(random, schedule_order);
   }
 
-  // Process all orgs in world population in current schedule order (single-threaded).
+  // Use the given order of pop ids (e.g., from the world's UpdateSchedule) for
+  // the next Run. The order may be shorter than the world (e.g., only occupied
+  // positions); thread batches are re-split whenever its size changes.
+  void SetSchedule(const emp::vector<size_t>& order) {
+    const bool resized = order.size() != schedule_order.size();
+    schedule_order.assign(order.begin(), order.end());
+    if (resized) SetupThreadBatches();
+  }
+
+  // Process all orgs in world population in current schedule order.
+  // In threaded mode, each thread processes its batch of the schedule; the
+  // caller blocks until all threads are done.
   template<typename WORLD_T>
   void Run(WORLD_T& world) {
-    for (size_t world_id : schedule_order) {
-      emp_assert(world_id < world.GetSize());
-      world.ProcessOrgsAt(world_id);
+    if (!threaded_mode) {
+      for (size_t world_id : schedule_order) {
+        emp_assert(world_id < world.GetSize());
+        world.ProcessOrgsAt(world_id);
+      }
+      return;
+    }
+    if (!thread_pool_started) StartThreadPool();
+    // Per-update thread seeds come from the root rng (in thread order) so runs
+    // are reproducible for a given seed and thread count.
+    for (int& seed : thread_seeds) {
+      seed = random.GetInt(1, std::numeric_limits<int>::max());
+    }
+    {
+      std::unique_lock<std::mutex> lock(threads_done_lock);
+      num_threads_done = 0;
+    }
+    {
+      std::unique_lock<std::mutex> lock(ready_lock);
+      fun_process_id = [&world](size_t world_id) {
+        emp_assert(world_id < world.GetSize());
+        world.ProcessOrgsAt(world_id);
+      };
+      ++cur_update;
+    }
+    ready_cv.notify_all();
+    {
+      std::unique_lock<std::mutex> lock(threads_done_lock);
+      threads_done_cv.wait(
+        lock,
+        [&]() { return num_threads_done == thread_count; }
+      );
     }
   }
 
@@ -138,4 +240,4 @@ public:
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -15,10 +15,28 @@
 #include "emp/base/array.hpp"
 #include "emp/math/math.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <span>
 
 namespace sgpmode {
 
+/**
+ * Input: None
+ *
+ * Output: A task profile version number that has never been handed out before
+ * (never 0).
+ *
+ * Purpose: Versions are unique across all organisms, so a (host version,
+ * symbiont version) pair identifies the contents of both task profiles (see
+ * CPUState::GetTaskProfileVersion).
+ */
+inline size_t NewTaskProfileVersion() {
+  static std::atomic<size_t> next_version = 1;
+  return next_version.fetch_add(1, std::memory_order_relaxed);
+}
+
 // NOTE - should this be repro "in progress" or "queued"?
 //        I think this is only used to manage queued reproductions?
 enum class ReproState { NONE=0, ATTEMPTING, IN_PROGRESS };
@@ -40,7 +58,7 @@ public:
 
   struct ReproInfo {
     ReproState state = ReproState::NONE;
-    size_t queue_pos = 0;
+    uint64_t queue_pos = 0; // Reproduction queue event id
   };
 
 protected:
@@ -58,11 +76,34 @@ protected:
 
   // Track which outputs for each task have been credited.
   // - Only give credit for repeats after all pairs have been used
-  // task outputs credited
-  emp::vector< std::set<uint32_t> > task_outputs_credited;
+  // - Stored flat, with room for credited_stride outputs per task: task i's
+  //   credited outputs are the first num_outputs_credited[i] values starting
+  //   at task_outputs_credited[i * credited_stride].
+  emp::vector<uint32_t> task_outputs_credited;
+  emp::vector<uint32_t> num_outputs_credited;
+  size_t credited_stride = 4; // Grows if a task is credited for more distinct outputs
+
+  // Make room for more credited outputs per task (keeps current credits).
+  void GrowCreditedStride() {
+    const size_t new_stride = credited_stride * 2;
+    emp::vector<uint32_t> new_credited(num_outputs_credited.size() * new_stride);
+    for (size_t task_id = 0; task_id < num_outputs_credited.size(); ++task_id) {
+      std::copy_n(
+        task_outputs_credited.begin() + (task_id * credited_stride),
+        num_outputs_credited[task_id],
+        new_credited.begin() + (task_id * new_stride)
+      );
+    }
+    task_outputs_credited = std::move(new_credited);
+    credited_stride = new_stride;
+  }
 
   emp::BitVector parent_tasks_performed;
   emp::BitVector parent_first_task_performed;
+  // Changes whenever any of the task profiles above (tasks_performed,
+  // first_task_performed, parent_tasks_performed, parent_first_task_performed)
+  // change, so comparisons between profiles can be cached.
+  size_t task_profile_version = 0;
 
   // NOTE - should this be tracked by the systematics instead?
   // NOTE - shifted int to size_t, looked like these were only ever positive numbers
@@ -120,8 +161,8 @@ public:
     output_buffer.clear();
 
     // Reset tasks credited
-    task_outputs_credited.clear();
-    task_outputs_credited.resize(task_count, {});
+    num_outputs_credited.assign(task_count, 0);
+    task_outputs_credited.resize(task_count * credited_stride);
 
     // Resize + 0-out
     // utils::ResizeClear(used_resources, num_tasks);
@@ -130,6 +171,7 @@ public:
     // first_task_performed_id = (size_t)-1;
     utils::ResizeClear(first_task_performed, num_tasks);
     utils::ResizeClear(parent_first_task_performed, num_tasks);
+    task_profile_version = NewTaskProfileVersion();
 
     utils::ResizeFill(tasks_performance_count, num_tasks, 0);
     utils::ResizeFill(lineage_task_change_loss, num_tasks, 0);
@@ -250,7 +292,7 @@ public:
   const Stacks<uint32_t>& GetStacks() const { return stacks; }
 
   void MarkReproAttempt() { repro_info.state = ReproState::ATTEMPTING; }
-  void MarkReproInProgress(size_t queue_pos) {
+  void MarkReproInProgress(uint64_t queue_pos) {
     repro_info.state = ReproState::IN_PROGRESS;
     repro_info.queue_pos = queue_pos;
   }
@@ -263,7 +305,7 @@ public:
   bool NotReproducing() const {
     return repro_info.state == ReproState::NONE;
   }
-  size_t GetReproQueuePos() const {
+  uint64_t GetReproQueuePos() const {
     emp_assert(ReproInProgress(), "Queue position valid only if repro is in progress");
     return repro_info.queue_pos;
   }
@@ -281,35 +323,40 @@ public:
     cpu_cycles_since_repro = value;
   }
 
+  // NOTE - Task profiles are only changed through the functions below (not
+  //        through references), so that the task profile version stays current.
   const emp::BitVector& GetTasksPerformed() const { return tasks_performed; }
-  emp::BitVector& GetTasksPerformed() { return tasks_performed; }
   bool GetTaskPerformed(size_t task_id) const { return tasks_performed.Get(task_id); }
 
   const emp::BitVector& GetFirstTaskPerformed() const { return first_task_performed; }
-  emp::BitVector& GetFirstTaskPerformed() { return first_task_performed; }
 
   const emp::BitVector& GetParentTasksPerformed() const { return parent_tasks_performed; }
-  emp::BitVector& GetParentTasksPerformed() { return parent_tasks_performed; }
 
   bool GetParentTaskPerformed(size_t task_id) const { return parent_tasks_performed.Get(task_id); }
 
   void SetParentTasksPerformed(const emp::BitVector& parent_tasks) {
     parent_tasks_performed.Import(parent_tasks);
+    task_profile_version = NewTaskProfileVersion();
   }
   void SetParentTaskPerformed(size_t task_id, bool performed=true) {
     parent_tasks_performed.Set(task_id, performed);
+    task_profile_version = NewTaskProfileVersion();
   }
 
   const emp::BitVector& GetParentFirstTaskPerformed() const { return parent_first_task_performed; }
-  emp::BitVector& GetParentFirstTaskPerformed() { return parent_first_task_performed; }
   void SetParentFirstTaskPerformed(const emp::BitVector& parent_first_task) {
     parent_first_task_performed.Import(parent_first_task);
+    task_profile_version = NewTaskProfileVersion();
   }
   void SetParentFirstTaskPerformed(size_t task_id, bool performed=true) {
     parent_first_task_performed.Clear();
     parent_first_task_performed.Set(task_id, performed);
+    task_profile_version = NewTaskProfileVersion();
   }
 
+  // Unique to the current contents of this organism's task profiles.
+  size_t GetTaskProfileVersion() const { return task_profile_version; }
+
 
   const emp::vector<size_t>& GetTaskPerformanceCounts() const { return tasks_performance_count; }
   emp::vector<size_t>& GetTaskPerformanceCounts() { return tasks_performance_count; }
@@ -322,8 +369,9 @@ public:
     emp_assert(task_id < tasks_performance_count.size());
     tasks_performance_count[task_id] = 0;
     tasks_performed.Set(task_id, false);
-    task_outputs_credited[task_id].clear();
+    num_outputs_credited[task_id] = 0;
     first_task_performed.Set(task_id, false);
+    task_profile_version = NewTaskProfileVersion();
   }
 
   // NOTE - could move these into protected, then write a single wrapper function
@@ -332,36 +380,44 @@ public:
   void MarkTaskPerformed(size_t task_id) {
     emp_assert(task_id < tasks_performed.GetSize());
     emp_assert(task_id < tasks_performance_count.size());
-    if (!tasks_performed.Any()) {
-      // first_task_performed_id = task_id;
-      first_task_performed.Set(task_id, true);
+    if (!tasks_performed.Get(task_id)) {
+      if (!tasks_performed.Any()) {
+        // first_task_performed_id = task_id;
+        first_task_performed.Set(task_id, true);
+      }
+      tasks_performed.Set(task_id, true);
+      task_profile_version = NewTaskProfileVersion();
     }
-    tasks_performed.Set(task_id, true);
     ++(tasks_performance_count[task_id]);
 
   }
 
   // Has this output value been credited for given task id?
   bool OutputCredited(size_t task_id, uint32_t output_val) const {
-    emp_assert(task_id < task_outputs_credited.size());
-    return emp::Has(task_outputs_credited[task_id], output_val);
+    const auto outputs = GetOutputsCredited(task_id);
+    return std::find(outputs.begin(), outputs.end(), output_val) != outputs.end();
   }
-  const std::set<uint32_t>& GetOutputsCredited(size_t task_id) const {
-    emp_assert(task_id < task_outputs_credited.size());
-    return task_outputs_credited[task_id];
+  std::span<const uint32_t> GetOutputsCredited(size_t task_id) const {
+    emp_assert(task_id < num_outputs_credited.size());
+    return std::span<const uint32_t>(
+      task_outputs_credited.data() + (task_id * credited_stride),
+      num_outputs_credited[task_id]
+    );
   }
   // Credit the output value
   void CreditOutputValue(size_t task_id, uint32_t output_val) {
-    emp_assert(task_id < task_outputs_credited.size());
-    task_outputs_credited[task_id].emplace(output_val);
+    emp_assert(task_id < num_outputs_credited.size());
+    if (OutputCredited(task_id, output_val)) return;
+    if (num_outputs_credited[task_id] == credited_stride) GrowCreditedStride();
+    task_outputs_credited[(task_id * credited_stride) + num_outputs_credited[task_id]] = output_val;
+    ++num_outputs_credited[task_id];
   }
   void ResetCreditedOutputs(size_t task_id) {
-    task_outputs_credited[task_id].clear();
+    emp_assert(task_id < num_outputs_credited.size());
+    num_outputs_credited[task_id] = 0;
   }
   void ResetCreditedOutputs() {
-    for (auto& outputs : task_outputs_credited) {
-      outputs.clear();
-    }
+    std::fill(num_outputs_credited.begin(), num_outputs_credited.end(), 0);
   }
 
   size_t GetLineageTaskLossCount(size_t task_id) const {
@@ -402,6 +458,91 @@ public:
     lineage_task_diverge_partner[task_id] = count;
   }
 
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the state instructions and the world change as the
+   * organism runs (stacks, IO buffers, task counters, lineage task changes,
+   * cycle counts and reproduction state). The jump table, organism, world and
+   * location are set up by the hardware and world, so they aren't saved.
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const {
+    stacks.SaveCheckpoint(writer);
+    input_buf.SaveCheckpoint(writer);
+    writer.WriteVector(output_buffer);
+    writer.Write<uint64_t>(task_env_id);
+    writer.Write<uint64_t>(num_tasks);
+    writer.WriteBits(tasks_performed);
+    writer.WriteVector(tasks_performance_count);
+    writer.WriteBits(first_task_performed);
+    writer.WriteVector(task_outputs_credited);
+    writer.WriteVector(num_outputs_credited);
+    writer.Write<uint64_t>(credited_stride);
+    writer.WriteBits(parent_tasks_performed);
+    writer.WriteBits(parent_first_task_performed);
+    writer.WriteVector(lineage_task_change_loss);
+    writer.WriteVector(lineage_task_change_gain);
+    writer.WriteVector(lineage_task_converge_partner);
+    writer.WriteVector(lineage_task_diverge_partner);
+    writer.Write(survival_resource);
+    writer.Write<uint64_t>(cpu_cycles_to_exec);
+    writer.Write(repro_info.state);
+    writer.Write(repro_info.queue_pos);
+    writer.Write<uint64_t>(cpu_cycles_since_repro);
+  }
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the state saved by SaveCheckpoint. The saved task
+   * count must match the world's. Task profiles get a new version, so
+   * comparisons cached against the old contents aren't reused.
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) {
+    stacks.LoadCheckpoint(reader);
+    input_buf.LoadCheckpoint(reader);
+    reader.ReadVector(output_buffer);
+    task_env_id = reader.Read<uint64_t>();
+    num_tasks = reader.Read<uint64_t>();
+    reader.ReadBits(tasks_performed);
+    reader.ReadVector(tasks_performance_count);
+    reader.ReadBits(first_task_performed);
+    reader.ReadVector(task_outputs_credited);
+    reader.ReadVector(num_outputs_credited);
+    credited_stride = reader.Read<uint64_t>();
+    reader.ReadBits(parent_tasks_performed);
+    reader.ReadBits(parent_first_task_performed);
+    reader.ReadVector(lineage_task_change_loss);
+    reader.ReadVector(lineage_task_change_gain);
+    reader.ReadVector(lineage_task_converge_partner);
+    reader.ReadVector(lineage_task_diverge_partner);
+    survival_resource = reader.Read<double>();
+    cpu_cycles_to_exec = reader.Read<uint64_t>();
+    repro_info.state = reader.Read<ReproState>();
+    repro_info.queue_pos = reader.Read<uint64_t>();
+    cpu_cycles_since_repro = reader.Read<uint64_t>();
+    task_profile_version = NewTaskProfileVersion();
+
+    const bool consistent = num_tasks == world_ptr->GetTaskCount() &&
+      tasks_performed.GetSize() == num_tasks && first_task_performed.GetSize() == num_tasks &&
+      parent_tasks_performed.GetSize() == num_tasks && parent_first_task_performed.GetSize() == num_tasks &&
+      tasks_performance_count.size() == num_tasks && num_outputs_credited.size() == num_tasks &&
+      task_outputs_credited.size() == num_tasks * credited_stride &&
+      lineage_task_change_loss.size() == num_tasks && lineage_task_change_gain.size() == num_tasks &&
+      lineage_task_converge_partner.size() == num_tasks && lineage_task_diverge_partner.size() == num_tasks &&
+      std::all_of(num_outputs_credited.begin(), num_outputs_credited.end(),
+                  [this](uint32_t count) { return count <= credited_stride; }) &&
+      repro_info.state <= ReproState::IN_PROGRESS;
+    if (!consistent) {
+      reader.Fail();
+      Reset(world_ptr->GetTaskCount());
+    }
+  }
+
 };
 
 }
@@ -205,10 +205,10 @@ INST(SenseTask, {
   const auto& task_io = task_env.GetIOBank().GetIO(env_task_id);
 
   // Check loaded value
-  if (task_io.IsValidOutput(a)) {
+  // Get all task ids associated with this output value (none if it's not correct)
+  const auto task_ids = task_io.FindTaskIDs(a);
+  if (!task_ids.empty()) {
     // Yes, this output is correct.
-    // Get all task ids associated with this output value
-    const emp::vector<size_t>& task_ids = task_io.GetTaskIDs(a);
 
     // Give credit for completed tasks
     for (size_t task_id : task_ids) {
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "SharedProgram.h"
+
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+
+namespace sgpmode {
+
+/**
+ * Size-bounded, least-recently-used cache of the jump destinations computed
+ * for a program (see SGPHardware::InitializeLocalJumpTable), keyed by the
+ * program's contents.
+ *
+ * Every birth and CPU reset rebuilds the jump table by tag-matching each jump
+ * instruction against the program's anchors. Jump destinations only depend on
+ * the program, so offspring with an unmutated genome (or any genome seen
+ * recently) can reuse the table instead of matching again.
+ *
+ * NOTE - Not thread-safe. Hardware is only (re)initialized on the main thread
+ *        (births are never made on scheduler threads).
+ */
+template<typename PROGRAM_T>
+class JumpTableCache {
+public:
+  using program_t = PROGRAM_T;
+  using shared_program_t = SharedProgram<program_t>;
+  using jump_table_t = emp::vector<size_t>;
+
+protected:
+  struct Entry {
+    // A private copy of the program for equality checks. Holding the
+    // organism's SharedProgram instead would count as a share, so every
+    // mutation of a cached genome (GetMutable) would make a needless copy.
+    program_t program;
+    size_t hash;
+    jump_table_t jump_table;
+  };
+  using entry_list_t = std::list<Entry>;
+
+  entry_list_t entries; // Most recently used first
+  std::unordered_map<size_t, typename entry_list_t::iterator> lookup; // Program hash -> entry
+  size_t capacity = 0;  // Maximum number of entries (0 disables caching)
+  size_t num_hits = 0;
+  size_t num_misses = 0;
+
+  void Evict() {
+    while (entries.size() > capacity) {
+      lookup.erase(entries.back().hash);
+      entries.pop_back();
+    }
+  }
+
+public:
+  JumpTableCache(size_t capacity=0) : capacity(capacity) { }
+
+  /**
+   * Input: A program.
+   *
+   * Output: The cached jump table for the program, or nullptr if there isn't one.
+   *
+   * Purpose: To look up a program's jump table, counting the hit or miss.
+   */
+  emp::Ptr<const jump_table_t> Find(const shared_program_t& program) {
+    if (capacity == 0) return nullptr;
+    auto it = lookup.find(program.GetHash());
+    // Programs with the same hash might still differ, so compare contents
+    if (it == lookup.end() || !(it->second->program == program.Get())) {
+      ++num_misses;
+      return nullptr;
+    }
+    ++num_hits;
+    entries.splice(entries.begin(), entries, it->second);
+    return &(it->second->jump_table);
+  }
+
+  /**
+   * Input: A program and the jump table computed for it.
+   *
+   * Output: None
+   *
+   * Purpose: To cache a program's jump table, evicting the least recently used
+   * entry if the cache is full. Replaces any entry with the same hash.
+   */
+  void Insert(const shared_program_t& program, const jump_table_t& jump_table) {
+    if (capacity == 0) return;
+    const size_t hash = program.GetHash();
+    auto it = lookup.find(hash);
+    if (it != lookup.end()) entries.erase(it->second);
+    entries.push_front({program.Get(), hash, jump_table});
+    lookup[hash] = entries.begin();
+    Evict();
+  }
+
+  void SetCapacity(size_t new_capacity) {
+    capacity = new_capacity;
+    Evict();
+  }
+
+  void Clear() {
+    entries.clear();
+    lookup.clear();
+  }
+
+  void ResetCounts() {
+    num_hits = 0;
+    num_misses = 0;
+  }
+
+  size_t GetCapacity() const { return capacity; }
+  size_t GetSize() const { return entries.size(); }
+  size_t GetNumHits() const { return num_hits; }
+  size_t GetNumMisses() const { return num_misses; }
+};
+
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../../Checkpoint.h"
+
 #include "emp/base/array.hpp"
 
 #include <algorithm>
@@ -86,6 +88,25 @@ public:
       buffer.begin()
     );
   }
+
+  void SaveCheckpoint(checkpoint::Writer& writer) const {
+    writer.WriteVector(buffer);
+    writer.Write<uint64_t>(write_ptr);
+    writer.Write<uint64_t>(read_ptr);
+  }
+
+  void LoadCheckpoint(checkpoint::Reader& reader) {
+    reader.ReadVector(buffer);
+    write_ptr = reader.Read<uint64_t>();
+    read_ptr = reader.Read<uint64_t>();
+    // An empty buffer's pointers stay at 0
+    const size_t max_ptr = buffer.empty() ? 0 : buffer.size() - 1;
+    if (write_ptr > max_ptr || read_ptr > max_ptr) {
+      reader.Fail();
+      write_ptr = 0;
+      read_ptr = 0;
+    }
+  }
 };
 
 }
\ No newline at end of file
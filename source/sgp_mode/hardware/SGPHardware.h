@@ -4,6 +4,8 @@
 #include "CPUState.h"
 #include "Instructions.h"
 #include "GenomeLibrary.h"
+#include "JumpTableCache.h"
+#include "SharedProgram.h"
 #include "../../default_mode/Host.h"
 
 #include "sgpl/algorithm/execute_cpu_n_cycles.hpp"
@@ -13,8 +15,13 @@
 #include "sgpl/utility/ThreadLocalRandom.hpp"
 #include "emp/datastructs/set_utils.hpp"
 
+#include "cereal/archives/binary.hpp"
+
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <type_traits>
 
 namespace sgpmode {
 
@@ -30,16 +37,58 @@ public:
   using spec_t = HW_SPEC_T;
   using cpu_t = sgpl::Cpu<spec_t>;
   using program_t = sgpl::Program<spec_t>;
+  using shared_program_t = SharedProgram<program_t>;
   using inst_t = sgpl::Instruction<spec_t>;
   using jump_table_t = sgpl::JumpTable<spec_t, typename spec_t::global_matching_t>;
   using world_t = typename spec_t::world_t;
   using cpu_state_t = CPUState<world_t>;
   using tag_t = typename spec_t::tag_t;
 
+  // Maximum number of dead organisms' buffers kept for reuse on each thread
+  static constexpr size_t MAX_SPARE_BUFFERS = 1024;
+
 protected:
-  cpu_t cpu;
-  program_t program;
-  cpu_state_t state;       // cpu_t Peripheral
+  // The CPU and its state, allocated together so that when an organism dies
+  // its hardware can hand them (and all of their internal buffers) to the
+  // next organism born on the same thread, instead of freeing them.
+  struct Buffers {
+    cpu_t cpu;
+    cpu_state_t state;
+
+    Buffers(emp::Ptr<world_t> world_ptr, emp::Ptr<Organism> organism) :
+      state(world_ptr, organism, world_ptr->GetTaskCount()) { }
+  };
+
+  static emp::vector<std::unique_ptr<Buffers>>& GetSpareBuffers() {
+    static thread_local emp::vector<std::unique_ptr<Buffers>> spare_buffers;
+    return spare_buffers;
+  }
+
+  /**
+   * Input: (1) The world; (2) the organism the hardware belongs to.
+   *
+   * Output: A CPU and CPU state in their initial (just constructed) state.
+   *
+   * Purpose: To reuse a dead organism's buffers if there are any, resetting
+   * them, or else to allocate new ones.
+   */
+  static std::unique_ptr<Buffers> AcquireBuffers(emp::Ptr<world_t> world_ptr, emp::Ptr<Organism> organism) {
+    auto& spare_buffers = GetSpareBuffers();
+    if (spare_buffers.empty()) return std::make_unique<Buffers>(world_ptr, organism);
+    std::unique_ptr<Buffers> buffers = std::move(spare_buffers.back());
+    spare_buffers.pop_back();
+    buffers->cpu.Reset();
+    buffers->state.SetWorld(world_ptr);
+    buffers->state.SetOrganism(organism);
+    buffers->state.Reset(world_ptr->GetTaskCount());
+    buffers->state.GetStacks().SetStackLimit(org_info::DEFAULT_STACK_SIZE_LIMIT);
+    return buffers;
+  }
+
+  std::unique_ptr<Buffers> buffers;
+  cpu_t& cpu;
+  shared_program_t program; // Shared with relatives until mutated (copy-on-write)
+  cpu_state_t& state;       // cpu_t Peripheral
   /**
    * Input: The instruction to print, and the context needed to print it.
    *
@@ -58,15 +107,22 @@ protected:
   // Internal helper function for initializing local jump table used by
   // symbulation jump instructions.
   void InitializeLocalJumpTable() {
+    auto& state_jump_table = state.GetJumpTable();
+    // Jump destinations only depend on the program, so reuse them if this
+    // program's table was computed recently.
+    auto& jump_table_cache = state.GetWorld().GetJumpTableCache();
+    if (auto cached = jump_table_cache.Find(program)) {
+      state_jump_table = *cached;
+      return;
+    }
     // Get global jump table in sgplite cpu
     auto& table = cpu.GetActiveCore().GetGlobalJumpTable();
-    auto& state_jump_table = state.GetJumpTable();
     const auto& jump_opcodes = state.GetWorld().GetJumpInstOpcodes();
     // NOTE - jump table was previously size 100. Seemed like that was because
     //        program size is 100?
-    state_jump_table.resize(program.size(), 0);
+    state_jump_table.resize(GetProgram().size(), 0);
     size_t idx = 0;
-    for (auto& inst : program) {
+    for (auto& inst : GetProgram()) {
       const uint8_t inst_opcode = inst.op_code;
       if (emp::Has(jump_opcodes, inst_opcode)) {
         const auto entry{table.MatchRegulated(inst.tag)};
@@ -76,6 +132,7 @@ protected:
       }
       ++idx;
     }
+    jump_table_cache.Insert(program, state_jump_table);
   }
 
   /**
@@ -88,7 +145,7 @@ protected:
    */
   // TODO - should this be launching cores? At the moment, it needs to.
   void InitializeState() {
-    cpu.InitializeAnchors(program);
+    cpu.InitializeAnchors(GetProgram());
     LaunchCPU(state.GetWorld().START_TAG);
 
     // NOTE - this is awkward: it requires that a CPU core be launched to run.
@@ -106,12 +163,10 @@ public:
     emp::Ptr<world_t> world_ptr,
     emp::Ptr<Organism> organism
   ) :
+    buffers(AcquireBuffers(world_ptr, organism)),
+    cpu(buffers->cpu),
     program(),
-    state(
-      world_ptr,
-      organism,
-      world_ptr->GetTaskCount()
-    )
+    state(buffers->state)
   {
     // State constructor (above) will reset cpu state.
     // InitializeState (below) will configure the local jump table using program.
@@ -119,19 +174,18 @@ public:
   }
 
   /**
-   * Constructs a new CPU with a copy of another CPU's genome.
+   * Constructs a new CPU with another CPU's genome. The genome is shared (not
+   * copied) when given as a shared_program_t.
    */
   SGPHardware(
     emp::Ptr<world_t> world_ptr,
     emp::Ptr<Organism> organism,
-    const program_t& program
+    const shared_program_t& program
   ) :
+    buffers(AcquireBuffers(world_ptr, organism)),
+    cpu(buffers->cpu),
     program(program),
-    state(
-      world_ptr,
-      organism,
-      world_ptr->GetTaskCount()
-    )
+    state(buffers->state)
   {
     // State constructor (above) will reset cpu state.
     // InitializeState (below) will configure the local jump table using program.
@@ -143,9 +197,28 @@ public:
    *
    * Output: None
    *
-   * Purpose: To destruct the objects belonging to CPU.
+   * Purpose: To free the buffers kept for reuse on the calling thread (e.g.,
+   * between runs).
+   */
+  static void ReleaseSpareBuffers() {
+    GetSpareBuffers().clear();
+  }
+
+  SGPHardware(const SGPHardware&) = delete;
+  SGPHardware& operator=(const SGPHardware&) = delete;
+
+  /**
+   * Input: None
+   *
+   * Output: None
+   *
+   * Purpose: To destruct the objects belonging to CPU, keeping its buffers
+   * for the next hardware constructed on this thread.
    */
-  ~SGPHardware() { }
+  ~SGPHardware() {
+    auto& spare_buffers = GetSpareBuffers();
+    if (spare_buffers.size() < MAX_SPARE_BUFFERS) spare_buffers.emplace_back(std::move(buffers));
+  }
 
   /**
    * Input: None
@@ -170,6 +243,88 @@ public:
     Reset();
   }
 
+  /**
+   * Input: None
+   *
+   * Output: The program serialized as a binary cereal archive.
+   *
+   * Purpose: To store the program in a checkpoint.
+   */
+  std::string SerializeProgram() const {
+    std::ostringstream os;
+    {
+      cereal::BinaryOutputArchive archive(os);
+      archive(GetProgram());
+    }
+    return os.str();
+  }
+
+  /**
+   * Input: A program serialized with SerializeProgram.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the program from a checkpoint. Like SetProgram, this
+   * resets the CPU.
+   */
+  void DeserializeProgram(const std::string& bytes) {
+    program_t new_program;
+    {
+      std::istringstream is(bytes);
+      cereal::BinaryInputArchive archive(is);
+      archive(new_program);
+    }
+    program.Set(std::move(new_program));
+    Reset();
+  }
+
+  /**
+   * Input: The checkpoint writer to save into.
+   *
+   * Output: None
+   *
+   * Purpose: To save the program and the CPU's execution state: the CPU
+   * state, and the running core's position in the program and registers.
+   * (Organisms only ever run one core.)
+   */
+  void SaveCheckpoint(checkpoint::Writer& writer) const {
+    writer.WriteString(SerializeProgram());
+    state.SaveCheckpoint(writer);
+    writer.Write<bool>(cpu.HasActiveCore());
+    if (cpu.HasActiveCore()) {
+      const auto& core = cpu.GetActiveCore();
+      writer.Write<uint64_t>(core.GetProgramCounter());
+      writer.Write(core.registers);
+    }
+  }
+
+  /**
+   * Input: The checkpoint reader to load from.
+   *
+   * Output: None
+   *
+   * Purpose: To restore the program and execution state saved by
+   * SaveCheckpoint. The CPU is reset on the restored program (which rebuilds
+   * its jump tables and launches a core), then the core is moved to where
+   * the saved one was.
+   */
+  void LoadCheckpoint(checkpoint::Reader& reader) {
+    const std::string program_bytes = reader.ReadString();
+    if (!reader.IsOK()) return;
+    DeserializeProgram(program_bytes);
+    state.LoadCheckpoint(reader);
+    if (!reader.Read<bool>()) return;
+    const size_t program_counter = reader.Read<uint64_t>();
+    const auto registers = reader.Read<std::decay_t<decltype(cpu.GetActiveCore().registers)>>();
+    if (!reader.IsOK() || !cpu.HasActiveCore() || program_counter > GetProgram().size()) {
+      reader.Fail();
+      return;
+    }
+    auto& core = cpu.GetActiveCore();
+    core.JumpToIndex(program_counter);
+    core.registers = registers;
+  }
+
   // Start a CPU core if none have been started
   void LaunchCPU(const tag_t& start_tag, bool force_launch=false) {
     // If CPU has no active cores or force is true, launch a core.
@@ -196,11 +351,31 @@ public:
     // std::cout << "  - Has active core? " << cpu.HasActiveCore() << std::endl;
     // std::cout << "  - Max cores: " << cpu.GetMaxCores() << std::endl;
     // std::cout << "  - Busy cores: " << cpu.GetNumBusyCores() << std::endl;
-    sgpl::execute_cpu_n_cycles<spec_t>(n_cycles, cpu, program, state);
+    sgpl::execute_cpu_n_cycles<spec_t>(n_cycles, cpu, GetProgram(), state);
     state.IncCPUCyclesSinceRepro(n_cycles);
     // sgpl::execute_cpu_n_cycles<spec_t>(5, cpu, program, state);
   }
 
+  /**
+   * Input: The maximum number of CPU cycles to run.
+   *
+   * Output: The number of CPU cycles actually run.
+   *
+   * Purpose: Steps the CPU forward up to max_cycles cycles, stopping right
+   * after any cycle in which an instruction flags a reproduction attempt. This
+   * does the same as calling RunCPUStep(1) and checking ReproAttempt() after
+   * each cycle, but keeps the per-cycle loop inside the hardware (no signal
+   * dispatch or virtual calls between cycles).
+   */
+  size_t RunCPUStepsUntilReproAttempt(size_t max_cycles) {
+    for (size_t cycle = 0; cycle < max_cycles; ++cycle) {
+      sgpl::execute_cpu_n_cycles<spec_t>(1, cpu, GetProgram(), state);
+      state.IncCPUCyclesSinceRepro(1);
+      if (state.ReproAttempt()) return cycle + 1;
+    }
+    return max_cycles;
+  }
+
   /**
    * Input: None
    *
@@ -208,8 +383,23 @@ public:
    *
    * Purpose: To Get the Program of an Organism from its CPU
    */
-  const program_t& GetProgram() const { return program; }
-  program_t& GetProgram() { return program; }
+  const program_t& GetProgram() const { return program.Get(); }
+
+  /**
+   * Input: None
+   *
+   * Output: Returns the CPU's program, unshared so that it can be modified
+   *
+   * Purpose: To get the program for mutation. Other organisms sharing the
+   * program keep the original.
+   */
+  program_t& GetMutableProgram() { return program.GetMutable(); }
+
+  const shared_program_t& GetSharedProgram() const { return program; }
+  shared_program_t& GetSharedProgram() { return program; }
+
+  // Do these CPUs share the same stored program? (If so, their genomes are identical.)
+  bool SharesProgram(const this_t& other) const { return program.SharesWith(other.program); }
 
   const cpu_state_t& GetCPUState() const { return state; }
   cpu_state_t& GetCPUState() { return state; }
@@ -254,7 +444,7 @@ public:
     // TODO - refactor internal/external dependencies of these functions
     //        could also consider shifting this functionality outside of this
     //        class and into a utilities file.
-    for (auto i : program) {
+    for (auto i : GetProgram()) {
       PrintOp(
         i,
         lib_info::arities,
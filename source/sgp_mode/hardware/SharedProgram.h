@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace sgpmode {
+
+/// Hash of a program's contents (every instruction's op code, arguments, and
+/// tag). Equal programs always hash the same.
+template<typename PROGRAM_T>
+size_t HashProgram(const PROGRAM_T& program) {
+  size_t hash = program.size();
+  auto combine = [&hash](size_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+  };
+  for (const auto& inst : program) {
+    combine(inst.op_code);
+    for (const auto arg : inst.args) combine(arg);
+    combine(std::hash<std::decay_t<decltype(inst.tag)>>{}(inst.tag));
+  }
+  return hash;
+}
+
+/// Reference-counted, copy-on-write storage for an organism's program
+/// (genome). Copying a SharedProgram shares the underlying program, so
+/// offspring point at their parent's genome until a mutation actually lands;
+/// GetMutable() makes a private copy first if the program is shared.
+///
+/// NOTE - Programs are only made mutable during births, which always happen on
+///        the main thread (see ReproductionQueue), so the share count check in
+///        GetMutable() doesn't race with other threads copying the program.
+template<typename PROGRAM_T>
+class SharedProgram {
+public:
+  using program_t = PROGRAM_T;
+
+protected:
+  std::shared_ptr<program_t> program;
+  // Cached HashProgram(*program); copies share it along with the program.
+  mutable size_t hash = 0;
+  mutable bool has_hash = false;
+
+public:
+  SharedProgram() : program(std::make_shared<program_t>()) { }
+
+  /// Stores a (private) copy of the given program. Intentionally implicit so
+  /// that organisms can still be built directly from a program.
+  SharedProgram(const program_t& in_program) :
+    program(std::make_shared<program_t>(in_program)) { }
+
+  const program_t& Get() const { return *program; }
+
+  /// Get a program that can be modified without affecting any other organism.
+  program_t& GetMutable() {
+    if (program.use_count() > 1) {
+      program = std::make_shared<program_t>(*program);
+    }
+    has_hash = false; // Caller may change the program
+    return *program;
+  }
+
+  /// Replace this organism's program (other organisms keep the old one).
+  void Set(program_t&& new_program) {
+    program = std::make_shared<program_t>(std::move(new_program));
+    has_hash = false;
+  }
+
+  /// Hash of the program's contents (computed once per stored program).
+  size_t GetHash() const {
+    if (!has_hash) {
+      hash = HashProgram(*program);
+      has_hash = true;
+    }
+    return hash;
+  }
+
+  /// Number of organisms (hardware) currently sharing this program.
+  size_t GetShareCount() const { return program.use_count(); }
+
+  /// Do these two point at the same stored program? (If so, they're identical.)
+  bool SharesWith(const SharedProgram& other) const { return program == other.program; }
+};
+
+}
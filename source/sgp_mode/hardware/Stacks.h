@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../../Checkpoint.h"
+
 #include "emp/base/vector.hpp"
 #include "emp/base/array.hpp"
 
@@ -100,6 +102,27 @@ public:
       std::nullopt;
   }
 
+  // Save the contents of every stack, which stack is active, and the limit.
+  void SaveCheckpoint(checkpoint::Writer& writer) const {
+    writer.Write<uint64_t>(stacks.size());
+    for (const stack_t& stack : stacks) writer.WriteVector(stack);
+    writer.Write<uint64_t>(active_stack);
+    writer.Write<uint64_t>(stack_size_limit);
+  }
+
+  // The number of stacks must match the one saved.
+  void LoadCheckpoint(checkpoint::Reader& reader) {
+    if (reader.Read<uint64_t>() != stacks.size()) {
+      reader.Fail();
+      return;
+    }
+    for (stack_t& stack : stacks) reader.ReadVector(stack);
+    const size_t saved_active = reader.Read<uint64_t>();
+    stack_size_limit = reader.Read<uint64_t>();
+    if (saved_active < stacks.size()) active_stack = saved_active;
+    else reader.Fail();
+  }
+
 };
 
 }
\ No newline at end of file
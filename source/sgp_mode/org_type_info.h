@@ -15,6 +15,8 @@ enum class SGPOrganismType { DEFAULT = 0 };
 enum class StressSymbiontType { MUTUALIST = 0, PARASITE, NEUTRAL, INTERACTION_VALUE_BASED };
 enum class HealthSymbiontType { MUTUALIST = 0, PARASITE, NEUTRAL, INTERACTION_VALUE_BASED };
 enum class NutrientSymbiontType { MUTUALIST = 0, PARASITE, NEUTRAL, INTERACTION_VALUE_BASED };
+enum class TaskProfileMode { PARENT_ALL = 0, PARENT_FIRST, SELF_ALL, SELF_FIRST };
+enum class InteractionCompatibilityMode { ALWAYS = 0, TASK_ANY_MATCH, TASK_PERFECT_MATCH, TAG_PROBABILISTIC_MATCH };
 
 // Mapping from commandline string configuration to organism type.
 std::unordered_map<std::string, SGPOrganismType> sgp_org_type_map = {
@@ -45,6 +47,22 @@ std::unordered_map<std::string, NutrientSymbiontType> sgp_nutrient_sym_type_map
   {"interaction-value", NutrientSymbiontType::INTERACTION_VALUE_BASED}
 };
 
+// Mapping from commandline task profile mode string to task profile mode.
+std::unordered_map<std::string, TaskProfileMode> sgp_task_profile_mode_map = {
+  {"parent-all", TaskProfileMode::PARENT_ALL},
+  {"parent-first", TaskProfileMode::PARENT_FIRST},
+  {"self-all", TaskProfileMode::SELF_ALL},
+  {"self-first", TaskProfileMode::SELF_FIRST}
+};
+
+// Mapping from commandline interaction profile compatibility mode string to compatibility mode.
+std::unordered_map<std::string, InteractionCompatibilityMode> sgp_interaction_compatibility_mode_map = {
+  {"always", InteractionCompatibilityMode::ALWAYS},
+  {"task-any-match", InteractionCompatibilityMode::TASK_ANY_MATCH},
+  {"task-perfect-match", InteractionCompatibilityMode::TASK_PERFECT_MATCH},
+  {"tag-probabilistic-match", InteractionCompatibilityMode::TAG_PROBABILISTIC_MATCH}
+};
+
 bool IsValidOrganismType(const std::string& type_str) {
   return emp::Has(sgp_org_type_map, type_str);
 }
@@ -81,6 +99,24 @@ NutrientSymbiontType GetNutrientSymType(const std::string& type_str) {
   return sgp_nutrient_sym_type_map[type_str];
 }
 
+bool IsValidTaskProfileMode(const std::string& mode_str) {
+  return emp::Has(sgp_task_profile_mode_map, mode_str);
+}
+
+TaskProfileMode GetTaskProfileMode(const std::string& mode_str) {
+  emp_assert(IsValidTaskProfileMode(mode_str));
+  return sgp_task_profile_mode_map[mode_str];
+}
+
+bool IsValidInteractionCompatibilityMode(const std::string& mode_str) {
+  return emp::Has(sgp_interaction_compatibility_mode_map, mode_str);
+}
+
+InteractionCompatibilityMode GetInteractionCompatibilityMode(const std::string& mode_str) {
+  emp_assert(IsValidInteractionCompatibilityMode(mode_str));
+  return sgp_interaction_compatibility_mode_map[mode_str];
+}
+
 }
 
 #endif
\ No newline at end of file
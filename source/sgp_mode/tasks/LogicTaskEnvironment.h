@@ -5,6 +5,7 @@
 
 #include "../../json/json.hpp"
 
+#include "emp/base/Ptr.hpp"
 #include "emp/base/vector.hpp"
 #include "emp/bits/Bits.hpp"
 #include "emp/tools/string_utils.hpp"
@@ -58,6 +59,7 @@ protected:
   std::unordered_map<size_t, size_t> host_tasks;  // Keys: Task IDs (in task_set) of host tasks; Values: associated index into host_task_reqs
   std::unordered_map<size_t, size_t> sym_tasks;   // Keys: Task IDs (in task set) of sym tasks; Values: associated index into sym_task_reqs
   io_bank_t io_bank;
+  emp::Ptr<const io_bank_t> shared_io_bank = nullptr; // If set, used in place of io_bank (unowned)
 
   emp::vector<TaskReqInfo> host_task_reqs;
   emp::vector<TaskReqInfo> sym_task_reqs;
@@ -135,6 +137,7 @@ public:
     host_task_reqs.clear();
     sym_task_reqs.clear();
     io_bank.Clear();
+    shared_io_bank = nullptr;
   }
 
   size_t GetTaskCount() const { return task_set.GetSize(); }
@@ -153,18 +156,49 @@ public:
     emp_assert(IsHostTask(task_id));
     return host_task_reqs[GetHostTaskReqID(task_id)];
   }
+  const TaskReqInfo& GetHostTaskReq(size_t task_id) const {
+    emp_assert(IsHostTask(task_id));
+    return host_task_reqs[GetHostTaskReqID(task_id)];
+  }
 
   TaskReqInfo& GetSymTaskReq(size_t task_id) {
     emp_assert(IsSymTask(task_id));
     return sym_task_reqs[GetSymTaskReqID(task_id)];
   }
+  const TaskReqInfo& GetSymTaskReq(size_t task_id) const {
+    emp_assert(IsSymTask(task_id));
+    return sym_task_reqs[GetSymTaskReqID(task_id)];
+  }
 
-  const io_bank_t& GetIOBank() const { return io_bank; }
+  const io_bank_t& GetIOBank() const {
+    return (shared_io_bank == nullptr) ? io_bank : *shared_io_bank;
+  }
   const LogicTaskSet& GetTaskSet() const { return task_set; }
 
-  void Setup(const std::string& env_filepath, size_t io_bank_size, bool io_unique_outputs) {
+  // With io_bank_seeded, the bank is generated on io_bank_threads threads from a
+  // bank seed drawn from the random number generator (see
+  // LogicTaskIOBank::GenerateSeededBank).
+  void Setup(
+    const std::string& env_filepath,
+    size_t io_bank_size,
+    bool io_unique_outputs,
+    bool io_bank_seeded=false,
+    size_t io_bank_threads=0
+  ) {
+    LoadTasks(env_filepath); // Will reset current bank, etc.
+    if (!io_bank_seeded) {
+      io_bank.GenerateBank(io_bank_size, io_unique_outputs);
+      return;
+    }
+    io_bank.GenerateSeededBank(io_bank_size, io_bank.DrawBankSeed(), io_bank_threads, io_unique_outputs);
+  }
+
+  // Load tasks, but use an IO bank that was already generated (by another
+  // environment set up from the same environment file) instead of generating
+  // a new one. The shared bank must outlive this environment.
+  void Setup(const std::string& env_filepath, const io_bank_t& shared_bank) {
     LoadTasks(env_filepath); // Will reset current bank, etc.
-    io_bank.GenerateBank(io_bank_size, io_unique_outputs);
+    shared_io_bank = &shared_bank;
   }
 
   // NOTE - can have a process output buffer function that triggers signals that world can attach functions to
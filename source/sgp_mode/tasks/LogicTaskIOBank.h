@@ -1,6 +1,7 @@
 #pragma once
 
 #include "LogicTaskSet.h"
+#include "../../utils.h"
 
 #include "emp/base/assert_warning.hpp"
 #include "emp/base/vector.hpp"
@@ -9,10 +10,15 @@
 #include "emp/datastructs/set_utils.hpp"
 #include "emp/base/Ptr.hpp"
 
-#include <unordered_set>
-#include <unordered_map>
-#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <limits>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
 
 // Each numeric "environment" has four input numbers.
 // We precompute all combinations of outputs (4x4 = 16 for two input tasks)
@@ -21,7 +27,11 @@
 namespace sgpmode::tasks {
 
 // Bank of L9 instances
-// TODO - save and load functionality
+// Banks can be generated serially from the bank's random number generator
+// (GenerateBank), or in parallel from a bank seed (GenerateSeededBank): each
+// chunk of GENERATE_CHUNK_SIZE environments is built from its own random number
+// stream, seeded by the bank seed and the chunk's index, so the bank doesn't
+// depend on how many threads build it.
 class LogicTaskIOBank {
 public:
   using this_t = LogicTaskIOBank;
@@ -33,6 +43,7 @@ public:
   static constexpr input_t MIN_LOGIC_TASK_INPUT = std::numeric_limits<input_t>::min();
   static constexpr input_t MAX_LOGIC_TASK_INPUT = std::numeric_limits<input_t>::max();
   static constexpr size_t MAX_ENV_BUILD_TRIES = 10000;
+  static constexpr size_t GENERATE_CHUNK_SIZE = 1024;
 
   // Used by TaskIO struct to associate a set of inputs with their associated output for a task
   struct IOSet {
@@ -49,11 +60,15 @@ public:
   };
 
   // Numeric environment (specifies input buffer for an organism + all correct outputs)
+  // Output -> task lookups use flat arrays (built once by BuildLookup) rather than
+  // per-environment hash tables: valid_outputs is sorted, and the tasks for
+  // valid_outputs[i] are output_task_ids[output_task_offsets[i]:output_task_offsets[i+1]].
   struct TaskIO {
     emp::vector<input_t> input_buffer;                  // Specifies the inputs for this environment instance.
-    std::unordered_set<output_t> valid_outputs;         // Set of valid output values for this environment.
+    emp::vector<output_t> valid_outputs;                // Sorted, distinct valid output values for this environment.
     emp::vector<emp::vector<IOSet>> correct_outputs; // Indexed by task id. For each task id, correct outputs associated with particular inputs.
-    std::unordered_map<output_t, emp::vector<size_t>> task_lookup; // Which output belongs to which task?
+    emp::vector<uint32_t> output_task_offsets;          // Which output belongs to which task? (offsets into output_task_ids)
+    emp::vector<size_t> output_task_ids;
     bool is_collision=false;
     bool output_is_zero=false;
 
@@ -62,17 +77,56 @@ public:
       input_buffer.clear();
       valid_outputs.clear();
       correct_outputs.clear();
-      task_lookup.clear();
+      output_task_offsets.clear();
+      output_task_ids.clear();
       is_collision=false;
       output_is_zero=false;
     }
 
     bool operator==(const TaskIO& other) const {
       return std::tie(
-        input_buffer, valid_outputs, correct_outputs, task_lookup
+        input_buffer, valid_outputs, correct_outputs, output_task_offsets, output_task_ids
       ) == std::tie(
-        other.input_buffer, other.valid_outputs, other.correct_outputs, other.task_lookup
+        other.input_buffer, other.valid_outputs, other.correct_outputs, other.output_task_offsets, other.output_task_ids
+      );
+    }
+
+    // Is output a correct output for any task? (Linear scan over correct outputs;
+    // only used while building, before BuildLookup.)
+    bool HasCorrectOutput(output_t output) const {
+      for (const auto& task_outputs : correct_outputs) {
+        for (const IOSet& io_set : task_outputs) {
+          if (io_set.output == output) return true;
+        }
+      }
+      return false;
+    }
+
+    // Build the output -> task lookup from correct_outputs. Tasks for each output
+    // are listed in the order they were added (by task id).
+    void BuildLookup() {
+      emp::vector<std::pair<output_t, size_t>> output_tasks;
+      for (size_t task_id = 0; task_id < correct_outputs.size(); ++task_id) {
+        for (const IOSet& io_set : correct_outputs[task_id]) {
+          output_tasks.emplace_back(io_set.output, task_id);
+        }
+      }
+      std::stable_sort(
+        output_tasks.begin(),
+        output_tasks.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; }
       );
+      valid_outputs.clear();
+      output_task_offsets.clear();
+      output_task_ids.clear();
+      for (const auto& [output, task_id] : output_tasks) {
+        if (valid_outputs.empty() || valid_outputs.back() != output) {
+          valid_outputs.emplace_back(output);
+          output_task_offsets.emplace_back(output_task_ids.size());
+        }
+        output_task_ids.emplace_back(task_id);
+      }
+      output_task_offsets.emplace_back(output_task_ids.size());
     }
 
     bool IsValidOutput(float output) const {
@@ -81,12 +135,23 @@ public:
     }
 
     bool IsValidOutput(output_t output) const {
-      return emp::Has(valid_outputs, output);
+      return std::binary_search(valid_outputs.begin(), valid_outputs.end(), output);
+    }
+
+    // Get the ids of all tasks that output is correct for (empty if output is not valid).
+    std::span<const size_t> FindTaskIDs(output_t output) const {
+      auto it = std::lower_bound(valid_outputs.begin(), valid_outputs.end(), output);
+      if (it == valid_outputs.end() || *it != output) return {};
+      const size_t output_idx = (size_t)(it - valid_outputs.begin());
+      return std::span<const size_t>(
+        output_task_ids.data() + output_task_offsets[output_idx],
+        output_task_offsets[output_idx + 1] - output_task_offsets[output_idx]
+      );
     }
 
-    const emp::vector<size_t>& GetTaskIDs(output_t output) const {
+    std::span<const size_t> GetTaskIDs(output_t output) const {
       emp_assert(IsValidOutput(output));
-      return task_lookup.at(output);
+      return FindTaskIDs(output);
     }
 
     // Get number of distinct possible outputs stored for this task
@@ -109,8 +174,8 @@ protected:
   void SetTaskOutput(
     TaskIO& task_io,
     size_t task_id,
-    const IOSet& io_set
-  ) {
+    IOSet io_set
+  ) const {
     if (task_id >= task_io.correct_outputs.size()) {
       task_io.correct_outputs.resize(task_id+1, {});
     }
@@ -118,20 +183,53 @@ protected:
     if (output_val == 0) {
       task_io.output_is_zero = true;
     }
-    task_io.correct_outputs[task_id].emplace_back(io_set);  // Add this input-output pairing for this task
-    task_io.is_collision = emp::Has(task_io.valid_outputs, output_val); // Mark if io contains an output collision.
-    task_io.valid_outputs.emplace(output_val);                          // Add output value to valid outputs set.
-    // Add output value to task lookup (regardless of whether or not we've seen this output value before or it's zero)
-    if (emp::Has(task_io.task_lookup, output_val)) {
-      task_io.task_lookup[output_val].emplace_back(task_id);
-    } else {
-      task_io.task_lookup.emplace(
-        std::make_pair(output_val, emp::vector<size_t>({task_id}))
-      );
+    task_io.is_collision = task_io.HasCorrectOutput(output_val); // Mark if io contains an output collision.
+    task_io.correct_outputs[task_id].emplace_back(std::move(io_set));  // Add this input-output pairing for this task
+    // Output value is added to the task lookup (regardless of whether or not we've
+    // seen this output value before or it's zero) by BuildLookup.
+  }
+
+  // Calculate every task's outputs for task_io's input buffer. With
+  // unique_outputs, bails (returning false) as soon as a task's outputs collide
+  // with earlier outputs or are zero, leaving later tasks' outputs empty.
+  bool CalcTaskOutputs(TaskIO& task_io, bool unique_outputs) const {
+    // Prepare correct outputs to hold IO combinations for each task.
+    task_io.correct_outputs.resize(task_set.GetSize(), {});
+    const auto& input_buffer = task_io.input_buffer;
+    // For each task, generate output values for input pairings
+    for (size_t task_id = 0; task_id < task_set.GetSize(); ++task_id) {
+      const auto& task_def = task_set.GetTaskDef(task_id);
+      task_io.correct_outputs[task_id].reserve(input_buffer.size());
+      for (size_t input_idx = 0; input_idx < input_buffer.size(); ++input_idx) {
+        // Call task function with rotated inputs
+        // I.e., Add input pairings for all sequential inputs (not all combinations)
+        emp::vector<input_t> buffer(input_buffer.size());
+        for (size_t i = 0; i < buffer.size(); ++i) {
+          buffer[i] = input_buffer[(i + input_idx) % buffer.size()];
+        }
+        const output_t task_output = task_def.CalcOutput(buffer);
+        IOSet io_set;
+        io_set.inputs = std::move(buffer);
+        io_set.output = task_output;
+        SetTaskOutput(task_io, task_id, std::move(io_set));
+      }
+      // Any collisions?
+      if (unique_outputs && (task_io.is_collision || task_io.output_is_zero)) return false;
     }
+    return true;
   }
 
-  TaskIO BuildTaskIO(bool unique_outputs, size_t num_inputs_per_task = 4) {
+  // NOTE - Serial banks (GenerateBank) keep their original retry behavior, so that
+  //        existing seeds give the same banks: once an attempt bails, later
+  //        attempts don't calculate outputs, so the environment uses up
+  //        MAX_ENV_BUILD_TRIES and is left without correct outputs. Seeded banks
+  //        (recalc_on_retry) calculate outputs on every attempt.
+  TaskIO BuildTaskIO(
+    emp::Random& rnd,
+    bool unique_outputs,
+    size_t num_inputs_per_task = 4,
+    bool recalc_on_retry = false
+  ) const {
     TaskIO task_io;
     task_io.is_collision=false;
     task_io.output_is_zero=false;
@@ -141,40 +239,60 @@ protected:
     do {
       // Reset task io
       task_io.Clear();
-      // Prepare correct outputs to hold IO combinations for each task.
-      task_io.correct_outputs.resize(task_set.GetSize(), {});
       // Build input buffer with random values.
       auto& input_buffer = task_io.input_buffer;
       input_buffer.resize(num_inputs_per_task);
       for (size_t i = 0; i < num_inputs_per_task; ++i) {
-        const input_t rand_in = (input_t)random.GetUInt(
+        const input_t rand_in = (input_t)rnd.GetUInt(
           this_t::MIN_LOGIC_TASK_INPUT,
           this_t::MAX_LOGIC_TASK_INPUT
         );
         input_buffer[i] = rand_in;
       }
-      // For each task, generate output values for input pairings
-      for (size_t task_id = 0; (task_id < task_set.GetSize()) && !collision_or_zero_bail; ++task_id) {
-        const auto& task_def = task_set.GetTaskDef(task_id);
-        for (size_t input_idx = 0; input_idx < input_buffer.size(); ++input_idx) {
-          // Call task function with rotated inputs
-          // I.e., Add input pairings for all sequential inputs (not all combinations)
-          emp::vector<input_t> buffer(input_buffer.size());
-          for (size_t i = 0; i < buffer.size(); ++i) {
-            buffer[i] = input_buffer[(i + input_idx) % buffer.size()];
-          }
-          const output_t task_output = task_def.CalcOutput(buffer);
-          SetTaskOutput(task_io, task_id, IOSet{buffer, task_output});
-        }
-        // Any collisions?
-        collision_or_zero_bail = unique_outputs && (task_io.is_collision || task_io.output_is_zero);
+      if (recalc_on_retry || !collision_or_zero_bail) {
+        collision_or_zero_bail = !CalcTaskOutputs(task_io, unique_outputs);
+      } else {
+        task_io.correct_outputs.resize(task_set.GetSize(), {});
       }
       ++build_tries;
     } while (collision_or_zero_bail && (build_tries < this_t::MAX_ENV_BUILD_TRIES));
     emp_assert_warning(build_tries <= this_t::MAX_ENV_BUILD_TRIES, "Failed to build environment with unique, non-zero outputs for each task.");
+    task_io.BuildLookup();
     return task_io;
   }
 
+  // Run fun(chunk_id, begin, end) over each chunk of GENERATE_CHUNK_SIZE
+  // environments in [0, count), on num_threads threads (0: all hardware threads).
+  static void ForEachChunk(
+    size_t count,
+    size_t num_threads,
+    const std::function<void(size_t, size_t, size_t)>& fun
+  ) {
+    const size_t num_chunks = (count + GENERATE_CHUNK_SIZE - 1) / GENERATE_CHUNK_SIZE;
+    if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    num_threads = std::max<size_t>(1, std::min(num_threads, num_chunks));
+    std::atomic<size_t> next_chunk = 0;
+    auto worker = [&]() {
+      for (size_t chunk_id = next_chunk++; chunk_id < num_chunks; chunk_id = next_chunk++) {
+        const size_t begin = chunk_id * GENERATE_CHUNK_SIZE;
+        fun(chunk_id, begin, std::min(count, begin + GENERATE_CHUNK_SIZE));
+      }
+    };
+    if (num_threads == 1) {
+      worker();
+      return;
+    }
+    emp::vector<std::thread> workers;
+    for (size_t i = 0; i < num_threads; ++i) workers.emplace_back(worker);
+    for (std::thread& t : workers) t.join();
+  }
+
+  // Seed (always positive, as emp::Random requires) for one chunk's random number stream
+  static int GetChunkSeed(uint64_t bank_seed, size_t chunk_id) {
+    const uint64_t h = utils::SplitMix64(bank_seed + 0x9e3779b97f4a7c15 * (chunk_id + 1));
+    return (int)(h % (uint64_t)std::numeric_limits<int>::max()) + 1;
+  }
+
 public:
 
   LogicTaskIOBank(
@@ -196,10 +314,34 @@ public:
     Clear();
     io_bank.resize(count);
     for (size_t n = 0; n < count; ++n) {
-      io_bank[n] = BuildTaskIO(unique_outputs, input_buffer_size);
+      io_bank[n] = BuildTaskIO(random, unique_outputs, input_buffer_size);
     }
   }
 
+  // Draw a bank seed for GenerateSeededBank from this bank's random number generator.
+  uint64_t DrawBankSeed() { return random.GetUInt64(); }
+
+  // Generate count task io instances like GenerateBank, but on num_threads
+  // threads (0: all hardware threads), from random number streams seeded by
+  // bank_seed. The same bank seed always generates the same bank.
+  // WARNING - calling this function will delete any existing task ios in this bank, invalidating references to them.
+  void GenerateSeededBank(
+    size_t count,
+    uint64_t bank_seed,
+    size_t num_threads,
+    bool unique_outputs=true,
+    size_t input_buffer_size=4
+  ) {
+    Clear();
+    io_bank.resize(count);
+    ForEachChunk(count, num_threads, [&](size_t chunk_id, size_t begin, size_t end) {
+      emp::Random chunk_random(GetChunkSeed(bank_seed, chunk_id));
+      for (size_t n = begin; n < end; ++n) {
+        io_bank[n] = BuildTaskIO(chunk_random, unique_outputs, input_buffer_size, true);
+      }
+    });
+  }
+
   void Clear() {
     io_bank.clear();
   }
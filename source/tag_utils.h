@@ -0,0 +1,417 @@
+#pragma once
+
+#include "emp/base/array.hpp"
+#include "emp/base/assert.hpp"
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/bits/BitSet.hpp"
+#include "emp/matching/matchbin_metrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <typeinfo>
+
+// tag_utils contains a devirtualized engine for computing distances between
+// fixed-width tags (see TAG_MATCHING and TAG_METRIC), and a streaming writer
+// for tag distance matrices (see WRITE_TAG_MATRIX).
+namespace tag_utils {
+
+/**
+ * A set of tags stored alongside a packed (64-bit word) copy of each tag, so
+ * that one tag can be scored against all of them in a single tight loop.
+ */
+template<size_t WIDTH>
+class TagBatch {
+public:
+  using tag_t = emp::BitSet<WIDTH>;
+  static constexpr size_t NUM_WORDS = (WIDTH + 63) / 64;
+  using packed_tag_t = emp::array<uint64_t, NUM_WORDS>;
+
+  /**
+   * Input: A tag.
+   *
+   * Output: The tag's bits as 64-bit words.
+   *
+   * Purpose: To lay a tag out so that Hamming distances are plain popcounts.
+   */
+  static packed_tag_t Pack(const tag_t& tag) {
+    packed_tag_t packed;
+    for (size_t i = 0; i < NUM_WORDS; ++i) packed[i] = tag.GetUInt64(i);
+    return packed;
+  }
+
+protected:
+  emp::vector<tag_t> tags;
+  emp::vector<packed_tag_t> packed;
+
+public:
+  void Add(const tag_t& tag) {
+    tags.push_back(tag);
+    packed.push_back(Pack(tag));
+  }
+
+  void Clear() {
+    tags.clear();
+    packed.clear();
+  }
+
+  void Reserve(size_t count) {
+    tags.reserve(count);
+    packed.reserve(count);
+  }
+
+  size_t size() const { return tags.size(); }
+  bool empty() const { return tags.empty(); }
+  const tag_t& GetTag(size_t i) const { return tags[i]; }
+  const packed_tag_t& GetPacked(size_t i) const { return packed[i]; }
+  const emp::vector<packed_tag_t>& GetPacked() const { return packed; }
+};
+
+/**
+ * Input: A packed tag and a batch of packed tags.
+ *
+ * Output: None (number of mismatching bits to each tag in the batch is written
+ * to counts)
+ *
+ * Purpose: To compute many Hamming distances at once. The word count is known
+ * at compile time, so the loop is unrolled and vectorized wherever the target
+ * supports it (e.g., popcnt/AVX2); otherwise it falls back to scalar popcounts.
+ */
+template<size_t NUM_WORDS>
+void HammingCounts(
+  const emp::array<uint64_t, NUM_WORDS>& query,
+  const emp::vector<emp::array<uint64_t, NUM_WORDS>>& batch,
+  emp::vector<size_t>& counts
+) {
+  counts.resize(batch.size());
+  for (size_t i = 0; i < batch.size(); ++i) {
+    size_t count = 0;
+    for (size_t w = 0; w < NUM_WORDS; ++w) {
+      count += std::popcount(query[w] ^ batch[i][w]);
+    }
+    counts[i] = count;
+  }
+}
+
+/**
+ * Computes distances between tags with the world's tag metric, without going
+ * through emp::BaseMetric's virtual calls for the built-in metrics: Hamming
+ * distances are popcounts over packed words, and streak/hash distances call the
+ * metric's implementation directly. Any other metric (e.g., a uniformified one,
+ * see NORMALIZE_TAG_DISTANCES) is called through its virtual interface.
+ *
+ * Only reads the metric, so it can be shared between threads.
+ */
+template<size_t WIDTH>
+class TagDistanceEngine {
+public:
+  using tag_t = emp::BitSet<WIDTH>;
+  using metric_t = emp::BaseMetric<tag_t, tag_t>;
+  using batch_t = TagBatch<WIDTH>;
+  using hamming_metric_t = emp::HammingMetric<WIDTH>;
+  using streak_metric_t = emp::StreakMetric<WIDTH>;
+  using hash_metric_t = emp::HashMetric<WIDTH>;
+
+  enum class KERNEL { NONE, HAMMING, STREAK, HASH, VIRTUAL };
+
+protected:
+  emp::Ptr<const metric_t> metric = nullptr;
+  KERNEL kernel = KERNEL::NONE;
+
+public:
+  TagDistanceEngine() = default;
+  TagDistanceEngine(emp::Ptr<const metric_t> metric) { SetMetric(metric); }
+
+  /**
+   * Input: The metric to compute distances with (not owned; may be nullptr).
+   *
+   * Output: None
+   *
+   * Purpose: To pick the kernel for a metric. Only exact metric types get a
+   * specialized kernel, so subclasses keep their own behavior.
+   */
+  void SetMetric(emp::Ptr<const metric_t> new_metric) {
+    metric = new_metric;
+    if (metric == nullptr) kernel = KERNEL::NONE;
+    else if (typeid(*metric) == typeid(hamming_metric_t)) kernel = KERNEL::HAMMING;
+    else if (typeid(*metric) == typeid(streak_metric_t)) kernel = KERNEL::STREAK;
+    else if (typeid(*metric) == typeid(hash_metric_t)) kernel = KERNEL::HASH;
+    else kernel = KERNEL::VIRTUAL;
+  }
+
+  emp::Ptr<const metric_t> GetMetric() const { return metric; }
+  KERNEL GetKernel() const { return kernel; }
+
+  /**
+   * Input: Two tags.
+   *
+   * Output: The metric's distance from tag a to tag b (in [0, 1]).
+   *
+   * Purpose: To compute a single tag distance.
+   */
+  double Distance(const tag_t& a, const tag_t& b) const {
+    emp_assert(metric != nullptr, "No tag metric set");
+    switch (kernel) {
+      case KERNEL::HAMMING:
+        return (double)(a ^ b).CountOnes() / WIDTH;
+      case KERNEL::STREAK:
+        return static_cast<const streak_metric_t&>(*metric).streak_metric_t::calculate(a, b);
+      case KERNEL::HASH:
+        return static_cast<const hash_metric_t&>(*metric).hash_metric_t::calculate(a, b);
+      default:
+        return (*metric)(a, b);
+    }
+  }
+
+  /**
+   * Input: A tag, a batch of tags, and a vector to store distances in.
+   *
+   * Output: None (distance from tag a to each tag in the batch is written to
+   * distances)
+   *
+   * Purpose: To score one tag against many, e.g. a host against every sampled
+   * symbiont.
+   */
+  void DistancesFrom(const tag_t& a, const batch_t& batch, emp::vector<double>& distances) const {
+    if (kernel == KERNEL::HAMMING) {
+      HammingToDistances(a, batch, distances);
+      return;
+    }
+    distances.resize(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) distances[i] = Distance(a, batch.GetTag(i));
+  }
+
+  /**
+   * Input: A batch of tags, a tag, and a vector to store distances in.
+   *
+   * Output: None (distance from each tag in the batch to tag b is written to
+   * distances)
+   *
+   * Purpose: To score many tags against one, e.g. candidate hosts against a
+   * symbiont. (Metrics need not be symmetric, so argument order matters.)
+   */
+  void DistancesTo(const batch_t& batch, const tag_t& b, emp::vector<double>& distances) const {
+    if (kernel == KERNEL::HAMMING) {
+      HammingToDistances(b, batch, distances);
+      return;
+    }
+    distances.resize(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) distances[i] = Distance(batch.GetTag(i), b);
+  }
+
+protected:
+  void HammingToDistances(const tag_t& tag, const batch_t& batch, emp::vector<double>& distances) const {
+    thread_local emp::vector<size_t> counts;
+    HammingCounts(batch_t::Pack(tag), batch.GetPacked(), counts);
+    distances.resize(counts.size());
+    for (size_t i = 0; i < counts.size(); ++i) distances[i] = (double)counts[i] / WIDTH;
+  }
+};
+
+/**
+ * Tag matrix file formats (see TAG_MATRIX_FORMAT).
+ * - CSV: the header row lists each column's id, then every row starts with its
+ *   id followed by its distances (every value is followed by a comma).
+ * - BINARY: a header (magic number, format version, number of rows, number of
+ *   columns), the row ids and column ids as uint64s, then every distance as a
+ *   float32, row by row. Values are stored in native byte order.
+ */
+enum class TagMatrixFormat { CSV, BINARY };
+
+constexpr uint64_t TAG_MATRIX_MAGIC = 0x58544d47415453; // "STAGMTX"
+constexpr uint32_t TAG_MATRIX_FORMAT_VERSION = 1;
+
+/**
+ * Input: The output stream, the engine to compute distances with, the row tags
+ * and their ids, the column tags and their ids, the file format, the number of
+ * threads to use (0 for one per hardware thread), and the number of rows per
+ * block.
+ *
+ * Output: Boolean indicating whether the whole matrix was written.
+ *
+ * Purpose: To write the distance from every row tag to every column tag
+ * without holding the matrix in memory. Worker threads take the next block of
+ * rows from a shared counter and compute and format it, while the calling
+ * thread writes finished blocks in order, so the output doesn't depend on the
+ * number of threads. At most two blocks per thread are held waiting to be
+ * written.
+ */
+template<size_t WIDTH>
+bool WriteTagMatrix(
+  std::ostream& out,
+  const TagDistanceEngine<WIDTH>& engine,
+  const TagBatch<WIDTH>& rows,
+  const emp::vector<size_t>& row_ids,
+  const TagBatch<WIDTH>& cols,
+  const emp::vector<size_t>& col_ids,
+  TagMatrixFormat format,
+  size_t num_threads=1,
+  size_t block_rows=32
+) {
+  emp_assert(rows.size() == row_ids.size());
+  emp_assert(cols.size() == col_ids.size());
+  emp_assert(block_rows > 0);
+  auto write_value = [&out](auto value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  if (format == TagMatrixFormat::BINARY) {
+    write_value(TAG_MATRIX_MAGIC);
+    write_value(TAG_MATRIX_FORMAT_VERSION);
+    write_value((uint64_t)rows.size());
+    write_value((uint64_t)cols.size());
+    for (size_t id : row_ids) write_value((uint64_t)id);
+    for (size_t id : col_ids) write_value((uint64_t)id);
+  } else {
+    out << ',';
+    for (size_t id : col_ids) out << id << ',';
+    out << '\n';
+  }
+
+  const size_t num_blocks = (rows.size() + block_rows - 1) / block_rows;
+  if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+  num_threads = std::max<size_t>(1, std::min(num_threads, num_blocks));
+
+  // Computes and formats rows [block_id * block_rows, ...) into bytes.
+  auto build_block = [&](size_t block_id, std::string& bytes) {
+    bytes.clear();
+    emp::vector<double> distances;
+    std::ostringstream csv;
+    const size_t row_end = std::min(rows.size(), (block_id + 1) * block_rows);
+    for (size_t row = block_id * block_rows; row < row_end; ++row) {
+      engine.DistancesFrom(rows.GetTag(row), cols, distances);
+      if (format == TagMatrixFormat::BINARY) {
+        const size_t start = bytes.size();
+        bytes.resize(start + distances.size() * sizeof(float));
+        for (size_t col = 0; col < distances.size(); ++col) {
+          const float distance = (float)distances[col];
+          std::memcpy(bytes.data() + start + col * sizeof(float), &distance, sizeof(float));
+        }
+      } else {
+        csv << row_ids[row] << ',';
+        for (double distance : distances) csv << distance << ',';
+        csv << '\n';
+      }
+    }
+    if (format == TagMatrixFormat::CSV) bytes = csv.str();
+  };
+
+  std::string bytes;
+  if (num_threads == 1) {
+    for (size_t block_id = 0; block_id < num_blocks && out; ++block_id) {
+      build_block(block_id, bytes);
+      out.write(bytes.data(), bytes.size());
+    }
+    return (bool)out;
+  }
+
+  // Block b is handed over in slot b % num_slots, which is free once block
+  // b - num_slots has been written.
+  const size_t num_slots = 2 * num_threads;
+  emp::vector<std::string> slot_bytes(num_slots);
+  emp::vector<size_t> slot_block(num_slots, num_blocks); // Block in each slot (num_blocks if none yet)
+  std::mutex slot_lock;
+  std::condition_variable slots_changed;
+  size_t num_written = 0;
+  bool stop = false; // Set if writing fails
+  std::atomic<size_t> next_block = 0;
+
+  auto worker = [&]() {
+    std::string built;
+    for (size_t block_id = next_block++; block_id < num_blocks; block_id = next_block++) {
+      build_block(block_id, built);
+      std::unique_lock<std::mutex> lock(slot_lock);
+      slots_changed.wait(lock, [&]() { return stop || block_id < num_written + num_slots; });
+      if (stop) return;
+      std::swap(slot_bytes[block_id % num_slots], built);
+      slot_block[block_id % num_slots] = block_id;
+      slots_changed.notify_all();
+    }
+  };
+  emp::vector<std::thread> workers;
+  for (size_t i = 0; i < num_threads; ++i) workers.emplace_back(worker);
+
+  for (size_t block_id = 0; block_id < num_blocks; ++block_id) {
+    {
+      std::unique_lock<std::mutex> lock(slot_lock);
+      slots_changed.wait(lock, [&]() { return slot_block[block_id % num_slots] == block_id; });
+      std::swap(bytes, slot_bytes[block_id % num_slots]);
+    }
+    out.write(bytes.data(), bytes.size());
+    std::lock_guard<std::mutex> lock(slot_lock);
+    if (!out) stop = true;
+    else num_written = block_id + 1;
+    slots_changed.notify_all();
+    if (stop) break;
+  }
+  for (std::thread& t : workers) t.join();
+  return (bool)out;
+}
+
+/**
+ * A tag matrix read back from a binary tag matrix file.
+ */
+struct TagMatrix {
+  emp::vector<uint64_t> row_ids;
+  emp::vector<uint64_t> col_ids;
+  emp::vector<float> distances; // Row-major
+
+  float Get(size_t row, size_t col) const { return distances[row * col_ids.size() + col]; }
+};
+
+/**
+ * Input: The input stream and the matrix to read into.
+ *
+ * Output: Boolean indicating whether a complete binary tag matrix was read.
+ *
+ * Purpose: To load a matrix written by WriteTagMatrix with
+ * TagMatrixFormat::BINARY (e.g., for analyses or tests). The stream must be
+ * seekable, so that the header's sizes can be checked against the stream's
+ * length before any memory is allocated for them.
+ */
+inline bool ReadTagMatrix(std::istream& in, TagMatrix& matrix) {
+  auto read_value = [&in](auto& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return (bool)in;
+  };
+  uint64_t magic = 0;
+  uint32_t version = 0;
+  uint64_t num_rows = 0;
+  uint64_t num_cols = 0;
+  if (!read_value(magic) || magic != TAG_MATRIX_MAGIC) return false;
+  if (!read_value(version) || version != TAG_MATRIX_FORMAT_VERSION) return false;
+  if (!read_value(num_rows) || !read_value(num_cols)) return false;
+
+  const std::streampos start = in.tellg();
+  in.seekg(0, std::ios::end);
+  const std::streampos end = in.tellg();
+  in.seekg(start);
+  if (!in || start < 0 || end < start) return false;
+  const uint64_t remaining = uint64_t(end - start);
+  const uint64_t max_ids = remaining / sizeof(uint64_t);
+  if (num_rows > max_ids || num_cols > max_ids - num_rows) return false;
+  const uint64_t distance_bytes = remaining - (num_rows + num_cols) * sizeof(uint64_t);
+  if (num_cols > 0 && num_rows > distance_bytes / sizeof(float) / num_cols) return false;
+
+  matrix.row_ids.resize(num_rows);
+  matrix.col_ids.resize(num_cols);
+  matrix.distances.resize(num_rows * num_cols);
+  in.read(reinterpret_cast<char*>(matrix.row_ids.data()), num_rows * sizeof(uint64_t));
+  in.read(reinterpret_cast<char*>(matrix.col_ids.data()), num_cols * sizeof(uint64_t));
+  in.read(reinterpret_cast<char*>(matrix.distances.data()), num_rows * num_cols * sizeof(float));
+  return (bool)in;
+}
+
+}
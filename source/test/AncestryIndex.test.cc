@@ -0,0 +1,79 @@
+#include "../catch/catch.hpp"
+
+#include "test_utils.h"
+#include "../AncestryIndex.h"
+#include "../default_mode/SymWorld.h"
+#include "../default_mode/Host.h"
+#include "../default_mode/Symbiont.h"
+#include "../default_mode/WorldSetup.cc"
+
+namespace {
+  // Ancestry found by walking parents, for checking the index
+  bool IsAncestorByWalk(emp::Ptr<taxon_t::host_taxon_t> ancestor, emp::Ptr<taxon_t::host_taxon_t> descendant) {
+    for (emp::Ptr<taxon_t::host_taxon_t> cur = descendant; cur != nullptr; cur = cur->GetParent()) {
+      if (cur == ancestor) return true;
+    }
+    return false;
+  }
+}
+
+TEST_CASE("AncestryIndex finds ancestors in a deep branching phylogeny", "[default]") {
+  emp::Random random(24);
+  emp::vector<emp::Ptr<taxon_t::host_taxon_t>> taxa;
+  for (size_t id = 0; id < 3000; id++) {
+    emp::Ptr<taxon_t::host_taxon_t> parent = nullptr;
+    // Mostly long chains, with some branches off earlier taxa and a second root
+    if (id != 0 && id != 1500) parent = random.P(0.9) ? taxa.back() : taxa[random.GetUInt(taxa.size())];
+    taxa.push_back(emp::NewPtr<taxon_t::host_taxon_t>(id, 0, parent));
+    ancestry::Link(taxa.back());
+  }
+
+  THEN("Depths count the generations back to a root") {
+    REQUIRE(ancestry::GetDepth(taxa[0]) == 0);
+    REQUIRE(ancestry::GetDepth(taxa[1]) == 1);
+    REQUIRE(ancestry::GetDepth(taxa[1500]) == 0);
+    REQUIRE(ancestry::GetAncestorAtDepth(taxa[2999], 0) == taxa[1500]);
+  }
+
+  THEN("Ancestry matches walking up the parents") {
+    for (size_t i = 0; i < 20000; i++) {
+      emp::Ptr<taxon_t::host_taxon_t> descendant = taxa[random.GetUInt(taxa.size())];
+      emp::Ptr<taxon_t::host_taxon_t> ancestor = taxa[random.GetUInt(taxa.size())];
+      if (i % 2) { // An actual ancestor, some generations back
+        ancestor = descendant;
+        for (size_t steps = random.GetUInt(500); steps > 0 && ancestor->GetParent(); steps--) ancestor = ancestor->GetParent();
+      }
+      REQUIRE(ancestry::IsAncestor(ancestor, descendant) == IsAncestorByWalk(ancestor, descendant));
+    }
+    REQUIRE(ancestry::IsAncestor(taxa[10], taxa[10]));
+  }
+
+  for (emp::Ptr<taxon_t::host_taxon_t> taxon : taxa) taxon.Delete();
+}
+
+TEST_CASE("The host systematic indexes host ancestry", "[default]") {
+  emp::Random random(25);
+  SymConfigBase config;
+  test_utils::SetWellMixed(config, 20, 20);
+  config.START_MOI(1);
+  config.PHYLOGENY(1);
+  config.PHYLOGENY_TAXON_TYPE("individual");
+  config.STORE_EXTINCT(1);
+  SymWorld world(random, &config);
+  world.Setup();
+  for (size_t i = 0; i < 60; i++) world.Update();
+
+  emp::vector<emp::Ptr<taxon_t::host_taxon_t>> taxa;
+  for (emp::Ptr<taxon_t::host_taxon_t> taxon : world.GetHostSys()->GetActive()) taxa.push_back(taxon);
+  for (emp::Ptr<taxon_t::host_taxon_t> taxon : world.GetHostSys()->GetAncestors()) taxa.push_back(taxon);
+  REQUIRE(taxa.size() > 1);
+
+  THEN("IsHostAncestor matches walking up the parents") {
+    for (size_t i = 0; i < 5000; i++) {
+      emp::Ptr<taxon_t::host_taxon_t> ancestor = taxa[random.GetUInt(taxa.size())];
+      emp::Ptr<taxon_t::host_taxon_t> descendant = taxa[random.GetUInt(taxa.size())];
+      REQUIRE(world.IsHostAncestor(ancestor, descendant) == IsAncestorByWalk(ancestor, descendant));
+      if (descendant->GetParent()) REQUIRE(world.IsHostAncestor(descendant->GetParent(), descendant));
+    }
+  }
+}
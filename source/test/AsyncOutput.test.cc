@@ -0,0 +1,144 @@
+#include "../catch/catch.hpp"
+
+#include "test_utils.h"
+#include "../AsyncOutput.h"
+#include "../default_mode/SymWorld.h"
+#include "../default_mode/WorldSetup.cc"
+#include "../default_mode/DataNodes.h"
+
+#include <cstdio>
+#include <filesystem>
+
+TEST_CASE("WriteQueue writes queued output in order", "[default]") {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::string csv_path = (dir / "AsyncOutput_test.data").string();
+  const std::string queued_path = (dir / "AsyncOutput_test_queued.data").string();
+  const std::string snapshot_path = (dir / "AsyncOutput_test_snapshot.data").string();
+  const std::string atomic_path = (dir / "AsyncOutput_test_atomic.data").string();
+
+  // A tiny queue, so nearly every write waits for the writer thread
+  std::shared_ptr<async_output::WriteQueue> queue = std::make_shared<async_output::WriteQueue>(32);
+  int update = 0;
+  double value = 0;
+  {
+    emp::DataFile csv_file(csv_path);
+    async_output::QueuedDataFile<> queued_file(queue, queued_path);
+    for (emp::DataFile* file : {&csv_file, static_cast<emp::DataFile*>(&queued_file)}) {
+      file->AddVar(update, "update", "Update");
+      file->AddVar(value, "value", "Value");
+      file->PrintHeaderKeys();
+    }
+    for (update = 0; update < 200; update++) {
+      value = update * 0.25;
+      csv_file.Update();
+      queued_file.Update();
+      queue->WriteFile(snapshot_path, "snapshot " + std::to_string(update));
+      queue->WriteFileAtomic(atomic_path, "atomic " + std::to_string(update));
+    }
+
+    THEN("Flushing writes out every queued row, while the file is still open") {
+      REQUIRE(queue->Flush());
+      REQUIRE(test_utils::ReadFile(queued_path) == test_utils::ReadFile(csv_path));
+    }
+  }
+
+  THEN("Whole-file writes land in the order they were queued") {
+    REQUIRE(queue->Flush());
+    REQUIRE(test_utils::ReadFile(snapshot_path) == "snapshot 199");
+    REQUIRE(test_utils::ReadFile(atomic_path) == "atomic 199");
+    REQUIRE(!std::filesystem::exists(atomic_path + ".tmp"));
+  }
+  std::remove(csv_path.c_str());
+  std::remove(queued_path.c_str());
+  std::remove(snapshot_path.c_str());
+  std::remove(atomic_path.c_str());
+}
+
+TEST_CASE("SymWorld output is the same with ASYNC_OUTPUT", "[default]") {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  auto run_world = [&](bool async_output, const std::string& suffix) {
+    SymConfigBase config;
+    test_utils::SetWellMixed(config, 40, 30);
+    config.START_MOI(1);
+    config.SYM_LIMIT(2);
+    config.ASYNC_OUTPUT(async_output);
+    config.ASYNC_OUTPUT_QUEUE_MB(1);
+    config.PHYLOGENY(1);
+    emp::Random random(32);
+    SymWorld world(random, &config);
+    world.Setup();
+    world.SetupSymIntValFile((dir / ("AsyncOutput_test_SymVals" + suffix)).string());
+    for (size_t i = 0; i < 20; i++) world.Update();
+    world.WriteOrgDumpFile((dir / ("AsyncOutput_test_OrgDump" + suffix)).string());
+    // Phylogeny snapshot names are prefixed, so they are written to the working directory
+    world.WritePhylogenyFile("AsyncOutput_test_Phylogeny" + suffix);
+    REQUIRE(world.FlushOutput());
+  };
+  run_world(false, ".data");
+  run_world(true, "_async.data");
+
+  THEN("Data files, dumps and phylogeny snapshots are identical to synchronously written ones") {
+    const std::vector<std::pair<std::string, std::string>> paths = {
+      {(dir / "AsyncOutput_test_SymVals.data").string(), (dir / "AsyncOutput_test_SymVals_async.data").string()},
+      {(dir / "AsyncOutput_test_OrgDump.data").string(), (dir / "AsyncOutput_test_OrgDump_async.data").string()},
+      {"SymSnapshot_AsyncOutput_test_Phylogeny.data", "SymSnapshot_AsyncOutput_test_Phylogeny_async.data"},
+      {"HostSnapshot_AsyncOutput_test_Phylogeny.data", "HostSnapshot_AsyncOutput_test_Phylogeny_async.data"}
+    };
+    for (const auto& [path, async_path] : paths) {
+      REQUIRE(!test_utils::ReadFile(path).empty());
+      REQUIRE(test_utils::ReadFile(async_path) == test_utils::ReadFile(path));
+      std::remove(path.c_str());
+      std::remove(async_path.c_str());
+    }
+  }
+}
+
+TEST_CASE("Phylogeny snapshots are written in emp::Systematics::Snapshot's format", "[default]") {
+  SymConfigBase config;
+  test_utils::SetWellMixed(config, 40, 30);
+  config.START_MOI(1);
+  config.PHYLOGENY(1);
+  config.ASYNC_OUTPUT(1);
+  emp::Random random(34);
+  SymWorld world(random, &config);
+  world.Setup();
+  for (size_t i = 0; i < 20; i++) world.Update();
+  world.WritePhylogenyFile("AsyncOutput_test_Format.data");
+  REQUIRE(world.FlushOutput());
+
+  // The same extra column the world adds to its host snapshots
+  world.GetHostSys()->AddSnapshotFun([](const taxon_t::host_taxon_t& t) { return std::to_string(t.GetInfo()); }, "info");
+  world.GetHostSys()->Snapshot("AsyncOutput_test_Format_emp.data");
+
+  const std::string snapshot = test_utils::ReadFile("HostSnapshot_AsyncOutput_test_Format.data");
+  REQUIRE(!snapshot.empty());
+  REQUIRE(snapshot == test_utils::ReadFile("AsyncOutput_test_Format_emp.data"));
+  std::remove("HostSnapshot_AsyncOutput_test_Format.data");
+  std::remove("SymSnapshot_AsyncOutput_test_Format.data");
+  std::remove("AsyncOutput_test_Format_emp.data");
+}
+
+TEST_CASE("Periodic checkpoints are written by the output queue with ASYNC_OUTPUT", "[default]") {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::string periodic_path = (dir / "AsyncOutput_test_periodic.ckpt").string();
+  const std::string saved_path = (dir / "AsyncOutput_test_saved.ckpt").string();
+  SymConfigBase config;
+  test_utils::SetWellMixed(config, 40, 30);
+  config.START_MOI(1);
+  config.ASYNC_OUTPUT(1);
+  config.CHECKPOINT_INTERVAL(5);
+  config.CHECKPOINT_PATH(periodic_path);
+  emp::Random random(33);
+  SymWorld world(random, &config);
+  world.Setup();
+  for (size_t i = 0; i < 10; i++) world.Update();
+  REQUIRE(world.FlushOutput());
+  REQUIRE(world.SaveCheckpoint(saved_path));
+
+  THEN("The last periodic checkpoint matches one saved directly") {
+    REQUIRE(!test_utils::ReadFile(periodic_path).empty());
+    REQUIRE(test_utils::ReadFile(periodic_path) == test_utils::ReadFile(saved_path));
+  }
+  std::remove(periodic_path.c_str());
+  std::remove(saved_path.c_str());
+}
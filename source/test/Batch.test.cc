@@ -0,0 +1,125 @@
+#include "../native/symbulation_batch.h"
+#include "../default_mode/SymWorld.h"
+#include "../default_mode/WorldSetup.cc"
+
+#include "../catch/catch.hpp"
+
+TEST_CASE("Batch options are parsed out of the command line", "[default]") {
+  std::string args[] = {"symbulation", "--seeds", "10:13", "-START_MOI", "2", "--sweep", "VERTICAL_TRANSMISSION=0,0.5", "--threads", "4"};
+  char* argv[9];
+  for (size_t i = 0; i < 9; ++i) argv[i] = args[i].data();
+  int argc = 9;
+
+  batch::BatchSpec spec;
+  REQUIRE(batch::ParseBatchArgs(argc, argv, spec));
+
+  THEN("Only the config options are left for CheckConfigFile") {
+    REQUIRE(argc == 3);
+    REQUIRE(std::string(argv[1]) == "-START_MOI");
+    REQUIRE(std::string(argv[2]) == "2");
+  }
+  THEN("The batch spec is filled in") {
+    REQUIRE(spec.has_seeds);
+    REQUIRE(spec.seed_start == 10);
+    REQUIRE(spec.seed_end == 13);
+    REQUIRE(spec.num_threads == 4);
+    REQUIRE(spec.sweep.size() == 1);
+    REQUIRE(spec.sweep[0].name == "VERTICAL_TRANSMISSION");
+    REQUIRE(spec.sweep[0].values == emp::vector<std::string>{"0", "0.5"});
+  }
+  THEN("Every sweep combination is run for every seed, each with its own prefix") {
+    spec.sweep.push_back({"START_MOI", {"1", "2"}});
+    const emp::vector<batch::Replicate> replicates = batch::BuildReplicates(spec, 1);
+    REQUIRE(replicates.size() == 12);
+    REQUIRE(replicates[0].seed == 10);
+    REQUIRE(replicates[0].label == "_VERTICAL_TRANSMISSION0_START_MOI1");
+    REQUIRE(replicates[2].seed == 12);
+    REQUIRE(replicates[3].label == "_VERTICAL_TRANSMISSION0_START_MOI2");
+    REQUIRE(replicates[11].label == "_VERTICAL_TRANSMISSION0.5_START_MOI2");
+    REQUIRE(replicates[11].settings.size() == 2);
+  }
+}
+
+TEST_CASE("Batch replicates run independently on worker threads", "[default]") {
+  batch::BatchSpec spec;
+  spec.has_seeds = true;
+  spec.seed_start = 1;
+  spec.seed_end = 5;
+  const emp::vector<batch::Replicate> replicates = batch::BuildReplicates(spec, 0);
+
+  SymConfigBase config;
+  config.WORLD_WIDTH(5);
+  config.WORLD_HEIGHT(5);
+  std::stringstream base_settings;
+  config.Write(base_settings);
+
+  // emp::Ptr memory tracking isn't thread safe, so debug builds use one worker.
+#ifdef EMP_TRACK_MEM
+  const size_t num_threads = 1;
+#else
+  const size_t num_threads = 2;
+#endif
+  emp::vector<size_t> final_counts(replicates.size(), 0);
+  batch::RunReplicates(replicates, num_threads, [&](const batch::Replicate& replicate, size_t rep_id) {
+    SymConfigBase rep_config;
+    batch::SetupReplicateConfig(base_settings.str(), replicate, rep_config);
+    emp::Random random(rep_config.SEED());
+    SymWorld world(random, &rep_config);
+    world.Setup();
+    for (size_t i = 0; i < 20; ++i) world.Update();
+    final_counts[rep_id] = world.GetNumOrgs();
+  });
+
+  THEN("Each replicate matches the same seed run on its own") {
+    for (size_t rep_id = 0; rep_id < replicates.size(); ++rep_id) {
+      SymConfigBase rep_config;
+      batch::SetupReplicateConfig(base_settings.str(), replicates[rep_id], rep_config);
+      REQUIRE(rep_config.SEED() == replicates[rep_id].seed);
+      emp::Random random(rep_config.SEED());
+      SymWorld world(random, &rep_config);
+      world.Setup();
+      for (size_t i = 0; i < 20; ++i) world.Update();
+      REQUIRE(world.GetNumOrgs() == final_counts[rep_id]);
+    }
+  }
+}
+
+TEST_CASE("Batch replicate output is prefixed with the replicate, one whole line at a time", "[default]") {
+  batch::BatchSpec spec;
+  spec.has_seeds = true;
+  spec.seed_start = 1;
+  spec.seed_end = 5;
+  const emp::vector<batch::Replicate> replicates = batch::BuildReplicates(spec, 0);
+
+  std::ostringstream captured;
+  std::streambuf* const cout_buf = std::cout.rdbuf(captured.rdbuf());
+  batch::RunReplicates(replicates, 3, [](const batch::Replicate& replicate, size_t) {
+    for (size_t i = 0; i < 200; ++i) {
+      std::cout << "line " << i << " of seed " << replicate.seed << std::endl;
+    }
+    std::cout << "unfinished line of seed " << replicate.seed;
+  });
+  std::cout.rdbuf(cout_buf);
+
+  THEN("Every line a replicate printed is intact and labeled with its seed") {
+    std::istringstream lines(captured.str());
+    size_t num_replicate_lines = 0;
+    size_t num_finished_lines = 0;
+    for (std::string line; std::getline(lines, line); ) {
+      if (line.rfind("Finished replicate ", 0) == 0) {
+        ++num_finished_lines;
+        continue;
+      }
+      const std::string prefix_start = "[SEED ";
+      const size_t prefix_end = line.find("] ");
+      REQUIRE(line.rfind(prefix_start, 0) == 0);
+      REQUIRE(prefix_end != std::string::npos);
+      const std::string ending = " of seed " + line.substr(prefix_start.size(), prefix_end - prefix_start.size());
+      REQUIRE(line.size() >= ending.size());
+      REQUIRE(line.compare(line.size() - ending.size(), ending.size(), ending) == 0);
+      ++num_replicate_lines;
+    }
+    REQUIRE(num_replicate_lines == replicates.size() * 201);
+    REQUIRE(num_finished_lines == replicates.size());
+  }
+}
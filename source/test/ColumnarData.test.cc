@@ -0,0 +1,147 @@
+#include "../catch/catch.hpp"
+
+#include "test_utils.h"
+#include "../ColumnarData.h"
+#include "../default_mode/SymWorld.h"
+#include "../default_mode/WorldSetup.cc"
+#include "../default_mode/DataNodes.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <sstream>
+
+namespace {
+  std::string ColumnarToCSV(const std::string& path) {
+    columnar::Table table;
+    REQUIRE(columnar::ReadTable(path, table));
+    std::ostringstream out;
+    columnar::WriteCSV(table, out);
+    return out.str();
+  }
+}
+
+TEST_CASE("Columnar data files convert back to the CSV emp::DataFile writes", "[default]") {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::string csv_path = (dir / "ColumnarData_test.data").string();
+  const std::string columnar_path = csv_path + columnar::FILE_EXTENSION;
+
+  int update = 0;
+  double mean = 0;
+  std::string label;
+  double mixed = 0;
+  {
+    emp::DataFile csv_file(csv_path);
+    columnar::DataFile columnar_file(columnar_path, 4);
+    for (emp::DataFile* file : {&csv_file, static_cast<emp::DataFile*>(&columnar_file)}) {
+      file->AddVar(update, "update", "Update");
+      file->AddVar(mean, "mean", "A float column");
+      file->AddVar(label, "label", "A text column");
+      file->AddVar(mixed, "mixed", "Integers, floats, and infinity");
+      file->PrintHeaderKeys();
+    }
+    for (update = 0; update < 10; update++) {
+      mean = 0.1 * update - 0.35;
+      label = (update % 3) ? "host" : "sym";
+      mixed = (update % 2) ? 1.0 / (update + 2) : update * 1000000.0;
+      if (update == 9) mixed = std::numeric_limits<double>::infinity();
+      csv_file.Update();
+      columnar_file.Update();
+    }
+  }
+
+  THEN("Every value (and the header) is the same") {
+    REQUIRE(ColumnarToCSV(columnar_path) == test_utils::ReadFile(csv_path));
+  }
+  std::remove(csv_path.c_str());
+  std::remove(columnar_path.c_str());
+}
+
+TEST_CASE("Columnar data files record the codec their columns are stored with", "[default]") {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::string csv_path = (dir / "ColumnarData_test_codec.data").string();
+
+  int update = 0;
+  std::string label;
+  {
+    emp::DataFile csv_file(csv_path);
+    columnar::DataFile plain_file(csv_path + "_none" + columnar::FILE_EXTENSION, 32, columnar::CODEC::NONE);
+    emp::vector<emp::DataFile*> files = {&csv_file, &plain_file};
+    emp::Ptr<columnar::DataFile> deflate_file = nullptr;
+    if (columnar::HasCodec(columnar::CODEC::DEFLATE)) {
+      deflate_file = emp::NewPtr<columnar::DataFile>(csv_path + "_deflate" + columnar::FILE_EXTENSION, 32, columnar::CODEC::DEFLATE);
+      files.push_back(deflate_file.Raw());
+    }
+    for (emp::DataFile* file : files) {
+      file->AddVar(update, "update", "Update");
+      file->AddVar(label, "label", "A repetitive text column");
+      file->PrintHeaderKeys();
+    }
+    for (update = 0; update < 100; update++) {
+      label = (update % 3) ? "host_with_a_long_name" : "symbiont_with_a_long_name";
+      for (emp::DataFile* file : files) file->Update();
+    }
+    if (deflate_file) deflate_file.Delete();
+  }
+  const std::string csv = test_utils::ReadFile(csv_path);
+
+  THEN("Uncompressed files read back the same") {
+    columnar::Table table;
+    REQUIRE(columnar::ReadTable(csv_path + "_none" + columnar::FILE_EXTENSION, table));
+    REQUIRE(table.codec == columnar::CODEC::NONE);
+    REQUIRE(ColumnarToCSV(csv_path + "_none" + columnar::FILE_EXTENSION) == csv);
+  }
+
+  THEN("Version 1 files, which have no codec, can still be read") {
+    std::string bytes = test_utils::ReadFile(csv_path + "_none" + columnar::FILE_EXTENSION);
+    const uint32_t version = 1;
+    std::memcpy(bytes.data() + sizeof(columnar::MAGIC), &version, sizeof(version));
+    bytes.erase(sizeof(columnar::MAGIC) + sizeof(version), sizeof(columnar::CODEC));
+    REQUIRE(checkpoint::WriteFileAtomic(csv_path + "_v1" + columnar::FILE_EXTENSION, bytes));
+    REQUIRE(ColumnarToCSV(csv_path + "_v1" + columnar::FILE_EXTENSION) == csv);
+  }
+
+  if (columnar::HasCodec(columnar::CODEC::DEFLATE)) {
+    THEN("Compressed files read back the same, and are smaller") {
+      columnar::Table table;
+      REQUIRE(columnar::ReadTable(csv_path + "_deflate" + columnar::FILE_EXTENSION, table));
+      REQUIRE(table.codec == columnar::CODEC::DEFLATE);
+      REQUIRE(ColumnarToCSV(csv_path + "_deflate" + columnar::FILE_EXTENSION) == csv);
+      REQUIRE(std::filesystem::file_size(csv_path + "_deflate" + columnar::FILE_EXTENSION) <
+              std::filesystem::file_size(csv_path + "_none" + columnar::FILE_EXTENSION));
+    }
+  }
+
+  for (const std::string suffix : {"", "_none.col", "_deflate.col", "_v1.col"}) {
+    std::remove((csv_path + suffix).c_str());
+  }
+}
+
+TEST_CASE("SymWorld writes columnar data files when configured to", "[default]") {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::string csv_path = (dir / "ColumnarData_test_SymVals.data").string();
+  const std::string columnar_path = csv_path + columnar::FILE_EXTENSION;
+
+  auto run_world = [&](const std::string& format) {
+    SymConfigBase config;
+    test_utils::SetWellMixed(config, 40, 30);
+    config.START_MOI(1);
+    config.SYM_LIMIT(2);
+    config.DATA_FILE_FORMAT(format);
+    emp::Random random(31);
+    SymWorld world(random, &config);
+    world.Setup();
+    world.SetupSymIntValFile(csv_path).SetTimingRepeat(2);
+    for (size_t i = 0; i < 20; i++) world.Update();
+  };
+  run_world("csv");
+  run_world("columnar");
+
+  THEN("The columnar file holds the same data as the CSV file") {
+    REQUIRE(std::filesystem::exists(columnar_path));
+    REQUIRE(ColumnarToCSV(columnar_path) == test_utils::ReadFile(csv_path));
+  }
+  std::remove(csv_path.c_str());
+  std::remove(columnar_path.c_str());
+}
@@ -0,0 +1,127 @@
+#include "../OrganismPool.h"
+#include "../default_mode/SymWorld.h"
+#include "../default_mode/Host.h"
+#include "../default_mode/Symbiont.h"
+
+#include "../catch/catch.hpp"
+
+#include <thread>
+
+TEST_CASE("OrganismPool recycles organism memory", "[default]") {
+  org_pool::OrganismPool pool;
+
+  WHEN("An object is freed") {
+    void* first = pool.Allocate(100);
+    pool.Free(first);
+    void* second = pool.Allocate(100);
+    THEN("Its memory is reused by the next allocation of the same size") {
+      REQUIRE(second == first);
+      REQUIRE(pool.GetStats().num_allocs == 2);
+      REQUIRE(pool.GetStats().num_reused == 1);
+      REQUIRE(pool.GetStats().num_frees == 1);
+      REQUIRE(pool.GetStats().num_live == 1);
+      REQUIRE(pool.GetStats().num_slabs == 1);
+    }
+    pool.Free(second);
+  }
+
+  WHEN("Objects of different sizes are allocated") {
+    void* small = pool.Allocate(64);
+    void* large = pool.Allocate(512);
+    THEN("They come from different slabs") {
+      REQUIRE(small != large);
+      REQUIRE(pool.GetStats().num_slabs == 2);
+    }
+    pool.Free(small);
+    pool.Free(large);
+  }
+
+  WHEN("More objects than fit in a slab are allocated") {
+    std::vector<void*> ptrs;
+    for (size_t i = 0; i < org_pool::OrganismPool::SLAB_OBJECTS + 1; ++i) {
+      ptrs.emplace_back(pool.Allocate(32));
+    }
+    THEN("A second slab is allocated") {
+      REQUIRE(pool.GetStats().num_slabs == 2);
+      REQUIRE(pool.GetStats().num_live == org_pool::OrganismPool::SLAB_OBJECTS + 1);
+    }
+    for (void* ptr : ptrs) pool.Free(ptr);
+  }
+}
+
+#ifndef SYM_DISABLE_ORGANISM_POOL
+TEST_CASE("Organisms are allocated from the organism pool", "[default]") {
+  emp::Random random(5);
+  SymConfigBase config;
+  SymWorld world(random, &config);
+
+  emp::Ptr<Organism> host = emp::NewPtr<Host>(&random, &world, &config, 0.5);
+  const size_t live_before = org_pool::GetStats().num_live;
+  const size_t reused_before = org_pool::GetStats().num_reused;
+  Organism* host_addr = host.Raw();
+  host.Delete();
+  REQUIRE(org_pool::GetStats().num_live == live_before - 1);
+
+  emp::Ptr<Organism> new_host = emp::NewPtr<Host>(&random, &world, &config, 0.5);
+  REQUIRE(new_host.Raw() == host_addr);
+  REQUIRE(org_pool::GetStats().num_reused == reused_before + 1);
+  new_host.Delete();
+}
+
+TEST_CASE("Each thread's organism pool is destroyed with its thread", "[default]") {
+  // Deletes its organism at thread exit, after the thread's pool is destroyed
+  // (thread-local objects are destroyed in reverse order of construction)
+  struct DeleteAtThreadExit {
+    Organism* org = nullptr;
+    ~DeleteAtThreadExit() { delete org; }
+  };
+  size_t thread_num_slabs = 0;
+  std::thread thread([&thread_num_slabs]() {
+    static thread_local DeleteAtThreadExit late_delete;
+    late_delete.org = new Organism();
+    delete new Organism();
+    thread_num_slabs = org_pool::GetStats().num_slabs;
+  });
+  thread.join();
+
+  THEN("The thread had its own pool, and deleting an organism after it was gone is safe") {
+    REQUIRE(thread_num_slabs == 1);
+  }
+}
+
+TEST_CASE("Organisms deleted on another thread go back to the pool they came from", "[default]") {
+  WHEN("An organism is deleted on another thread") {
+    Organism* org = new Organism();
+    void* org_addr = org;
+    std::thread([org]() { delete org; }).join();
+
+    THEN("Its memory is reused by the creating thread once it runs out of free memory") {
+      std::vector<Organism*> orgs;
+      bool is_reused = false;
+      for (size_t i = 0; i <= org_pool::OrganismPool::SLAB_OBJECTS; ++i) {
+        orgs.emplace_back(new Organism());
+        is_reused = is_reused || orgs.back() == org_addr;
+      }
+      REQUIRE(is_reused);
+      for (Organism* next_org : orgs) delete next_org;
+    }
+  }
+
+  WHEN("Threads delete each other's organisms after the creating thread exits") {
+    std::vector<Organism*> first_orgs;
+    std::vector<Organism*> second_orgs;
+    std::thread([&first_orgs]() {
+      for (size_t i = 0; i <= org_pool::OrganismPool::SLAB_OBJECTS; ++i) first_orgs.emplace_back(new Organism());
+    }).join();
+    std::thread([&first_orgs, &second_orgs]() {
+      for (size_t i = 0; i <= org_pool::OrganismPool::SLAB_OBJECTS; ++i) second_orgs.emplace_back(new Organism());
+      for (Organism* org : first_orgs) delete org;
+    }).join();
+    for (Organism* org : second_orgs) delete org;
+
+    THEN("Each thread's pool is freed with its last organism") {
+      SUCCEED();
+    }
+  }
+}
+#endif
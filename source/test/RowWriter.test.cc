@@ -0,0 +1,122 @@
+#include "../catch/catch.hpp"
+
+#include "test_utils.h"
+#include "../PairCounter.h"
+#include "../RowWriter.h"
+#include "../default_mode/SymWorld.h"
+#include "../default_mode/Host.h"
+#include "../default_mode/Symbiont.h"
+#include "../default_mode/WorldSetup.cc"
+#include "../default_mode/DataNodes.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+
+TEST_CASE("RowWriter streams rows through a small buffer", "[default]") {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::string path = (dir / "RowWriter_test.data").string();
+  const std::string queued_path = (dir / "RowWriter_test_queued.data").string();
+
+  std::ostringstream expected;
+  expected << "host,symbiont,count\n";
+  for (size_t i = 0; i < 1000; i++) expected << i * 1000003 << "," << i % 7 << "," << int(i % 5) - 2 << "\n";
+
+  auto write_rows = [](output::RowWriter writer) {
+    writer.Write("host,symbiont,count\n");
+    for (size_t i = 0; i < 1000; i++) writer.Row(i * 1000003, uint64_t(i % 7), int(i % 5) - 2);
+    return writer.Close();
+  };
+  std::shared_ptr<async_output::WriteQueue> queue = std::make_shared<async_output::WriteQueue>();
+  REQUIRE(write_rows(output::RowWriter(output::OpenSink(path, nullptr), 64)));
+  REQUIRE(write_rows(output::RowWriter(output::OpenSink(queued_path, queue), 64)));
+  REQUIRE(queue->Flush());
+
+  THEN("The files hold every row, written directly or through a queue") {
+    REQUIRE(test_utils::ReadFile(path) == expected.str());
+    REQUIRE(test_utils::ReadFile(queued_path) == expected.str());
+  }
+  std::remove(path.c_str());
+  std::remove(queued_path.c_str());
+}
+
+TEST_CASE("PairCounter counts pairs in the order they were first added", "[default]") {
+  PairCounter counter;
+  for (size_t round = 0; round < 2; round++) {
+    counter.Clear();
+    for (uint64_t host = 0; host < 500; host++) {
+      for (uint64_t sym = 0; sym <= host % 4; sym++) counter.Add(host, sym);
+      counter.Add(host, 0, 2);
+    }
+
+    REQUIRE(counter.GetSize() == 1250);
+    REQUIRE(counter.GetCount(7, 0) == 3);
+    REQUIRE(counter.GetCount(7, 3) == 1);
+    REQUIRE(counter.GetCount(4, 3) == 0);
+    REQUIRE(counter.GetCount(600, 0) == 0);
+
+    uint64_t prev_host = 0;
+    size_t total = 0;
+    for (const PairCounter::Entry& entry : counter) {
+      REQUIRE(entry.first >= prev_host);
+      prev_host = entry.first;
+      total += entry.count;
+    }
+    REQUIRE(total == 1250 + 500 * 2);
+  }
+}
+
+TEST_CASE("Interaction snapshots are streamed to files", "[default]") {
+  emp::Random random(41);
+  SymConfigBase config;
+  config.SPATIAL_STRUCT_MODE("grid");
+  config.WORLD_WIDTH(10);
+  config.WORLD_HEIGHT(10);
+  config.START_MOI(1);
+  config.SYM_LIMIT(3);
+  config.PHYLOGENY(1);
+  config.TRACK_PHYLOGENY_INTERACTIONS(1);
+  config.WRITE_CURRENT_INTERACTION_COUNTS(1);
+  SymWorld world(random, &config);
+  world.Setup();
+  for (size_t i = 0; i < 30; i++) world.Update();
+
+  const std::string filename = "RowWriter_test_phylogeny.data";
+  world.WritePhylogenyFile(filename);
+
+  THEN("Every tracked interaction is written") {
+    size_t num_interactions = 0;
+    emp::Ptr<SymWorld::host_systematics_t> host_sys = world.GetHostSys();
+    auto count_interactions = [&num_interactions](const auto& taxa) {
+      for (emp::Ptr<taxon_t::host_taxon_t> t : taxa) num_interactions += t->GetData().associated_syms.size();
+    };
+    count_interactions(host_sys->GetActive());
+    count_interactions(host_sys->GetAncestors());
+    count_interactions(host_sys->GetOutside());
+    std::istringstream in(test_utils::ReadFile("InteractionSnapshot_" + filename));
+    std::string line;
+    REQUIRE(std::getline(in, line));
+    REQUIRE(line == "host, symbiont, count");
+    size_t num_rows = 0;
+    while (std::getline(in, line)) num_rows++;
+    REQUIRE(num_rows == num_interactions);
+  }
+
+  THEN("Current interactions count every hosted symbiont") {
+    size_t num_hosted_syms = 0;
+    for (size_t i = 0; i < world.GetSize(); i++) {
+      if (world.IsOccupied(i)) num_hosted_syms += world.GetOrg(i).GetSymbionts().size();
+    }
+    std::istringstream in(test_utils::ReadFile("CurrentInteractionsSnapshot_" + filename));
+    std::string line;
+    REQUIRE(std::getline(in, line));
+    REQUIRE(line == "host,symbiont,count");
+    size_t total = 0;
+    while (std::getline(in, line)) total += std::stoul(line.substr(line.rfind(',') + 1));
+    REQUIRE(total == num_hosted_syms);
+  }
+
+  for (const std::string prefix : {"SymSnapshot_", "HostSnapshot_", "InteractionSnapshot_", "CurrentInteractionsSnapshot_"}) {
+    std::remove((prefix + filename).c_str());
+  }
+}
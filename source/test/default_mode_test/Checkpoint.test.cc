@@ -0,0 +1,213 @@
+#include "../../catch/catch.hpp"
+
+#include "../test_utils.h"
+#include "../../default_mode/SymWorld.h"
+#include "../../default_mode/Host.h"
+#include "../../default_mode/Symbiont.h"
+#include "../../default_mode/WorldSetup.cc"
+
+#include <cstdio>
+#include <fstream>
+
+namespace {
+  void SetCheckpointTestConfig(SymConfigBase& config) {
+    config.SPATIAL_STRUCT_MODE("grid");
+    config.WORLD_WIDTH(10);
+    config.WORLD_HEIGHT(10);
+    config.INIT_POP_SIZE(60);
+    config.START_MOI(1);
+    config.SYM_LIMIT(2);
+    config.HOST_REPRO_RES(200);
+    config.SYM_HORIZ_TRANS_RES(50);
+    config.MUTATION_SIZE(0.05);
+    config.LIMITED_RES_TOTAL(50000);
+    config.LIMITED_RES_INFLOW(500);
+  }
+}
+
+TEST_CASE("SymWorld checkpoints resume identically", "[default]") {
+  GIVEN("A world that is checkpointed partway through a run") {
+    const std::string checkpoint_path = "symworld-checkpoint-test.ckpt";
+    SymConfigBase config;
+    SetCheckpointTestConfig(config);
+
+    emp::Random random(17);
+    SymWorld world(random, &config);
+    world.Setup();
+    for (size_t i = 0; i < 5; i++) world.Update();
+    REQUIRE(world.SaveCheckpoint(checkpoint_path));
+
+    WHEN("The checkpoint is loaded into a differently seeded world") {
+      emp::Random restored_random(99);
+      SymWorld restored_world(restored_random, &config);
+      restored_world.Setup();
+      REQUIRE(restored_world.LoadCheckpoint(checkpoint_path));
+
+      THEN("Both worlds continue with the same population") {
+        REQUIRE(restored_world.GetUpdate() == world.GetUpdate());
+        for (size_t update = 0; update < 10; update++) {
+          world.Update();
+          restored_world.Update();
+          REQUIRE(restored_world.GetNumOrgs() == world.GetNumOrgs());
+          for (size_t i = 0; i < world.GetSize(); i++) {
+            REQUIRE(restored_world.IsOccupied(i) == world.IsOccupied(i));
+            if (!world.IsOccupied(i)) continue;
+            Organism& host = world.GetOrg(i);
+            Organism& restored_host = restored_world.GetOrg(i);
+            REQUIRE(restored_host.GetIntVal() == host.GetIntVal());
+            REQUIRE(restored_host.GetPoints() == host.GetPoints());
+            REQUIRE(restored_host.GetAge() == host.GetAge());
+            REQUIRE(restored_host.GetSymbionts().size() == host.GetSymbionts().size());
+            for (size_t sym_i = 0; sym_i < host.GetSymbionts().size(); sym_i++) {
+              REQUIRE(restored_host.GetSymbionts()[sym_i]->GetIntVal() == host.GetSymbionts()[sym_i]->GetIntVal());
+              REQUIRE(restored_host.GetSymbionts()[sym_i]->GetPoints() == host.GetSymbionts()[sym_i]->GetPoints());
+            }
+          }
+        }
+      }
+    }
+
+    WHEN("The checkpoint is truncated") {
+      {
+        std::ofstream out(checkpoint_path, std::ios::binary | std::ios::trunc);
+        out << "SYMCKPT";
+      }
+      emp::Random other_random(99);
+      SymWorld other_world(other_random, &config);
+      other_world.Setup();
+      const size_t num_orgs = other_world.GetNumOrgs();
+
+      THEN("Loading fails and the world is unchanged") {
+        REQUIRE(!other_world.LoadCheckpoint(checkpoint_path));
+        REQUIRE(other_world.GetNumOrgs() == num_orgs);
+        REQUIRE(other_world.GetUpdate() == 0);
+      }
+    }
+    std::remove(checkpoint_path.c_str());
+  }
+}
+
+TEST_CASE("A resumed run writes the same data as an uninterrupted run", "[default]") {
+  const std::string checkpoint_path = "symworld-checkpoint-resume-test.ckpt";
+  const std::string resumed_path = "symworld-checkpoint-resume-test-resumed.data";
+  const std::string uninterrupted_path = "symworld-checkpoint-resume-test-uninterrupted.data";
+  SymConfigBase config;
+  SetCheckpointTestConfig(config);
+
+  {
+    // Saving the checkpoint must not change the rest of this run
+    emp::Random random(17);
+    SymWorld world(random, &config);
+    world.Setup();
+    world.SetupHostIntValFile(resumed_path).SetTimingRepeat(1);
+    for (size_t i = 0; i < 5; i++) world.Update();
+    REQUIRE(world.SaveCheckpoint(checkpoint_path));
+  }
+  {
+    SymConfigBase resumed_config;
+    SetCheckpointTestConfig(resumed_config);
+    resumed_config.LOAD_CHECKPOINT(checkpoint_path);
+    emp::Random random(99);
+    SymWorld world(random, &resumed_config);
+    world.Setup();
+    REQUIRE(world.GetUpdate() == 5);
+    world.SetupHostIntValFile(resumed_path).SetTimingRepeat(1);
+    for (size_t i = 0; i < 5; i++) world.Update();
+  }
+  {
+    emp::Random random(17);
+    SymWorld world(random, &config);
+    world.Setup();
+    world.SetupHostIntValFile(uninterrupted_path).SetTimingRepeat(1);
+    for (size_t i = 0; i < 10; i++) world.Update();
+  }
+
+  const std::string uninterrupted_data = test_utils::ReadFile(uninterrupted_path);
+  REQUIRE(uninterrupted_data.size() > 0);
+  REQUIRE(test_utils::ReadFile(resumed_path) == uninterrupted_data);
+  std::remove(checkpoint_path.c_str());
+  std::remove(resumed_path.c_str());
+  std::remove(uninterrupted_path.c_str());
+}
+
+TEST_CASE("A resumed run tracking a phylogeny matches an uninterrupted run", "[default]") {
+  const std::string checkpoint_path = "symworld-checkpoint-phylogeny-test.ckpt";
+  const std::string phylogeny_name = "symworld-checkpoint-phylogeny-test";
+  SymConfigBase config;
+  SetCheckpointTestConfig(config);
+  config.PHYLOGENY(1);
+  config.TRACK_PHYLOGENY_INTERACTIONS(1);
+
+  emp::Random random(17);
+  SymWorld world(random, &config);
+  world.Setup();
+  for (size_t i = 0; i < 5; i++) world.Update();
+  REQUIRE(world.SaveCheckpoint(checkpoint_path));
+
+  emp::Random resumed_random(99);
+  SymWorld resumed_world(resumed_random, &config);
+  resumed_world.Setup();
+  REQUIRE(resumed_world.LoadCheckpoint(checkpoint_path));
+  REQUIRE(resumed_world.GetHostSys()->GetNumTaxa() == world.GetHostSys()->GetNumTaxa());
+  REQUIRE(resumed_world.GetSymSys()->GetNumTaxa() == world.GetSymSys()->GetNumTaxa());
+
+  for (size_t update = 0; update < 10; update++) {
+    world.Update();
+    resumed_world.Update();
+    REQUIRE(resumed_world.GetNumOrgs() == world.GetNumOrgs());
+    for (size_t i = 0; i < world.GetSize(); i++) {
+      REQUIRE(resumed_world.IsOccupied(i) == world.IsOccupied(i));
+      if (!world.IsOccupied(i)) continue;
+      Organism& host = world.GetOrg(i);
+      Organism& resumed_host = resumed_world.GetOrg(i);
+      REQUIRE(resumed_host.GetTaxon()->GetID() == host.GetTaxon()->GetID());
+      REQUIRE(resumed_world.GetHostSys()->GetTaxonAt(i) == resumed_host.GetTaxon().Cast<taxon_t::host_taxon_t>());
+      REQUIRE(resumed_host.GetSymbionts().size() == host.GetSymbionts().size());
+      for (size_t sym_i = 0; sym_i < host.GetSymbionts().size(); sym_i++) {
+        REQUIRE(resumed_host.GetSymbionts()[sym_i]->GetTaxon()->GetID() == host.GetSymbionts()[sym_i]->GetTaxon()->GetID());
+      }
+    }
+  }
+
+  // Taxa are written in (pointer-based) set order, so compare sorted rows
+  world.WritePhylogenyFile(phylogeny_name + ".data");
+  resumed_world.WritePhylogenyFile(phylogeny_name + "-resumed.data");
+  REQUIRE(world.FlushOutput());
+  REQUIRE(resumed_world.FlushOutput());
+  for (const std::string prefix : {"SymSnapshot_", "HostSnapshot_", "InteractionSnapshot_"}) {
+    const std::string path = prefix + phylogeny_name + ".data";
+    const std::string resumed_path = prefix + phylogeny_name + "-resumed.data";
+    REQUIRE(!test_utils::ReadSortedLines(path).empty());
+    REQUIRE(test_utils::ReadSortedLines(resumed_path) == test_utils::ReadSortedLines(path));
+    std::remove(path.c_str());
+    std::remove(resumed_path.c_str());
+  }
+  std::remove(checkpoint_path.c_str());
+}
+
+TEST_CASE("Checkpoints only load into worlds with the same PHYLOGENY setting", "[default]") {
+  const std::string checkpoint_path = "symworld-checkpoint-phylogeny-mismatch-test.ckpt";
+  SymConfigBase config;
+  SetCheckpointTestConfig(config);
+  emp::Random random(17);
+  SymWorld world(random, &config);
+  world.Setup();
+  REQUIRE(world.SaveCheckpoint(checkpoint_path));
+
+  SymConfigBase phylogeny_config;
+  SetCheckpointTestConfig(phylogeny_config);
+  phylogeny_config.PHYLOGENY(1);
+  emp::Random phylogeny_random(18);
+  SymWorld phylogeny_world(phylogeny_random, &phylogeny_config);
+  phylogeny_world.Setup();
+  const size_t num_orgs = phylogeny_world.GetNumOrgs();
+  const size_t num_taxa = phylogeny_world.GetHostSys()->GetNumTaxa();
+
+  REQUIRE(!phylogeny_world.LoadCheckpoint(checkpoint_path));
+  REQUIRE(phylogeny_world.GetNumOrgs() == num_orgs);
+  REQUIRE(phylogeny_world.GetHostSys()->GetNumTaxa() == num_taxa);
+
+  REQUIRE(phylogeny_world.SaveCheckpoint(checkpoint_path));
+  REQUIRE(!world.LoadCheckpoint(checkpoint_path));
+  std::remove(checkpoint_path.c_str());
+}
@@ -3,6 +3,9 @@
 #include "../../default_mode/Symbiont.h"
 #include "../../default_mode/Host.h"
 
+#include <cstdio>
+#include <filesystem>
+
 TEST_CASE("GetHostCountDataNode", "[default]") {
   using sym_world_t = test_utils::TestingWorldWrapper<SymWorld>;
   GIVEN( "a world" ) {
@@ -1117,4 +1120,115 @@ TEST_CASE("GetHostTagPermissiveness", "[default]") {
       }
     }
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Data nodes are filled by a single collection pass", "[default]") {
+  using sym_world_t = test_utils::TestingWorldWrapper<SymWorld>;
+  GIVEN("a world with hosted and free-living symbionts") {
+    emp::Random random(17);
+    SymConfigBase config;
+    config.FREE_LIVING_SYMS(1);
+    config.SYM_INFECTION_CHANCE(0);
+    config.SYM_LIMIT(2);
+    sym_world_t world(random, &config);
+    world.Resize(4);
+
+    emp::DataMonitor<int>& host_count_node = world.GetHostCountDataNode();
+    emp::DataMonitor<int>& sym_count_node = world.GetSymCountDataNode();
+    emp::DataMonitor<int>& hosted_sym_count_node = world.GetCountHostedSymsDataNode();
+    emp::DataMonitor<int>& free_sym_count_node = world.GetCountFreeSymsDataNode();
+    emp::DataMonitor<int>& uninf_hosts_node = world.GetUninfectedHostsDataNode();
+    emp::DataMonitor<double, emp::data::Histogram>& sym_int_val_node = world.GetSymIntValDataNode();
+    emp::DataMonitor<double, emp::data::Histogram>& within_host_mean_node = world.GetWithinHostMeanDataNode();
+
+    emp::Ptr<Host> infected_host = emp::NewPtr<Host>(&random, &world, &config, 0);
+    world.AddOrgAt(infected_host, 0);
+    infected_host->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, 0.5));
+    infected_host->AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, -0.5));
+    world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0), 2);
+    world.AddOrgAt(emp::NewPtr<Symbiont>(&random, &world, &config, 0.2), emp::WorldPosition(0, 1));
+
+    WHEN("the world updates") {
+      world.Update();
+
+      THEN("every requested node holds the same data as a separate scan would give") {
+        REQUIRE(host_count_node.GetTotal() == 2);
+        REQUIRE(sym_count_node.GetTotal() == 3);
+        REQUIRE(hosted_sym_count_node.GetTotal() == 2);
+        REQUIRE(free_sym_count_node.GetTotal() == 1);
+        REQUIRE(uninf_hosts_node.GetTotal() == 1);
+        REQUIRE(sym_int_val_node.GetCount() == 3);
+        REQUIRE(sym_int_val_node.GetMean() == Approx((0.5 - 0.5 + 0.2) / 3.0));
+        REQUIRE(within_host_mean_node.GetCount() == 1);
+        REQUIRE(within_host_mean_node.GetMean() == Approx(0));
+      }
+    }
+  }
+}
+
+TEST_CASE("Data nodes are only collected on data node interval updates", "[default]") {
+  using sym_world_t = test_utils::TestingWorldWrapper<SymWorld>;
+  GIVEN("a world that collects data every other update") {
+    emp::Random random(17);
+    SymConfigBase config;
+    sym_world_t world(random, &config);
+    world.Resize(4);
+    REQUIRE(world.GetDataNodeInterval() == 1);
+    world.SetDataNodeInterval(2);
+
+    emp::DataMonitor<int>& host_count_node = world.GetHostCountDataNode();
+    world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0), 0);
+    world.Update(); // update 0 is collected
+    REQUIRE(host_count_node.GetTotal() == 1);
+
+    WHEN("a host is added before an update that isn't collected") {
+      world.AddOrgAt(emp::NewPtr<Host>(&random, &world, &config, 0), 1);
+      world.Update(); // update 1 is skipped
+
+      THEN("the data node keeps its last collected value until the next collected update") {
+        REQUIRE(host_count_node.GetTotal() == 1);
+        world.Update(); // update 2 is collected
+        REQUIRE(host_count_node.GetTotal() == 2);
+      }
+    }
+  }
+}
+
+TEST_CASE("Data files are unchanged by collecting data nodes only on written updates", "[default]") {
+  const std::string file_path = (std::filesystem::temp_directory_path() / "DataNodes_test_").string();
+  // With collect_every_update, data nodes are refilled every update, as each
+  // node's own scan did before collection was limited to written updates
+  auto run_world = [&](const std::string& file_name, bool collect_every_update) {
+    emp::Random random(19);
+    SymConfigBase config;
+    test_utils::SetWellMixed(config, 100, 60);
+    config.SEED(19);
+    config.START_MOI(1);
+    config.SYM_LIMIT(3);
+    config.HORIZ_TRANS(1);
+    config.DATA_INT(3);
+    config.FILE_PATH(file_path);
+    config.FILE_NAME(file_name);
+    SymWorld world(random, &config);
+    world.Setup();
+    world.CreateDataFiles();
+    REQUIRE(world.GetDataNodeInterval() == 3);
+    if (collect_every_update) world.SetDataNodeInterval(1);
+    for (size_t i = 0; i < 40; i++) world.Update();
+  };
+  run_world("_interval", false);
+  run_world("_every_update", true);
+
+  THEN("The host, symbiont and transmission files are byte for byte the same") {
+    for (const std::string file : {"HostVals", "SymVals", "TransmissionRates"}) {
+      const std::string path = file_path + file + "_interval_SEED19.data";
+      const std::string every_update_path = file_path + file + "_every_update_SEED19.data";
+      REQUIRE(!test_utils::ReadFile(path).empty());
+      REQUIRE(test_utils::ReadFile(path) == test_utils::ReadFile(every_update_path));
+    }
+  }
+  for (const std::string file : {"HostVals", "SymVals", "TransmissionRates", "SymDiversity", "ReproHist"}) {
+    std::remove((file_path + file + "_interval_SEED19.data").c_str());
+    std::remove((file_path + file + "_every_update_SEED19.data").c_str());
+  }
+}
@@ -261,3 +261,48 @@ TEST_CASE( "Host-Symbiont interactions", "[default]") {
 }
 
 
+
+// A plain Symbiont in every way except its type, so hosts distribute
+// resources to it one symbiont at a time instead of with the batch kernel
+class PerSymPathSymbiont : public Symbiont {
+public:
+  using Symbiont::Symbiont;
+};
+
+TEST_CASE("Batch resource distribution matches the per-symbiont path", "[default]") {
+  emp::Random random(5);
+  SymConfigBase config;
+  config.SYM_LIMIT(4);
+  config.SYNERGY(3);
+  SymWorld world(random, &config);
+  const emp::vector<double> sym_int_vals = {-1, -0.5, 0, 0.7};
+  const double resources = 100;
+
+  for (double host_int_val : {-1.0, -0.6, -0.2, 0.0, 0.3, 1.0}) {
+    Host batch_host(&random, &world, &config, host_int_val);
+    Host per_sym_host(&random, &world, &config, host_int_val);
+    for (double sym_int_val : sym_int_vals) {
+      batch_host.AddSymbiont(emp::NewPtr<Symbiont>(&random, &world, &config, sym_int_val));
+      per_sym_host.AddSymbiont(emp::NewPtr<PerSymPathSymbiont>(&random, &world, &config, sym_int_val));
+    }
+    REQUIRE(Host::AreDefaultSymbionts(batch_host.GetSymbionts()));
+    REQUIRE(!Host::AreDefaultSymbionts(per_sym_host.GetSymbionts()));
+
+    batch_host.DistribResources(resources);
+    per_sym_host.DistribResources(resources);
+    REQUIRE(batch_host.GetPoints() == per_sym_host.GetPoints());
+    for (size_t i = 0; i < sym_int_vals.size(); i++) {
+      REQUIRE(batch_host.GetSymbionts()[i]->GetPoints() == per_sym_host.GetSymbionts()[i]->GetPoints());
+    }
+
+    // A single (e.g., ectosymbiotic) symbiont
+    emp::Ptr<Organism> batch_sym = emp::NewPtr<Symbiont>(&random, &world, &config, -0.8);
+    emp::Ptr<Organism> per_sym_sym = emp::NewPtr<PerSymPathSymbiont>(&random, &world, &config, -0.8);
+    batch_host.DistribResToSym(batch_sym, resources);
+    per_sym_host.DistribResToSym(per_sym_sym, resources);
+    REQUIRE(batch_host.GetPoints() == per_sym_host.GetPoints());
+    REQUIRE(batch_sym->GetPoints() == per_sym_sym->GetPoints());
+    batch_sym.Delete();
+    per_sym_sym.Delete();
+  }
+}
@@ -0,0 +1,51 @@
+#include "../../catch/catch.hpp"
+
+#include "../../default_mode/OccupancyIndex.h"
+
+TEST_CASE("OccupancyIndex tracks occupied positions", "[default]") {
+  OccupancyIndex index;
+  index.Resize(200);
+  for (size_t pos : {130, 3, 64, 63, 199, 17}) index.Set(pos, true);
+  index.Set(17, false);
+  index.Set(17, false);
+  index.Set(3, true);
+
+  THEN("Positions are counted once") {
+    REQUIRE(index.GetCount() == 5);
+    REQUIRE(index.Has(3));
+    REQUIRE(!index.Has(17));
+    REQUIRE(index.Has(199));
+    REQUIRE(!index.Has(1000));
+  }
+
+  THEN("Positions are visited in increasing order") {
+    emp::vector<size_t> positions;
+    index.GetPositions(positions);
+    REQUIRE(positions == emp::vector<size_t>{3, 63, 64, 130, 199});
+  }
+
+  WHEN("Positions are emptied while being visited") {
+    index.ForEach([&index](size_t pos) { if (pos % 2) index.Set(pos, false); });
+    THEN("Every position was still visited once") {
+      emp::vector<size_t> positions;
+      index.GetPositions(positions);
+      REQUIRE(positions == emp::vector<size_t>{64, 130});
+    }
+  }
+
+  WHEN("The index is shrunk") {
+    index.Resize(100);
+    THEN("Positions past the new size are dropped") {
+      REQUIRE(index.GetCount() == 3);
+      REQUIRE(!index.Has(130));
+    }
+  }
+
+  WHEN("A position past the end is marked occupied") {
+    index.Set(500, true);
+    THEN("The index grows") {
+      REQUIRE(index.Has(500));
+      REQUIRE(index.GetCount() == 6);
+    }
+  }
+}
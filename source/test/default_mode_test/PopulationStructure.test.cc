@@ -316,7 +316,7 @@ TEST_CASE("World uses custom spatial structure", "[default][spatial-structure]")
       for (size_t pop_i = 0; pop_i < world.GetSize(); ++pop_i) {
         emp::vector<size_t> world_neighbors(world.GetValidNeighborOrgIDs(pop_i));
         std::sort(world_neighbors.begin(), world_neighbors.end());
-        REQUIRE(structure.GetNeighbors(pop_i) == expected_connections[pop_i]);
+        REQUIRE(structure.GetNeighborList(pop_i) == expected_connections[pop_i]);
         REQUIRE(world_neighbors == expected_connections[pop_i]);
       }
     }
@@ -0,0 +1,220 @@
+#include "../../catch/catch.hpp"
+
+#include "../test_utils.h"
+#include "../../default_mode/SymWorld.h"
+#include "../../default_mode/Host.h"
+#include "../../default_mode/Symbiont.h"
+#include "../../default_mode/WorldSetup.cc"
+#include "../../default_mode/DataNodes.h"
+#include "../../default_mode/SoAPopulation.h"
+
+#include <cstdio>
+#include <filesystem>
+
+namespace {
+  // Hosts reproduce and symbionts transmit both ways, on a limited resource
+  void SetSoATestConfig(SymConfigBase& config) {
+    config.SPATIAL_STRUCT_MODE("grid");
+    config.WORLD_WIDTH(10);
+    config.WORLD_HEIGHT(10);
+    config.INIT_POP_SIZE(60);
+    config.START_MOI(2);
+    config.SYM_LIMIT(3);
+    config.HOST_REPRO_RES(200);
+    config.SYM_HORIZ_TRANS_RES(50);
+    config.SYM_VERT_TRANS_RES(10);
+    config.MUTATION_SIZE(0.05);
+    config.LIMITED_RES_TOTAL(50000);
+    config.LIMITED_RES_INFLOW(500);
+    config.HOST_AGE_MAX(25);
+    config.SYM_AGE_MAX(15);
+    config.SYNERGY(3);
+  }
+
+  void RequireSamePopulation(SoAPopulation& soa_pop, SymWorld& world) {
+    REQUIRE(soa_pop.GetNumHosts() == world.GetNumOrgs());
+    for (size_t i = 0; i < world.GetSize(); ++i) {
+      REQUIRE(soa_pop.IsOccupied(i) == world.IsOccupied(i));
+      if (!world.IsOccupied(i)) continue;
+      Organism& host = world.GetOrg(i);
+      REQUIRE(soa_pop.GetHostIntVal(i) == host.GetIntVal());
+      REQUIRE(soa_pop.GetHostPoints(i) == host.GetPoints());
+      REQUIRE(soa_pop.GetHostAge(i) == host.GetAge());
+      REQUIRE(soa_pop.GetHostReproCount(i) == host.GetReproCount());
+      REQUIRE(soa_pop.GetSymCount(i) == host.GetSymbionts().size());
+      for (size_t sym_i = 0; sym_i < host.GetSymbionts().size(); ++sym_i) {
+        Organism& sym = *host.GetSymbionts()[sym_i];
+        REQUIRE(soa_pop.GetSymIntVal(i, sym_i) == sym.GetIntVal());
+        REQUIRE(soa_pop.GetSymPoints(i, sym_i) == sym.GetPoints());
+        REQUIRE(soa_pop.GetSymAge(i, sym_i) == sym.GetAge());
+        REQUIRE(soa_pop.GetSymInfectionChance(i, sym_i) == sym.GetInfectionChance());
+        REQUIRE(soa_pop.GetSymReproCount(i, sym_i) == sym.GetReproCount());
+      }
+    }
+  }
+
+  void RequireSameTransmissions(SymWorld& soa_world, SymWorld& world) {
+    REQUIRE(soa_world.GetVerticalTransmissionAttemptCount().GetCount() == world.GetVerticalTransmissionAttemptCount().GetCount());
+    REQUIRE(soa_world.GetVerticalTransmissionSuccessCount().GetCount() == world.GetVerticalTransmissionSuccessCount().GetCount());
+    REQUIRE(soa_world.GetHorizontalTransmissionAttemptCount().GetCount() == world.GetHorizontalTransmissionAttemptCount().GetCount());
+    REQUIRE(soa_world.GetHorizontalTransmissionSizeFailCount().GetCount() == world.GetHorizontalTransmissionSizeFailCount().GetCount());
+    REQUIRE(soa_world.GetHorizontalTransmissionSuccessCount().GetCount() == world.GetHorizontalTransmissionSuccessCount().GetCount());
+    REQUIRE(soa_world.GetHorizontalTransmissionSuccessCount().GetTotal() == world.GetHorizontalTransmissionSuccessCount().GetTotal());
+  }
+
+  // Update identically seeded worlds, one through an SoAPopulation, and check
+  // that they match after every update
+  void RequireSoAMatchesWorld(SymConfigBase& config, int seed, size_t num_updates) {
+    REQUIRE(SoAPopulation::SupportsConfig(config));
+
+    emp::Random random(seed);
+    SymWorld world(random, &config);
+    world.Setup();
+
+    emp::Random soa_random(seed);
+    SymWorld soa_world(soa_random, &config);
+    soa_world.Setup();
+    SoAPopulation soa_pop(soa_world);
+    soa_pop.LoadFromWorld();
+    RequireSamePopulation(soa_pop, world);
+
+    for (size_t update = 0; update < num_updates; ++update) {
+      world.Update();
+      soa_pop.Update();
+      REQUIRE(soa_world.GetUpdate() == world.GetUpdate());
+      RequireSamePopulation(soa_pop, world);
+      RequireSameTransmissions(soa_world, world);
+    }
+    REQUIRE(soa_random.GetUInt(1000000) == random.GetUInt(1000000));
+  }
+}
+
+TEST_CASE("SoAPopulation update matches SymWorld update", "[default]") {
+  SymConfigBase config;
+  SetSoATestConfig(config);
+
+  WHEN("Symbionts transmit vertically and horizontally on a grid") {
+    RequireSoAMatchesWorld(config, 31, 30);
+  }
+
+  WHEN("The world is well-mixed and only occupied positions are scheduled") {
+    test_utils::SetWellMixed(config, 80, 40);
+    config.SCHEDULE_MODE("occupied");
+    RequireSoAMatchesWorld(config, 32, 30);
+  }
+
+  WHEN("Positions are scheduled in blocks, and hosts mutate at their own rate") {
+    config.SCHEDULE_MODE("blocked-random");
+    config.SCHEDULE_BLOCK_SIZE(8);
+    config.HOST_MUTATION_RATE(0.5);
+    config.HOST_MUTATION_SIZE(0.1);
+    RequireSoAMatchesWorld(config, 33, 30);
+  }
+
+  WHEN("Phage exclusion, free horizontal transmission failure, random infection chances and within-lifetime mutation are on") {
+    config.PHAGE_EXCLUDE(1);
+    config.FREE_HT_FAILURE(1);
+    config.SYM_INFECTION_CHANCE(-2);
+    config.SYM_WITHIN_LIFETIME_MUTATION_RATE(0.1);
+    RequireSoAMatchesWorld(config, 34, 30);
+  }
+
+  WHEN("Resources are unlimited and nobody dies of old age") {
+    config.LIMITED_RES_TOTAL(-1);
+    config.HOST_AGE_MAX(-1);
+    config.SYM_AGE_MAX(-1);
+    config.VERTICAL_TRANSMISSION(1);
+    RequireSoAMatchesWorld(config, 35, 20);
+  }
+}
+
+TEST_CASE("SoAPopulation stores its population back into the world", "[default]") {
+  SymConfigBase config;
+  SetSoATestConfig(config);
+  config.SYM_INFECTION_CHANCE(-2);
+  emp::Random random(36);
+  SymWorld world(random, &config);
+  world.Setup();
+  SoAPopulation soa_pop(world);
+  soa_pop.LoadFromWorld();
+  for (size_t update = 0; update < 10; ++update) soa_pop.Update();
+
+  const std::string random_state = checkpoint::SaveRandomState(random);
+  soa_pop.StoreToWorld();
+
+  THEN("The world holds the same hosts and symbionts, and its random number generator is untouched") {
+    RequireSamePopulation(soa_pop, world);
+    REQUIRE(checkpoint::SaveRandomState(random) == random_state);
+  }
+  THEN("The population loads back unchanged") {
+    SoAPopulation reloaded_pop(world);
+    reloaded_pop.LoadFromWorld();
+    RequireSamePopulation(reloaded_pop, world);
+    REQUIRE(reloaded_pop.GetNumSyms() == soa_pop.GetNumSyms());
+  }
+}
+
+TEST_CASE("RunExperiment with POPULATION_STORE soa writes the same output", "[default]") {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::string file_path = (dir / "SoAPopulation_test_").string();
+  const emp::vector<std::string> data_files = {"HostVals", "SymVals", "TransmissionRates", "SymDiversity", "ReproHist"};
+  auto run_experiment = [&](const std::string& population_store) {
+    SymConfigBase config;
+    SetSoATestConfig(config);
+    config.POPULATION_STORE(population_store);
+    config.SEED(37);
+    config.FILE_PATH(file_path);
+    config.FILE_NAME("_" + population_store);
+    config.DATA_INT(5);
+    config.UPDATES(40);
+    config.NO_MUT_UPDATES(10);
+    config.CURE(1);
+    config.CURE_UPDATES(30);
+    config.CHECKPOINT_INTERVAL(15);
+    config.CHECKPOINT_PATH(file_path + population_store + ".ckpt");
+    emp::Random random(config.SEED());
+    SymWorld world(random, &config);
+    world.Setup();
+    world.CreateDataFiles();
+    world.RunExperiment(false);
+    world.WriteOrgDumpFile(file_path + "OrgDump_" + population_store + ".data");
+    REQUIRE(world.FlushOutput());
+  };
+  run_experiment("objects");
+  run_experiment("soa");
+
+  THEN("Data files, org dumps and checkpoints are identical") {
+    emp::vector<std::pair<std::string, std::string>> paths = {
+      {file_path + "OrgDump_objects.data", file_path + "OrgDump_soa.data"},
+      {file_path + "objects.ckpt", file_path + "soa.ckpt"}
+    };
+    for (const std::string& data_file : data_files) {
+      paths.emplace_back(file_path + data_file + "_objects_SEED37.data", file_path + data_file + "_soa_SEED37.data");
+    }
+    for (const auto& [path, soa_path] : paths) {
+      REQUIRE(!test_utils::ReadFile(path).empty());
+      REQUIRE(test_utils::ReadFile(soa_path) == test_utils::ReadFile(path));
+      std::remove(path.c_str());
+      std::remove(soa_path.c_str());
+    }
+  }
+}
+
+TEST_CASE("SoAPopulation rejects configurations that need organism objects", "[default]") {
+  SymConfigBase config;
+  REQUIRE(SoAPopulation::SupportsConfig(config));
+  config.PHYLOGENY(1);
+  REQUIRE(!SoAPopulation::SupportsConfig(config));
+  config.PHYLOGENY(0);
+  config.TAG_MATCHING(1);
+  REQUIRE(!SoAPopulation::SupportsConfig(config));
+  config.TAG_MATCHING(0);
+  config.FREE_LIVING_SYMS(1);
+  REQUIRE(!SoAPopulation::SupportsConfig(config));
+  config.FREE_LIVING_SYMS(0);
+  config.ECTOSYMBIOSIS(1);
+  REQUIRE(!SoAPopulation::SupportsConfig(config));
+  config.ECTOSYMBIOSIS(0);
+  config.OUSTING(1);
+  REQUIRE(!SoAPopulation::SupportsConfig(config));
+}
@@ -6,6 +6,7 @@
 #include "emp/base/vector.hpp"
 #include "emp/math/Random.hpp"
 
+#include <cstdio>
 #include <iostream>
 
 TEST_CASE("Can define spatial structure from a connection mapping", "[spatial-structure],[default]") {
@@ -171,7 +172,7 @@ TEST_CASE("Can get a random neighbor", "[spatial-structure],[default]") {
 
   for (size_t i = 0; i < 100; ++i) {
     const size_t neighbor = structure.GetRandomNeighbor(rnd, 0).value();
-    REQUIRE(emp::Has(structure.GetNeighbors(0), neighbor));
+    REQUIRE(emp::Has(structure.GetNeighborList(0), neighbor));
   }
 
   auto result = structure.GetRandomNeighbor(rnd, 1);
@@ -190,11 +191,11 @@ TEST_CASE("Can read structure from csv that lists edges", "[spatial-structure],[
   structure.LoadStructureFromEdgeCSV(csv_path);
   // structure.Print(std::cout);
   REQUIRE(structure.GetNumPositions() == 5);
-  REQUIRE(structure.GetNeighbors(0) == emp::vector<size_t>{1, 2, 3});
-  REQUIRE(structure.GetNeighbors(1) == emp::vector<size_t>{0, 2});
-  REQUIRE(structure.GetNeighbors(2) == emp::vector<size_t>{0});
-  REQUIRE(structure.GetNeighbors(3) == emp::vector<size_t>{});
-  REQUIRE(structure.GetNeighbors(4) == emp::vector<size_t>{});
+  REQUIRE(structure.GetNeighborList(0) == emp::vector<size_t>{1, 2, 3});
+  REQUIRE(structure.GetNeighborList(1) == emp::vector<size_t>{0, 2});
+  REQUIRE(structure.GetNeighborList(2) == emp::vector<size_t>{0});
+  REQUIRE(structure.GetNeighborList(3) == emp::vector<size_t>{});
+  REQUIRE(structure.GetNeighborList(4) == emp::vector<size_t>{});
 
 }
 
@@ -207,40 +208,40 @@ TEST_CASE("Can read structure from matrix file", "[spatial-structure],[default]"
   // structure.Print(std::cout);
   // structure.Print(std::cout, false);
   REQUIRE(structure.GetNumPositions() == 5);
-  REQUIRE(structure.GetNeighbors(0) == emp::vector<size_t>{1, 2, 3});
-  REQUIRE(structure.GetNeighbors(1) == emp::vector<size_t>{0, 2});
-  REQUIRE(structure.GetNeighbors(2) == emp::vector<size_t>{0});
-  REQUIRE(structure.GetNeighbors(3) == emp::vector<size_t>{});
-  REQUIRE(structure.GetNeighbors(4) == emp::vector<size_t>{});
+  REQUIRE(structure.GetNeighborList(0) == emp::vector<size_t>{1, 2, 3});
+  REQUIRE(structure.GetNeighborList(1) == emp::vector<size_t>{0, 2});
+  REQUIRE(structure.GetNeighborList(2) == emp::vector<size_t>{0});
+  REQUIRE(structure.GetNeighborList(3) == emp::vector<size_t>{});
+  REQUIRE(structure.GetNeighborList(4) == emp::vector<size_t>{});
 
 }
 
 TEST_CASE("Can configure toroidal grid structure", "[spatial-structure],[default]") {
   SpatialStructure structure;
   ConfigureToroidalGrid(structure, 2, 2);
-  REQUIRE(structure.GetNeighbors(0) == emp::vector<size_t>{1, 2});
-  REQUIRE(structure.GetNeighbors(1) == emp::vector<size_t>{0, 3});
-  REQUIRE(structure.GetNeighbors(2) == emp::vector<size_t>{0, 3});
-  REQUIRE(structure.GetNeighbors(3) == emp::vector<size_t>{1, 2});
+  REQUIRE(structure.GetNeighborList(0) == emp::vector<size_t>{1, 2});
+  REQUIRE(structure.GetNeighborList(1) == emp::vector<size_t>{0, 3});
+  REQUIRE(structure.GetNeighborList(2) == emp::vector<size_t>{0, 3});
+  REQUIRE(structure.GetNeighborList(3) == emp::vector<size_t>{1, 2});
 
   ConfigureToroidalGrid(structure, 3, 3);
   // structure.Print(std::cout);
-  REQUIRE(structure.GetNeighbors(0) == emp::vector<size_t>{1, 2, 3, 6});
-  REQUIRE(structure.GetNeighbors(1) == emp::vector<size_t>{0, 2, 4, 7});
-  REQUIRE(structure.GetNeighbors(2) == emp::vector<size_t>{0, 1, 5, 8});
-  REQUIRE(structure.GetNeighbors(3) == emp::vector<size_t>{0, 4, 5, 6});
-  REQUIRE(structure.GetNeighbors(4) == emp::vector<size_t>{1, 3, 5, 7});
-  REQUIRE(structure.GetNeighbors(5) == emp::vector<size_t>{2, 3, 4, 8});
-  REQUIRE(structure.GetNeighbors(6) == emp::vector<size_t>{0, 3, 7, 8});
-  REQUIRE(structure.GetNeighbors(7) == emp::vector<size_t>{1, 4, 6, 8});
-  REQUIRE(structure.GetNeighbors(8) == emp::vector<size_t>{2, 5, 6, 7});
+  REQUIRE(structure.GetNeighborList(0) == emp::vector<size_t>{1, 2, 3, 6});
+  REQUIRE(structure.GetNeighborList(1) == emp::vector<size_t>{0, 2, 4, 7});
+  REQUIRE(structure.GetNeighborList(2) == emp::vector<size_t>{0, 1, 5, 8});
+  REQUIRE(structure.GetNeighborList(3) == emp::vector<size_t>{0, 4, 5, 6});
+  REQUIRE(structure.GetNeighborList(4) == emp::vector<size_t>{1, 3, 5, 7});
+  REQUIRE(structure.GetNeighborList(5) == emp::vector<size_t>{2, 3, 4, 8});
+  REQUIRE(structure.GetNeighborList(6) == emp::vector<size_t>{0, 3, 7, 8});
+  REQUIRE(structure.GetNeighborList(7) == emp::vector<size_t>{1, 4, 6, 8});
+  REQUIRE(structure.GetNeighborList(8) == emp::vector<size_t>{2, 5, 6, 7});
 
   ConfigureToroidalGrid(structure, 4, 3);
-  REQUIRE(structure.GetNeighbors(11) == emp::vector<size_t>{3, 7, 8, 10});
+  REQUIRE(structure.GetNeighborList(11) == emp::vector<size_t>{3, 7, 8, 10});
   // structure.Print(std::cout);
 
   ConfigureToroidalGrid(structure, 3, 4);
-  REQUIRE(structure.GetNeighbors(11) == emp::vector<size_t>{2, 8, 9, 10});
+  REQUIRE(structure.GetNeighborList(11) == emp::vector<size_t>{2, 8, 9, 10});
   // structure.Print(std::cout);
 }
 
@@ -249,22 +250,79 @@ TEST_CASE("Can configure fully connected structure", "[spatial-structure],[defau
 
   ConfigureFullyConnected(structure, 1);
   REQUIRE(structure.GetNumPositions() == 1);
-  REQUIRE(structure.GetNeighbors(0) == emp::vector<size_t>{});
+  REQUIRE(structure.GetNeighborList(0) == emp::vector<size_t>{});
 
   ConfigureFullyConnected(structure, 2);
   REQUIRE(structure.GetNumPositions() == 2);
-  REQUIRE(structure.GetNeighbors(0) == emp::vector<size_t>{1});
-  REQUIRE(structure.GetNeighbors(1) == emp::vector<size_t>{0});
+  REQUIRE(structure.GetNeighborList(0) == emp::vector<size_t>{1});
+  REQUIRE(structure.GetNeighborList(1) == emp::vector<size_t>{0});
 
   ConfigureFullyConnected(structure, 4);
   REQUIRE(structure.GetNumPositions() == 4);
-  REQUIRE(structure.GetNeighbors(0) == emp::vector<size_t>{1, 2, 3});
-  REQUIRE(structure.GetNeighbors(1) == emp::vector<size_t>{0, 2, 3});
-  REQUIRE(structure.GetNeighbors(2) == emp::vector<size_t>{0, 1, 3});
-  REQUIRE(structure.GetNeighbors(3) == emp::vector<size_t>{0, 1, 2});
+  REQUIRE(structure.GetNeighborList(0) == emp::vector<size_t>{1, 2, 3});
+  REQUIRE(structure.GetNeighborList(1) == emp::vector<size_t>{0, 2, 3});
+  REQUIRE(structure.GetNeighborList(2) == emp::vector<size_t>{0, 1, 3});
+  REQUIRE(structure.GetNeighborList(3) == emp::vector<size_t>{0, 1, 2});
 }
 
+TEST_CASE("Spatial structure can be saved to and loaded from a binary file", "[spatial-structure],[default]") {
+  const std::string csv_path = "source/test/data/spatial-structure-edges.csv";
+  const std::string bin_path = "spatial-structure-test.bin";
 
+  SpatialStructure structure;
+  structure.LoadStructureFromEdgeCSV(csv_path);
+  REQUIRE(structure.GetNumConnections() == 6);
+  REQUIRE(structure.SaveStructureToBinary(bin_path));
+
+  SpatialStructure loaded;
+  REQUIRE(loaded.LoadStructureFromBinary(bin_path));
+  REQUIRE(loaded.GetNumPositions() == 5);
+  REQUIRE(loaded.GetNumConnections() == 6);
+  for (size_t pos = 0; pos < structure.GetNumPositions(); ++pos) {
+    REQUIRE(loaded.GetNeighborList(pos) == structure.GetNeighborList(pos));
+  }
+  REQUIRE(loaded.GetConnectionMatrix() == structure.GetConnectionMatrix());
+
+  WHEN("the edge csv is loaded with a cache file that exists") {
+    SpatialStructure cached;
+    cached.LoadStructureFromEdgeCSV("does-not-exist.csv", bin_path);
+    THEN("the structure is loaded from the cache") {
+      REQUIRE(cached.GetNumPositions() == 5);
+      REQUIRE(cached.GetNeighborList(0) == emp::vector<size_t>{1, 2, 3});
+    }
+  }
 
+  WHEN("the file is not a binary structure file") {
+    SpatialStructure bad;
+    ConfigureFullyConnected(bad, 2);
+    THEN("loading fails and leaves the structure unchanged") {
+      REQUIRE(!bad.LoadStructureFromBinary(csv_path));
+      REQUIRE(bad.GetNumPositions() == 2);
+      REQUIRE(bad.IsConnected(0, 1));
+    }
+  }
 
+  std::remove(bin_path.c_str());
+}
 
+TEST_CASE("Connecting and disconnecting keeps other positions' neighbors intact", "[spatial-structure],[default]") {
+  SpatialStructure structure;
+  ConfigureToroidalGrid(structure, 3, 3);
+  REQUIRE(structure.GetNumConnections() == 36);
+
+  structure.Connect(0, 4);
+  REQUIRE(structure.IsConnected(0, 4));
+  REQUIRE(structure.GetNeighborList(0) == emp::vector<size_t>{1, 2, 3, 4, 6});
+  REQUIRE(structure.GetNeighborList(1) == emp::vector<size_t>{0, 2, 4, 7});
+  REQUIRE(structure.GetNeighborList(8) == emp::vector<size_t>{2, 5, 6, 7});
+  REQUIRE(structure.GetNumConnections() == 37);
+
+  structure.DisconnectBidirectional(4, 1);
+  REQUIRE(!structure.IsConnected(4, 1));
+  REQUIRE(!structure.IsConnected(1, 4));
+  REQUIRE(structure.GetNeighborList(0) == emp::vector<size_t>{1, 2, 3, 4, 6});
+  REQUIRE(structure.GetNeighborList(1) == emp::vector<size_t>{0, 2, 7});
+  REQUIRE(structure.GetNeighborList(4) == emp::vector<size_t>{3, 5, 7});
+  REQUIRE(structure.GetNeighborList(8) == emp::vector<size_t>{2, 5, 6, 7});
+  REQUIRE(structure.GetNumConnections() == 35);
+}
@@ -4,6 +4,11 @@
 
 #include "../test_utils.h"
 
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+
 TEST_CASE("Tag matching", "[default]") {
   using sym_world_t = test_utils::TestingWorldWrapper<SymWorld>;
   int trans_res = 10;
@@ -1030,4 +1035,103 @@ TEST_CASE("Partner to-from tag evolution tracking", "[default]") {
 
   if (!host->HasSym()) symbiont.Delete();
   host.Delete();
-}
\ No newline at end of file
+}
+
+TEST_CASE("Tag distance engine matches the tag metrics", "[default]") {
+  using tag_t = emp::BitSet<TAG_LENGTH>;
+  using engine_t = tag_utils::TagDistanceEngine<TAG_LENGTH>;
+  emp::Random random(19);
+
+  tag_utils::TagBatch<TAG_LENGTH> batch;
+  for (size_t i = 0; i < 20; i++) batch.Add(tag_t(random, 0.5));
+  tag_t query(random, 0.5);
+
+  emp::HammingMetric<TAG_LENGTH> hamming;
+  emp::StreakMetric<TAG_LENGTH> streak;
+  emp::HashMetric<TAG_LENGTH> hash;
+  emp::UnifMod<emp::HammingMetric<TAG_LENGTH>> unif_hamming;
+  emp::vector<std::pair<const emp::BaseMetric<tag_t, tag_t>*, engine_t::KERNEL>> metrics = {
+    {&hamming, engine_t::KERNEL::HAMMING},
+    {&streak, engine_t::KERNEL::STREAK},
+    {&hash, engine_t::KERNEL::HASH},
+    {&unif_hamming, engine_t::KERNEL::VIRTUAL}
+  };
+
+  for (auto [metric, kernel] : metrics) {
+    engine_t engine(emp::Ptr<const emp::BaseMetric<tag_t, tag_t>>(metric));
+    REQUIRE(engine.GetKernel() == kernel);
+
+    emp::vector<double> from;
+    emp::vector<double> to;
+    engine.DistancesFrom(query, batch, from);
+    engine.DistancesTo(batch, query, to);
+    REQUIRE(from.size() == batch.size());
+    REQUIRE(to.size() == batch.size());
+    for (size_t i = 0; i < batch.size(); i++) {
+      REQUIRE(engine.Distance(query, batch.GetTag(i)) == (*metric)(query, batch.GetTag(i)));
+      REQUIRE(from[i] == (*metric)(query, batch.GetTag(i)));
+      REQUIRE(to[i] == (*metric)(batch.GetTag(i), query));
+    }
+  }
+}
+
+TEST_CASE("WriteTagMatrixFile", "[default]") {
+  emp::Random random(20);
+  SymConfigBase config;
+  test_utils::SetWellMixed(config, 30, 30);
+  config.SYM_LIMIT(1);
+  config.TAG_MATCHING(1);
+  config.HOST_STARTING_TAGS_ONE_PROB(0.5);
+  config.TAG_MATRIX_SAMPLE_PROPORTION(1);
+  SymWorld world(random, &config);
+  world.Setup();
+
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  auto write_matrix = [&](const std::string& format, size_t num_threads) {
+    const std::filesystem::path path = dir / ("TagMatching_test_" + format + emp::to_string(num_threads));
+    config.TAG_MATRIX_FORMAT(format);
+    config.TAG_MATRIX_NUM_THREADS(num_threads);
+    random.ResetSeed(5); // Same sampled order every time
+    world.WriteTagMatrixFile(path.string());
+    const std::string contents = test_utils::ReadFile(path.string());
+    std::remove(path.string().c_str());
+    return contents;
+  };
+
+  WHEN("The matrix is written with different numbers of threads") {
+    THEN("The files are identical") {
+      REQUIRE(write_matrix("csv", 1) == write_matrix("csv", 4));
+      REQUIRE(write_matrix("binary", 1) == write_matrix("binary", 3));
+    }
+  }
+
+  WHEN("The matrix is written in binary") {
+    std::istringstream in(write_matrix("binary", 2));
+    tag_utils::TagMatrix matrix;
+    REQUIRE(tag_utils::ReadTagMatrix(in, matrix));
+
+    THEN("Every host is compared to every symbiont") {
+      REQUIRE(matrix.row_ids.size() == world.GetNumOrgs());
+      REQUIRE(matrix.col_ids.size() == world.GetNumOrgs());
+      for (size_t row = 0; row < matrix.row_ids.size(); row++) {
+        for (size_t col = 0; col < matrix.col_ids.size(); col++) {
+          const double distance = world.CalcTagMetric(
+            world.GetOrg(matrix.row_ids[row]).GetTag(),
+            world.GetOrg(matrix.col_ids[col]).GetSymbiont(0).GetTag()
+          );
+          REQUIRE(matrix.Get(row, col) == (float)distance);
+        }
+      }
+    }
+
+    THEN("Files whose header claims more values than they hold are rejected") {
+      std::string bytes = write_matrix("binary", 1);
+      const uint64_t num_rows = uint64_t(1) << 40;
+      std::memcpy(bytes.data() + sizeof(tag_utils::TAG_MATRIX_MAGIC) + sizeof(tag_utils::TAG_MATRIX_FORMAT_VERSION), &num_rows, sizeof(num_rows));
+      std::istringstream oversized(bytes);
+      REQUIRE(!tag_utils::ReadTagMatrix(oversized, matrix));
+      std::istringstream truncated(write_matrix("binary", 1).substr(0, bytes.size() - 1));
+      REQUIRE(!tag_utils::ReadTagMatrix(truncated, matrix));
+    }
+  }
+}
@@ -0,0 +1,114 @@
+#include "../../catch/catch.hpp"
+
+#include "../test_utils.h"
+#include "../../default_mode/SymWorld.h"
+#include "../../default_mode/Host.h"
+#include "../../default_mode/Symbiont.h"
+#include "../../default_mode/WorldSetup.cc"
+#include "../../default_mode/UpdateSchedule.h"
+
+#include <algorithm>
+
+TEST_CASE("UpdateSchedule builds schedules for each mode", "[default]") {
+  emp::Random random(23);
+  const size_t num_positions = 50;
+  UpdateSchedule schedule;
+  OccupancyIndex occupied;
+  for (size_t pos : {3, 18, 40}) occupied.Set(pos, true);
+
+  WHEN("The mode is random") {
+    emp::vector<size_t> order = schedule.Build(random, num_positions);
+    THEN("Every position is scheduled once") {
+      std::sort(order.begin(), order.end());
+      for (size_t pos = 0; pos < num_positions; pos++) REQUIRE(order[pos] == pos);
+    }
+  }
+
+  WHEN("The mode is occupied") {
+    schedule.SetMode(UpdateSchedule::MODE::OCCUPIED);
+    emp::vector<size_t> order = schedule.Build(random, num_positions, &occupied);
+    THEN("Only occupied positions are scheduled") {
+      std::sort(order.begin(), order.end());
+      REQUIRE(order == emp::vector<size_t>{3, 18, 40});
+    }
+  }
+
+  WHEN("The mode is blocked-random") {
+    schedule.SetMode(UpdateSchedule::MODE::BLOCKED_RANDOM);
+    schedule.SetBlockSize(8);
+    const emp::vector<size_t> order = schedule.Build(random, num_positions);
+    THEN("Every position is scheduled once, with each block's positions together") {
+      REQUIRE(order.size() == num_positions);
+      emp::vector<size_t> first_index(7, num_positions);
+      emp::vector<size_t> last_index(7, 0);
+      for (size_t i = 0; i < num_positions; i++) {
+        const size_t block = order[i] / 8;
+        first_index[block] = std::min(first_index[block], i);
+        last_index[block] = std::max(last_index[block], i);
+      }
+      for (size_t block = 0; block < 7; block++) {
+        const size_t block_size = (block < 6) ? 8 : 2;
+        REQUIRE(last_index[block] - first_index[block] + 1 == block_size);
+      }
+      emp::vector<size_t> sorted = order;
+      std::sort(sorted.begin(), sorted.end());
+      for (size_t pos = 0; pos < num_positions; pos++) REQUIRE(sorted[pos] == pos);
+    }
+  }
+}
+
+TEST_CASE("SymWorld tracks occupied positions", "[default]") {
+  emp::Random random(24);
+  SymConfigBase config;
+  test_utils::SetWellMixed(config, 10);
+  config.FREE_LIVING_SYMS(1);
+  config.SCHEDULE_MODE("occupied");
+  SymWorld world(random, &config);
+  world.Setup();
+  REQUIRE(world.GetUpdateSchedule().GetMode() == UpdateSchedule::MODE::OCCUPIED);
+  const OccupancyIndex& occupied = world.GetOccupiedPositions();
+  const OccupancyIndex& hosts = world.GetHostPositions();
+  const OccupancyIndex& free_syms = world.GetFreeSymPositions();
+  REQUIRE(occupied.IsEmpty());
+
+  emp::Ptr<Host> host = emp::NewPtr<Host>(&random, &world, &config, 0);
+  emp::Ptr<Symbiont> sym = emp::NewPtr<Symbiont>(&random, &world, &config, 0);
+  world.AddOrgAt(host, emp::WorldPosition(2));
+  world.AddOrgAt(sym, emp::WorldPosition(0, 2));
+
+  THEN("A position stays occupied until both its host and free-living symbiont are gone") {
+    REQUIRE(occupied.GetCount() == 1);
+    REQUIRE(occupied.Has(2));
+    REQUIRE(hosts.Has(2));
+    REQUIRE(free_syms.Has(2));
+    world.DoDeath(emp::WorldPosition(2));
+    REQUIRE(occupied.Has(2));
+    REQUIRE(!hosts.Has(2));
+    world.DoSymDeath(2);
+    REQUIRE(occupied.IsEmpty());
+    REQUIRE(free_syms.IsEmpty());
+  }
+
+  WHEN("A free-living symbiont is extracted") {
+    emp::Ptr<Organism> extracted = world.ExtractSym(2);
+    THEN("Only its host's position is left") {
+      REQUIRE(free_syms.IsEmpty());
+      REQUIRE(occupied.Has(2));
+      REQUIRE(hosts.Has(2));
+    }
+    extracted.Delete();
+  }
+
+  WHEN("A random host is chosen") {
+    THEN("It is the only host") {
+      REQUIRE(world.GetRandomOrgID() == 2);
+    }
+  }
+
+  WHEN("The world updates") {
+    world.Update();
+    THEN("Only occupied positions were scheduled") {
+      REQUIRE(world.GetUpdateSchedule().GetOrder() == emp::vector<size_t>{2});
+    }
+  }
+}
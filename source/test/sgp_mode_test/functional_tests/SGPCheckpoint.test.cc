@@ -0,0 +1,134 @@
+#include "../../test_utils.h"
+
+#include "../../../default_mode/SymWorld.h"
+#include "../../../default_mode/WorldSetup.cc"
+#include "../../../default_mode/DataNodes.h"
+#include "../../../sgp_mode/SGPWorld.h"
+#include "../../../sgp_mode/SGPWorld.cc"
+#include "../../../sgp_mode/SGPWorldSetup.cc"
+#include "../../../sgp_mode/SGPWorldData.cc"
+#include "../../../sgp_mode/SGPW_InteractionMechanismSetup.cc"
+#include "../../../sgp_mode/SGPW_TaskProfileSetup.cc"
+
+#include "../../../catch/catch.hpp"
+
+#include <cstdio>
+
+/**
+ * This file is dedicated to checkpointing and resuming SGP worlds
+ */
+
+namespace {
+  using sgp_checkpoint_world_t = sgpmode::SGPWorld;
+  using sgp_checkpoint_hw_spec_t = sgpmode::SGPHardwareSpec<sgpmode::Library, sgpmode::CPUState<sgp_checkpoint_world_t>, sgp_checkpoint_world_t>;
+  using sgp_checkpoint_host_t = sgpmode::SGPHost<sgp_checkpoint_hw_spec_t>;
+  using sgp_checkpoint_sym_t = sgpmode::SGPSymbiont<sgp_checkpoint_hw_spec_t>;
+
+  // Hosts and symbionts reproduce, symbionts live freely, and the task values
+  // flip every few updates
+  void SetSGPCheckpointTestConfig(sgpmode::SymConfigSGP& config) {
+    config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+    test_utils::SetWellMixed(config, 100, 50);
+    config.START_MOI(1);
+    config.FREE_LIVING_SYMS(1);
+    config.TASK_IO_BANK_SIZE(10);
+    config.CYCLES_PER_UPDATE(30);
+    config.ENABLE_TEMP_CHANGING_ENVIRONMENT(1);
+    config.TEMP_CHANGING_ENVIRONMENT_INTERVAL(3);
+  }
+
+  void RequireSameSGPWorld(sgp_checkpoint_world_t& resumed_world, sgp_checkpoint_world_t& world) {
+    REQUIRE(resumed_world.GetUpdate() == world.GetUpdate());
+    REQUIRE(resumed_world.GetNumOrgs() == world.GetNumOrgs());
+    for (size_t i = 0; i < world.GetSize(); i++) {
+      REQUIRE(resumed_world.IsOccupied(i) == world.IsOccupied(i));
+      if (!world.IsOccupied(i)) continue;
+      auto& host = static_cast<sgp_checkpoint_host_t&>(world.GetOrg(i));
+      auto& resumed_host = static_cast<sgp_checkpoint_host_t&>(resumed_world.GetOrg(i));
+      REQUIRE(resumed_host.GetPoints() == host.GetPoints());
+      REQUIRE(resumed_host.GetReproCount() == host.GetReproCount());
+      REQUIRE(resumed_host.GetHardware().SerializeProgram() == host.GetHardware().SerializeProgram());
+      REQUIRE(resumed_host.GetSymbionts().size() == host.GetSymbionts().size());
+      for (size_t sym_i = 0; sym_i < host.GetSymbionts().size(); sym_i++) {
+        auto& sym = static_cast<sgp_checkpoint_sym_t&>(*host.GetSymbionts()[sym_i]);
+        auto& resumed_sym = static_cast<sgp_checkpoint_sym_t&>(*resumed_host.GetSymbionts()[sym_i]);
+        REQUIRE(resumed_sym.GetPoints() == sym.GetPoints());
+        REQUIRE(resumed_sym.GetHardware().SerializeProgram() == sym.GetHardware().SerializeProgram());
+      }
+    }
+  }
+
+  // Checkpoint a world at update 5 and finish its run, then resume the
+  // checkpoint in a differently seeded world and check that it matches the
+  // original after every update. (The worlds can't be updated in turn: they
+  // share this thread's sgpl random number generator.)
+  void RequireSGPResumeMatches(sgpmode::SymConfigSGP& config, const std::string& checkpoint_path) {
+    emp::Random random(83);
+    sgp_checkpoint_world_t world(random, &config);
+    world.Setup();
+    for (size_t i = 0; i < 5; i++) world.Update();
+    REQUIRE(world.SaveCheckpoint(checkpoint_path));
+    // Full world states (including every CPU and generator) after each update
+    emp::vector<std::string> world_states;
+    for (size_t i = 0; i < 10; i++) {
+      world.Update();
+      world_states.push_back(world.CaptureCheckpoint());
+    }
+
+    emp::Random resumed_random(84);
+    sgp_checkpoint_world_t resumed_world(resumed_random, &config);
+    resumed_world.Setup();
+    REQUIRE(resumed_world.LoadCheckpoint(checkpoint_path));
+    REQUIRE(resumed_world.GetUpdate() == 5);
+    for (const std::string& world_state : world_states) {
+      resumed_world.Update();
+      REQUIRE(resumed_world.CaptureCheckpoint() == world_state);
+    }
+    RequireSameSGPWorld(resumed_world, world);
+    std::remove(checkpoint_path.c_str());
+  }
+}
+
+TEST_CASE("A resumed SGP world matches an uninterrupted one", "[sgp][sgp-functional]") {
+  sgpmode::SymConfigSGP config;
+  SetSGPCheckpointTestConfig(config);
+
+  WHEN("Organisms are processed on one thread") {
+    RequireSGPResumeMatches(config, "sgpworld-checkpoint-test.ckpt");
+  }
+
+  WHEN("Organisms are processed on several threads") {
+    config.NUM_THREADS(2);
+    RequireSGPResumeMatches(config, "sgpworld-checkpoint-threads-test.ckpt");
+  }
+
+  WHEN("The world tracks a phylogeny") {
+    config.PHYLOGENY(1);
+    RequireSGPResumeMatches(config, "sgpworld-checkpoint-phylogeny-test.ckpt");
+  }
+}
+
+TEST_CASE("SGP checkpoints don't load into worlds with a different thread count", "[sgp][sgp-functional]") {
+  const std::string checkpoint_path = "sgpworld-checkpoint-thread-mismatch-test.ckpt";
+  sgpmode::SymConfigSGP config;
+  SetSGPCheckpointTestConfig(config);
+  config.NUM_THREADS(2);
+  emp::Random random(83);
+  sgp_checkpoint_world_t world(random, &config);
+  world.Setup();
+  world.Update();
+  REQUIRE(world.SaveCheckpoint(checkpoint_path));
+
+  sgpmode::SymConfigSGP other_config;
+  SetSGPCheckpointTestConfig(other_config);
+  other_config.NUM_THREADS(3);
+  emp::Random other_random(84);
+  sgp_checkpoint_world_t other_world(other_random, &other_config);
+  other_world.Setup();
+  const size_t num_orgs = other_world.GetNumOrgs();
+
+  REQUIRE(!other_world.LoadCheckpoint(checkpoint_path));
+  REQUIRE(other_world.GetNumOrgs() == num_orgs);
+  REQUIRE(other_world.GetUpdate() == 0);
+  std::remove(checkpoint_path.c_str());
+}
@@ -70,6 +70,52 @@ TEST_CASE("Reproduction without points or mutations", "[sgp][sgp-functional]") {
   }
 }
 
+TEST_CASE("Batched CPU cycles match cycle-by-cycle execution", "[sgp]") {
+  GIVEN("Two identical worlds of reproducing hosts, one with a per-cycle listener attached") {
+    auto run_world = [](bool attach_cpu_step_listener) {
+      emp::Random random(65);
+      sgpmode::SymConfigSGP config;
+      test_utils::SetWellMixed(config, 100, 0);
+      config.TASK_IO_BANK_SIZE(10);
+      config.HOST_REPRO_RES(0);
+      config.CYCLES_PER_UPDATE(30);
+      config.SEED(62);
+      config.START_MOI(0);
+      config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+
+      world_t world(random, &config);
+      world.Setup();
+      size_t listener_calls = 0;
+      if (attach_cpu_step_listener) {
+        world.after_host_cpu_step_sig.AddAction([&listener_calls](sgp_host_t&) { ++listener_calls; });
+      }
+      auto& prog_builder = world.GetProgramBuilder();
+      world.AddOrgAt(emp::NewPtr<sgp_host_t>(&random, &world, &config, prog_builder.CreateReproProgram(10)), 0);
+      for (int i = 0; i < 20; i++) {
+        world.Update();
+      }
+
+      emp::vector<size_t> cycles_since_repro;
+      for (size_t i = 0; i < world.GetSize(); i++) {
+        if (!world.IsOccupied(i)) continue;
+        cycles_since_repro.push_back(
+          static_cast<sgp_host_t&>(world.GetOrg(i)).GetHardware().GetCPUState().GetCPUCyclesSinceRepro()
+        );
+      }
+      if (attach_cpu_step_listener) REQUIRE(listener_calls > 0);
+      return std::make_pair(world.GetNumOrgs(), cycles_since_repro);
+    };
+
+    THEN("Both worlds end up with the same population") {
+      const auto batched = run_world(false);
+      const auto per_cycle = run_world(true);
+      REQUIRE(batched.first > 1);
+      REQUIRE(batched.first == per_cycle.first);
+      REQUIRE(batched.second == per_cycle.second);
+    }
+  }
+}
+
 TEST_CASE("Mutations occur during reproduction", "[sgp]") {
   GIVEN("A world with high mutation rate") {
     using world_t = sgpmode::SGPWorld;
@@ -587,7 +587,7 @@ TEST_CASE("SGPSymbiont Reproduce tracks lineage task information", "[sgp][sgp-fu
     // Mark repro in progress to check that reproduce function resets repro in progress
     // flag on parent.
 
-    size_t q_id = world.GetReproQueue().Enqueue(&sgp_sym, sgp_sym.GetLocation());
+    sgpmode::ReproductionQueue::event_id_t q_id = world.GetReproQueue().Enqueue(&sgp_sym, sgp_sym.GetLocation());
     sym_hw.GetCPUState().MarkReproInProgress(q_id);
     REQUIRE(sym_hw.GetCPUState().ReproInProgress());
 
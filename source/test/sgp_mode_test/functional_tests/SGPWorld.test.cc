@@ -128,4 +128,56 @@ TEST_CASE("A world containing a single free living symbiont is updated correctly
     REQUIRE(world.GetNumOrgs() == 1);
   }
 }
-*/
\ No newline at end of file
+*/
+
+TEST_CASE("Threaded world updates are reproducible for a given seed and thread count", "[sgp][sgp-functional]") {
+  // Run a world with the given number of threads, return a summary of the final population
+  auto run_world = [](size_t num_threads) {
+    emp::Random random(61);
+    sgpmode::SymConfigSGP config;
+    config.FREE_LIVING_SYMS(1);
+    config.START_MOI(1);
+    config.NUM_THREADS(num_threads);
+    test_utils::SetWellMixed(config, 64, 32);
+    config.TASK_IO_BANK_SIZE(10);
+    config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+
+    sgpmode::SGPWorld world(random, &config);
+    world.Setup();
+    for (size_t i = 0; i < 50; ++i) {
+      world.Update();
+    }
+
+    emp::vector<double> summary;
+    summary.emplace_back(world.GetNumOrgs());
+    for (size_t i = 0; i < world.GetSize(); ++i) {
+      if (!world.IsOccupied(i)) continue;
+      summary.emplace_back(i);
+      summary.emplace_back(world.GetOrg(i).GetPoints());
+      summary.emplace_back(world.GetOrg(i).GetSymbionts().size());
+    }
+    for (size_t i = 0; i < world.GetSize(); ++i) {
+      if (!world.IsSymPopOccupied(i)) continue;
+      summary.emplace_back(i);
+      summary.emplace_back(world.GetSymAt(i)->GetPoints());
+    }
+    return summary;
+  };
+
+  WHEN("Two worlds are run with the same seed and multiple threads") {
+    const emp::vector<double> run_a = run_world(4);
+    const emp::vector<double> run_b = run_world(4);
+    THEN("They end up in the same state") {
+      REQUIRE(run_a.size() > 1);
+      REQUIRE(run_a == run_b);
+    }
+  }
+
+  WHEN("Two worlds are run with the same seed and a single thread") {
+    const emp::vector<double> run_a = run_world(1);
+    const emp::vector<double> run_b = run_world(1);
+    THEN("They end up in the same state") {
+      REQUIRE(run_a == run_b);
+    }
+  }
+}
@@ -0,0 +1,140 @@
+#include "emp/math/Random.hpp"
+
+#include "../../../sgp_mode/hardware/JumpTableCache.h"
+#include "../../../sgp_mode/hardware/SGPHardware.h"
+#include "../../../sgp_mode/SGPWorld.h"
+#include "../../../sgp_mode/SGPWorld.cc"
+#include "../../../sgp_mode/SGPWorldSetup.cc"
+#include "../../../sgp_mode/SGPWorldData.cc"
+#include "../../../sgp_mode/ProgramBuilder.h"
+
+#include "../../../catch/catch.hpp"
+
+TEST_CASE("JumpTableCache hits, misses, and eviction", "[sgp][sgp-unit]") {
+  using program_t = typename sgpmode::SGPWorld::sgp_prog_t;
+  using cache_t = sgpmode::JumpTableCache<program_t>;
+  using shared_program_t = typename cache_t::shared_program_t;
+  using tag_t = typename sgpmode::SGPWorld::tag_t;
+
+  sgpmode::SymConfigSGP config;
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  emp::Random random(2);
+  sgpmode::SGPWorld world(random, &config);
+  auto& prog_builder = world.GetProgramBuilder();
+
+  program_t program_a;
+  prog_builder.AddInst(program_a, "Nop-0", 0);
+  program_t program_b = program_a;
+  prog_builder.AddInst(program_b, "Nop-0", 0);
+  program_t program_c = program_a;
+  prog_builder.AddInst(program_c, "Global Anchor", tag_t());
+
+  cache_t cache(2);
+  const shared_program_t shared_a(program_a);
+  REQUIRE(cache.Find(shared_a) == nullptr);
+  cache.Insert(shared_a, {1});
+  cache.Insert(shared_program_t(program_b), {2, 2});
+
+  WHEN("A program with the same contents is looked up") {
+    const shared_program_t copy_a(program_a);
+    REQUIRE(!copy_a.SharesWith(shared_a));
+    auto found = cache.Find(copy_a);
+    THEN("Its jump table is found") {
+      REQUIRE(found != nullptr);
+      REQUIRE(*found == emp::vector<size_t>{1});
+      REQUIRE(cache.GetNumHits() == 1);
+      REQUIRE(cache.GetNumMisses() == 1);
+    }
+  }
+
+  WHEN("A cached program is made mutable") {
+    shared_program_t owned(program_c);
+    cache.Insert(owned, {3});
+    const program_t* stored = &owned.Get();
+    THEN("The cache doesn't hold a share of it, so it isn't copied") {
+      REQUIRE(owned.GetShareCount() == 1);
+      REQUIRE(&owned.GetMutable() == stored);
+    }
+    THEN("Changing it in place leaves the cached contents alone") {
+      prog_builder.AddInst(owned.GetMutable(), "Nop-0", 0);
+      REQUIRE(cache.Find(owned) == nullptr);
+      REQUIRE(cache.Find(shared_program_t(program_c)) != nullptr);
+    }
+  }
+
+  WHEN("More programs are inserted than the cache holds") {
+    cache.Find(shared_a); // a is now more recently used than b
+    cache.Insert(shared_program_t(program_c), {3});
+    THEN("The least recently used program is evicted") {
+      REQUIRE(cache.GetSize() == 2);
+      REQUIRE(cache.Find(shared_a) != nullptr);
+      REQUIRE(cache.Find(shared_program_t(program_b)) == nullptr);
+      REQUIRE(cache.Find(shared_program_t(program_c)) != nullptr);
+    }
+  }
+
+  WHEN("The cache is disabled") {
+    cache.SetCapacity(0);
+    THEN("Nothing is cached or counted") {
+      REQUIRE(cache.GetSize() == 0);
+      REQUIRE(cache.Find(shared_a) == nullptr);
+      REQUIRE(cache.GetNumMisses() == 1);
+    }
+  }
+}
+
+TEST_CASE("Cached jump tables match freshly computed ones", "[sgp][sgp-unit]") {
+  using world_t = sgpmode::SGPWorld;
+  using cpu_state_t = sgpmode::CPUState<world_t>;
+  using hw_spec_t = sgpmode::SGPHardwareSpec<sgpmode::Library, cpu_state_t, world_t>;
+  using program_t = typename world_t::sgp_prog_t;
+  using sgp_host_t = sgpmode::SGPHost<hw_spec_t>;
+  using tag_t = typename hw_spec_t::tag_t;
+
+  sgpmode::SymConfigSGP config;
+  config.SEED(61);
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  config.FILE_PATH("hardware_test_output");
+  config.POP_SIZE(1);
+  config.START_MOI(0);
+  config.SGP_MUT_PER_BIT_RATE(0.0);
+
+  emp::Random random(config.SEED());
+  world_t world(random, &config);
+  world.Setup();
+  auto& prog_builder = world.GetProgramBuilder();
+
+  tag_t tag1("0000000000000000000000000000000000000000000000000000000000000001");
+  program_t program;
+  prog_builder.AddStartAnchor(program);
+  prog_builder.AddInst(program, "Nop-0", 0);
+  prog_builder.AddInst(program, "Global Anchor", tag1);
+  prog_builder.AddInst(program, "Nop-0", 0);
+  prog_builder.AddInst(program, "JumpIfNEq", 0, 1, 0, tag1);
+
+  world.GetJumpTableCache().ResetCounts();
+  emp::Ptr<sgp_host_t> host = emp::NewPtr<sgp_host_t>(&random, &world, &config, program);
+  const emp::vector<size_t> computed = host->GetHardware().GetCPUState().GetJumpTable();
+  REQUIRE(computed.size() == program.size());
+  REQUIRE(world.GetJumpTableCache().GetNumMisses() == 1);
+
+  WHEN("The host reproduces without mutation") {
+    emp::Ptr<Organism> offspring = host->Reproduce();
+    auto& offspring_hw = static_cast<sgp_host_t&>(*offspring).GetHardware();
+    THEN("The offspring's jump table comes from the cache and matches its parent's") {
+      REQUIRE(world.GetJumpTableCache().GetNumHits() >= 1);
+      REQUIRE(offspring_hw.GetCPUState().GetJumpTable() == computed);
+    }
+    offspring.Delete();
+  }
+
+  WHEN("The cache is disabled") {
+    world.GetJumpTableCache().SetCapacity(0);
+    host->GetHardware().Reset();
+    THEN("The jump table is recomputed the same way") {
+      REQUIRE(host->GetHardware().GetCPUState().GetJumpTable() == computed);
+    }
+  }
+
+  host.Delete();
+}
@@ -0,0 +1,68 @@
+#include "../../../sgp_mode/tasks/LogicTaskIOBank.h"
+#include "../../../catch/catch.hpp"
+
+#include "emp/math/Random.hpp"
+
+#include <algorithm>
+
+TEST_CASE("LogicTaskIOBank output lookup matches correct outputs", "[sgp]") {
+  emp::Random random(61);
+  sgpmode::tasks::LogicTaskSet task_set;
+  task_set.AddTasksByName({"NOT", "NAND", "AND", "OR_NOT", "OR", "AND_NOT", "NOR", "XOR", "EQU"});
+  sgpmode::tasks::LogicTaskIOBank io_bank(random, task_set);
+  // Allow collisions so that some outputs belong to several tasks
+  io_bank.GenerateBank(50, false);
+  REQUIRE(io_bank.GetSize() == 50);
+
+  for (size_t env_id = 0; env_id < io_bank.GetSize(); ++env_id) {
+    const auto& task_io = io_bank.GetIO(env_id);
+    // Valid outputs are sorted and distinct
+    REQUIRE(std::is_sorted(task_io.valid_outputs.begin(), task_io.valid_outputs.end()));
+    REQUIRE(std::adjacent_find(task_io.valid_outputs.begin(), task_io.valid_outputs.end()) == task_io.valid_outputs.end());
+    // Every correct output finds its task
+    for (size_t task_id = 0; task_id < task_set.GetSize(); ++task_id) {
+      for (const auto& io_set : task_io.correct_outputs[task_id]) {
+        REQUIRE(task_io.IsValidOutput(io_set.output));
+        const auto task_ids = task_io.FindTaskIDs(io_set.output);
+        REQUIRE(std::find(task_ids.begin(), task_ids.end(), task_id) != task_ids.end());
+      }
+    }
+    // Every looked-up task really has that output, and task ids are in order
+    for (uint32_t output : task_io.valid_outputs) {
+      const auto task_ids = task_io.GetTaskIDs(output);
+      REQUIRE(task_ids.size() > 0);
+      REQUIRE(std::is_sorted(task_ids.begin(), task_ids.end()));
+      for (size_t task_id : task_ids) {
+        const auto& io_sets = task_io.correct_outputs[task_id];
+        REQUIRE(std::any_of(io_sets.begin(), io_sets.end(), [output](const auto& io_set) { return io_set.output == output; }));
+      }
+    }
+  }
+
+  // Outputs that aren't correct find no tasks
+  const auto& task_io = io_bank.GetIO(0);
+  uint32_t invalid_output = 0;
+  while (task_io.IsValidOutput(invalid_output)) ++invalid_output;
+  REQUIRE(task_io.FindTaskIDs(invalid_output).empty());
+}
+
+TEST_CASE("Seeded LogicTaskIOBanks are generated deterministically", "[sgp]") {
+  emp::Random random(62);
+  sgpmode::tasks::LogicTaskSet task_set;
+  task_set.AddTasksByName({"NOT", "NAND", "AND", "OR_NOT", "OR", "AND_NOT", "NOR", "XOR", "EQU"});
+  sgpmode::tasks::LogicTaskIOBank serial_bank(random, task_set);
+  sgpmode::tasks::LogicTaskIOBank threaded_bank(random, task_set);
+  // More than one chunk, with a partial last chunk
+  const size_t bank_size = 2 * sgpmode::tasks::LogicTaskIOBank::GENERATE_CHUNK_SIZE + 10;
+  serial_bank.GenerateSeededBank(bank_size, 5, 1);
+  threaded_bank.GenerateSeededBank(bank_size, 5, 3);
+
+  THEN("The bank doesn't depend on the number of threads") {
+    REQUIRE(serial_bank.GetSize() == bank_size);
+    REQUIRE(threaded_bank.GetSize() == bank_size);
+    for (size_t env_id = 0; env_id < bank_size; ++env_id) {
+      REQUIRE(serial_bank.GetIO(env_id) == threaded_bank.GetIO(env_id));
+    }
+    REQUIRE(!(serial_bank.GetIO(0) == serial_bank.GetIO(sgpmode::tasks::LogicTaskIOBank::GENERATE_CHUNK_SIZE)));
+  }
+}
@@ -0,0 +1,105 @@
+#include "../../../sgp_mode/ReproductionQueue.h"
+
+#include "../../../catch/catch.hpp"
+
+#include <algorithm>
+
+/**
+ * This file is dedicated to unit tests for the SGP mode ReproductionQueue
+ */
+
+namespace {
+  // Minimal organism that can be queued for reproduction
+  struct QueueTestOrg : public Organism {
+    bool dead = false;
+    bool GetDead() const override { return dead; }
+  };
+}
+
+TEST_CASE("ReproductionQueue event ids and invalidation", "[sgp]") {
+  emp::Random random(61);
+  sgpmode::ReproductionQueue queue;
+  queue.SetNumSegments(2);
+  emp::vector<QueueTestOrg> orgs(4);
+
+  const auto id_0 = queue.Enqueue(&orgs[0], emp::WorldPosition(0), 0);
+  const auto id_1 = queue.Enqueue(&orgs[1], emp::WorldPosition(1), 1);
+  const auto id_2 = queue.Enqueue(&orgs[2], emp::WorldPosition(2), 1);
+  const auto id_3 = queue.Enqueue(&orgs[3], emp::WorldPosition(3), 0);
+
+  THEN("Event ids are unique and refer to the queued events") {
+    REQUIRE(queue.GetSize() == 4);
+    REQUIRE(queue.GetSegment(0).size() == 2);
+    REQUIRE(queue.GetSegment(1).size() == 2);
+    REQUIRE(queue.GetEvent(id_0).org == &orgs[0]);
+    REQUIRE(queue.GetEvent(id_1).org == &orgs[1]);
+    REQUIRE(queue.GetEvent(id_2).org == &orgs[2]);
+    REQUIRE(queue.GetEvent(id_3).org == &orgs[3]);
+    REQUIRE(queue.GetEvent(id_2).pos.GetIndex() == 2);
+  }
+
+  WHEN("Events are invalidated or organisms die") {
+    queue.Invalidate(id_1);
+    orgs[3].dead = true;
+    REQUIRE(!queue.IsValid(id_1));
+    REQUIRE(queue.IsValid(id_0));
+    REQUIRE(queue.IsValid(id_2));
+
+    emp::vector<Organism*> reproduced;
+    queue.Process(random, [&reproduced](const sgpmode::ReproEvent& repro_info) {
+      reproduced.emplace_back(repro_info.org.Raw());
+    });
+
+    THEN("Only valid events with living organisms are handled") {
+      REQUIRE(reproduced.size() == 2);
+      REQUIRE(std::count(reproduced.begin(), reproduced.end(), &orgs[0]) == 1);
+      REQUIRE(std::count(reproduced.begin(), reproduced.end(), &orgs[2]) == 1);
+    }
+    THEN("The queue is empty after processing") {
+      REQUIRE(queue.GetSize() == 0);
+    }
+  }
+}
+
+TEST_CASE("ReproductionQueue processing order", "[sgp]") {
+  emp::vector<QueueTestOrg> orgs(100);
+
+  // Queue orgs round-robin across segments, return processing order
+  auto get_order = [&orgs](size_t num_segments, int seed) {
+    emp::Random random(seed);
+    sgpmode::ReproductionQueue queue;
+    queue.SetNumSegments(num_segments);
+    for (size_t i = 0; i < orgs.size(); ++i) {
+      queue.Enqueue(&orgs[i], emp::WorldPosition(i), i % num_segments);
+    }
+    emp::vector<size_t> order;
+    queue.Process(random, [&order](const sgpmode::ReproEvent& repro_info) {
+      order.emplace_back(repro_info.pos.GetIndex());
+    });
+    return order;
+  };
+
+  WHEN("There is a single segment") {
+    const emp::vector<size_t> order = get_order(1, 2);
+    THEN("Events are processed in the order they were queued") {
+      REQUIRE(order.size() == orgs.size());
+      for (size_t i = 0; i < order.size(); ++i) {
+        REQUIRE(order[i] == i);
+      }
+    }
+  }
+
+  WHEN("There are multiple segments") {
+    const emp::vector<size_t> order_a = get_order(4, 2);
+    const emp::vector<size_t> order_b = get_order(4, 2);
+    THEN("Every event is processed once, in the same order for the same seed") {
+      REQUIRE(order_a.size() == orgs.size());
+      REQUIRE(order_a == order_b);
+      emp::vector<size_t> sorted_order(order_a);
+      std::sort(sorted_order.begin(), sorted_order.end());
+      for (size_t i = 0; i < sorted_order.size(); ++i) {
+        REQUIRE(sorted_order[i] == i);
+      }
+    }
+  }
+}
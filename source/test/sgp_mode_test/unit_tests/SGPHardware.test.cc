@@ -196,4 +196,58 @@ TEST_CASE("Test Printing Complex Instructions", "[sgp]"){
     }
   }
   
-}
\ No newline at end of file
+}
+
+TEST_CASE("Hardware reuses dead organisms' CPU buffers", "[sgp]") {
+  using world_t = sgpmode::SGPWorld;
+  using cpu_state_t = sgpmode::CPUState<world_t>;
+  using hw_spec_t = sgpmode::SGPHardwareSpec<sgpmode::Library, cpu_state_t, world_t>;
+  using hardware_t = sgpmode::SGPHardware<hw_spec_t>;
+  using program_t = typename world_t::sgp_prog_t;
+  using sgp_host_t = sgpmode::SGPHost<hw_spec_t>;
+
+  sgpmode::SymConfigSGP config;
+  config.CYCLES_PER_UPDATE(0);
+  config.SEED(61);
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  config.FILE_PATH("hardware_test_output");
+  config.POP_SIZE(1);
+  config.START_MOI(0);
+
+  emp::Random random(config.SEED());
+  world_t world(random, &config);
+  world.Setup();
+  auto& prog_builder = world.GetProgramBuilder();
+
+  program_t program;
+  prog_builder.AddStartAnchor(program);
+  prog_builder.AddInst(program, "Increment", 0);
+  prog_builder.AddInst(program, "Increment", 0);
+  prog_builder.AddInst(program, "Increment", 1);
+  prog_builder.AddInst(program, "Decrement", 2);
+
+  // Runs a host's CPU and returns its registers
+  auto run_host = [](sgp_host_t& host) {
+    host.GetHardware().RunCPUStep(50);
+    emp::vector<uint32_t> registers;
+    for (size_t i = 0; i < hw_spec_t::num_registers; ++i) {
+      registers.push_back(host.GetHardware().GetRegister(i));
+    }
+    return registers;
+  };
+
+  hardware_t::ReleaseSpareBuffers();
+  emp::Ptr<sgp_host_t> first = emp::NewPtr<sgp_host_t>(&random, &world, &config, program);
+  const auto* first_cpu = &first->GetHardware().GetCPU();
+  const emp::vector<uint32_t> first_registers = run_host(*first);
+  first.Delete();
+
+  emp::Ptr<sgp_host_t> second = emp::NewPtr<sgp_host_t>(&random, &world, &config, program);
+  THEN("A new host gets the dead host's CPU, reset to its initial state") {
+    REQUIRE(&second->GetHardware().GetCPU() == first_cpu);
+    REQUIRE(second->GetHardware().GetCPUState().GetCPUCyclesSinceRepro() == 0);
+    REQUIRE(run_host(*second) == first_registers);
+  }
+  second.Delete();
+  hardware_t::ReleaseSpareBuffers();
+}
@@ -109,14 +109,14 @@ TEST_CASE("SGPHost destructor cleans up shared pointers and in-progress reproduc
 
     emp::WorldPosition host_pos = emp::WorldPosition(1, 2);
     host->SetLocation(host_pos);
-    const size_t queue_id = world.GetReproQueue().Enqueue(host->GetHardware().GetCPUState().GetOrgPtr(), host_pos);
+    const sgpmode::ReproductionQueue::event_id_t queue_id = world.GetReproQueue().Enqueue(host->GetHardware().GetCPUState().GetOrgPtr(), host_pos);
     host->GetHardware().GetCPUState().MarkReproInProgress(queue_id);
 
     WHEN("The host is destroyed") {
       host.Delete();
 
       THEN("The host's position in the reproduction queue is marked as invalid") {
-        REQUIRE(world.GetReproQueue().GetQueue()[queue_id].valid == false);
+        REQUIRE(world.GetReproQueue().IsValid(queue_id) == false);
       }
     }
   }
@@ -217,6 +217,99 @@ TEST_CASE("MakeNew returns identical host", "[sgp][sgp-unit]") {
   }
 }
 
+TEST_CASE("Offspring share their parent's program until it's modified", "[sgp][sgp-unit]") {
+  using world_t = sgpmode::SGPWorld;
+  using cpu_state_t = sgpmode::CPUState<world_t>;
+  using hw_spec_t = sgpmode::SGPHardwareSpec<sgpmode::Library, cpu_state_t, world_t>;
+  using sgp_host_t = sgpmode::SGPHost<hw_spec_t>;
+
+  emp::Random random(31);
+  sgpmode::SymConfigSGP config;
+  test_utils::SetWellMixed(config, 4, 0);
+  config.TASK_IO_BANK_SIZE(10);
+  config.SGP_MUT_PER_BIT_RATE(0.0);
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  world_t world(random, &config);
+  world.Setup();
+
+  emp::Ptr<sgp_host_t> host = emp::NewPtr<sgp_host_t>(&random, &world, &config, world.GetProgramBuilder().CreateReproProgram(100));
+  emp::Ptr<sgp_host_t> offspring = host->MakeNew().DynamicCast<sgp_host_t>();
+  REQUIRE(offspring->GetHardware().SharesProgram(host->GetHardware()));
+  REQUIRE(host->GetHardware().GetSharedProgram().GetShareCount() == 2);
+
+  WHEN("The offspring is mutated with a 0 mutation rate") {
+    offspring->Mutate();
+    THEN("It still shares its parent's program") {
+      REQUIRE(offspring->GetHardware().SharesProgram(host->GetHardware()));
+    }
+  }
+
+  WHEN("The offspring asks for a mutable program") {
+    auto& program = offspring->GetHardware().GetMutableProgram();
+    THEN("It gets its own copy, leaving the parent's program alone") {
+      REQUIRE(!offspring->GetHardware().SharesProgram(host->GetHardware()));
+      REQUIRE(host->GetHardware().GetSharedProgram().GetShareCount() == 1);
+      REQUIRE(&program != &host->GetProgram());
+      REQUIRE(*offspring == *host);
+    }
+  }
+
+  offspring.Delete();
+  host.Delete();
+}
+
+TEST_CASE("Copy-on-write mutation makes the same draws as sgplite's ApplyPointMutations", "[sgp][sgp-unit]") {
+  using world_t = sgpmode::SGPWorld;
+  using cpu_state_t = sgpmode::CPUState<world_t>;
+  using hw_spec_t = sgpmode::SGPHardwareSpec<sgpmode::Library, cpu_state_t, world_t>;
+  using sgp_host_t = sgpmode::SGPHost<hw_spec_t>;
+  using program_t = typename sgp_host_t::program_t;
+
+  emp::Random random(31);
+  sgpmode::SymConfigSGP config;
+  test_utils::SetWellMixed(config, 4, 0);
+  config.TASK_IO_BANK_SIZE(10);
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  world_t world(random, &config);
+  world.Setup();
+
+  emp::Ptr<sgp_host_t> host = emp::NewPtr<sgp_host_t>(&random, &world, &config, world.GetProgramBuilder().CreateReproProgram(100));
+  const program_t original = host->GetProgram();
+
+  // One expected mutation per program, so some offspring are left unchanged
+  const double rate = 1.0 / (original.size() * sizeof(original[0]) * 8);
+  sgpl::OpCodeRectifier<sgpmode::Library> rectifier;
+  world_t::mutator_t mutator(rectifier);
+  mutator.SetPerBitMutationRate(rate);
+  size_t num_changed = 0;
+  for (int seed = 1; seed <= 20; ++seed) {
+    emp::Ptr<sgp_host_t> offspring = host->MakeNew().DynamicCast<sgp_host_t>();
+    REQUIRE(offspring->GetHardware().SharesProgram(host->GetHardware()));
+    sgpl::tlrand.Get().ResetSeed(seed);
+    mutator.MutateProgram(offspring->GetHardware().GetSharedProgram());
+
+    program_t expected = original;
+    sgpl::tlrand.Get().ResetSeed(seed);
+    expected.ApplyPointMutations(rate, rectifier);
+
+    REQUIRE(offspring->GetProgram() == expected);
+    REQUIRE(host->GetProgram() == original);
+    if (expected == original) {
+      REQUIRE(offspring->GetHardware().SharesProgram(host->GetHardware()));
+    } else {
+      REQUIRE(!offspring->GetHardware().SharesProgram(host->GetHardware()));
+      ++num_changed;
+    }
+    offspring.Delete();
+  }
+  // The rate is low enough that some offspring keep sharing, but not so low
+  // that none are mutated.
+  REQUIRE(num_changed > 0);
+  REQUIRE(num_changed < 20);
+
+  host.Delete();
+}
+
 TEST_CASE("SetReproCount & GetReproCount","[sgp][sgp-unit]") {
   using world_t = sgpmode::SGPWorld;
   using cpu_state_t = sgpmode::CPUState<world_t>;
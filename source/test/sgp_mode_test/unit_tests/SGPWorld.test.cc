@@ -297,6 +297,103 @@ TEST_CASE("NoBetterMatchingSymbionts returns true for an incoming better match",
   incoming_symbiont.Delete();
 }
 
+TEST_CASE("CountCompatibleSymbionts follows the configured task profile and compatibility modes", "[sgp][sgp-unit]") {
+  sgpmode::SymConfigSGP config;
+  config.SYM_LIMIT(3);
+  config.TASK_IO_BANK_SIZE(10);
+  test_utils::SetWellMixed(config, 1, 0);
+  config.SEED(2312);
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+
+  auto count_compatible = [&config](const std::string& profile_mode, const std::string& compat_mode) {
+    config.TASK_PROFILE_MODE(profile_mode);
+    config.INTERACTION_PROFILE_COMPATIBILITY_MODE(compat_mode);
+    emp::Random random(config.SEED());
+    world_t world(random, &config);
+    world.Setup();
+
+    emp::Ptr<sgp_host_t> host = emp::NewPtr<sgp_host_t>(&random, &world, &config);
+    host->GetHardware().GetCPUState().MarkTaskPerformed(8);
+    for (size_t task_id : {8, 6, 4}) {
+      emp::Ptr<sgp_sym_t> symbiont = emp::NewPtr<sgp_sym_t>(&random, &world, &config);
+      symbiont->GetHardware().GetCPUState().MarkTaskPerformed(task_id);
+      host->AddSymbiont(symbiont);
+    }
+    // Counting in one pass must agree with checking each symbiont.
+    size_t expected = 0;
+    for (emp::Ptr<Organism> symbiont : host->GetSymbionts()) {
+      expected += world.GetInteractionCompatibility(*host, static_cast<sgp_sym_t&>(*symbiont));
+    }
+    const size_t count = world.CountCompatibleSymbionts(*host);
+    REQUIRE(count == expected);
+    host.Delete();
+    return count;
+  };
+
+  REQUIRE(count_compatible("self-all", "always") == 3);
+  REQUIRE(count_compatible("self-all", "task-any-match") == 1);
+  REQUIRE(count_compatible("self-all", "task-perfect-match") == 1);
+  // No organism has parents, so parent task profiles are all empty.
+  REQUIRE(count_compatible("parent-all", "task-any-match") == 0);
+  REQUIRE(count_compatible("parent-all", "task-perfect-match") == 3);
+}
+
+TEST_CASE("Cached task profile matches are updated when task profiles change", "[sgp][sgp-unit]") {
+  sgpmode::SymConfigSGP config;
+  config.SYM_LIMIT(1);
+  config.TASK_IO_BANK_SIZE(10);
+  test_utils::SetWellMixed(config, 1, 0);
+  config.SEED(2312);
+  config.TASK_ENV_CFG_PATH("source/test/sgp_mode_test/hardware-test-env.json");
+  config.INTERACTION_PROFILE_COMPATIBILITY_MODE("task-any-match");
+  config.TASK_PROFILE_MODE("self-all");
+
+  emp::Random random(config.SEED());
+  world_t world(random, &config);
+  world.Setup();
+
+  emp::Ptr<sgp_host_t> host = emp::NewPtr<sgp_host_t>(&random, &world, &config);
+  emp::Ptr<sgp_sym_t> symbiont = emp::NewPtr<sgp_sym_t>(&random, &world, &config);
+  host->AddSymbiont(symbiont);
+  auto& host_state = host->GetHardware().GetCPUState();
+  auto& sym_state = symbiont->GetHardware().GetCPUState();
+  host_state.MarkTaskPerformed(8);
+  sym_state.MarkTaskPerformed(6);
+
+  REQUIRE(host_state.GetTaskProfileVersion() != sym_state.GetTaskProfileVersion());
+  REQUIRE(world.GetTaskProfileMatch(*host, *symbiont).compatible == false);
+  REQUIRE(world.GetTaskProfileMatch(*host, *symbiont).match_strength == 0);
+
+  WHEN("A task that's already in the profile is performed again") {
+    const size_t version = sym_state.GetTaskProfileVersion();
+    sym_state.MarkTaskPerformed(6);
+    THEN("The task profile version doesn't change") {
+      REQUIRE(sym_state.GetTaskProfileVersion() == version);
+    }
+  }
+
+  WHEN("The symbiont performs one of the host's tasks") {
+    sym_state.MarkTaskPerformed(8);
+    THEN("The cached match is recomputed") {
+      REQUIRE(world.GetTaskProfileMatch(*host, *symbiont).compatible == true);
+      REQUIRE(world.GetTaskProfileMatch(*host, *symbiont).match_strength == 1);
+      REQUIRE(world.CountCompatibleSymbionts(*host) == 1);
+    }
+  }
+
+  WHEN("The host's task profile is reset") {
+    sym_state.MarkTaskPerformed(8);
+    REQUIRE(world.CountCompatibleSymbionts(*host) == 1);
+    host_state.ResetTaskPerformance(8);
+    THEN("The cached match is recomputed") {
+      REQUIRE(world.CountCompatibleSymbionts(*host) == 0);
+      REQUIRE(world.GetTaskProfileMatch(*host, *symbiont).match_strength == 0);
+    }
+  }
+
+  host.Delete();
+}
+
 TEST_CASE("FindHostForHorizontalTrans when task matching is not required for horizontal transmission and there is a nearby matching host", "[sgp][sgp-unit]") {
   GIVEN("A host infected with a symbiont") {
     sgpmode::SymConfigSGP config;
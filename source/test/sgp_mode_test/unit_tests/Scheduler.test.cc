@@ -0,0 +1,75 @@
+#include "../../../sgp_mode/Scheduler.h"
+
+#include "../../../catch/catch.hpp"
+
+/**
+ * This file is dedicated to unit tests for the SGP mode Scheduler
+ */
+
+TEST_CASE("Scheduler splits schedule into one contiguous batch per thread", "[sgp]") {
+  emp::Random random(61);
+
+  WHEN("The scheduler is single-threaded") {
+    sgpmode::Scheduler scheduler(random, 10);
+    THEN("All schedule indexes are in a single batch") {
+      REQUIRE(!scheduler.IsThreaded());
+      REQUIRE(scheduler.GetThreadCount() == 1);
+      REQUIRE(scheduler.GetThreadBatches().size() == 1);
+      REQUIRE(scheduler.GetThreadBatches()[0].size() == 10);
+    }
+  }
+
+  WHEN("The scheduler uses several threads") {
+    const size_t world_size = 10;
+    const size_t num_threads = 3;
+    sgpmode::Scheduler scheduler(random, world_size, num_threads);
+    const auto& batches = scheduler.GetThreadBatches();
+    THEN("Each schedule index is in exactly one batch, in order") {
+      REQUIRE(scheduler.IsThreaded());
+      REQUIRE(scheduler.GetThreadCount() == num_threads);
+      REQUIRE(batches.size() == num_threads);
+      size_t expected_idx = 0;
+      for (const auto& batch : batches) {
+        // Batches should be (roughly) evenly sized
+        REQUIRE(batch.size() >= world_size / num_threads);
+        REQUIRE(batch.size() <= (world_size / num_threads) + 1);
+        for (size_t schedule_idx : batch) {
+          REQUIRE(schedule_idx == expected_idx);
+          ++expected_idx;
+        }
+      }
+      REQUIRE(expected_idx == world_size);
+    }
+    THEN("The calling thread is worker 0") {
+      REQUIRE(sgpmode::Scheduler::GetWorkerID() == 0);
+    }
+  }
+
+  WHEN("The scheduler is reconfigured") {
+    sgpmode::Scheduler scheduler(random, 10, 4);
+    scheduler.SetupScheduler(20, 1);
+    THEN("Batches are rebuilt for the new configuration") {
+      REQUIRE(!scheduler.IsThreaded());
+      REQUIRE(scheduler.GetScheduleSize() == 20);
+      REQUIRE(scheduler.GetThreadBatches().size() == 1);
+      REQUIRE(scheduler.GetThreadBatches()[0].size() == 20);
+    }
+  }
+}
+
+TEST_CASE("Scheduler runs a schedule given by the world", "[sgp]") {
+  emp::Random random(62);
+  sgpmode::Scheduler scheduler(random, 10, 3);
+
+  WHEN("A shorter schedule (e.g., only occupied positions) is set") {
+    const emp::vector<size_t> order = {7, 2, 5, 9};
+    scheduler.SetSchedule(order);
+    THEN("The schedule is used as given and re-split between threads") {
+      REQUIRE(scheduler.GetCurSchedule() == order);
+      REQUIRE(scheduler.GetScheduleSize() == order.size());
+      size_t num_scheduled = 0;
+      for (const auto& batch : scheduler.GetThreadBatches()) num_scheduled += batch.size();
+      REQUIRE(num_scheduled == order.size());
+    }
+  }
+}
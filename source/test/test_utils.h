@@ -9,8 +9,29 @@
 #include "../../Empirical/include/emp/math/random_utils.hpp"
 #include "../../Empirical/include/emp/math/Random.hpp"
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
 namespace test_utils {
 
+// Contents of a whole file, read in binary (empty if it can't be opened)
+std::string ReadFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Lines of a whole file, sorted (for files whose row order isn't meaningful)
+emp::vector<std::string> ReadSortedLines(const std::string& path) {
+  std::istringstream in(ReadFile(path));
+  emp::vector<std::string> lines;
+  for (std::string line; std::getline(in, line); ) lines.push_back(line);
+  std::sort(lines.begin(), lines.end());
+  return lines;
+}
+
 void SetEmptyWellMixed(SymConfigBase& cfg) {
   // Set spatial structure mode to well-mixed
   cfg.SPATIAL_STRUCT_MODE("well-mixed");
@@ -11,6 +11,7 @@
 #include "emp/datastructs/map_utils.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <unordered_map>
 
 namespace utils {
@@ -203,6 +204,20 @@ emp::vector<size_t> GenerateRandomOrdering(
   return positions;
 }
 
+/**
+ * Input: A 64-bit value (e.g., a seed or an ID).
+ *
+ * Output: The value with its bits mixed by the splitmix64 finalizer.
+ *
+ * Purpose: Turn related values (consecutive IDs, seed + offset) into
+ *          unrelated-looking hashes or seeds.
+ */
+uint64_t SplitMix64(uint64_t h) {
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111eb;
+  return h ^ (h >> 31);
+}
+
 /**
  * Input: Random number generator, length of ordering.
  *
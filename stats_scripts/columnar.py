@@ -0,0 +1,149 @@
+"""Reader for Symbulation's columnar data files (DATA_FILE_FORMAT columnar).
+
+See source/ColumnarData.h for the format. read_columnar returns the column
+keys and each column's values as the text the CSV data file would contain,
+so scripts that split CSV lines can use the columns unchanged.
+
+Usage as a script converts files to CSV:
+    python3 columnar.py FILE.col [FILE.col ...]
+"""
+import struct
+import sys
+import zlib
+
+MAGIC = 0x4c4f434d5953
+FORMAT_VERSION = 2
+FILE_EXTENSION = ".col"
+INT, FLOAT, STRING = 0, 1, 2
+CODEC_NONE, CODEC_DEFLATE = 0, 1
+
+
+class _Reader:
+    def __init__(self, buffer):
+        self.buffer = buffer
+        self.pos = 0
+
+    def at_end(self):
+        return self.pos >= len(self.buffer)
+
+    def read(self, fmt):
+        val = struct.unpack_from("<" + fmt, self.buffer, self.pos)[0]
+        self.pos += struct.calcsize("<" + fmt)
+        return val
+
+    def read_bytes(self):
+        size = self.read("Q")
+        if self.pos + size > len(self.buffer):
+            raise ValueError("truncated block")
+        val = self.buffer[self.pos:self.pos + size]
+        self.pos += size
+        return val
+
+    def read_string(self):
+        return self.read_bytes().decode()
+
+    def read_var_string(self):
+        size = self.read_varint()
+        val = self.buffer[self.pos:self.pos + size]
+        if len(val) != size:
+            raise ValueError("truncated block")
+        self.pos += size
+        return val.decode()
+
+    def read_varint(self):
+        val = 0
+        shift = 0
+        while True:
+            byte = self.buffer[self.pos]
+            self.pos += 1
+            val |= (byte & 0x7f) << shift
+            if not byte & 0x80:
+                return val
+            shift += 7
+
+
+def _unzigzag(val):
+    return (val >> 1) ^ -(val & 1)
+
+
+def _read_payload(reader, codec):
+    if codec == CODEC_NONE:
+        return reader.read_bytes()
+    size = reader.read("Q")
+    try:
+        payload = zlib.decompress(reader.read_bytes())
+    except zlib.error:
+        raise ValueError("corrupt block")
+    if len(payload) != size:
+        raise ValueError("corrupt block")
+    return payload
+
+
+def _read_column(reader, num_rows, codec):
+    col_type = reader.read("B")
+    payload = _Reader(_read_payload(reader, codec))
+    if col_type == STRING:
+        return [payload.read_var_string() for _ in range(num_rows)]
+    if col_type not in (INT, FLOAT):
+        raise ValueError("unknown column type")
+    mantissa = 0
+    exponent = 0
+    values = []
+    for _ in range(num_rows):
+        if col_type == FLOAT:
+            exponent += _unzigzag(payload.read_varint())
+        mantissa += _unzigzag(payload.read_varint())
+        if col_type == INT:
+            values.append(str(mantissa))
+        else:
+            # Same text as C++ default stream formatting
+            values.append("%g" % float("{}e{}".format(mantissa, exponent)))
+    return values
+
+
+def read_columnar(path):
+    """Returns (keys, columns, has_header_row) for a columnar data file."""
+    with open(path, "rb") as in_file:
+        reader = _Reader(in_file.read())
+    if reader.read("Q") != MAGIC:
+        raise ValueError(path + " is not a columnar data file")
+    version = reader.read("I")
+    if version not in (1, FORMAT_VERSION):
+        raise ValueError(path + " has unknown columnar format version " + str(version))
+    codec = CODEC_NONE if version == 1 else reader.read("B")
+    if codec not in (CODEC_NONE, CODEC_DEFLATE):
+        raise ValueError(path + " has unknown codec " + str(codec))
+    has_header_row = reader.read("B") != 0
+    num_columns = reader.read("Q")
+    keys = []
+    for _ in range(num_columns):
+        keys.append(reader.read_string())
+        reader.read_string()  # description
+    columns = [[] for _ in range(num_columns)]
+    while not reader.at_end():
+        try:
+            num_rows = reader.read("Q")
+            if reader.read("Q") != num_columns:
+                break
+            block = [_read_column(reader, num_rows, codec) for _ in range(num_columns)]
+        except (struct.error, IndexError, ValueError):
+            break  # The last block was cut short
+        for column, values in zip(columns, block):
+            column.extend(values)
+    return keys, columns, has_header_row
+
+
+def columnar_lines(path):
+    """Yields the lines (with newlines) of the CSV file a columnar file replaces."""
+    keys, columns, has_header_row = read_columnar(path)
+    if has_header_row:
+        yield ",".join(keys) + "\n"
+    for row in zip(*columns):
+        yield ",".join(row) + "\n"
+
+
+if __name__ == "__main__":
+    for in_path in sys.argv[1:]:
+        out_path = in_path[:-len(FILE_EXTENSION)] if in_path.endswith(FILE_EXTENSION) else in_path + ".csv"
+        with open(out_path, "w") as out_file:
+            out_file.writelines(columnar_lines(in_path))
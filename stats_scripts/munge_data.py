@@ -1,6 +1,8 @@
 import os.path
 import gzip
 
+from columnar import FILE_EXTENSION, columnar_lines
+
 folder = '../'
 
 treatment_postfixes = ['000000_0.000000', '000000_0.100000', '000000_0.300000', '000000_0.400000', '000000_0.500000']
@@ -20,7 +22,11 @@ for t in treatment_postfixes:
         for p in partners:
             fname = folder +p+"Vals" + str(r) + "_" + t + ".data"
             uid = t + "_" + str(r)
-            curFile = open(fname, 'r')
+            # Runs with DATA_FILE_FORMAT columnar write FILE.data.col instead
+            if os.path.exists(fname + FILE_EXTENSION):
+                curFile = columnar_lines(fname + FILE_EXTENSION)
+            else:
+                curFile = open(fname, 'r')
             for line in curFile:
                 if (line[0] != "u"):
                     splitline = line.split(',')